@@ -13,14 +13,20 @@
 #import "clouds/dsp/granular_processor.h"
 #import <BurnsAudioUnit/multistage_envelope.h>
 #import <BurnsAudioUnit/DSPKernel.hpp>
-#import <BurnsAudioUnit/converter.hpp>
+#import "stmlib/dsp/polyphase_resampler.h"
 #import "stmlib/dsp/parameter_interpolator.h"
 #import <vector>
+#import <atomic>
+#import <thread>
+#import <chrono>
+#import <pthread.h>
 
 #import <BurnsAudioUnit/MIDIProcessor.hpp>
 #import <BurnsAudioUnit/ModulationEngine.hpp>
 #import <BurnsAudioUnit/LFOKernel.hpp>
 
+#import "PerformanceCounters.hpp"
+
 const size_t kAudioBlockSize = 32;
 const size_t kPolyphony = 1;
 const size_t kNumModulationRules = 10;
@@ -116,26 +122,35 @@ public:
         midiProcessor.noteStack.addVoice(this);
     }
     
+    ~CloudsDSPKernel() {
+        stopSpectralWorker();
+    }
+    
     void init(int channelCount, double inSampleRate) {
-        if (inputSrc) {
-            delete inputSrc;
-        }
-        if (outputSrc) {
-            delete outputSrc;
-        }
-        inputSrc = new Converter((int) inSampleRate, 32000);
-        outputSrc = new Converter(32000, (int) inSampleRate);
+        // The worker must not touch the phase vocoder while the processor is re-initialized.
+        stopSpectralWorker();
+        
+        inputSrc.Init((int) inSampleRate, 32000, resamplerQuality);
+        outputSrc.Init(32000, (int) inSampleRate, resamplerQuality);
 
+        allocateRecordingBuffers();
         processor.Init(
-                       &large_buffer[0], sizeof(large_buffer),
-                       &small_buffer[0],sizeof(small_buffer));
+                       &large_buffer[0], large_buffer.size(),
+                       &small_buffer[0], small_buffer.size());
         
         processor.set_num_channels(2);
         processor.set_low_fidelity(false);
+        processor.set_float_storage(floatStorage);
+        processor.set_fft_alignment(fftAlignment);
         processor.set_playback_mode(clouds::PLAYBACK_MODE_GRANULAR);
         playback_mode = clouds::PLAYBACK_MODE_GRANULAR;
         processor.Prepare();
         
+        if (asynchronousSpectral) {
+            processor.set_asynchronous_buffering(true);
+            startSpectralWorker();
+        }
+        
         midiAllNotesOff();
         envelope.Init();
         lfo.Init(32000);
@@ -143,6 +158,102 @@ public:
         modEngine.rules = &modulationEngineRules;
         modEngine.in[ModInDirect] = 1.0f;
         previousGain = 0.0f;
+        performanceCounters.init(inSampleRate);
+    }
+    
+    // Not on the render thread, and from one thread at a time.
+    void readPerformanceCounters(PerformanceSnapshot *snapshot) {
+        performanceCounters.read(snapshot);
+    }
+    
+    void resetPerformanceCounters() {
+        performanceCounters.reset();
+    }
+    
+    // Takes effect at the next init().
+    void setResamplerQuality(stmlib::ResamplerQuality quality) {
+        resamplerQuality = quality;
+    }
+    
+    // In stretch mode, aligns the windows on the recorded samples at full resolution rather than
+    // on their signs. Costs up to twice as much per window, and takes effect at the next one.
+    void setFftAlignment(bool enabled) {
+        fftAlignment = enabled;
+        processor.set_fft_alignment(enabled);
+    }
+    
+    // Records seconds of audio per channel instead of the module's 1 second at 32kHz, in
+    // floating point instead of 16-bit if floatStorage is set. 0 restores the module's 1
+    // second. Takes effect at the next init().
+    void setRecordingBuffer(double seconds, bool floatStorage) {
+        recordingBufferSeconds = seconds;
+        this->floatStorage = floatStorage;
+    }
+    
+    // Sizes in bytes of the buffers which the next init() allocates.
+    void recordingBufferSizes(size_t *smallSize, size_t *largeSize) const {
+        size_t bytesPerSample = floatStorage ? sizeof(float) : sizeof(int16_t);
+        // The module's buffers, scaled so that floats record as long as 16-bit samples. In mono
+        // the large buffer is all sample memory; in stereo its workspace part only grows.
+        *smallSize = (65536 - 128) * (bytesPerSample / sizeof(int16_t));
+        *largeSize = 118784 * (bytesPerSample / sizeof(int16_t));
+        if (recordingBufferSeconds > 0.0) {
+            *smallSize = static_cast<size_t>(recordingBufferSeconds * 32000.0) * bytesPerSample;
+            // In stereo, the rest of the large buffer is the workspace of the WSOLA correlator.
+            *largeSize = *smallSize + kRecordingWorkspaceSize;
+        }
+    }
+    
+    // The memory is allocated here rather than in the processor, which only splits the two
+    // buffers it is given. Called from init(), never from the render thread.
+    void allocateRecordingBuffers() {
+        size_t smallSize, largeSize;
+        recordingBufferSizes(&smallSize, &largeSize);
+        // Fresh vectors: a shrunk vector would keep its capacity.
+        std::vector<uint8_t>(largeSize).swap(large_buffer);
+        std::vector<uint8_t>(smallSize).swap(small_buffer);
+    }
+    
+    // In asynchronous mode, the phase vocoder FFTs run on a worker thread instead of landing
+    // on the render thread every 32nd block. The worker has one FFT hop (1024 samples at
+    // 32kHz) to transform each frame. Must not be called from the render thread.
+    void setAsynchronousSpectral(bool enabled) {
+        if (enabled == asynchronousSpectral) {
+            return;
+        }
+        asynchronousSpectral = enabled;
+        if (enabled) {
+            processor.set_asynchronous_buffering(true);
+            startSpectralWorker();
+        } else {
+            stopSpectralWorker();
+            processor.set_asynchronous_buffering(false);
+        }
+    }
+    
+    void startSpectralWorker() {
+        if (spectralWorker.joinable()) {
+            return;
+        }
+        spectralWorkerRunning = true;
+        spectralWorker = std::thread([this] {
+#ifdef __APPLE__
+            pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0);
+#endif
+            while (spectralWorkerRunning) {
+                if (!processor.BufferSpectralFrames()) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+        });
+    }
+    
+    void stopSpectralWorker() {
+        if (!spectralWorker.joinable()) {
+            return;
+        }
+        spectralWorkerRunning = false;
+        spectralWorker.join();
     }
     
     void setupModulationRules() {
@@ -519,6 +630,8 @@ public:
     }
     
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        performanceCounters.beginProcess(frameCount, bufferOffset);
+        
         float* outL = (float*)outBufferListPtr->mBuffers[0].mData + bufferOffset;
         float* outR = (float*)outBufferListPtr->mBuffers[1].mData + bufferOffset;
         float *inL = (float *)inBufferListPtr->mBuffers[0].mData + bufferOffset;
@@ -540,11 +653,13 @@ public:
             if (renderedFramesPos == kAudioBlockSize) {
                 runModulations(kAudioBlockSize);
                 
-                ConverterResult result;
-                inputSrc->convert(inL, inR, inputFramesRemaining, processedL + carriedInputFrames, processedR + carriedInputFrames, kAudioBlockSize - carriedInputFrames, &result);
-                inL += result.inputConsumed;
-                inR += result.inputConsumed;
-                inputFramesRemaining -= result.inputConsumed;
+                stmlib::ResamplerResult result;
+                performanceCounters.beginResampler();
+                inputSrc.Process(inL, inR, inputFramesRemaining, processedL + carriedInputFrames, processedR + carriedInputFrames, kAudioBlockSize - carriedInputFrames, &result);
+                performanceCounters.endResampler();
+                inL += result.input_consumed;
+                inR += result.input_consumed;
+                inputFramesRemaining -= (int) result.input_consumed;
                 
                 // convert inputBuffer into clouds Input
                 clouds::FloatFrame input[kAudioBlockSize] = {};
@@ -552,7 +667,7 @@ public:
                 // We might not fill all of the input buffer if there is a deficiency, but this cannot be avoided due to imprecisions between the input and output SRC.
                 float gain = inputGain;
                 
-                for (int i = 0; i < carriedInputFrames + result.outputLength; i++) {
+                for (int i = 0; i < carriedInputFrames + (int) result.output_length; i++) {
                     input[i].l = clamp(processedL[i] * gain, -1.0f, 1.0f);
                     input[i].r = clamp(processedR[i] * gain, -1.0f, 1.0f);
                 }
@@ -575,6 +690,8 @@ public:
                     renderedL[i] = output[i].l * amount;
                     renderedR[i] = output[i].r * amount;
                 }
+                performanceCounters.countDenormals(renderedL, kAudioBlockSize);
+                performanceCounters.countDenormals(renderedR, kAudioBlockSize);
                 
                 renderedFramesPos = 0;
                 
@@ -588,22 +705,28 @@ public:
                 }
             }
             
-            ConverterResult result;
+            stmlib::ResamplerResult result;
 
-            outputSrc->convert(renderedL + renderedFramesPos, renderedR + renderedFramesPos, kAudioBlockSize - renderedFramesPos, outL, outR, outputFramesRemaining, &result);
+            performanceCounters.beginResampler();
+            outputSrc.Process(renderedL + renderedFramesPos, renderedR + renderedFramesPos, kAudioBlockSize - renderedFramesPos, outL, outR, outputFramesRemaining, &result);
+            performanceCounters.endResampler();
             
-            outL += result.outputLength;
-            outR += result.outputLength;
+            outL += result.output_length;
+            outR += result.output_length;
             
-            renderedFramesPos += result.inputConsumed;
-            outputFramesRemaining -= result.outputLength;
+            renderedFramesPos += (int) result.input_consumed;
+            outputFramesRemaining -= (int) result.output_length;
         }
         
         if (inputFramesRemaining > 0) {
-            ConverterResult result;
-            inputSrc->convert(inL, inR, inputFramesRemaining, processedL, processedR, kAudioBlockSize, &result);
-            carriedInputFrames = result.outputLength;
+            stmlib::ResamplerResult result;
+            performanceCounters.beginResampler();
+            inputSrc.Process(inL, inR, inputFramesRemaining, processedL, processedR, kAudioBlockSize, &result);
+            performanceCounters.endResampler();
+            carriedInputFrames = (int) result.output_length;
         }
+        
+        performanceCounters.endProcess();
     }
     
     void drawLFO(float *points, int count) {
@@ -622,21 +745,32 @@ private:
     
     unsigned int activePolyphony = 1;
     
+    PerformanceCounters performanceCounters;
+    
 public:
     clouds::Parameters baseParameters;
     clouds::GranularProcessor processor;
     KernelTransportState transportState;
+    
+    bool asynchronousSpectral = false;
+    std::atomic<bool> spectralWorkerRunning;
+    std::thread spectralWorker;
     int playback_mode;
 
-    uint8_t large_buffer[118784];
-    uint8_t small_buffer[65536 - 128];
-    
-    Converter *inputSrc = 0;
+    static const size_t kRecordingWorkspaceSize = 4096;
+    double recordingBufferSeconds = 0.0;
+    bool floatStorage = false;
+    bool fftAlignment = false;
+    std::vector<uint8_t> large_buffer;
+    std::vector<uint8_t> small_buffer;
+    
+    stmlib::ResamplerQuality resamplerQuality = stmlib::RESAMPLER_QUALITY_REALTIME;
+    stmlib::PolyphaseResampler inputSrc;
     float processedL[kAudioBlockSize] = {};
     float processedR[kAudioBlockSize] = {};
     int carriedInputFrames = 0;
     
-    Converter *outputSrc = 0;
+    stmlib::PolyphaseResampler outputSrc;
     float renderedL[kAudioBlockSize] = {};
     float renderedR[kAudioBlockSize] = {};
     int renderedFramesPos = 0;
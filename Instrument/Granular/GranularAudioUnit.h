@@ -23,6 +23,18 @@
 - (void) reloadCloudsBufferFromState:(NSDictionary *)state;
 - (void) storeCloudsBufferInState:(NSMutableDictionary *)state;
 
+// Seconds of audio recorded per channel, up to 10 minutes; 0 keeps the module's 1 second. Float
+// storage records in floating point instead of 16-bit. Both are saved in fullState. They take
+// effect at once when the render resources are not allocated, else at the next allocation.
+@property (nonatomic) double recordingBufferSeconds;
+@property (nonatomic) BOOL floatRecordingStorage;
+
+// Render statistics of the kernel since the last reset, keyed by the fields of
+// PerformanceSnapshot. Never blocks the render thread; must only be polled from one thread, such
+// as the display link of the view controller.
+- (NSDictionary<NSString *, NSNumber *> *) performanceCounters;
+- (void) resetPerformanceCounters;
+
 @end
 
 #endif /* GranularAudioUnit_h */
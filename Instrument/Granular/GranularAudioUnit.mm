@@ -20,8 +20,8 @@
 #define DEBUG_LOG(...)
 #endif
 
-#define CLOUDS_SMALLBUFFER_LEN (65536 - 128)
-#define CLOUDS_LARGEBUFFER_LEN 118784
+// Longest recording buffer offered, in seconds per channel.
+static const double kMaxRecordingBufferSeconds = 600.0;
 
 @interface GranularAudioUnit ()
 
@@ -38,6 +38,11 @@
     // C++ members need to be ivars; they would be copied on access if they were properties.
     CloudsDSPKernel _kernel;
     AUParameter *freezeParameter;
+    
+    double _recordingBufferSeconds;
+    BOOL _floatRecordingStorage;
+    // A frozen recording restored from a state whose buffers are not allocated yet.
+    NSDictionary *pendingCloudsBufferState;
 }
 
 @synthesize parameterTree = _parameterTree;
@@ -56,6 +61,7 @@
     
     // Create a DSP kernel to handle the signal processing.
     _kernel.init(defaultFormat.channelCount, defaultFormat.sampleRate);
+    _kernel.setAsynchronousSpectral(true);
     
     // Create a parameter object for the attack time.
     AudioUnitParameterOptions flags = kAudioUnitParameterFlag_IsWritable |
@@ -454,9 +460,15 @@ NSArray *modOutputs = @[
         return NO;
     }
     
+    _kernel.setResamplerQuality(self.renderingOffline ? stmlib::RESAMPLER_QUALITY_OFFLINE : stmlib::RESAMPLER_QUALITY_REALTIME);
     _kernel.init(_audioBuffers.outputBus.format.channelCount, _audioBuffers.outputBus.format.sampleRate);
     _kernel.midiAllNotesOff();
     
+    if (pendingCloudsBufferState) {
+        [self reloadCloudsBufferFromState:pendingCloudsBufferState];
+        pendingCloudsBufferState = nil;
+    }
+    
     if (self.musicalContextBlock) {
         [_hostTransport setMusicalContextBlock: self.musicalContextBlock];
     }
@@ -546,6 +558,7 @@ static AUAudioUnitPreset* NewAUPreset(NSInteger number, NSString *name)
 - (NSDictionary *)fullState {
     NSMutableDictionary *parentState = [_stateManager fullStateWithDictionary:[super fullState]];
     
+    [self storeRecordingBufferInState:parentState];
     [self storeCloudsBufferInState:parentState];
 
     return parentState;
@@ -555,6 +568,7 @@ static AUAudioUnitPreset* NewAUPreset(NSInteger number, NSString *name)
     [_stateManager setFullState:fullState];
     
     _kernel.setupModulationRules();
+    [self loadRecordingBufferFromState:fullState];
     [self reloadCloudsBufferFromState:fullState];
 }
 
@@ -562,6 +576,7 @@ static AUAudioUnitPreset* NewAUPreset(NSInteger number, NSString *name)
     DEBUG_LOG(@"fullStateForDocument")
     NSMutableDictionary *parentState = [_stateManager fullStateForDocumentWithDictionary:[super fullStateForDocument]];
      
+    [self storeRecordingBufferInState:parentState];
     [self storeCloudsBufferInState:parentState];
     
     return parentState;
@@ -574,26 +589,83 @@ static AUAudioUnitPreset* NewAUPreset(NSInteger number, NSString *name)
     [super setFullStateForDocument:fullStateForDocument];
     
     _kernel.setupModulationRules();
+    [self loadRecordingBufferFromState:fullStateForDocument];
     [self reloadCloudsBufferFromState:fullStateForDocument];
 
     DEBUG_LOG(@"setFullStateForDocument end")
 }
 
+// The buffers are only restored if they have the size of the recording buffers of the state. When
+// those are not allocated yet, they are restored by the next allocateRenderResources.
 - (void) reloadCloudsBufferFromState:(NSDictionary *)state {
     NSData *smallBuffer = state[@"smallBuffer"];
     NSData *largeBuffer = state[@"largeBuffer"];
-    if (smallBuffer != nil && largeBuffer != nil && smallBuffer.length == CLOUDS_SMALLBUFFER_LEN && largeBuffer.length == CLOUDS_LARGEBUFFER_LEN) {
+    size_t smallSize, largeSize;
+    _kernel.recordingBufferSizes(&smallSize, &largeSize);
+    if (smallBuffer != nil && largeBuffer != nil && smallBuffer.length == smallSize && largeBuffer.length == largeSize) {
+        if (_kernel.small_buffer.size() != smallSize || _kernel.large_buffer.size() != largeSize) {
+            pendingCloudsBufferState = state;
+            return;
+        }
         DEBUG_LOG(@"reloading Clouds buffer from State")
         
-        memcpy(_kernel.small_buffer, smallBuffer.bytes, CLOUDS_SMALLBUFFER_LEN);
-        memcpy(_kernel.large_buffer, largeBuffer.bytes, CLOUDS_LARGEBUFFER_LEN);
+        memcpy(_kernel.small_buffer.data(), smallBuffer.bytes, smallSize);
+        memcpy(_kernel.large_buffer.data(), largeBuffer.bytes, largeSize);
     }
 }
 
 - (void) storeCloudsBufferInState:(NSMutableDictionary *)state {
     if (freezeParameter.value > 0.9f) {
-        state[@"largeBuffer"] = [NSData dataWithBytes:_kernel.large_buffer length:CLOUDS_LARGEBUFFER_LEN];
-        state[@"smallBuffer"] = [NSData dataWithBytes:_kernel.small_buffer length:CLOUDS_SMALLBUFFER_LEN];
+        state[@"largeBuffer"] = [NSData dataWithBytes:_kernel.large_buffer.data() length:_kernel.large_buffer.size()];
+        state[@"smallBuffer"] = [NSData dataWithBytes:_kernel.small_buffer.data() length:_kernel.small_buffer.size()];
+    }
+}
+
+// MARK - recording buffer
+
+- (double)recordingBufferSeconds {
+    return _recordingBufferSeconds;
+}
+
+- (void)setRecordingBufferSeconds:(double)seconds {
+    _recordingBufferSeconds = std::min(std::max(seconds, 0.0), kMaxRecordingBufferSeconds);
+    [self applyRecordingBuffer];
+}
+
+- (BOOL)floatRecordingStorage {
+    return _floatRecordingStorage;
+}
+
+- (void)setFloatRecordingStorage:(BOOL)floatStorage {
+    _floatRecordingStorage = floatStorage;
+    [self applyRecordingBuffer];
+}
+
+// The buffers are never reallocated while the render thread may use them: until the render
+// resources are deallocated, the new ones wait for the next allocateRenderResources.
+- (void) applyRecordingBuffer {
+    _kernel.setRecordingBuffer(_recordingBufferSeconds, _floatRecordingStorage);
+    if (!self.renderResourcesAllocated) {
+        _kernel.init(_audioBuffers.outputBus.format.channelCount, _audioBuffers.outputBus.format.sampleRate);
+    }
+}
+
+- (void) storeRecordingBufferInState:(NSMutableDictionary *)state {
+    state[@"recordingBufferSeconds"] = @(_recordingBufferSeconds);
+    state[@"floatRecordingStorage"] = @(_floatRecordingStorage);
+}
+
+// States saved before the recording buffers could be changed keep the current ones.
+- (void) loadRecordingBufferFromState:(NSDictionary *)state {
+    NSNumber *seconds = state[@"recordingBufferSeconds"];
+    NSNumber *floatStorage = state[@"floatRecordingStorage"];
+    if (seconds == nil || floatStorage == nil) {
+        return;
+    }
+    if (seconds.doubleValue != _recordingBufferSeconds || floatStorage.boolValue != _floatRecordingStorage) {
+        _recordingBufferSeconds = std::min(std::max(seconds.doubleValue, 0.0), kMaxRecordingBufferSeconds);
+        _floatRecordingStorage = floatStorage.boolValue;
+        [self applyRecordingBuffer];
     }
 }
 
@@ -639,4 +711,28 @@ static AUAudioUnitPreset* NewAUPreset(NSInteger number, NSString *name)
     return _kernel.lfoDrawingDirty();
 }
 
+// MARK - performance counters
+- (NSDictionary<NSString *, NSNumber *> *) performanceCounters {
+    PerformanceSnapshot snapshot;
+    _kernel.readPerformanceCounters(&snapshot);
+    return @{
+        @"buffers": @(snapshot.buffers),
+        @"frames": @(snapshot.frames),
+        @"overloads": @(snapshot.overloads),
+        @"denormals": @(snapshot.denormals),
+        @"lastNanoseconds": @(snapshot.lastNanoseconds),
+        @"lastLoad": @(snapshot.lastLoad),
+        @"p99Load": @(snapshot.p99Load),
+        @"maxLoad": @(snapshot.maxLoad),
+        @"dspSeconds": @(snapshot.dspSeconds),
+        @"resamplerSeconds": @(snapshot.resamplerSeconds),
+        @"activeVoices": @(snapshot.activeVoices),
+        @"maxActiveVoices": @(snapshot.maxActiveVoices),
+    };
+}
+
+- (void) resetPerformanceCounters {
+    _kernel.resetPerformanceCounters();
+}
+
 @end
@@ -147,6 +147,19 @@ class GranularViewController: BaseAudioUnitViewController {
             processor.setAutomation(midiCC.value > 0.9)
         }
         
+        // The recording buffers are reallocated the next time the host starts the plug-in, or at
+        // once when it is not running.
+        let bufferLengths: [Double] = [0, 10, 30, 60, 120, 300, 600]
+        let bufferLength = Picker(name: "Recording Buffer", value: Float(bufferLengths.firstIndex(of: audioUnit.recordingBufferSeconds) ?? 0), valueStrings: ["1 s", "10 s", "30 s", "1 min", "2 min", "5 min", "10 min"], horizontal: true)
+        bufferLength.addControlEvent(.valueChanged) {
+            audioUnit.recordingBufferSeconds = bufferLengths[Int(bufferLength.value)]
+        }
+        
+        let storage = Picker(name: "Recording Storage", value: audioUnit.floatRecordingStorage ? 1.0 : 0.0, valueStrings: ["16-bit", "Float"], horizontal: true)
+        storage.addControlEvent(.valueChanged) {
+            audioUnit.floatRecordingStorage = storage.value > 0.9
+        }
+        
         let loadDefault = SettingsButton()
         loadDefault.button.setTitle("Load Defaults", for: .normal)
         loadDefault.button.addControlEvent(.touchUpInside) { [weak self] in
@@ -172,6 +185,9 @@ class GranularViewController: BaseAudioUnitViewController {
             Header("MIDI"),
             midiChannel,
             midiCC,
+            Header("Recording"),
+            bufferLength,
+            storage,
             HStack([loadDefault, saveDefault]),
             ]), requiresScroll: true)
     }
@@ -21,13 +21,16 @@
 #import <vector>
 #import "elements/dsp/part.h"
 #import <BurnsAudioUnit/LFOKernel.hpp>
-#import <BurnsAudioUnit/converter.hpp>
+#import "stmlib/dsp/polyphase_resampler.h"
+#import "stmlib/utils/sample_bank.h"
 
 #import <BurnsAudioUnit/MIDIProcessor.hpp>
 #import <BurnsAudioUnit/ModulationEngine.hpp>
 
+#import "PerformanceCounters.hpp"
+
 const size_t kAudioBlockSize = 16;
-const size_t kPolyphony = 1;
+const size_t kMaxPolyphony = elements::kMaxPolyphony;
 const size_t kNumModulationRules = 10;
 
 enum {
@@ -61,6 +64,7 @@ enum {
     ElementsParamLfoTempoSync = 28,
     ElementsParamLfoResetPhase = 29,
     ElementsParamLfoKeyReset = 30,
+    ElementsParamPolyphony = 31,
     ElementsParamModMatrixStart = 400,
     ElementsParamModMatrixEnd = 400 + (kNumModulationRules * 4), // 26 + 40 = 66
     
@@ -112,17 +116,83 @@ enum {
  Performs our filter signal processing.
  As a non-ObjC class, this is safe to use from render thread.
  */
-class ElementsDSPKernel : public DSPKernel, public MIDIVoice {
+class ElementsDSPKernel : public DSPKernel {
 public:
+    // The part is shared by all the notes: the patch, the modulations and the envelope are
+    // global, each note only has its own pitch, velocity and gate.
+    class VoiceState: public MIDIVoice {
+    public:
+        int state = NoteStateUnused;
+        ElementsDSPKernel *kernel = 0;
+        
+        bool gate = false;
+        bool delayed_trigger = false;
+        uint8_t note = 48;
+        float velocity = 0.0f;
+        
+        virtual void midiNoteOff(uint8_t vel) override {
+            state = NoteStateReleasing;
+            gate = false;
+            delayed_trigger = false;
+            kernel->modEngine.in[ModInLift] = ((float) vel )/ 127.0f;
+            if (!kernel->anyNotePlaying()) {
+                kernel->envelope.TriggerLow();
+            }
+        }
+        
+        void add() {
+            if (state == NoteStateUnused) {
+                gate = true;
+                kernel->trigger();
+            } else {
+                delayed_trigger = true;
+            }
+            state = NoteStatePlaying;
+        }
+        
+        virtual void retrigger() override {
+            kernel->trigger();
+        }
+        
+        virtual void midiNoteOn(uint8_t note, uint8_t vel) override {
+            this->note = note;
+            velocity = ((float) vel) / 127.0;
+            kernel->modEngine.in[ModInNote] = ((float) note) / 127.0f;
+            kernel->modEngine.in[ModInVelocity] = velocity;
+            kernel->modEngine.in[ModInLift] = 0.0f;
+            
+            add();
+        }
+        
+        virtual void midiAllNotesOff() override {
+            state = NoteStateUnused;
+            delayed_trigger = false;
+            gate = false;
+            kernel->midiAllNotesOff();
+        }
+        
+        virtual void midiControlMessage(MIDIControlMessage msg, int16_t val) override {
+            kernel->midiControlMessage(msg, val);
+        }
+        
+        virtual int State() override {
+            return state;
+        }
+    };
+    
     // MARK: Member Functions
     
-    ElementsDSPKernel() : midiProcessor(1), modEngine(NumModulationInputs, NumModulationOutputs), modulationEngineRules(kNumModulationRules, NumModulationInputs, NumModulationOutputs),
+    ElementsDSPKernel() : midiProcessor(kMaxPolyphony), modEngine(NumModulationInputs, NumModulationOutputs), modulationEngineRules(kNumModulationRules, NumModulationInputs, NumModulationOutputs),
         lfo(ElementsParamLfoRate, ElementsParamLfoShape, ElementsParamLfoShapeMod, ElementsParamLfoTempoSync, ElementsParamLfoResetPhase, ElementsParamLfoKeyReset)
 
     {
-        midiProcessor.noteStack.addVoice(this);
+        for (int i = 0; i < kMaxPolyphony; i++) {
+            voices[i].kernel = this;
+            midiProcessor.noteStack.addVoice(&voices[i]);
+        }
+        midiProcessor.noteStack.setActivePolyphony(1);
         
-        part.Init(reverb_buffer);
+        part.Init(reverb_buffer, elements::kNativeSampleRate);
         
         patch = part.mutable_patch();
         
@@ -146,31 +216,101 @@ public:
     
     ~ElementsDSPKernel() {
         KERNEL_DEBUG_LOG("kernel voice delete\n")
-        
-        if (inputSrc) {
-            delete inputSrc;
-        }
-        if (outputSrc) {
-            delete outputSrc;
-        }
     }
     
     void init(int channelCount, double inSampleRate) {
-        if (inputSrc) {
-            delete inputSrc;
-        }
-        if (outputSrc) {
-            delete outputSrc;
-        }
-        inputSrc = new Converter((int) inSampleRate, 32000);
-        outputSrc = new Converter(32000, (int) inSampleRate);
+        int partSampleRate = renderAtHostRate ? (int) inSampleRate : (int) elements::kNativeSampleRate;
+        
+        // Part::Init resets the resonator model and the polyphony, which are set from the
+        // parameters.
+        elements::ResonatorModel resonatorModel = part.resonator_model();
+        bool easterEgg = part.easter_egg_;
+        part.Init(reverb_buffer, partSampleRate);
+        part.set_resonator_model(resonatorModel);
+        part.easter_egg_ = easterEgg;
+        part.set_polyphony(midiProcessor.noteStack.getActivePolyphony());
+        part.set_ominous_oversampling(ominousOversampling);
+        applySampleBank();
         
-        midiAllNotesOff();
+        // At equal rates, the resamplers copy their input.
+        inputSrc.Init((int) inSampleRate, partSampleRate, resamplerQuality);
+        outputSrc.Init(partSampleRate, (int) inSampleRate, resamplerQuality);
+        
+        for (int i = 0; i < kMaxPolyphony; i++) {
+            voices[i].midiAllNotesOff();
+        }
         envelope.Init();
-        lfo.Init(32000);
+        lfo.Init(partSampleRate);
         
         modEngine.rules = &modulationEngineRules;
         modEngine.in[ModInDirect] = 1.0f;
+        performanceCounters.init(inSampleRate);
+    }
+    
+    // Not on the render thread, and from one thread at a time.
+    void readPerformanceCounters(PerformanceSnapshot *snapshot) {
+        performanceCounters.read(snapshot);
+    }
+    
+    void resetPerformanceCounters() {
+        performanceCounters.reset();
+    }
+    
+    // Takes effect at the next init().
+    void setResamplerQuality(stmlib::ResamplerQuality quality) {
+        resamplerQuality = quality;
+    }
+    
+    // Runs the part at the host rate instead of the 32kHz of the module. Takes effect at the
+    // next init().
+    void setRenderAtHostRate(bool enabled) {
+        renderAtHostRate = enabled;
+    }
+    
+    // Oversampling factor of the FM oscillators of the easter egg model: 2, 4 or 8. Lower factors
+    // cost less, and alias more. Takes effect at the next init().
+    void setOminousOversampling(int oversampling) {
+        ominousOversampling = oversampling;
+    }
+    
+    // Maps a bank written by elements/resources/exciter_bank.py. The exciters play it from the
+    // next render call on, or the samples of the module again if path is NULL. Must not be
+    // called from the render thread.
+    bool loadSampleBank(const char* path) {
+        return sampleBank.Load(path);
+    }
+    
+    // Render thread. A section missing from the bank, or inconsistent, is replaced by the one
+    // of the module.
+    void applySampleBank() {
+        const stmlib::SampleBank* bank = sampleBank.bank();
+        const int16_t* sampleData = nullptr;
+        const uint32_t* boundaries = nullptr;
+        const int16_t* noiseSample = nullptr;
+        if (bank && bank->is_open()) {
+            size_t size = 0;
+            size_t numBoundaries = 0;
+            size_t noiseSize = 0;
+            size_t stride = 0;
+            // The boundaries index the samples: without them, they are not read at all.
+            sampleData = bank->section<int16_t>(stmlib::SampleBankTag('H', 'I', 'T', 'S'), &size, &stride);
+            if (sampleData) {
+                boundaries = bank->section<uint32_t>(stmlib::SampleBankTag('B', 'N', 'D', 'S'), &numBoundaries, &stride);
+            }
+            noiseSample = bank->section<int16_t>(stmlib::SampleBankTag('N', 'O', 'I', 'S'), &noiseSize, &stride);
+            bool valid = sampleData && boundaries && numBoundaries == SMP_BOUNDARIES_SIZE;
+            for (size_t i = 1; valid && i < numBoundaries; i++) {
+                valid = boundaries[i] > boundaries[i - 1] && boundaries[i] <= size;
+            }
+            if (!valid) {
+                sampleData = nullptr;
+                boundaries = nullptr;
+            }
+            if (noiseSample && noiseSize < SMP_NOISE_SAMPLE_SIZE) {
+                noiseSample = nullptr;
+            }
+        }
+        part.set_samples(sampleData, boundaries, noiseSample);
     }
     
     void setupModulationRules() {
@@ -248,6 +388,18 @@ public:
                 inputResonator = (value > 0.7);
                 break;
                 
+            case ElementsParamPolyphony: {
+                int newPolyphony = 1 + round(clamp(value, 0.0f, (float) kMaxPolyphony - 1));
+                if (newPolyphony != midiProcessor.noteStack.getActivePolyphony()) {
+                    for (int i = 0; i < kMaxPolyphony; i++) {
+                        voices[i].midiAllNotesOff();
+                    }
+                    midiProcessor.noteStack.setActivePolyphony(newPolyphony);
+                    part.set_polyphony(newPolyphony);
+                }
+                break;
+            }
+                
             case ElementsParamMode:
                 part.set_resonator_model((elements::ResonatorModel) clamp(value, 0.0f, 3.0f));
                 break;
@@ -380,6 +532,9 @@ public:
             case ElementsParamInputGain:
                 return inputGain;
                 
+            case ElementsParamPolyphony:
+                return (float) midiProcessor.noteStack.getActivePolyphony() - 1;
+                
             default:
                 return 0.0f;
         }
@@ -410,45 +565,21 @@ public:
     
     // =========== MIDI
     
-    virtual void midiNoteOff(uint8_t vel) override {
-        state = NoteStateReleasing;
-        gate = false;
-        modEngine.in[ModInLift] = ((float) vel )/ 127.0f;
-        envelope.TriggerLow();
-        delayed_trigger = false;
-    }
-    
-    void add() {
-        if (state == NoteStateUnused) {
-            gate = true;
-            envelope.TriggerHigh();
-            lfo.trigger();
-        } else {
-            delayed_trigger = true;
-        }
-        state = NoteStatePlaying;
-    }
-    
-    virtual void retrigger() override {
+    void trigger() {
         envelope.TriggerHigh();
         lfo.trigger();
     }
     
-    virtual void midiNoteOn(uint8_t note, uint8_t vel) override {
-        currentNote = note;
-        currentVelocity = ((float) vel) / 127.0;
-        modEngine.in[ModInNote] = ((float) currentNote) / 127.0f;
-        modEngine.in[ModInVelocity] = currentVelocity;
-        modEngine.in[ModInLift] = 0.0f;
-
-        add();
+    bool anyNotePlaying() {
+        for (int i = 0; i < kMaxPolyphony; i++) {
+            if (voices[i].gate || voices[i].delayed_trigger) {
+                return true;
+            }
+        }
+        return false;
     }
     
-    virtual void midiAllNotesOff() override {
-        state = NoteStateUnused;
-        printf("note state unused");
-        delayed_trigger = false;
-        gate = false;
+    void midiAllNotesOff() {
         bendAmount = 0.0f;
         modEngine.in[ModInModwheel] = 0.0f;
         modEngine.in[ModInAftertouch] = 0.0f;
@@ -456,7 +587,7 @@ public:
         
     }
     
-    virtual void midiControlMessage(MIDIControlMessage msg, int16_t val) override {
+    void midiControlMessage(MIDIControlMessage msg, int16_t val) {
         switch(msg) {
             case MIDIControlMessage::Pitchbend:
                 bendAmount = (clamp((float) val, -8192.0f, 8192.0f) / 8192.0f) * bendRange;
@@ -476,10 +607,6 @@ public:
         }
     }
     
-    virtual int State() override {
-        return state;
-    }
-    
     virtual void handleMIDIEvent(AUMIDIEvent const& midiEvent) override {
         midiProcessor.handleMIDIEvent(midiEvent);
     }
@@ -527,11 +654,17 @@ public:
     }
     
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        performanceCounters.beginProcess(frameCount, bufferOffset);
+        
         float* outL = (float*)outBufferListPtr->mBuffers[0].mData + bufferOffset;
         float* outR = (float*)outBufferListPtr->mBuffers[1].mData + bufferOffset;
         float *inL = 0;
         float *inR = 0;
         
+        if (sampleBank.Acquire()) {
+            applySampleBank();
+        }
+        
         if (useAudioInput) {
             inL = (float *)inBufferListPtr->mBuffers[0].mData + bufferOffset;
             inR = (float *)inBufferListPtr->mBuffers[1].mData + bufferOffset;
@@ -549,11 +682,13 @@ public:
                 runModulations(kAudioBlockSize);
                 
                 if (useAudioInput) {
-                    ConverterResult result;
-                    inputSrc->convert(inL, inR, inputFramesRemaining, processedL + carriedInputFrames, processedR + carriedInputFrames, kAudioBlockSize - carriedInputFrames, &result);
-                    inL += result.inputConsumed;
-                    inR += result.inputConsumed;
-                    inputFramesRemaining -= result.inputConsumed;
+                    stmlib::ResamplerResult result;
+                    performanceCounters.beginResampler();
+                    inputSrc.Process(inL, inR, inputFramesRemaining, processedL + carriedInputFrames, processedR + carriedInputFrames, kAudioBlockSize - carriedInputFrames, &result);
+                    performanceCounters.endResampler();
+                    inL += result.input_consumed;
+                    inR += result.input_consumed;
+                    inputFramesRemaining -= (int) result.input_consumed;
                     
                     for (int i = 0; i < kAudioBlockSize; i++) {
                         mixedInput[i] = ((processedL[i] + processedR[i]) / 2.0f) * inputGain;
@@ -563,25 +698,23 @@ public:
                     resInputPtr = inputResonator ? &mixedInput[0] : &silence[0];
                 }
                 
-                //voice->Render(kernel->patch, modulations, &frames[0], kAudioBlockSize);
-                elements::PerformanceState performance;
-                performance.note = currentNote + pitch + detune + bendAmount + 12.0f + modEngine.out[ModOutTune] + (modEngine.out[ModOutFrequency] * 48.0f);
-                
-                performance.modulation = 0.0f; /*i & 16 ? 60.0f : -60.0f;
-                                                if (i > ::kSampleRate * 5) {
-                                                performance.modulation = 0;
-                                                }*/
-                performance.strength = currentVelocity;
-                performance.gate = gate;
+                elements::PerformanceState performance[kMaxPolyphony];
+                for (int i = 0; i < part.polyphony(); i++) {
+                    performance[i].note = voices[i].note + pitch + detune + bendAmount + 12.0f + modEngine.out[ModOutTune] + (modEngine.out[ModOutFrequency] * 48.0f);
+                    performance[i].modulation = 0.0f;
+                    performance[i].strength = voices[i].velocity;
+                    performance[i].gate = voices[i].gate;
+                }
                 float finalVolume = clamp(volume + modEngine.out[ModOutLevel], 0.0f, 1.0f);
                 
                 part.Process(performance, extInputPtr, resInputPtr, renderedL, renderedR, kAudioBlockSize);
                 
-                if (delayed_trigger) {
-                    gate = true;
-                    delayed_trigger = false;
-                    envelope.TriggerHigh();
-                    lfo.trigger();
+                for (int i = 0; i < part.polyphony(); i++) {
+                    if (voices[i].delayed_trigger) {
+                        voices[i].gate = true;
+                        voices[i].delayed_trigger = false;
+                        trigger();
+                    }
                 }
                 
                 if (modulationEngineRules.isPatched(ModOutLevel)) {
@@ -596,26 +729,40 @@ public:
                     renderedR[i] *= amount;
                 }
                 
+                int activeVoices = 0;
+                for (int i = 0; i < part.polyphony(); i++) {
+                    activeVoices += voices[i].gate;
+                }
+                performanceCounters.countDenormals(renderedL, kAudioBlockSize);
+                performanceCounters.countDenormals(renderedR, kAudioBlockSize);
+                performanceCounters.setActiveVoices(activeVoices);
+                
                 modEngine.in[ModInOut] = renderedL[kAudioBlockSize-1];
                 renderedFramesPos = 0;
             }
             
-            ConverterResult result;
+            stmlib::ResamplerResult result;
             
-            outputSrc->convert(renderedL + renderedFramesPos, renderedR + renderedFramesPos, kAudioBlockSize - renderedFramesPos, outL, outR, outputFramesRemaining, &result);
+            performanceCounters.beginResampler();
+            outputSrc.Process(renderedL + renderedFramesPos, renderedR + renderedFramesPos, kAudioBlockSize - renderedFramesPos, outL, outR, outputFramesRemaining, &result);
+            performanceCounters.endResampler();
             
-            outL += result.outputLength;
-            outR += result.outputLength;
+            outL += result.output_length;
+            outR += result.output_length;
             
-            renderedFramesPos += result.inputConsumed;
-            outputFramesRemaining -= result.outputLength;
+            renderedFramesPos += (int) result.input_consumed;
+            outputFramesRemaining -= (int) result.output_length;
         }
         
         if (useAudioInput && inputFramesRemaining > 0) {
-            ConverterResult result;
-            inputSrc->convert(inL, inR, inputFramesRemaining, processedL, processedR, kAudioBlockSize, &result);
-            carriedInputFrames = result.outputLength;
+            stmlib::ResamplerResult result;
+            performanceCounters.beginResampler();
+            inputSrc.Process(inL, inR, inputFramesRemaining, processedL, processedR, kAudioBlockSize, &result);
+            performanceCounters.endResampler();
+            carriedInputFrames = (int) result.output_length;
         }
+        
+        performanceCounters.endProcess();
     }
     
     void drawLFO(float *points, int count) {
@@ -632,23 +779,25 @@ private:
     AudioBufferList* inBufferListPtr = nullptr;
     AudioBufferList* outBufferListPtr = nullptr;
     
-    unsigned int activePolyphony = 1;
-    
-    
+    PerformanceCounters performanceCounters;
     
 public:
     elements::Part part;
+    stmlib::SampleBankLoader sampleBank;
     elements::Patch *patch;
     elements::Patch basePatch;
     
     KernelTransportState transportState;
     
-    Converter *inputSrc = 0;
+    stmlib::ResamplerQuality resamplerQuality = stmlib::RESAMPLER_QUALITY_REALTIME;
+    bool renderAtHostRate = false;
+    int ominousOversampling = elements::kOversamplingUp;
+    stmlib::PolyphaseResampler inputSrc;
     float processedL[kAudioBlockSize] = {};
     float processedR[kAudioBlockSize] = {};
     int carriedInputFrames = 0;
     
-    Converter *outputSrc = 0;
+    stmlib::PolyphaseResampler outputSrc;
     float renderedL[kAudioBlockSize] = {};
     float renderedR[kAudioBlockSize] = {};
     int renderedFramesPos = 0;
@@ -657,11 +806,7 @@ public:
     uint16_t reverb_buffer[32768];
     
     MIDIProcessor midiProcessor;
-    bool gate;
-    uint8_t currentNote = 48;
-    float currentVelocity;
-    int state;
-    bool delayed_trigger = false;
+    VoiceState voices[kMaxPolyphony];
     int pitch = 0;
     float detune = 0;
     int bendRange = 12;
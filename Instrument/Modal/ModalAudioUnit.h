@@ -18,6 +18,22 @@
 - (MIDIProcessorWrapper *) midiProcessor;
 - (void) saveDefaults;
 - (void) loadFromDefaults;
+
+// Exciter sample bank written by elements/resources/exciter_bank.py, or nil for the samples of
+// the module. Returns NO if the file is not a bank.
+- (BOOL) loadSampleBank:(NSString *)path;
+
+// Render statistics of the kernel since the last reset, keyed by the fields of
+// PerformanceSnapshot. Never blocks the render thread; must only be polled from one thread, such
+// as the display link of the view controller.
+- (NSDictionary<NSString *, NSNumber *> *) performanceCounters;
+- (void) resetPerformanceCounters;
+
+// Oversampling factor of the FM oscillators of the easter egg model: 2, 4 or 8. Lower factors
+// cost less CPU and alias more. Saved with the state; while the audio unit renders, it takes
+// effect at the next allocation of the render resources.
+@property (nonatomic) NSInteger ominousOversampling;
+
 @end
 
 #endif /* ModalAudioUnit_h */
@@ -37,6 +37,8 @@
     NSArray *modInputs;
     NSArray *modOutputs;
     bool loadAsEffect;
+    
+    NSInteger _ominousOversampling;
 }
 
 @synthesize parameterTree = _parameterTree;
@@ -60,6 +62,8 @@
     AVAudioFormat *defaultFormat = [[AVAudioFormat alloc] initStandardFormatWithSampleRate:44100. channels:2];
     
     // Create a DSP kernel to handle the signal processing.
+    _ominousOversampling = elements::kOversamplingUp;
+    _kernel.setOminousOversampling((int) _ominousOversampling);
     _kernel.init(defaultFormat.channelCount, defaultFormat.sampleRate);
     _kernel.useAudioInput = loadAsEffect;
     
@@ -221,7 +225,17 @@
                                                                           min:-1.0 max:1.0 unit:kAudioUnitParameterUnit_Generic unitName:nil
                                                                         flags: flags valueStrings:nil dependentParameters:nil];
     
-    AUParameterGroup *resonatorPage = [AUParameterTree createGroupWithIdentifier:@"resonator" name:@"Resonator" children:@[modeParam, pitchParam, detuneParam, geometry, brightness, position, damping, space, volume]];
+    NSMutableArray *polyphonyStrings = [NSMutableArray array];
+    for (int i = 1; i <= elements::kMaxPolyphony; i++) {
+        [polyphonyStrings addObject:[NSString stringWithFormat:@"%d", i]];
+    }
+    AUParameter *polyphonyParam = [AUParameterTree createParameterWithIdentifier:@"polyphony" name:@"Polyphony"
+                                                                         address:ElementsParamPolyphony min:0.0 max:elements::kMaxPolyphony - 1
+                                                                            unit:kAudioUnitParameterUnit_Generic unitName:nil
+                                                                           flags:flags valueStrings:polyphonyStrings
+                                                             dependentParameters:nil];
+    
+    AUParameterGroup *resonatorPage = [AUParameterTree createGroupWithIdentifier:@"resonator" name:@"Resonator" children:@[modeParam, polyphonyParam, pitchParam, detuneParam, geometry, brightness, position, damping, space, volume]];
     
     // LFO
     AUParameter *lfoRate = [AUParameterTree createParameterWithIdentifier:@"lfoRate" name:@"LFO Rate"
@@ -443,6 +457,7 @@
         return NO;
     }
     
+    _kernel.setResamplerQuality(self.renderingOffline ? stmlib::RESAMPLER_QUALITY_OFFLINE : stmlib::RESAMPLER_QUALITY_REALTIME);
     _kernel.init(_audioBuffers.outputBus.format.channelCount, _audioBuffers.outputBus.format.sampleRate);
     _kernel.midiAllNotesOff();
     
@@ -521,7 +536,7 @@ static const FactoryPreset elementsPresets[kElementsNumPresets] =
 {
     {
         @"Init",
-        @"{\"414\":0,\"421\":0,\"407\":0,\"408\":2,\"415\":0,\"422\":0,\"409\":0,\"416\":0,\"423\":0,\"430\":0,\"0\":0.82749956846237183,\"417\":0,\"424\":0,\"1\":0.75250041484832764,\"431\":0,\"2\":0.5074998140335083,\"3\":0,\"418\":0,\"4\":0.7799994945526123,\"425\":0,\"432\":0,\"5\":0,\"6\":0.70500028133392334,\"419\":0,\"7\":0.51499927043914795,\"426\":0,\"10\":0.15249940752983093,\"8\":0.57999992370605469,\"433\":0,\"9\":0.33500015735626221,\"11\":0.69999974966049194,\"427\":0,\"434\":0,\"12\":0.35750013589859009,\"13\":0.69000053405761719,\"400\":1,\"20\":0,\"428\":0,\"435\":0,\"14\":1,\"429\":0,\"401\":0,\"22\":0,\"436\":0,\"15\":0,\"30\":0,\"23\":0,\"16\":0,\"437\":0,\"402\":0,\"24\":0,\"17\":0,\"25\":0,\"18\":0,\"438\":0,\"403\":0,\"410\":0,\"26\":1,\"19\":0,\"27\":0,\"439\":0,\"404\":1,\"411\":0,\"28\":0,\"29\":0,\"405\":0,\"412\":2,\"420\":0,\"406\":0,\"413\":0}"
+        @"{\"414\":0,\"421\":0,\"407\":0,\"408\":2,\"415\":0,\"422\":0,\"409\":0,\"416\":0,\"423\":0,\"430\":0,\"0\":0.82749956846237183,\"417\":0,\"424\":0,\"1\":0.75250041484832764,\"431\":0,\"2\":0.5074998140335083,\"3\":0,\"418\":0,\"4\":0.7799994945526123,\"425\":0,\"432\":0,\"5\":0,\"6\":0.70500028133392334,\"419\":0,\"7\":0.51499927043914795,\"426\":0,\"10\":0.15249940752983093,\"8\":0.57999992370605469,\"433\":0,\"9\":0.33500015735626221,\"11\":0.69999974966049194,\"427\":0,\"434\":0,\"12\":0.35750013589859009,\"13\":0.69000053405761719,\"400\":1,\"20\":0,\"428\":0,\"435\":0,\"14\":1,\"429\":0,\"401\":0,\"22\":0,\"436\":0,\"15\":0,\"30\":0,\"31\":0,\"23\":0,\"16\":0,\"437\":0,\"402\":0,\"24\":0,\"17\":0,\"25\":0,\"18\":0,\"438\":0,\"403\":0,\"410\":0,\"26\":1,\"19\":0,\"27\":0,\"439\":0,\"404\":1,\"411\":0,\"28\":0,\"29\":0,\"405\":0,\"412\":2,\"420\":0,\"406\":0,\"413\":0}"
     },
     {
         @"Blank",
@@ -540,19 +555,27 @@ static AUAudioUnitPreset* NewAUPreset(NSInteger number, NSString *name)
 // MARK - state management
 
 - (NSDictionary *)fullState {
-    return [_stateManager fullStateWithDictionary:[super fullState]];
+    NSMutableDictionary *parentState = [_stateManager fullStateWithDictionary:[super fullState]];
+    
+    [self storeOminousOversamplingInState:parentState];
+    
+    return parentState;
 }
 
 - (void)setFullState:(NSDictionary *)fullState {
     [_stateManager setFullState:fullState];
     
     _kernel.setupModulationRules();
+    [self loadOminousOversamplingFromState:fullState];
 }
 
 - (NSDictionary *)fullStateForDocument {
     DEBUG_LOG(@"fullStateForDocument")
+    NSMutableDictionary *parentState = [_stateManager fullStateForDocumentWithDictionary:[super fullStateForDocument]];
+    
+    [self storeOminousOversamplingInState:parentState];
     
-    return [_stateManager fullStateForDocumentWithDictionary:[super fullStateForDocument]];
+    return parentState;
 }
 
 - (void)setFullStateForDocument:(NSDictionary *)fullStateForDocument {
@@ -562,10 +585,43 @@ static AUAudioUnitPreset* NewAUPreset(NSInteger number, NSString *name)
     [super setFullStateForDocument:fullStateForDocument];
     
     _kernel.setupModulationRules();
+    [self loadOminousOversamplingFromState:fullStateForDocument];
     DEBUG_LOG(@"setFullStateForDocument end")
     
 }
 
+// MARK - ominous oversampling
+
+- (NSInteger)ominousOversampling {
+    return _ominousOversampling;
+}
+
+- (void)setOminousOversampling:(NSInteger)oversampling {
+    _ominousOversampling = oversampling <= 2 ? 2 : (oversampling <= 4 ? 4 : 8);
+    [self applyOminousOversampling];
+}
+
+// The decimators of the voices are never reinitialized while the render thread may use them: until
+// the render resources are deallocated, the new factor waits for the next allocateRenderResources.
+- (void) applyOminousOversampling {
+    _kernel.setOminousOversampling((int) _ominousOversampling);
+    if (!self.renderResourcesAllocated) {
+        _kernel.init(_audioBuffers.outputBus.format.channelCount, _audioBuffers.outputBus.format.sampleRate);
+    }
+}
+
+- (void) storeOminousOversamplingInState:(NSMutableDictionary *)state {
+    state[@"ominousOversampling"] = @(_ominousOversampling);
+}
+
+// States saved before the factor could be changed keep the current one.
+- (void) loadOminousOversamplingFromState:(NSDictionary *)state {
+    NSNumber *oversampling = state[@"ominousOversampling"];
+    if (oversampling != nil && oversampling.integerValue != _ominousOversampling) {
+        self.ominousOversampling = oversampling.integerValue;
+    }
+}
+
 - (void) saveDefaults {
     [_stateManager saveDefaultsForName:@"Modal"];
 }
@@ -608,4 +664,33 @@ static AUAudioUnitPreset* NewAUPreset(NSInteger number, NSString *name)
     return _kernel.lfoDrawingDirty();
 }
 
+// MARK - sample bank
+- (BOOL) loadSampleBank:(NSString *)path {
+    return _kernel.loadSampleBank(path ? path.fileSystemRepresentation : NULL);
+}
+
+// MARK - performance counters
+- (NSDictionary<NSString *, NSNumber *> *) performanceCounters {
+    PerformanceSnapshot snapshot;
+    _kernel.readPerformanceCounters(&snapshot);
+    return @{
+        @"buffers": @(snapshot.buffers),
+        @"frames": @(snapshot.frames),
+        @"overloads": @(snapshot.overloads),
+        @"denormals": @(snapshot.denormals),
+        @"lastNanoseconds": @(snapshot.lastNanoseconds),
+        @"lastLoad": @(snapshot.lastLoad),
+        @"p99Load": @(snapshot.p99Load),
+        @"maxLoad": @(snapshot.maxLoad),
+        @"dspSeconds": @(snapshot.dspSeconds),
+        @"resamplerSeconds": @(snapshot.resamplerSeconds),
+        @"activeVoices": @(snapshot.activeVoices),
+        @"maxActiveVoices": @(snapshot.maxActiveVoices),
+    };
+}
+
+- (void) resetPerformanceCounters {
+    _kernel.resetPerformanceCounters();
+}
+
 @end
@@ -42,6 +42,7 @@ enum ElementsParam: AUParameterAddress {
     case LfoTempoSync = 28
     case LfoResetPhase = 29
     case LfoKeyReset = 30
+    case Polyphony = 31
     case ModMatrixStart = 400
     case ModMatrixEnd = 440
 };
@@ -144,7 +145,8 @@ class ModalViewController: BaseAudioUnitViewController {
                         HStack([
                             intKnob(ElementsParam.Pitch.rawValue),
                             knob(ElementsParam.Detune.rawValue),
-                            menuPicker(ElementsParam.Mode.rawValue)
+                            menuPicker(ElementsParam.Mode.rawValue),
+                            menuPicker(ElementsParam.Polyphony.rawValue)
                             ]),
                         HStack([
                             knob(ElementsParam.ResonatorGeometry.rawValue, size: 70),
@@ -190,6 +192,13 @@ class ModalViewController: BaseAudioUnitViewController {
             processor?.setAutomation(midiCC.value > 0.9)
         }
         
+        // Applied at once when the audio unit is not running, otherwise the next time it starts.
+        let oversamplingFactors = [2, 4, 8]
+        let oversampling = Picker(name: "Easter Egg Oversampling", value: Float(oversamplingFactors.firstIndex(of: audioUnit.ominousOversampling) ?? 2), valueStrings: ["2x", "4x", "8x"], horizontal: true)
+        oversampling.addControlEvent(.valueChanged) { [weak audioUnit] in
+            audioUnit?.ominousOversampling = oversamplingFactors[Int(oversampling.value)]
+        }
+        
         let loadDefault = SettingsButton()
         loadDefault.button.setTitle("Load Defaults", for: .normal)
         loadDefault.button.addControlEvent(.touchUpInside) { [weak self, weak audioUnit] in
@@ -216,6 +225,8 @@ class ModalViewController: BaseAudioUnitViewController {
             Header("MIDI"),
             midiChannel,
             midiCC,
+            Header("Easter Egg"),
+            oversampling,
             HStack([loadDefault, saveDefault]),
             ]), requiresScroll: true)
     }
@@ -17,4 +17,10 @@
 - (void) saveDefaults;
 - (void) loadFromDefaults;
 
+// Render statistics of the kernel since the last reset, keyed by the fields of
+// PerformanceSnapshot. Never blocks the render thread; must only be polled from one thread, such
+// as the display link of the view controller.
+- (NSDictionary<NSString *, NSNumber *> *) performanceCounters;
+- (void) resetPerformanceCounters;
+
 @end
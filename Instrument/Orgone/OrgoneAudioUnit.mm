@@ -479,6 +479,7 @@
         return NO;
     }
     
+    _kernel.setResamplerQuality(self.renderingOffline ? stmlib::RESAMPLER_QUALITY_OFFLINE : stmlib::RESAMPLER_QUALITY_REALTIME);
     _kernel.init(_audioBuffers.outputBus.format.channelCount, _audioBuffers.outputBus.format.sampleRate);
     _kernel.reset();
     
@@ -628,5 +629,29 @@ static AUAudioUnitPreset* NewAUPreset(NSInteger number, NSString *name)
     return _kernel.lfoDrawingDirty();
 }
 
+// MARK - performance counters
+- (NSDictionary<NSString *, NSNumber *> *) performanceCounters {
+    PerformanceSnapshot snapshot;
+    _kernel.readPerformanceCounters(&snapshot);
+    return @{
+        @"buffers": @(snapshot.buffers),
+        @"frames": @(snapshot.frames),
+        @"overloads": @(snapshot.overloads),
+        @"denormals": @(snapshot.denormals),
+        @"lastNanoseconds": @(snapshot.lastNanoseconds),
+        @"lastLoad": @(snapshot.lastLoad),
+        @"p99Load": @(snapshot.p99Load),
+        @"maxLoad": @(snapshot.maxLoad),
+        @"dspSeconds": @(snapshot.dspSeconds),
+        @"resamplerSeconds": @(snapshot.resamplerSeconds),
+        @"activeVoices": @(snapshot.activeVoices),
+        @"maxActiveVoices": @(snapshot.maxActiveVoices),
+    };
+}
+
+- (void) resetPerformanceCounters {
+    _kernel.resetPerformanceCounters();
+}
+
 @end
 
@@ -15,12 +15,14 @@
 #import "peaks/multistage_envelope.h"
 #import "stmlib/dsp/parameter_interpolator.h"
 #import "stmlib/dsp/dsp.h"
-#import "converter.hpp"
+#import "stmlib/dsp/polyphase_resampler.h"
 #import "DSPKernel.hpp"
 
 #import "MIDIProcessor.hpp"
 #import "ModulationEngine.hpp"
 #import "LFOKernel.hpp"
+#import "ModulationProgram.hpp"
+#import "PerformanceCounters.hpp"
 
 #ifdef DEBUG
 #define KERNEL_DEBUG_LOG(...) printf(__VA_ARGS__);
@@ -121,6 +123,8 @@ enum {
 class OrgoneDSPKernel : public DSPKernel {
 public:
     // MARK: Types
+    typedef ModulationProgram<kMaxPolyphony, NumModulationInputs, NumModulationOutputs, kNumModulationRules> OrgoneModulationProgram;
+    
     class VoiceState: public MIDIVoice {
     public:
         unsigned int state = 0;
@@ -140,7 +144,8 @@ public:
         float rightGain, leftGain, rightGainTarget, leftGainTarget;
         
         Orgone orgone;
-        ModulationEngine modEngine;
+        // Lanes of this voice in the modulation program of the kernel.
+        OrgoneModulationProgram::VoiceLanes modEngine;
         
         double portamento = 0.0;
         float bendAmount;
@@ -153,12 +158,11 @@ public:
         
         bool delayed_trigger = false;
         
-        VoiceState() : modEngine(NumModulationInputs, NumModulationOutputs),
-        lfo(OrgoneParamLfoRate, OrgoneParamLfoShape, OrgoneParamLfoShapeMod, OrgoneParamLfoTempoSync, OrgoneParamLfoResetPhase, OrgoneParamLfoKeyReset) {
+        VoiceState() : lfo(OrgoneParamLfoRate, OrgoneParamLfoShape, OrgoneParamLfoShapeMod, OrgoneParamLfoTempoSync, OrgoneParamLfoResetPhase, OrgoneParamLfoKeyReset) {
             
         }
         
-        void Init(ModulationEngineRuleList *rules) {
+        void Init(OrgoneModulationProgram::VoiceLanes lanes) {
             KERNEL_DEBUG_LOG("kernel voice Init")
             
             orgone.patch.freq = 512;
@@ -188,7 +192,7 @@ public:
             envelope.Init();
             ampEnvelope.Init();
             lfo.Init(48000);
-            modEngine.rules = rules;
+            modEngine = lanes;
             modEngine.in[ModInDirect] = 1.0f;
         }
         
@@ -293,12 +297,19 @@ public:
             portamento = pow(portamento, 0.05f);
         }
         
-        void runModulations(int blockSize) {
+        // The modulations of a block are computed in two steps, between which the kernel runs its
+        // modulation program for all the playing voices: beginModulations() sets the inputs of
+        // the voice, then applyModulations() reads its outputs.
+        void beginModulations(int blockSize) {
+            if (state == NoteStateReleasing && ampEnvelope.done) {
+                state = NoteStateUnused;
+            }
+            
             envelope.Process(blockSize);
             ampEnvelope.Process(blockSize);
             
             float lfoAmount = 1.0;
-            if (kernel->modulationEngineRules.isPatched(ModOutLFOAmount)) {
+            if (kernel->modulationProgram.isPatched(ModOutLFOAmount)) {
                 lfoAmount = modEngine.out[ModOutLFOAmount];
             }
             
@@ -308,7 +319,7 @@ public:
             modEngine.in[ModInEnvelope] = envelope.value;
             modEngine.in[ModInOut] = out;
             
-            if (kernel->modulationEngineRules.isPatched(ModOutPortamento)) {
+            if (kernel->modulationProgram.isPatched(ModOutPortamento)) {
                 updatePortamento(modEngine.out[ModOutPortamento]);
                 portamentoPatched = true;
             } else if (portamentoPatched) {
@@ -318,10 +329,10 @@ public:
             
             ONE_POLE(orgone.patch.note, noteTarget, 1.0f - portamento);
             ONE_POLE(modEngine.in[ModInAftertouch], aftertouchTarget, 0.1f);
-            
-            modEngine.run();
-            
-            if (kernel->modulationEngineRules.isPatched(ModOutLFORate)) {
+        }
+        
+        void applyModulations() {
+            if (kernel->modulationProgram.isPatched(ModOutLFORate)) {
                 lfo.updateRate(modEngine.out[ModOutLFORate]);
                 lfoRatePatched = true;
             } else if (lfoRatePatched) {
@@ -365,24 +376,18 @@ public:
             }
         }
         
+        // The modulations of each block of kAudioBlockSize frames must have been computed before.
         void run(int n, float* outL, float* outR)
         {
             int framesRemaining = n;
             
             while (framesRemaining) {
                 if (orgoneFramesIndex >= kAudioBlockSize) {
-                    
-                    if (state == NoteStateReleasing && ampEnvelope.done) {
-                        state = NoteStateUnused;
-                    }
-                    
-                    runModulations(kAudioBlockSize);
-                    
                     orgone.gateISR();
                     orgone.loop();
+                    orgone.render(frames, kAudioBlockSize);
                     for (int i = 0; i < kAudioBlockSize; i++) {
-                        orgone.interrupt();
-                        frames[i] = orgone.written;
+                        frames[i] = (frames[i] - 32000) / 32000.0;
                     }
                     
                     //voice->Render(kernel->patch, modulations, &frames[0], kAudioBlockSize);
@@ -399,7 +404,7 @@ public:
                     }
                 }
                 
-                out = ((float) frames[orgoneFramesIndex] - 32000)/ 32000.0;
+                out = frames[orgoneFramesIndex];
                 
                 ONE_POLE(leftGain, leftGainTarget, 0.01);
                 ONE_POLE(rightGain, rightGainTarget, 0.01);
@@ -420,9 +425,10 @@ public:
         KERNEL_DEBUG_LOG("Kernel constructor")
         
         voices.resize(kMaxPolyphony);
+        int i = 0;
         for (VoiceState& voice : voices) {
             voice.kernel = this;
-            voice.Init(&modulationEngineRules);
+            voice.Init(modulationProgram.lanes(i++));
             midiProcessor.noteStack.addVoice(&voice);
         }
         envParameters[2] = UINT16_MAX;
@@ -431,10 +437,22 @@ public:
     
     void init(int channelCount, double inSampleRate) {
         KERNEL_DEBUG_LOG("Kernel init")
-        if (outputSrc) {
-            delete outputSrc;
-        }
-        outputSrc = new Converter(48000, (int) inSampleRate);
+        outputSrc.Init(48000, (int) inSampleRate, resamplerQuality);
+        performanceCounters.init(inSampleRate);
+    }
+    
+    // Not on the render thread, and from one thread at a time.
+    void readPerformanceCounters(PerformanceSnapshot *snapshot) {
+        performanceCounters.read(snapshot);
+    }
+    
+    void resetPerformanceCounters() {
+        performanceCounters.reset();
+    }
+    
+    // Takes effect at the next init().
+    void setResamplerQuality(stmlib::ResamplerQuality quality) {
+        resamplerQuality = quality;
     }
     
     void setupModulationRules() {
@@ -444,6 +462,7 @@ public:
         modulationEngineRules.rules[1].input1 = ModInLFO;
         modulationEngineRules.rules[2].input1 = ModInEnvelope;
         modulationEngineRules.rules[3].input1 = ModInEnvelope;
+        modulationProgram.invalidate();
     }
     
     void reset() {
@@ -455,6 +474,7 @@ public:
     void setParameter(AUParameterAddress address, AUValue value) {
         if (address >= OrgoneParamModMatrixStart && address <= OrgoneParamModMatrixEnd) {
             modulationEngineRules.setParameter(address - OrgoneParamModMatrixStart, value);
+            modulationProgram.invalidate();
             
             return;
         }
@@ -785,6 +805,8 @@ public:
     }
     
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        performanceCounters.beginProcess(frameCount, bufferOffset);
+        
         float* outL = (float*)outBufferListPtr->mBuffers[0].mData + bufferOffset;
         float* outR = (float*)outBufferListPtr->mBuffers[1].mData + bufferOffset;
         
@@ -796,13 +818,23 @@ public:
                 memset(renderedL, 0, sizeof(float) * kAudioBlockSize);
                 memset(renderedR, 0, sizeof(float) * kAudioBlockSize);
                 
+                int numPlaying = 0;
                 for (int i = 0; i < midiProcessor.noteStack.getActivePolyphony(); i++) {
                     if (voices[i].state != NoteStateUnused) {
-                        playingNotes++;
-                        
-                        voices[i].run(kAudioBlockSize, renderedL, renderedR);
+                        renderQueue[numPlaying++] = i;
                     }
                 }
+                playingNotes += numPlaying;
+                
+                modulationProgram.update(modulationEngineRules);
+                for (int j = 0; j < numPlaying; j++) {
+                    voices[renderQueue[j]].beginModulations(kAudioBlockSize);
+                }
+                modulationProgram.run(renderQueue, numPlaying);
+                for (int j = 0; j < numPlaying; j++) {
+                    voices[renderQueue[j]].applyModulations();
+                    voices[renderQueue[j]].run(kAudioBlockSize, renderedL, renderedR);
+                }
                 
                 if (playingNotes > 0) {
                     for (int i = 0; i < kAudioBlockSize; i++) {
@@ -811,19 +843,26 @@ public:
                     }
                 }
                 
+                performanceCounters.countDenormals(renderedL, kAudioBlockSize);
+                performanceCounters.countDenormals(renderedR, kAudioBlockSize);
+                performanceCounters.setActiveVoices(numPlaying);
                 renderedFramesPos = 0;
             }
             
-            ConverterResult result;
+            stmlib::ResamplerResult result;
             
-            outputSrc->convert(renderedL + renderedFramesPos, renderedR + renderedFramesPos, kAudioBlockSize - renderedFramesPos, outL, outR, frameCount, &result);
+            performanceCounters.beginResampler();
+            outputSrc.Process(renderedL + renderedFramesPos, renderedR + renderedFramesPos, kAudioBlockSize - renderedFramesPos, outL, outR, frameCount, &result);
+            performanceCounters.endResampler();
             
-            outL += result.outputLength;
-            outR += result.outputLength;
+            outL += result.output_length;
+            outR += result.output_length;
             
-            renderedFramesPos += result.inputConsumed;
-            frameCount -= result.outputLength;
+            renderedFramesPos += (int) result.input_consumed;
+            frameCount -= (int) result.output_length;
         }
+        
+        performanceCounters.endProcess();
     }
     
     float randomSignedFloat(float max) {
@@ -859,23 +898,28 @@ public:
     
 private:
     std::vector<VoiceState> voices;
+    int renderQueue[kMaxPolyphony];
     
     AudioBufferList* outBufferListPtr = nullptr;
     
+    PerformanceCounters performanceCounters;
+    
 public:
     MIDIProcessor midiProcessor;
     orgone_patch_t patch;
     
     ModulationEngineRuleList modulationEngineRules;
+    OrgoneModulationProgram modulationProgram;
     KernelTransportState transportState;
     
-    Converter *outputSrc = 0;
+    stmlib::ResamplerQuality resamplerQuality = stmlib::RESAMPLER_QUALITY_REALTIME;
+    stmlib::PolyphaseResampler outputSrc;
     float renderedL[kAudioBlockSize] = {};
     float renderedR[kAudioBlockSize] = {};
     int renderedFramesPos = 0;
     
-    uint16_t envParameters[4];
-    uint16_t ampEnvParameters[4];
+    uint16_t envParameters[4] = {};
+    uint16_t ampEnvParameters[4] = {};
     
     bool lastPanSpreadWasNegative = 0;
     
@@ -1004,6 +1004,50 @@ public:
     // ---------------------------
     }
 
+    // Renders size samples at once. The oscillator mode only changes in
+    // loop(), so it is dispatched once per block. Each renderISR_*() copies
+    // the oscillators and the controls its ISR uses into locals, runs the
+    // whole block on them, and stores the oscillators back, so the compiler
+    // keeps them in registers instead of reloading the members after every
+    // table write. The sub oscillator, declick ramp and noise oscillators
+    // stay members, updated sample by sample. out receives the DAC values,
+    // centered on 32000.
+    void render(float *out, size_t size) {
+      switch(isr) {
+        case MAIN:
+          renderISR_MAIN(out, size);
+          break;
+        case WAVE_TWIN:
+          renderISR_WAVE_TWIN(out, size);
+          break;
+        case DISTS:
+          renderISR_DISTS(out, size);
+          break;
+        case SPECTRUM:
+          renderISR_SPECTRUM(out, size);
+          break;
+        case WAVE_DELAY:
+          renderISR_WAVE_DELAY(out, size);
+          break;
+        case DRUM:
+          renderISR_DRUM(out, size);
+          break;
+        case PULSAR_CHORD:
+          renderISR_PULSAR_CHORD(out, size);
+          break;
+        case PULSAR_TWIN:
+          renderISR_PULSAR_TWIN(out, size);
+          break;
+        case PULSAR_DISTS:
+          renderISR_PULSAR_DISTS(out, size);
+          break;
+
+        case PULSAR_DELAY:
+          renderISR_PULSAR_DELAY(out, size);
+          break;
+      }
+    }
+
     void interrupt() {
       switch(isr) {
         case MAIN:
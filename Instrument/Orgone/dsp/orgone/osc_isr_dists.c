@@ -1,388 +1,480 @@
 
 
-void FASTRUN outUpdateISR_DISTS(void) {
-  //noInterrupts();
+void FASTRUN renderISR_DISTS(float *out, size_t size) {
+  oscillator1 o1 = this->o1;
+  oscillator2 o2 = this->o2;
+  oscillator3 o3 = this->o3;
+  oscillator4 o4 = this->o4;
+  oscillator6 o6 = this->o6;
+  oscillator7 o7 = this->o7;
+
+  const int16_t NT3Rate = this->NT3Rate;
+  const int32_t nextstep = this->nextstep;
+  const int Temporal_Shift_CZ = this->Temporal_Shift_CZ;
+  const uint8_t WTShiftFM = this->WTShiftFM;
+  const int16_t *const FMTable = this->FMTable;
+  const int16_t *const GWTlo1 = this->GWTlo1;
+  const int16_t *const GWTlo2 = this->GWTlo2;
+  const int16_t *const GWTmid1 = this->GWTmid1;
+  const int16_t *const GWTmid2 = this->GWTmid2;
+  const int16_t *const GWThi1 = this->GWThi1;
+  const int16_t *const GWThi2 = this->GWThi2;
+  const int32_t GremLo = this->GremLo;
+  const int32_t GremMid = this->GremMid;
+  const int32_t GremHi = this->GremHi;
+  const uint16_t mixHi = this->mixHi;
+  const uint16_t mixLo = this->mixLo;
+  const uint16_t mixMid = this->mixMid;
+  const uint32_t mixEffectDn = this->mixEffectDn;
+  const int32_t CZMix = this->CZMix;
+  const uint16_t FMIndex = this->FMIndex;
+  const uint8_t oscMode = this->oscMode;
+  const uint8_t CRUSHBITS = this->CRUSHBITS;
+  const int32_t CRUSH_Remain = this->CRUSH_Remain;
 
-  //digitalWriteFast (oSQout,0);//temp testing OC
+  for (size_t i = 0; i < size; i++) {
+    //noInterrupts();
 
+    //digitalWriteFast (oSQout,0);//temp testing OC
 
-  SUBMULOC();
-  DECLICK_CHECK();
-  NOISELIVE0();
-  NOISELIVE1();
 
+    SUBMULOC();
+    DECLICK_CHECK();
+    NOISELIVE0();
+    NOISELIVE1();
 
-  switch (oscMode) {
-    //-----------------------------------------------FM MODE OSCILLATORS-----------------------------------------------
-    case 0:
 
-      noiseTable3[0] = noiseTable3[1] = (noiseTable3[0] + NT3Rate);
-      noiseTable[o1.phase >> 23] = randomVal(-32767, 32767); //replace noise cells with random values.
+    switch (oscMode) {
+      //-----------------------------------------------FM MODE OSCILLATORS-----------------------------------------------
+      case 0:
 
-      //main oscillator
-      o1.phase = o1.phase + o1.phase_increment;
-     // o1.phaseRemain = (o1.phase << 9) >> 17;
-      o1.wave = (FMTable[o1.phase >> WTShiftFM]);
-      o1.nextwave =  (FMTable[(o1.phase + nextstep) >> WTShiftFM]);
-      o1.wave = Interp512(o1.wave,o1.nextwave,o1.phase);
-      o1.index = (FMIndex * o1.wave);
-      o2.phase = o2.phase +  (o2.phase_increment + o1.index + o3.index);
-      o2.phaseRemain = (o2.phase << 9) >> 17;
+        noiseTable3[0] = noiseTable3[1] = (noiseTable3[0] + NT3Rate);
+        noiseTable[o1.phase >> 23] = randomVal(-32767, 32767); //replace noise cells with random values.
 
-      o3.phase = o3.phase + o2.phase_increment;
-      o3.phaseRemain = (o3.phase << 9) >> 17;
-      o3.wave = (FMTable[o3.phase >> WTShiftFM]);
-      o3.nextwave =  (FMTable[(o3.phase + nextstep) >> WTShiftFM]);
-      o3.wave = o3.wave + ((((o3.nextwave - o3.wave)) * o3.phaseRemain) >> 15);
-      o3.index = ((o3.wave * o1.amp) >> 14) * FXMixer[2];
+        //main oscillator
+        o1.phase = o1.phase + o1.phase_increment;
+       // o1.phaseRemain = (o1.phase << 9) >> 17;
+        o1.wave = (FMTable[o1.phase >> WTShiftFM]);
+        o1.nextwave =  (FMTable[(o1.phase + nextstep) >> WTShiftFM]);
+        o1.wave = Interp512(o1.wave,o1.nextwave,o1.phase);
+        o1.index = (FMIndex * o1.wave);
+        o2.phase = o2.phase +  (o2.phase_increment + o1.index + o3.index);
+        o2.phaseRemain = (o2.phase << 9) >> 17;
 
-      //-----------------------------------------------------------------------
+        o3.phase = o3.phase + o2.phase_increment;
+        o3.phaseRemain = (o3.phase << 9) >> 17;
+        o3.wave = (FMTable[o3.phase >> WTShiftFM]);
+        o3.nextwave =  (FMTable[(o3.phase + nextstep) >> WTShiftFM]);
+        o3.wave = o3.wave + ((((o3.nextwave - o3.wave)) * o3.phaseRemain) >> 15);
+        o3.index = ((o3.wave * o1.amp) >> 14) * FXMixer[2];
 
-      o2.wave = (
-                  (((int32_t)(((GWThi1[o2.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o2.phase >> 23] * (GremHi)) >> 9))) * mixHi) +
-                  (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
-                  (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * mixMid)) >> 11;
+        //-----------------------------------------------------------------------
 
-      o2.nextwave = (
-                      (((int32_t)(((GWThi1[(o2.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o2.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi) +
-                      (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
-                      (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)) >> 11;
+        o2.wave = (
+                    (((int32_t)(((GWThi1[o2.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o2.phase >> 23] * (GremHi)) >> 9))) * mixHi) +
+                    (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
+                    (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * mixMid)) >> 11;
 
-      o2.wave = Interp512(o2.wave,o2.nextwave,o2.phase)>>1;
+        o2.nextwave = (
+                        (((int32_t)(((GWThi1[(o2.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o2.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi) +
+                        (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
+                        (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)) >> 11;
 
-      break;
+        o2.wave = Interp512(o2.wave,o2.nextwave,o2.phase)>>1;
 
-    //-----------------------------------------------ALT FM MODE OSCILLATORS-----------------------------------------------
-    case 2:
+        break;
 
+      //-----------------------------------------------ALT FM MODE OSCILLATORS-----------------------------------------------
+      case 2:
 
-      noiseTable3[0] = noiseTable3[1] = (noiseTable3[0] + NT3Rate);
 
+        noiseTable3[0] = noiseTable3[1] = (noiseTable3[0] + NT3Rate);
 
-      //main oscillator
-      o1.phase = o1.phase + o1.phase_increment;
-      if (o1.phaseOld > o1.phase) {
-        noiseLive1[0] = randomVal(-32767, 32767);
-      }
-      o1.phaseOld = o1.phase;    
-      o1.wave = (FMTable[o1.phase >> WTShiftFM]);
-      o1.nextwave =  (FMTable[(o1.phase + nextstep) >> WTShiftFM]);
-      o1.wave = Interp512(o1.wave,o1.nextwave,o1.phase);
-      o1.index = (FMIndex * o1.wave);
-      o2.phase = o2.phase +  (o2.phase_increment + o1.index + o3.index);
-      o2.phaseRemain = (o2.phase << 9) >> 17;
 
-      o3.phase = o3.phase + o2.phase_increment;      
-      o3.wave = (FMTable[o3.phase >> WTShiftFM]);
-      o3.nextwave =  (FMTable[(o3.phase + nextstep) >> WTShiftFM]);
-      o3.wave = Interp512(o3.wave,o3.nextwave,o3.phase);
-      o3.index = ((o3.wave * o1.amp) >> 16) * FXMixer[2];
+        //main oscillator
+        o1.phase = o1.phase + o1.phase_increment;
+        if (o1.phaseOld > o1.phase) {
+          noiseLive1[0] = randomVal(-32767, 32767);
+        }
+        o1.phaseOld = o1.phase;    
+        o1.wave = (FMTable[o1.phase >> WTShiftFM]);
+        o1.nextwave =  (FMTable[(o1.phase + nextstep) >> WTShiftFM]);
+        o1.wave = Interp512(o1.wave,o1.nextwave,o1.phase);
+        o1.index = (FMIndex * o1.wave);
+        o2.phase = o2.phase +  (o2.phase_increment + o1.index + o3.index);
+        o2.phaseRemain = (o2.phase << 9) >> 17;
 
+        o3.phase = o3.phase + o2.phase_increment;      
+        o3.wave = (FMTable[o3.phase >> WTShiftFM]);
+        o3.nextwave =  (FMTable[(o3.phase + nextstep) >> WTShiftFM]);
+        o3.wave = Interp512(o3.wave,o3.nextwave,o3.phase);
+        o3.index = ((o3.wave * o1.amp) >> 16) * FXMixer[2];
 
-      //-----------------------------------------------------------------------
 
-      o2.wave = (
+        //-----------------------------------------------------------------------
 
-                  (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
-                  (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 11;
+        o2.wave = (
 
-      o2.nextwave = (
+                    (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
+                    (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 11;
 
-                      (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
-                      (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 11;
+        o2.nextwave = (
 
-      o2.wave = Interp512(o2.wave,o2.nextwave,o2.phase)>>1;
+                        (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
+                        (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 11;
 
+        o2.wave = Interp512(o2.wave,o2.nextwave,o2.phase)>>1;
 
-      break;
 
+        break;
 
-    case 1://-------------------------------------------CZ MODE OSCILLATORS-----------------------------------------------
 
+      case 1://-------------------------------------------CZ MODE OSCILLATORS-----------------------------------------------
 
 
-      o1.phase = o1.phase + o1.phase_increment + o3.index;
-      o2.phase = o2.phase +  o2.phase_increment;
-      if (o1.phaseOld > o1.phase)o2.phase = (uint32_t)((o2.phase_increment * o1.phase) >> Temporal_Shift_CZ);;
-      o1.phaseOld = o1.phase;
-      o2.phaseRemain = (o2.phase << 9) >> 17; 
-      o1.phaseRemain = (o1.phase << 9) >> 17;
 
-      //dummy wave for self mod effect
-      o3.phase = o3.phase + o1.phase_increment;
-      o3.phaseRemain = (o3.phase << 9) >> 17;
-      o3.wave = (FMTable[o3.phase >> 23]);
-      o3.nextwave =  (FMTable[(o3.phase + nextstep) >> 23]);
-      o3.wave = o3.wave + ((((o3.nextwave - o3.wave)) * o3.phaseRemain) >> 15);
-      o3.index = ((o3.wave * o1.amp) >> 16) * FXMixer[2];
+        o1.phase = o1.phase + o1.phase_increment + o3.index;
+        o2.phase = o2.phase +  o2.phase_increment;
+        if (o1.phaseOld > o1.phase)o2.phase = (uint32_t)((o2.phase_increment * o1.phase) >> Temporal_Shift_CZ);;
+        o1.phaseOld = o1.phase;
+        o2.phaseRemain = (o2.phase << 9) >> 17; 
+        o1.phaseRemain = (o1.phase << 9) >> 17;
 
+        //dummy wave for self mod effect
+        o3.phase = o3.phase + o1.phase_increment;
+        o3.phaseRemain = (o3.phase << 9) >> 17;
+        o3.wave = (FMTable[o3.phase >> 23]);
+        o3.nextwave =  (FMTable[(o3.phase + nextstep) >> 23]);
+        o3.wave = o3.wave + ((((o3.nextwave - o3.wave)) * o3.phaseRemain) >> 15);
+        o3.index = ((o3.wave * o1.amp) >> 16) * FXMixer[2];
 
-      //-----------------------------------------------------------------------
 
-      o2.wave = (FMTable[o2.phase >> 23]);
-      o2.nextwave =  (FMTable[(o2.phase + nextstep) >> 23]);
+        //-----------------------------------------------------------------------
 
+        o2.wave = (FMTable[o2.phase >> 23]);
+        o2.nextwave =  (FMTable[(o2.phase + nextstep) >> 23]);
 
-      o1.wave = ((
-                   (((int32_t)(((GWThi1[o1.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o1.phase >> 23] * (GremHi)) >> 9))) * mixHi)   +
-                   (((int32_t)(((GWTlo1[o1.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o1.phase >> 23] * (GremLo)) >> 9))) * mixLo)   +
-                   (((int32_t)(((GWTmid1[o1.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o1.phase >> 23] * (GremMid)) >> 9))) * mixMid)
-                 ) >> 4) >> 11;
 
-      o1.nextwave = ((
-                       (((int32_t)(((GWThi1[(o1.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o1.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi)   +
-                       (((int32_t)(((GWTlo1[(o1.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o1.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo)   +
-                       (((int32_t)(((GWTmid1[(o1.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o1.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)
-                     ) >> 4) >> 11;
+        o1.wave = ((
+                     (((int32_t)(((GWThi1[o1.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o1.phase >> 23] * (GremHi)) >> 9))) * mixHi)   +
+                     (((int32_t)(((GWTlo1[o1.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o1.phase >> 23] * (GremLo)) >> 9))) * mixLo)   +
+                     (((int32_t)(((GWTmid1[o1.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o1.phase >> 23] * (GremMid)) >> 9))) * mixMid)
+                   ) >> 4) >> 11;
 
-      o2.wave = Interp512(o2.wave,o2.nextwave,o2.phase);
-      o1.wave = Interp512(o1.wave,o1.nextwave,o1.phase);
+        o1.nextwave = ((
+                         (((int32_t)(((GWThi1[(o1.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o1.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi)   +
+                         (((int32_t)(((GWTlo1[(o1.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o1.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo)   +
+                         (((int32_t)(((GWTmid1[(o1.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o1.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)
+                       ) >> 4) >> 11;
 
-      o2.wave = ((o1.wave * (2047 - CZMix)) >> 8)  +  ((int32_t)(((o1.wave) * ((o2.wave * CZMix) >> 11)) >> 12));  //cz mixer
+        o2.wave = Interp512(o2.wave,o2.nextwave,o2.phase);
+        o1.wave = Interp512(o1.wave,o1.nextwave,o1.phase);
 
+        o2.wave = ((o1.wave * (2047 - CZMix)) >> 8)  +  ((int32_t)(((o1.wave) * ((o2.wave * CZMix) >> 11)) >> 12));  //cz mixer
 
-      break;
 
+        break;
 
 
-    //----------------------------------------------ALT CZ mode-----------------------------------------
-    case 3:
 
-      o1.phase = o1.phase + (o1.phase_increment + o3.index);
-      o2.phase = (uint32_t)((((uint64_t)o1.phase) * ((uint64_t)o2.phase_increment))>>25); //different way, experimental
-      //if (o1.phaseOld > o1.phase)o2.phase = ((o1.phase * o2.phase_increment)>>Temporal_Shift_CZ); 
-      //o1.phaseOld = o1.phase;
-      
-      
+      //----------------------------------------------ALT CZ mode-----------------------------------------
+      case 3:
 
-      //dummy self mod wave
-      o3.phase = o3.phase + o1.phase_increment;
-      o3.phaseRemain = (o3.phase << 9) >> 17;
-      o3.wave = (FMTable[o3.phase >> 23]);
-      o3.nextwave =  (FMTable[(o3.phase + nextstep) >> 23]);
-      o3.wave = o3.wave + ((((o3.nextwave - o3.wave)) * o3.phaseRemain) >> 15);
-      o3.index = (int32_t)(((o3.wave * o1.amp) >> 15) * FXMixer[2]);
+        o1.phase = o1.phase + (o1.phase_increment + o3.index);
+        o2.phase = (uint32_t)((((uint64_t)o1.phase) * ((uint64_t)o2.phase_increment))>>25); //different way, experimental
+        //if (o1.phaseOld > o1.phase)o2.phase = ((o1.phase * o2.phase_increment)>>Temporal_Shift_CZ); 
+        //o1.phaseOld = o1.phase;
 
 
-      //-----------------------------------------------------------------------
 
-      o2.wave = (FMTable[o2.phase >> 23]);
-      o2.nextwave =  (FMTable[(o2.phase + nextstep) >> 23]);
+        //dummy self mod wave
+        o3.phase = o3.phase + o1.phase_increment;
+        o3.phaseRemain = (o3.phase << 9) >> 17;
+        o3.wave = (FMTable[o3.phase >> 23]);
+        o3.nextwave =  (FMTable[(o3.phase + nextstep) >> 23]);
+        o3.wave = o3.wave + ((((o3.nextwave - o3.wave)) * o3.phaseRemain) >> 15);
+        o3.index = (int32_t)(((o3.wave * o1.amp) >> 15) * FXMixer[2]);
 
 
-      o1.wave = ((
+        //-----------------------------------------------------------------------
 
-                   (((int32_t)(((GWTlo1[o1.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o1.phase >> 23] * (GremLo)) >> 9))) * mixLo)   +
-                   (((int32_t)(((GWTmid1[o1.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o1.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))
-                 ) >> 4) >> 11;
+        o2.wave = (FMTable[o2.phase >> 23]);
+        o2.nextwave =  (FMTable[(o2.phase + nextstep) >> 23]);
 
-      o1.nextwave = ((
 
-                       (((int32_t)(((GWTlo1[(o1.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o1.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo)   +
-                       (((int32_t)(((GWTmid1[(o1.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o1.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))
-                     ) >> 4) >> 11;
+        o1.wave = ((
 
+                     (((int32_t)(((GWTlo1[o1.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o1.phase >> 23] * (GremLo)) >> 9))) * mixLo)   +
+                     (((int32_t)(((GWTmid1[o1.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o1.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))
+                   ) >> 4) >> 11;
 
-      o2.wave = Interp512(o2.wave,o2.nextwave,o2.phase);
-      o1.wave = Interp512(o1.wave,o1.nextwave,o1.phase);
+        o1.nextwave = ((
 
+                         (((int32_t)(((GWTlo1[(o1.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o1.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo)   +
+                         (((int32_t)(((GWTmid1[(o1.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o1.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))
+                       ) >> 4) >> 11;
 
 
-      o2.wave = ((o1.wave * (2047 - CZMix)) >> 8)  +  ((int32_t)(((o1.wave) * ((o2.wave * CZMix) >> 11)) >> 12));
+        o2.wave = Interp512(o2.wave,o2.nextwave,o2.phase);
+        o1.wave = Interp512(o1.wave,o1.nextwave,o1.phase);
 
 
-      break;
 
-  }
+        o2.wave = ((o1.wave * (2047 - CZMix)) >> 8)  +  ((int32_t)(((o1.wave) * ((o2.wave * CZMix) >> 11)) >> 12));
 
-  o6.wave = ((o2.wave * (4095 - o1.amp)) >> 11) + (((o2.wave ^ (o3.wave)) * o1.amp) >> 13) ;
 
-  o7.wave = ((o2.wave * (4095 - o1.amp)) >> 11) + ((o1.amp * (FMTable[abs(o2.wave) >> 6])) >> 12); //lookup
+        break;
 
-  o1.wave = (((((o2.wave >> (CRUSHBITS)) << (CRUSHBITS))) * (CRUSH_Remain)) >> 10) + (((((o2.wave >> (CRUSHBITS - 1)) << (CRUSHBITS - 1))) * (1023 - CRUSH_Remain)) >> 10);
+    }
 
+    o6.wave = ((o2.wave * (4095 - o1.amp)) >> 11) + (((o2.wave ^ (o3.wave)) * o1.amp) >> 13) ;
 
-  o3.wave = (o2.wave + (((o2.wave) * o1.amp) >> 10)) >> 2 ; //start of folding
+    o7.wave = ((o2.wave * (4095 - o1.amp)) >> 11) + ((o1.amp * (FMTable[abs(o2.wave) >> 6])) >> 12); //lookup
 
-  o4.wave = (o3.wave << 19) >> 19;
+    o1.wave = (((((o2.wave >> (CRUSHBITS)) << (CRUSHBITS))) * (CRUSH_Remain)) >> 10) + (((((o2.wave >> (CRUSHBITS - 1)) << (CRUSHBITS - 1))) * (1023 - CRUSH_Remain)) >> 10);
 
 
-  if (o3.wave > 0) {
-    if ((((o3.wave) >> 12) & 0x01) == 0) o4.wave = -o4.wave;
-  }
-  else {
-    if ((((o3.wave) >> 12) & 0x01) == 1) o4.wave = -o4.wave;
-  }
+    o3.wave = (o2.wave + (((o2.wave) * o1.amp) >> 10)) >> 2 ; //start of folding
+
+    o4.wave = (o3.wave << 19) >> 19;
+
 
-  o1.wave =
-    (((o2.wave * ((int)mixEffectDn)) >> 10)) //undistorted
-    + (((-o4.wave) * ((int)FXMixer[0])) >> 8) //dists 1 fold
-    + (((o1.wave) * ((int)FXMixer[1])) >> 10)  //dists 1 crush
-    + (((o6.wave) * ((int)FXMixer[3])) >> 11) //dists2 XORrible
-    + (((o7.wave * ((int)FXMixer[2])) >> 11))  ; //dists 2 waveshaper
+    if (o3.wave > 0) {
+      if ((((o3.wave) >> 12) & 0x01) == 0) o4.wave = -o4.wave;
+    }
+    else {
+      if ((((o3.wave) >> 12) & 0x01) == 1) o4.wave = -o4.wave;
+    }
 
-  FinalOut = declickValue + ((o1.wave * declickRampIn) >> 12);
+    o1.wave =
+      (((o2.wave * ((int)mixEffectDn)) >> 10)) //undistorted
+      + (((-o4.wave) * ((int)FXMixer[0])) >> 8) //dists 1 fold
+      + (((o1.wave) * ((int)FXMixer[1])) >> 10)  //dists 1 crush
+      + (((o6.wave) * ((int)FXMixer[3])) >> 11) //dists2 XORrible
+      + (((o7.wave * ((int)FXMixer[2])) >> 11))  ; //dists 2 waveshaper
 
-  analogWrite(aout2, FinalOut + 32000);
+    FinalOut = declickValue + ((o1.wave * declickRampIn) >> 12);
 
-  noiseTable[o1.phase >> 23] = randomVal(-32767, 32767); //replace noise cells with random values.
+    analogWrite(aout2, FinalOut + 32000);
 
+    noiseTable[o1.phase >> 23] = randomVal(-32767, 32767); //replace noise cells with random values.
+
+    out[i] = written;
+  }
+
+  this->o1 = o1;
+  this->o2 = o2;
+  this->o3 = o3;
+  this->o4 = o4;
+  this->o6 = o6;
+  this->o7 = o7;
 }
 
-void FASTRUN outUpdateISR_PULSAR_DISTS(void) {
+void FASTRUN outUpdateISR_DISTS(void) {
+  float out;
+  renderISR_DISTS(&out, 1);
+}
 
-  delayCounter = delayCounter + 16;
-  delayCounterShift = delayCounter >> 4 ;
-  delayTimeShift = uint16_t(delayCounter - ((8192 - delayTime) << 3)) >> 4;
+void FASTRUN renderISR_PULSAR_DISTS(float *out, size_t size) {
+  oscillator1 o1 = this->o1;
+  oscillator2 o2 = this->o2;
+  oscillator3 o3 = this->o3;
+  oscillator4 o4 = this->o4;
+  oscillator6 o6 = this->o6;
+  oscillator7 o7 = this->o7;
+  uint16_t delayCounter = this->delayCounter;
+  uint16_t delayCounterShift = this->delayCounterShift;
+  uint16_t delayTimeShift = this->delayTimeShift;
 
+  const uint16_t delayTime = this->delayTime;
+  const int32_t nextstep = this->nextstep;
+  const int16_t *const FMTable = this->FMTable;
+  const int16_t *const GWTlo1 = this->GWTlo1;
+  const int16_t *const GWTlo2 = this->GWTlo2;
+  const int16_t *const GWTmid1 = this->GWTmid1;
+  const int16_t *const GWTmid2 = this->GWTmid2;
+  const int16_t *const GWThi1 = this->GWThi1;
+  const int16_t *const GWThi2 = this->GWThi2;
+  const int16_t *const PENV = this->PENV;
+  const int32_t GremLo = this->GremLo;
+  const int32_t GremMid = this->GremMid;
+  const int32_t GremHi = this->GremHi;
+  const uint16_t mixHi = this->mixHi;
+  const uint16_t mixLo = this->mixLo;
+  const uint16_t mixMid = this->mixMid;
+  const uint32_t mixEffectDn = this->mixEffectDn;
+  const uint8_t oscMode = this->oscMode;
+  const uint8_t CRUSHBITS = this->CRUSHBITS;
+  const int32_t CRUSH_Remain = this->CRUSH_Remain;
 
-  SUBMULOC();
-  DECLICK_CHECK();
-  NOISELIVE0();
-  NOISELIVE1();
+  for (size_t i = 0; i < size; i++) {
+    delayCounter = delayCounter + 16;
+    delayCounterShift = delayCounter >> 4 ;
+    delayTimeShift = uint16_t(delayCounter - ((8192 - delayTime) << 3)) >> 4;
 
 
+    SUBMULOC();
+    DECLICK_CHECK();
+    NOISELIVE0();
+    NOISELIVE1();
 
 
-  noiseTable[o1.phase >> 23] = randomVal(-32767, 32767); //replace noise cells with random values.
 
-  o1.phase = o1.phase + o1.phase_increment;
-  o2.phase = o2.phase +  o2.phase_increment;
 
-  if (o1.phaseOld > o1.phase) {
-    o3.phase = (uint32_t)((o3.phase_increment * o1.phase)>>Temporal_Shift_CZ);
-    o2.phase = (uint32_t)((o2.phase_increment * o1.phase)>>Temporal_Shift_CZ); 
-  }
-  o1.phaseOld = o1.phase;
+    noiseTable[o1.phase >> 23] = randomVal(-32767, 32767); //replace noise cells with random values.
 
-  
-  o2.phaseRemain = (o2.phase << 9) >> 17; 
+    o1.phase = o1.phase + o1.phase_increment;
+    o2.phase = o2.phase +  o2.phase_increment;
 
+    if (o1.phaseOld > o1.phase) {
+      o3.phase = (uint32_t)((o3.phase_increment * o1.phase)>>Temporal_Shift_CZ);
+      o2.phase = (uint32_t)((o2.phase_increment * o1.phase)>>Temporal_Shift_CZ); 
+    }
+    o1.phaseOld = o1.phase;
 
-  if (o3.phase >> 31 == 0) {
-    o3.phase = o3.phase + o3.phase_increment;
-    o3.wave = (PENV[o3.phase >> 23]);
-    o3.nextwave =  (PENV[(o3.phase + nextstep) >> 23]);
-  }
-  else {
-    o3.wave = 0;
-    o3.nextwave =  0;
-  }
 
-  o3.phaseRemain = (o3.phase << 9) >> 17;
+    o2.phaseRemain = (o2.phase << 9) >> 17; 
 
 
-  switch (oscMode) {
+    if (o3.phase >> 31 == 0) {
+      o3.phase = o3.phase + o3.phase_increment;
+      o3.wave = (PENV[o3.phase >> 23]);
+      o3.nextwave =  (PENV[(o3.phase + nextstep) >> 23]);
+    }
+    else {
+      o3.wave = 0;
+      o3.nextwave =  0;
+    }
 
-    //-----------------------------------------------FM MODE OSCILLATORS-----------------------------------------------
-    case 0:
+    o3.phaseRemain = (o3.phase << 9) >> 17;
 
 
-      o2.wave = (
-                  (((int32_t)(((GWThi1[o2.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o2.phase >> 23] * (GremHi)) >> 9))) * mixHi) +
-                  (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
-                  (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
+    switch (oscMode) {
 
-      o2.nextwave = (
-                      (((int32_t)(((GWThi1[(o2.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o2.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi) +
-                      (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
-                      (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
+      //-----------------------------------------------FM MODE OSCILLATORS-----------------------------------------------
+      case 0:
 
 
+        o2.wave = (
+                    (((int32_t)(((GWThi1[o2.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o2.phase >> 23] * (GremHi)) >> 9))) * mixHi) +
+                    (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
+                    (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
 
-      break;
+        o2.nextwave = (
+                        (((int32_t)(((GWThi1[(o2.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o2.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi) +
+                        (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
+                        (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
 
-    //-----------------------------------------------ALT FM MODE OSCILLATORS-----------------------------------------------
-    case 2:
 
-      o2.wave = (
 
-                  (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
-                  (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
+        break;
 
-      o2.nextwave = (
+      //-----------------------------------------------ALT FM MODE OSCILLATORS-----------------------------------------------
+      case 2:
 
-                      (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
-                      (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
+        o2.wave = (
 
+                    (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
+                    (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
 
-      break;
+        o2.nextwave = (
 
-    //-----------------------------------------------CZ MODE OSCILLATORS-----------------------------------------------
-    case 1:
+                        (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
+                        (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
 
 
+        break;
 
-      o2.wave = (
-                  (((int32_t)(((GWThi1[o2.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o2.phase >> 23] * (GremHi)) >> 9))) * mixHi) +
-                  (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
-                  (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
+      //-----------------------------------------------CZ MODE OSCILLATORS-----------------------------------------------
+      case 1:
 
-      o2.nextwave = (
-                      (((int32_t)(((GWThi1[(o2.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o2.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi) +
-                      (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
-                      (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
 
 
+        o2.wave = (
+                    (((int32_t)(((GWThi1[o2.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o2.phase >> 23] * (GremHi)) >> 9))) * mixHi) +
+                    (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
+                    (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
 
+        o2.nextwave = (
+                        (((int32_t)(((GWThi1[(o2.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o2.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi) +
+                        (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
+                        (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
 
-      break;
 
-    //-----------------------------------------------ALT CZ MODE OSCILLATORS-----------------------------------------------
-    case 3:
 
-      o2.wave = (
 
-                  (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
-                  (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
+        break;
 
-      o2.nextwave = (
+      //-----------------------------------------------ALT CZ MODE OSCILLATORS-----------------------------------------------
+      case 3:
 
-                      (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
-                      (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
+        o2.wave = (
 
+                    (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
+                    (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
 
-      break;
+        o2.nextwave = (
 
-  }
+                        (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
+                        (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
 
-  o2.wave = o2.wave + ((((o2.nextwave - o2.wave)) * o2.phaseRemain) >> 15);
-  o3.wave = o3.wave + ((((o3.nextwave - o3.wave)) * o3.phaseRemain) >> 15);
 
-  o2.wave =   (o2.wave * o3.wave) >> 12;  //15 bits
+        break;
 
-  o6.wave = ((o2.wave * (4095 - o1.amp)) >> 11) + (((o2.wave ^ (o3.wave)) * o1.amp) >> 13) ;
+    }
 
-  o7.wave = ((o2.wave * (4095 - o1.amp)) >> 11) + ((o1.amp * (FMTable[abs(o2.wave) >> 6])) >> 12); //lookup
+    o2.wave = o2.wave + ((((o2.nextwave - o2.wave)) * o2.phaseRemain) >> 15);
+    o3.wave = o3.wave + ((((o3.nextwave - o3.wave)) * o3.phaseRemain) >> 15);
 
-  o1.wave = (((((o2.wave >> (CRUSHBITS)) << (CRUSHBITS))) * (CRUSH_Remain)) >> 10) + (((((o2.wave >> (CRUSHBITS - 1)) << (CRUSHBITS - 1))) * (1023 - CRUSH_Remain)) >> 10);
+    o2.wave =   (o2.wave * o3.wave) >> 12;  //15 bits
 
+    o6.wave = ((o2.wave * (4095 - o1.amp)) >> 11) + (((o2.wave ^ (o3.wave)) * o1.amp) >> 13) ;
 
-  o3.wave = (o2.wave + (((o2.wave) * o1.amp) >> 10)) >> 2 ; //start of folding
+    o7.wave = ((o2.wave * (4095 - o1.amp)) >> 11) + ((o1.amp * (FMTable[abs(o2.wave) >> 6])) >> 12); //lookup
 
-  o4.wave = (o3.wave << 19) >> 19;
+    o1.wave = (((((o2.wave >> (CRUSHBITS)) << (CRUSHBITS))) * (CRUSH_Remain)) >> 10) + (((((o2.wave >> (CRUSHBITS - 1)) << (CRUSHBITS - 1))) * (1023 - CRUSH_Remain)) >> 10);
 
 
-  if (o3.wave > 0) {
-    if ((((o3.wave) >> 12) & 0x01) == 0) o4.wave = -o4.wave;
-  }
-  else {
-    if ((((o3.wave) >> 12) & 0x01) == 1) o4.wave = -o4.wave;
-  }
+    o3.wave = (o2.wave + (((o2.wave) * o1.amp) >> 10)) >> 2 ; //start of folding
 
-  o1.wave =
-    (((o2.wave * ((int)mixEffectDn)) >> 10)) //undistorted
-    + (((-o4.wave) * ((int)FXMixer[0])) >> 8) //dists 1 fold
-    + (((o1.wave) * ((int)FXMixer[1])) >> 10)  //dists 1 crush
-    + (((o6.wave) * ((int)FXMixer[3])) >> 11) //dists2 XORrible
-    + (((o7.wave * ((int)FXMixer[2])) >> 11))  ; //dists 2 waveshaper
+    o4.wave = (o3.wave << 19) >> 19;
 
-  FinalOut = declickValue + ((o1.wave * declickRampIn) >> 12);
 
-  analogWrite(aout2, FinalOut + 32000);
+    if (o3.wave > 0) {
+      if ((((o3.wave) >> 12) & 0x01) == 0) o4.wave = -o4.wave;
+    }
+    else {
+      if ((((o3.wave) >> 12) & 0x01) == 1) o4.wave = -o4.wave;
+    }
 
+    o1.wave =
+      (((o2.wave * ((int)mixEffectDn)) >> 10)) //undistorted
+      + (((-o4.wave) * ((int)FXMixer[0])) >> 8) //dists 1 fold
+      + (((o1.wave) * ((int)FXMixer[1])) >> 10)  //dists 1 crush
+      + (((o6.wave) * ((int)FXMixer[3])) >> 11) //dists2 XORrible
+      + (((o7.wave * ((int)FXMixer[2])) >> 11))  ; //dists 2 waveshaper
 
+    FinalOut = declickValue + ((o1.wave * declickRampIn) >> 12);
 
+    analogWrite(aout2, FinalOut + 32000);
+
+    out[i] = written;
+  }
+
+  this->o1 = o1;
+  this->o2 = o2;
+  this->o3 = o3;
+  this->o4 = o4;
+  this->o6 = o6;
+  this->o7 = o7;
+  this->delayCounter = delayCounter;
+  this->delayCounterShift = delayCounterShift;
+  this->delayTimeShift = delayTimeShift;
+}
+
+void FASTRUN outUpdateISR_PULSAR_DISTS(void) {
+  float out;
+  renderISR_PULSAR_DISTS(&out, 1);
 }
 
 
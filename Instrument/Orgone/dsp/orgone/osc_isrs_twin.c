@@ -1,467 +1,568 @@
 
 
-void FASTRUN outUpdateISR_PULSAR_TWIN(void) {
+void FASTRUN renderISR_PULSAR_TWIN(float *out, size_t size) {
+  oscillator1 o1 = this->o1;
+  oscillator2 o2 = this->o2;
+  oscillator3 o3 = this->o3;
+  oscillator4 o4 = this->o4;
+  oscillator5 o5 = this->o5;
+  oscillator6 o6 = this->o6;
+  oscillator8 o8 = this->o8;
+  oscillator9 o9 = this->o9;
+  oscillator10 o10 = this->o10;
+  uint16_t delayCounter = this->delayCounter;
+  uint16_t delayCounterShift = this->delayCounterShift;
+  uint16_t delayTimeShift = this->delayTimeShift;
 
-  delayCounter = delayCounter + 16;
-  delayCounterShift = delayCounter >> 4 ;
-  delayTimeShift = (uint16_t) (delayCounter - ((8192 - delayTime) << 3)) >> 4;
+  const uint16_t delayTime = this->delayTime;
+  const int32_t nextstep = this->nextstep;
+  const int Temporal_Shift_CZ = this->Temporal_Shift_CZ;
+  const int16_t *const GWTlo1 = this->GWTlo1;
+  const int16_t *const GWTlo2 = this->GWTlo2;
+  const int16_t *const GWTmid1 = this->GWTmid1;
+  const int16_t *const GWTmid2 = this->GWTmid2;
+  const int16_t *const GWThi1 = this->GWThi1;
+  const int16_t *const GWThi2 = this->GWThi2;
+  const int16_t *const PENV = this->PENV;
+  const int32_t GremLo = this->GremLo;
+  const int32_t GremMid = this->GremMid;
+  const int32_t GremHi = this->GremHi;
+  const uint16_t mixHi = this->mixHi;
+  const uint16_t mixLo = this->mixLo;
+  const uint16_t mixMid = this->mixMid;
+  const uint32_t mixEffect = this->mixEffect;
+  const uint8_t oscMode = this->oscMode;
+  const orgone_patch_t patch = this->patch;
 
+  for (size_t i = 0; i < size; i++) {
+    delayCounter = delayCounter + 16;
+    delayCounterShift = delayCounter >> 4 ;
+    delayTimeShift = (uint16_t) (delayCounter - ((8192 - delayTime) << 3)) >> 4;
 
-  SUBMULOC();
-  DECLICK_CHECK();
-  NOISELIVE0();
-  NOISELIVE1();
 
-  
+    SUBMULOC();
+    DECLICK_CHECK();
+    NOISELIVE0();
+    NOISELIVE1();
 
 
- o1.phase = o1.phase + o1.phase_increment;
-            
-      o4.phase = o1.phase + o1.phaseOffset;
-      
-      if (o1.phaseOld > o1.phase) {
-        o3.phase = (uint32_t)((o3.phase_increment * o1.phase) >> Temporal_Shift_CZ);
-        o2.phase = (uint32_t)((o2.phase_increment * o1.phase) >> Temporal_Shift_CZ);
-      }
-      if (o4.phase < (o1.phase_increment<<1)) {
-       o5.phase =  (uint32_t)((o2.phase_increment * o4.phase) >> Temporal_Shift_CZ);
-    o6.phase =  (uint32_t)((o6.phase_increment * o4.phase) >> Temporal_Shift_CZ);
-      }
-      o1.phaseOld = o1.phase;
-      o4.phaseOld = o4.phase;
-      
 
-      o2.phase = o2.phase +  o2.phase_increment + ((o10.wave<<10) * patch.fmMode);
-      o2.phaseRemain = (o2.phase << 9) >> 17; //used for fake interpolation
-     
 
-     if (o3.phase < 2147483647) {
-        o3.phase = o3.phase + o3.phase_increment ;
-        o3.wave = (PENV[o3.phase >> 23]);
-        o3.nextwave =  (PENV[(o3.phase + nextstep) >> 23]);
-      }
-      else {
-        o3.wave = 0;
-        o3.nextwave =  0;
-      }
-        
-    
-    
+   o1.phase = o1.phase + o1.phase_increment;
 
-      o3.phaseRemain = (o3.phase << 9) >> 17;
+        o4.phase = o1.phase + o1.phaseOffset;
 
+        if (o1.phaseOld > o1.phase) {
+          o3.phase = (uint32_t)((o3.phase_increment * o1.phase) >> Temporal_Shift_CZ);
+          o2.phase = (uint32_t)((o2.phase_increment * o1.phase) >> Temporal_Shift_CZ);
+        }
+        if (o4.phase < (o1.phase_increment<<1)) {
+         o5.phase =  (uint32_t)((o2.phase_increment * o4.phase) >> Temporal_Shift_CZ);
+      o6.phase =  (uint32_t)((o6.phase_increment * o4.phase) >> Temporal_Shift_CZ);
+        }
+        o1.phaseOld = o1.phase;
+        o4.phaseOld = o4.phase;
 
-      o5.phase = o5.phase +  o2.phase_increment + ((o10.wave<<10) * patch.fmMode);
-      o5.phaseRemain = (o5.phase << 9) >> 17; //used for fake interpolation
-      //o4.phaseRemain = (o4.phase << 9) >> 17;
 
-      if (o6.phase < 2147483647) {
-        o6.phase = o6.phase + o6.phase_increment ;
-        o6.wave = (PENV[o6.phase >> 23]);
-        o6.nextwave =  (PENV[(o6.phase + nextstep) >> 23]);
-      }
-      else {
-        o6.wave = 0;
-        o6.nextwave =  0;
-      }
-     
+        o2.phase = o2.phase +  o2.phase_increment + ((o10.wave<<10) * patch.fmMode);
+        o2.phaseRemain = (o2.phase << 9) >> 17; //used for fake interpolation
 
-      o6.phaseRemain = (o6.phase << 9) >> 17;
 
+       if (o3.phase < 2147483647) {
+          o3.phase = o3.phase + o3.phase_increment ;
+          o3.wave = (PENV[o3.phase >> 23]);
+          o3.nextwave =  (PENV[(o3.phase + nextstep) >> 23]);
+        }
+        else {
+          o3.wave = 0;
+          o3.nextwave =  0;
+        }
 
-  switch (oscMode) {
 
-    //-----------------------------------------------FM MODE OSCILLATORS-----------------------------------------------
-    case 0:
 
 
-      o2.wave = (
-                  (((int32_t)(((GWThi1[o2.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o2.phase >> 23] * (GremHi)) >> 9))) * mixHi) +
-                  (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
-                  (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
+        o3.phaseRemain = (o3.phase << 9) >> 17;
 
-      o2.nextwave = (
-                      (((int32_t)(((GWThi1[(o2.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o2.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi) +
-                      (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
-                      (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
 
-      o5.wave = (
-                  (((int32_t)(((GWThi1[o5.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o5.phase >> 23] * (GremHi)) >> 9))) * mixHi) +
-                  (((int32_t)(((GWTlo1[o5.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o5.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
-                  (((int32_t)(((GWTmid1[o5.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o5.phase >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
+        o5.phase = o5.phase +  o2.phase_increment + ((o10.wave<<10) * patch.fmMode);
+        o5.phaseRemain = (o5.phase << 9) >> 17; //used for fake interpolation
+        //o4.phaseRemain = (o4.phase << 9) >> 17;
 
-      o5.nextwave = (
-                      (((int32_t)(((GWThi1[(o5.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o5.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi) +
-                      (((int32_t)(((GWTlo1[(o5.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o5.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
-                      (((int32_t)(((GWTmid1[(o5.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o5.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
+        if (o6.phase < 2147483647) {
+          o6.phase = o6.phase + o6.phase_increment ;
+          o6.wave = (PENV[o6.phase >> 23]);
+          o6.nextwave =  (PENV[(o6.phase + nextstep) >> 23]);
+        }
+        else {
+          o6.wave = 0;
+          o6.nextwave =  0;
+        }
 
-      break;
 
-    //-----------------------------------------------ALT FM MODE OSCILLATORS-----------------------------------------------
-    case 2:
+        o6.phaseRemain = (o6.phase << 9) >> 17;
 
-      o2.wave = (
 
-                  (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
-                  (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
+    switch (oscMode) {
 
-      o2.nextwave = (
+      //-----------------------------------------------FM MODE OSCILLATORS-----------------------------------------------
+      case 0:
 
-                      (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
-                      (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
 
-      o5.wave = (
+        o2.wave = (
+                    (((int32_t)(((GWThi1[o2.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o2.phase >> 23] * (GremHi)) >> 9))) * mixHi) +
+                    (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
+                    (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
 
-                  (((int32_t)(((GWTlo1[o5.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o5.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
-                  (((int32_t)(((GWTmid1[o5.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o5.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
+        o2.nextwave = (
+                        (((int32_t)(((GWThi1[(o2.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o2.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi) +
+                        (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
+                        (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
 
-      o5.nextwave = (
+        o5.wave = (
+                    (((int32_t)(((GWThi1[o5.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o5.phase >> 23] * (GremHi)) >> 9))) * mixHi) +
+                    (((int32_t)(((GWTlo1[o5.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o5.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
+                    (((int32_t)(((GWTmid1[o5.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o5.phase >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
 
-                      (((int32_t)(((GWTlo1[(o5.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o5.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
-                      (((int32_t)(((GWTmid1[(o5.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o5.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
+        o5.nextwave = (
+                        (((int32_t)(((GWThi1[(o5.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o5.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi) +
+                        (((int32_t)(((GWTlo1[(o5.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o5.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
+                        (((int32_t)(((GWTmid1[(o5.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o5.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
 
-      break;
+        break;
 
-    //-----------------------------------------------CZ MODE OSCILLATORS-----------------------------------------------
-    case 1:
+      //-----------------------------------------------ALT FM MODE OSCILLATORS-----------------------------------------------
+      case 2:
 
+        o2.wave = (
 
+                    (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
+                    (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
 
-      o2.wave = (
-                  (((int32_t)(((GWThi1[o2.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o2.phase >> 23] * (GremHi)) >> 9))) * mixHi) +
-                  (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
-                  (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
+        o2.nextwave = (
 
-      o2.nextwave = (
-                      (((int32_t)(((GWThi1[(o2.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o2.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi) +
-                      (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
-                      (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
+                        (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
+                        (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
 
-      o5.wave = (
-                  (((int32_t)(((GWThi1[o5.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o5.phase >> 23] * (GremHi)) >> 9))) * mixHi) +
-                  (((int32_t)(((GWTlo1[o5.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o5.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
-                  (((int32_t)(((GWTmid1[o5.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o5.phase >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
+        o5.wave = (
 
-      o5.nextwave = (
-                      (((int32_t)(((GWThi1[(o5.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o5.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi) +
-                      (((int32_t)(((GWTlo1[(o5.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o5.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
-                      (((int32_t)(((GWTmid1[(o5.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o5.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
+                    (((int32_t)(((GWTlo1[o5.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o5.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
+                    (((int32_t)(((GWTmid1[o5.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o5.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
 
+        o5.nextwave = (
 
-      break;
+                        (((int32_t)(((GWTlo1[(o5.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o5.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
+                        (((int32_t)(((GWTmid1[(o5.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o5.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
 
-    //-----------------------------------------------ALT CZ MODE OSCILLATORS-----------------------------------------------
-    case 3:
+        break;
 
-      o2.wave = (
+      //-----------------------------------------------CZ MODE OSCILLATORS-----------------------------------------------
+      case 1:
 
-                  (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
-                  (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
 
-      o2.nextwave = (
 
-                      (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
-                      (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
+        o2.wave = (
+                    (((int32_t)(((GWThi1[o2.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o2.phase >> 23] * (GremHi)) >> 9))) * mixHi) +
+                    (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
+                    (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
 
-      o5.wave = (
+        o2.nextwave = (
+                        (((int32_t)(((GWThi1[(o2.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o2.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi) +
+                        (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
+                        (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
 
-                  (((int32_t)(((GWTlo1[o5.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o5.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
-                  (((int32_t)(((GWTmid1[o5.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o5.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
+        o5.wave = (
+                    (((int32_t)(((GWThi1[o5.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o5.phase >> 23] * (GremHi)) >> 9))) * mixHi) +
+                    (((int32_t)(((GWTlo1[o5.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o5.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
+                    (((int32_t)(((GWTmid1[o5.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o5.phase >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
 
-      o5.nextwave = (
+        o5.nextwave = (
+                        (((int32_t)(((GWThi1[(o5.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o5.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi) +
+                        (((int32_t)(((GWTlo1[(o5.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o5.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
+                        (((int32_t)(((GWTmid1[(o5.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o5.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)) >> 15;
 
-                      (((int32_t)(((GWTlo1[(o5.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o5.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
-                      (((int32_t)(((GWTmid1[(o5.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o5.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
 
-      break;
+        break;
 
-  }
+      //-----------------------------------------------ALT CZ MODE OSCILLATORS-----------------------------------------------
+      case 3:
 
-  o2.wave = o2.wave + ((((o2.nextwave - o2.wave)) * o2.phaseRemain) >> 15);
-  o3.wave = o3.wave + ((((o3.nextwave - o3.wave)) * o3.phaseRemain) >> 15);
-  o5.wave = o5.wave + ((((o5.nextwave - o5.wave)) * o5.phaseRemain) >> 15);
-  o6.wave = o6.wave + ((((o6.nextwave - o6.wave)) * o6.phaseRemain) >> 15);
+        o2.wave = (
 
-  o1.wave =   (o2.wave * o3.wave) >> 11;
-  o4.wave =   (o5.wave * o6.wave) >> 11;
+                    (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
+                    (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
 
-  o9.wave = ((32767- abs(o3.wave )) * mixEffect) >> 11; //get remaining headroom from pulse envelope
+        o2.nextwave = (
 
-  o8.wave = (-o1.wave ) + ((o4.wave * o9.wave) >> 15); //add delayed wave in remaining headroom.
+                        (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
+                        (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
 
-  FinalOut = declickValue + ((o8.wave * declickRampIn) >> 12);
-  analogWrite(aout2, FinalOut + 32000);
-}
+        o5.wave = (
 
-void FASTRUN outUpdateISR_WAVE_TWIN(void) {
+                    (((int32_t)(((GWTlo1[o5.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o5.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
+                    (((int32_t)(((GWTmid1[o5.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o5.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
 
-  delayCounter = delayCounter + 16;
-  delayCounterShift = delayCounter >> 4 ;
-  delayTimeShift = (uint16_t) (delayCounter - ((8192 - delayTime) << 3)) >> 4;
+        o5.nextwave = (
 
-  SUBMULOC();
-  DECLICK_CHECK();
-  NOISELIVE0();
-  NOISELIVE1();
+                        (((int32_t)(((GWTlo1[(o5.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o5.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
+                        (((int32_t)(((GWTmid1[(o5.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o5.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 15;
 
+        break;
 
-  
+    }
 
+    o2.wave = o2.wave + ((((o2.nextwave - o2.wave)) * o2.phaseRemain) >> 15);
+    o3.wave = o3.wave + ((((o3.nextwave - o3.wave)) * o3.phaseRemain) >> 15);
+    o5.wave = o5.wave + ((((o5.nextwave - o5.wave)) * o5.phaseRemain) >> 15);
+    o6.wave = o6.wave + ((((o6.nextwave - o6.wave)) * o6.phaseRemain) >> 15);
 
-  switch (oscMode) {
-    //-----------------------------------------------FM MODE OSCILLATORS-----------------------------------------------
-    case 0:
+    o1.wave =   (o2.wave * o3.wave) >> 11;
+    o4.wave =   (o5.wave * o6.wave) >> 11;
 
-      noiseTable3[0] = noiseTable3[1] = (noiseTable3[0] + NT3Rate);
-      noiseTable[o1.phase >> 23] = randomVal(-32767, 32767); //replace noise cells with random values.
+    o9.wave = ((32767- abs(o3.wave )) * mixEffect) >> 11; //get remaining headroom from pulse envelope
 
-      //main oscillator
-      o1.phase = o1.phase + o1.phase_increment;
-      o1.phaseRemain = (o1.phase << 9) >> 17;
-      o1.wave = (FMTable[o1.phase >> WTShiftFM]);
-      o1.nextwave =  (FMTable[(o1.phase + nextstep) >> WTShiftFM]);
-      o1.wave = o1.wave + ((((o1.nextwave - o1.wave)) * o1.phaseRemain) >> 15);
-      o1.index = (FMIndex * o1.wave);
-      o2.phase = o2.phase +  (o2.phase_increment + o1.index);
-      o2.phaseRemain = (o2.phase << 9) >> 17;
+    o8.wave = (-o1.wave ) + ((o4.wave * o9.wave) >> 15); //add delayed wave in remaining headroom.
+
+    FinalOut = declickValue + ((o8.wave * declickRampIn) >> 12);
+    analogWrite(aout2, FinalOut + 32000);
+
+    out[i] = written;
+  }
 
-      o3.phase = o3.phase + o3.phase_increment;
-      o3.phaseRemain = (o3.phase << 9) >> 17;
-      o3.wave = (FMTable[o3.phase >> WTShiftFM]);
-      o3.nextwave =  (FMTable[(o3.phase + nextstep) >> WTShiftFM]);
-      o3.wave = o3.wave + ((((o3.nextwave - o3.wave)) * o3.phaseRemain) >> 15);
-      o3.index = (FMIndex * o3.wave);
-      o4.phase = o2.phase +  o3.index + o1.phaseOffset;
-      o4.phaseRemain = (o4.phase << 9) >> 17;
+  this->o1 = o1;
+  this->o2 = o2;
+  this->o3 = o3;
+  this->o4 = o4;
+  this->o5 = o5;
+  this->o6 = o6;
+  this->o8 = o8;
+  this->o9 = o9;
+  this->o10 = o10;
+  this->delayCounter = delayCounter;
+  this->delayCounterShift = delayCounterShift;
+  this->delayTimeShift = delayTimeShift;
+}
 
+void FASTRUN outUpdateISR_PULSAR_TWIN(void) {
+  float out;
+  renderISR_PULSAR_TWIN(&out, 1);
+}
 
-      //-----------------------------------------------------------------------
+void FASTRUN renderISR_WAVE_TWIN(float *out, size_t size) {
+  oscillator1 o1 = this->o1;
+  oscillator2 o2 = this->o2;
+  oscillator3 o3 = this->o3;
+  oscillator4 o4 = this->o4;
+  uint16_t delayCounter = this->delayCounter;
+  uint16_t delayCounterShift = this->delayCounterShift;
+  uint16_t delayTimeShift = this->delayTimeShift;
+
+  const int16_t NT3Rate = this->NT3Rate;
+  const uint16_t delayTime = this->delayTime;
+  const int32_t nextstep = this->nextstep;
+  const int Temporal_Shift_CZ = this->Temporal_Shift_CZ;
+  const uint8_t WTShiftFM = this->WTShiftFM;
+  const int16_t *const FMTable = this->FMTable;
+  const int16_t *const GWTlo1 = this->GWTlo1;
+  const int16_t *const GWTlo2 = this->GWTlo2;
+  const int16_t *const GWTmid1 = this->GWTmid1;
+  const int16_t *const GWTmid2 = this->GWTmid2;
+  const int16_t *const GWThi1 = this->GWThi1;
+  const int16_t *const GWThi2 = this->GWThi2;
+  const int32_t GremLo = this->GremLo;
+  const int32_t GremMid = this->GremMid;
+  const int32_t GremHi = this->GremHi;
+  const uint16_t mixHi = this->mixHi;
+  const uint16_t mixLo = this->mixLo;
+  const uint16_t mixMid = this->mixMid;
+  const uint32_t mixEffect = this->mixEffect;
+  const uint32_t mixEffectDn = this->mixEffectDn;
+  const int32_t CZMix = this->CZMix;
+  const uint16_t FMIndex = this->FMIndex;
+  const uint8_t oscMode = this->oscMode;
+
+  for (size_t i = 0; i < size; i++) {
+    delayCounter = delayCounter + 16;
+    delayCounterShift = delayCounter >> 4 ;
+    delayTimeShift = (uint16_t) (delayCounter - ((8192 - delayTime) << 3)) >> 4;
+
+    SUBMULOC();
+    DECLICK_CHECK();
+    NOISELIVE0();
+    NOISELIVE1();
+
+
+
+
+
+    switch (oscMode) {
+      //-----------------------------------------------FM MODE OSCILLATORS-----------------------------------------------
+      case 0:
+
+        noiseTable3[0] = noiseTable3[1] = (noiseTable3[0] + NT3Rate);
+        noiseTable[o1.phase >> 23] = randomVal(-32767, 32767); //replace noise cells with random values.
+
+        //main oscillator
+        o1.phase = o1.phase + o1.phase_increment;
+        o1.phaseRemain = (o1.phase << 9) >> 17;
+        o1.wave = (FMTable[o1.phase >> WTShiftFM]);
+        o1.nextwave =  (FMTable[(o1.phase + nextstep) >> WTShiftFM]);
+        o1.wave = o1.wave + ((((o1.nextwave - o1.wave)) * o1.phaseRemain) >> 15);
+        o1.index = (FMIndex * o1.wave);
+        o2.phase = o2.phase +  (o2.phase_increment + o1.index);
+        o2.phaseRemain = (o2.phase << 9) >> 17;
 
-      o2.wave = (
-                  (((int32_t)(((GWThi1[o2.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o2.phase >> 23] * (GremHi)) >> 9))) * mixHi) +
-                  (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
-                  (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * mixMid)) >> 11;
+        o3.phase = o3.phase + o3.phase_increment;
+        o3.phaseRemain = (o3.phase << 9) >> 17;
+        o3.wave = (FMTable[o3.phase >> WTShiftFM]);
+        o3.nextwave =  (FMTable[(o3.phase + nextstep) >> WTShiftFM]);
+        o3.wave = o3.wave + ((((o3.nextwave - o3.wave)) * o3.phaseRemain) >> 15);
+        o3.index = (FMIndex * o3.wave);
+        o4.phase = o2.phase +  o3.index + o1.phaseOffset;
+        o4.phaseRemain = (o4.phase << 9) >> 17;
 
-      o2.nextwave = (
-                      (((int32_t)(((GWThi1[(o2.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o2.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi) +
-                      (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
-                      (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)) >> 11;
 
-      o4.wave = (
-                  (((int32_t)(((GWThi1[o4.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o4.phase >> 23] * (GremHi)) >> 9))) * mixHi) +
-                  (((int32_t)(((GWTlo1[o4.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o4.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
-                  (((int32_t)(((GWTmid1[o4.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o4.phase >> 23] * (GremMid)) >> 9))) * mixMid)) >> 11;
+        //-----------------------------------------------------------------------
+
+        o2.wave = (
+                    (((int32_t)(((GWThi1[o2.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o2.phase >> 23] * (GremHi)) >> 9))) * mixHi) +
+                    (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
+                    (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * mixMid)) >> 11;
 
-      o4.nextwave = (
-                      (((int32_t)(((GWThi1[(o4.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o4.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi) +
-                      (((int32_t)(((GWTlo1[(o4.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o4.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
-                      (((int32_t)(((GWTmid1[(o4.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o4.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)) >> 11;
+        o2.nextwave = (
+                        (((int32_t)(((GWThi1[(o2.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o2.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi) +
+                        (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
+                        (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)) >> 11;
 
-      o2.wave = (o2.wave + ((((o2.nextwave - o2.wave)) * o2.phaseRemain) >> 15)) >> 1;
-      o4.wave = (o4.wave + ((((o4.nextwave - o4.wave)) * o4.phaseRemain) >> 15)) >> 1;
-      break;
+        o4.wave = (
+                    (((int32_t)(((GWThi1[o4.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o4.phase >> 23] * (GremHi)) >> 9))) * mixHi) +
+                    (((int32_t)(((GWTlo1[o4.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o4.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
+                    (((int32_t)(((GWTmid1[o4.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o4.phase >> 23] * (GremMid)) >> 9))) * mixMid)) >> 11;
 
-    //-----------------------------------------------ALT FM MODE OSCILLATORS-----------------------------------------------
-    case 2:
+        o4.nextwave = (
+                        (((int32_t)(((GWThi1[(o4.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o4.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi) +
+                        (((int32_t)(((GWTlo1[(o4.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o4.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
+                        (((int32_t)(((GWTmid1[(o4.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o4.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)) >> 11;
+
+        o2.wave = (o2.wave + ((((o2.nextwave - o2.wave)) * o2.phaseRemain) >> 15)) >> 1;
+        o4.wave = (o4.wave + ((((o4.nextwave - o4.wave)) * o4.phaseRemain) >> 15)) >> 1;
+        break;
+
+      //-----------------------------------------------ALT FM MODE OSCILLATORS-----------------------------------------------
+      case 2:
+
+
+        noiseTable3[0] = noiseTable3[1] = (noiseTable3[0] + NT3Rate);
+
+
+        //main oscillator
+        o1.phase = o1.phase + o1.phase_increment;
+        if (o1.phaseOld > o1.phase) {
+          noiseLive1[0] = randomVal(-32767, 32767);
+        }
+        o1.phaseOld = o1.phase;
+        o1.phaseRemain = (o1.phase << 9) >> 17;
+        o1.wave = (FMTable[o1.phase >> WTShiftFM]);
+        o1.nextwave =  (FMTable[(o1.phase + nextstep) >> WTShiftFM]);
+        o1.wave = o1.wave + ((((o1.nextwave - o1.wave)) * o1.phaseRemain) >> 15);
+        o1.index = (FMIndex * o1.wave);
+        o2.phase = o2.phase +  (o2.phase_increment + o1.index );
+        o2.phaseRemain = (o2.phase << 9) >> 17;
 
+        o3.phase = o3.phase + o3.phase_increment;
+        o3.phaseRemain = (o3.phase << 9) >> 17;
+        o3.wave = (FMTable[o3.phase >> WTShiftFM]);
+        o3.nextwave =  (FMTable[(o3.phase + nextstep) >> WTShiftFM]);
+        o3.wave = o3.wave + ((((o3.nextwave - o3.wave)) * o3.phaseRemain) >> 15);
+        o3.index = (FMIndex * o3.wave);
+        o4.phase = o2.phase +  o3.index + o1.phaseOffset;
+        o4.phaseRemain = (o4.phase << 9) >> 17;
 
-      noiseTable3[0] = noiseTable3[1] = (noiseTable3[0] + NT3Rate);
+        //-----------------------------------------------------------------------
 
+        o2.wave = (
 
-      //main oscillator
-      o1.phase = o1.phase + o1.phase_increment;
-      if (o1.phaseOld > o1.phase) {
-        noiseLive1[0] = randomVal(-32767, 32767);
-      }
-      o1.phaseOld = o1.phase;
-      o1.phaseRemain = (o1.phase << 9) >> 17;
-      o1.wave = (FMTable[o1.phase >> WTShiftFM]);
-      o1.nextwave =  (FMTable[(o1.phase + nextstep) >> WTShiftFM]);
-      o1.wave = o1.wave + ((((o1.nextwave - o1.wave)) * o1.phaseRemain) >> 15);
-      o1.index = (FMIndex * o1.wave);
-      o2.phase = o2.phase +  (o2.phase_increment + o1.index );
-      o2.phaseRemain = (o2.phase << 9) >> 17;
+                    (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
+                    (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 11;
 
-      o3.phase = o3.phase + o3.phase_increment;
-      o3.phaseRemain = (o3.phase << 9) >> 17;
-      o3.wave = (FMTable[o3.phase >> WTShiftFM]);
-      o3.nextwave =  (FMTable[(o3.phase + nextstep) >> WTShiftFM]);
-      o3.wave = o3.wave + ((((o3.nextwave - o3.wave)) * o3.phaseRemain) >> 15);
-      o3.index = (FMIndex * o3.wave);
-      o4.phase = o2.phase +  o3.index + o1.phaseOffset;
-      o4.phaseRemain = (o4.phase << 9) >> 17;
+        o2.nextwave = (
 
-      //-----------------------------------------------------------------------
+                        (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
+                        (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 11;
 
-      o2.wave = (
+        o4.wave = (
 
-                  (((int32_t)(((GWTlo1[o2.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o2.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
-                  (((int32_t)(((GWTmid1[o2.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o2.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 11;
+                    (((int32_t)(((GWTlo1[o4.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o4.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
+                    (((int32_t)(((GWTmid1[o4.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o4.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 11;
 
-      o2.nextwave = (
+        o4.nextwave = (
 
-                      (((int32_t)(((GWTlo1[(o2.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o2.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
-                      (((int32_t)(((GWTmid1[(o2.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 11;
+                        (((int32_t)(((GWTlo1[(o4.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o4.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
+                        (((int32_t)(((GWTmid1[(o4.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 11;
 
-      o4.wave = (
+        o2.wave = (o2.wave + ((((o2.nextwave - o2.wave)) * o2.phaseRemain) >> 15)) >> 1;
+        o4.wave = (o4.wave + ((((o4.nextwave - o4.wave)) * o4.phaseRemain) >> 15)) >> 1;
 
-                  (((int32_t)(((GWTlo1[o4.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o4.phase >> 23] * (GremLo)) >> 9))) * mixLo) +
-                  (((int32_t)(((GWTmid1[o4.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o4.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 11;
 
-      o4.nextwave = (
+        break;
 
-                      (((int32_t)(((GWTlo1[(o4.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o4.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo) +
-                      (((int32_t)(((GWTmid1[(o4.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o2.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))) >> 11;
 
-      o2.wave = (o2.wave + ((((o2.nextwave - o2.wave)) * o2.phaseRemain) >> 15)) >> 1;
-      o4.wave = (o4.wave + ((((o4.nextwave - o4.wave)) * o4.phaseRemain) >> 15)) >> 1;
+      case 1://-------------------------------------------CZ MODE OSCILLATORS-----------------------------------------------
 
 
-      break;
+        o1.phase = o1.phase + (o1.phase_increment );
+        o2.phase = o2.phase +  o2.phase_increment;
+        if (o1.phaseOld > o1.phase)o2.phase = (uint32_t)((o2.phase_increment * o1.phase) >> Temporal_Shift_CZ);;
+        o1.phaseOld = o1.phase;
+        o2.phaseRemain = (o2.phase << 9) >> 17;
+        o1.phaseRemain = (o1.phase << 9) >> 17;
 
 
-    case 1://-------------------------------------------CZ MODE OSCILLATORS-----------------------------------------------
+        o3.phase = o1.phase + (o1.phaseOffset);
+        o4.phase = o4.phase +  o4.phase_increment;
+        if (o3.phase < (o1.phase_increment<<1))o4.phase = (uint32_t)((o4.phase_increment * o3.phase) >> Temporal_Shift_CZ);
+        o3.phaseOld = o3.phase;
+        o4.phaseRemain = (o4.phase << 9) >> 17;
+        o3.phaseRemain = (o3.phase << 9) >> 17;
 
+        //-----------------------------------------------------------------------
 
-      o1.phase = o1.phase + (o1.phase_increment );
-      o2.phase = o2.phase +  o2.phase_increment;
-      if (o1.phaseOld > o1.phase)o2.phase = (uint32_t)((o2.phase_increment * o1.phase) >> Temporal_Shift_CZ);;
-      o1.phaseOld = o1.phase;
-      o2.phaseRemain = (o2.phase << 9) >> 17;
-      o1.phaseRemain = (o1.phase << 9) >> 17;
+        o2.wave = (FMTable[o2.phase >> 23]);
+        o2.nextwave =  (FMTable[(o2.phase + nextstep) >> 23]);
+        o4.wave = (FMTable[o4.phase >> 23]);
+        o4.nextwave =  (FMTable[(o4.phase + nextstep) >> 23]);
 
-      
-      o3.phase = o1.phase + (o1.phaseOffset);
-      o4.phase = o4.phase +  o4.phase_increment;
-      if (o3.phase < (o1.phase_increment<<1))o4.phase = (uint32_t)((o4.phase_increment * o3.phase) >> Temporal_Shift_CZ);
-      o3.phaseOld = o3.phase;
-      o4.phaseRemain = (o4.phase << 9) >> 17;
-      o3.phaseRemain = (o3.phase << 9) >> 17;
 
-      //-----------------------------------------------------------------------
+        o1.wave = ((
+                     (((int32_t)(((GWThi1[o1.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o1.phase >> 23] * (GremHi)) >> 9))) * mixHi)   +
+                     (((int32_t)(((GWTlo1[o1.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o1.phase >> 23] * (GremLo)) >> 9))) * mixLo)   +
+                     (((int32_t)(((GWTmid1[o1.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o1.phase >> 23] * (GremMid)) >> 9))) * mixMid)
+                   ) >> 4) >> 11;
 
-      o2.wave = (FMTable[o2.phase >> 23]);
-      o2.nextwave =  (FMTable[(o2.phase + nextstep) >> 23]);
-      o4.wave = (FMTable[o4.phase >> 23]);
-      o4.nextwave =  (FMTable[(o4.phase + nextstep) >> 23]);
+        o1.nextwave = ((
+                         (((int32_t)(((GWThi1[(o1.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o1.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi)   +
+                         (((int32_t)(((GWTlo1[(o1.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o1.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo)   +
+                         (((int32_t)(((GWTmid1[(o1.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o1.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)
+                       ) >> 4) >> 11;
 
+        o3.wave = ((
+                     (((int32_t)(((GWThi1[o3.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o3.phase >> 23] * (GremHi)) >> 9))) * mixHi)   +
+                     (((int32_t)(((GWTlo1[o3.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o3.phase >> 23] * (GremLo)) >> 9))) * mixLo)   +
+                     (((int32_t)(((GWTmid1[o3.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o3.phase >> 23] * (GremMid)) >> 9))) * mixMid)
+                   ) >> 4) >> 11;
 
-      o1.wave = ((
-                   (((int32_t)(((GWThi1[o1.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o1.phase >> 23] * (GremHi)) >> 9))) * mixHi)   +
-                   (((int32_t)(((GWTlo1[o1.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o1.phase >> 23] * (GremLo)) >> 9))) * mixLo)   +
-                   (((int32_t)(((GWTmid1[o1.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o1.phase >> 23] * (GremMid)) >> 9))) * mixMid)
-                 ) >> 4) >> 11;
+        o3.nextwave = ((
+                         (((int32_t)(((GWThi1[(o3.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o3.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi)   +
+                         (((int32_t)(((GWTlo1[(o3.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o3.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo)   +
+                         (((int32_t)(((GWTmid1[(o3.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o3.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)
+                       ) >> 4) >> 11;
 
-      o1.nextwave = ((
-                       (((int32_t)(((GWThi1[(o1.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o1.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi)   +
-                       (((int32_t)(((GWTlo1[(o1.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o1.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo)   +
-                       (((int32_t)(((GWTmid1[(o1.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o1.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)
-                     ) >> 4) >> 11;
+        o2.wave = o2.wave + ((((o2.nextwave - o2.wave)) * o2.phaseRemain) >> 15);
+        o1.wave = o1.wave + ((((o1.nextwave - o1.wave)) * o1.phaseRemain) >> 15);
+        o4.wave = o4.wave + ((((o4.nextwave - o4.wave)) * o4.phaseRemain) >> 15);
+        o3.wave = o3.wave + ((((o3.nextwave - o3.wave)) * o3.phaseRemain) >> 15);
 
-      o3.wave = ((
-                   (((int32_t)(((GWThi1[o3.phase >> 23] * (511 - GremHi)) >> 9) + ((GWThi2[o3.phase >> 23] * (GremHi)) >> 9))) * mixHi)   +
-                   (((int32_t)(((GWTlo1[o3.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o3.phase >> 23] * (GremLo)) >> 9))) * mixLo)   +
-                   (((int32_t)(((GWTmid1[o3.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o3.phase >> 23] * (GremMid)) >> 9))) * mixMid)
-                 ) >> 4) >> 11;
+        o2.wave = ((o1.wave * (2047 - CZMix)) >> 8)  +  ((int32_t)(((o1.wave) * ((o2.wave * CZMix) >> 11)) >> 12));  //cz mixer
+        o4.wave = ((o3.wave * (2047 - CZMix)) >> 8)  +  ((int32_t)(((o3.wave) * ((o4.wave * CZMix) >> 11)) >> 12));  //cz mixer
 
-      o3.nextwave = ((
-                       (((int32_t)(((GWThi1[(o3.phase + nextstep) >> 23] * (511 - GremHi)) >> 9)  +  ((GWThi2[(o3.phase + nextstep) >> 23] * (GremHi)) >> 9))) * mixHi)   +
-                       (((int32_t)(((GWTlo1[(o3.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o3.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo)   +
-                       (((int32_t)(((GWTmid1[(o3.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o3.phase + nextstep) >> 23] * (GremMid)) >> 9))) * mixMid)
-                     ) >> 4) >> 11;
 
-      o2.wave = o2.wave + ((((o2.nextwave - o2.wave)) * o2.phaseRemain) >> 15);
-      o1.wave = o1.wave + ((((o1.nextwave - o1.wave)) * o1.phaseRemain) >> 15);
-      o4.wave = o4.wave + ((((o4.nextwave - o4.wave)) * o4.phaseRemain) >> 15);
-      o3.wave = o3.wave + ((((o3.nextwave - o3.wave)) * o3.phaseRemain) >> 15);
 
-      o2.wave = ((o1.wave * (2047 - CZMix)) >> 8)  +  ((int32_t)(((o1.wave) * ((o2.wave * CZMix) >> 11)) >> 12));  //cz mixer
-      o4.wave = ((o3.wave * (2047 - CZMix)) >> 8)  +  ((int32_t)(((o3.wave) * ((o4.wave * CZMix) >> 11)) >> 12));  //cz mixer
+        break;
 
 
 
-      break;
+      //----------------------------------------------ALT CZ mode-----------------------------------------
+      case 3:
 
+       o1.phase = o1.phase + (o1.phase_increment );
+        o2.phase = o2.phase +  o2.phase_increment;
+        if (o1.phaseOld > o1.phase)o2.phase = (uint32_t)((o2.phase_increment * o1.phase) >> Temporal_Shift_CZ);;
+        o1.phaseOld = o1.phase;
+        o2.phaseRemain = (o2.phase << 9) >> 17;
+        o1.phaseRemain = (o1.phase << 9) >> 17;
 
 
-    //----------------------------------------------ALT CZ mode-----------------------------------------
-    case 3:
+        o3.phase = o1.phase + (o1.phaseOffset);
+        o4.phase = o4.phase +  o4.phase_increment;
+        if (o3.phase < (o1.phase_increment<<1))o4.phase = (uint32_t)((o4.phase_increment * o3.phase) >> Temporal_Shift_CZ);
+        o3.phaseOld = o3.phase;
+        o4.phaseRemain = (o4.phase << 9) >> 17;
+        o3.phaseRemain = (o3.phase << 9) >> 17;
 
-     o1.phase = o1.phase + (o1.phase_increment );
-      o2.phase = o2.phase +  o2.phase_increment;
-      if (o1.phaseOld > o1.phase)o2.phase = (uint32_t)((o2.phase_increment * o1.phase) >> Temporal_Shift_CZ);;
-      o1.phaseOld = o1.phase;
-      o2.phaseRemain = (o2.phase << 9) >> 17;
-      o1.phaseRemain = (o1.phase << 9) >> 17;
 
-      
-      o3.phase = o1.phase + (o1.phaseOffset);
-      o4.phase = o4.phase +  o4.phase_increment;
-      if (o3.phase < (o1.phase_increment<<1))o4.phase = (uint32_t)((o4.phase_increment * o3.phase) >> Temporal_Shift_CZ);
-      o3.phaseOld = o3.phase;
-      o4.phaseRemain = (o4.phase << 9) >> 17;
-      o3.phaseRemain = (o3.phase << 9) >> 17;
 
+        //-----------------------------------------------------------------------
 
+        o2.wave = (FMTable[o2.phase >> 23]);
+        o2.nextwave =  (FMTable[(o2.phase + nextstep) >> 23]);
+        o4.wave = (FMTable[o4.phase >> 23]);
+        o4.nextwave =  (FMTable[(o4.phase + nextstep) >> 23]);
 
-      //-----------------------------------------------------------------------
 
-      o2.wave = (FMTable[o2.phase >> 23]);
-      o2.nextwave =  (FMTable[(o2.phase + nextstep) >> 23]);
-      o4.wave = (FMTable[o4.phase >> 23]);
-      o4.nextwave =  (FMTable[(o4.phase + nextstep) >> 23]);
+        o1.wave = ((
 
+                     (((int32_t)(((GWTlo1[o1.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o1.phase >> 23] * (GremLo)) >> 9))) * mixLo)   +
+                     (((int32_t)(((GWTmid1[o1.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o1.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))
+                   ) >> 4) >> 11;
 
-      o1.wave = ((
+        o1.nextwave = ((
 
-                   (((int32_t)(((GWTlo1[o1.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o1.phase >> 23] * (GremLo)) >> 9))) * mixLo)   +
-                   (((int32_t)(((GWTmid1[o1.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o1.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))
-                 ) >> 4) >> 11;
+                         (((int32_t)(((GWTlo1[(o1.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o1.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo)   +
+                         (((int32_t)(((GWTmid1[(o1.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o1.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))
+                       ) >> 4) >> 11;
 
-      o1.nextwave = ((
+        o3.wave = ((
 
-                       (((int32_t)(((GWTlo1[(o1.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o1.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo)   +
-                       (((int32_t)(((GWTmid1[(o1.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o1.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))
-                     ) >> 4) >> 11;
+                     (((int32_t)(((GWTlo1[o3.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o3.phase >> 23] * (GremLo)) >> 9))) * mixLo)   +
+                     (((int32_t)(((GWTmid1[o3.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o3.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))
+                   ) >> 4) >> 11;
 
-      o3.wave = ((
+        o3.nextwave = ((
 
-                   (((int32_t)(((GWTlo1[o3.phase >> 23] * (511 - GremLo)) >> 9) + ((GWTlo2[o3.phase >> 23] * (GremLo)) >> 9))) * mixLo)   +
-                   (((int32_t)(((GWTmid1[o3.phase >> 23] * (511 - GremMid)) >> 9) + ((GWTmid2[o3.phase >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))
-                 ) >> 4) >> 11;
+                         (((int32_t)(((GWTlo1[(o3.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o3.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo)   +
+                         (((int32_t)(((GWTmid1[(o3.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o3.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))
+                       ) >> 4) >> 11;
 
-      o3.nextwave = ((
 
-                       (((int32_t)(((GWTlo1[(o3.phase + nextstep) >> 23] * (511 - GremLo)) >> 9)  +  ((GWTlo2[(o3.phase + nextstep) >> 23] * (GremLo)) >> 9))) * mixLo)   +
-                       (((int32_t)(((GWTmid1[(o3.phase + nextstep) >> 23] * (511 - GremMid)) >> 9)  +  ((GWTmid2[(o3.phase + nextstep) >> 23] * (GremMid)) >> 9))) * (mixMid + mixHi))
-                     ) >> 4) >> 11;
+        o2.wave = o2.wave + ((((o2.nextwave - o2.wave)) * o2.phaseRemain) >> 15);
+        o1.wave = o1.wave + ((((o1.nextwave - o1.wave)) * o1.phaseRemain) >> 15);
+        o4.wave = o4.wave + ((((o4.nextwave - o4.wave)) * o4.phaseRemain) >> 15);
+        o3.wave = o3.wave + ((((o3.nextwave - o3.wave)) * o3.phaseRemain) >> 15);
 
+        o2.wave = ((o1.wave * (2047 - CZMix)) >> 8)  +  ((int32_t)(((o1.wave) * ((o2.wave * CZMix) >> 11)) >> 12));  //cz mixer
+        o4.wave = ((o3.wave * (2047 - CZMix)) >> 8)  +  ((int32_t)(((o3.wave) * ((o4.wave * CZMix) >> 11)) >> 12));  //cz mixer
 
-      o2.wave = o2.wave + ((((o2.nextwave - o2.wave)) * o2.phaseRemain) >> 15);
-      o1.wave = o1.wave + ((((o1.nextwave - o1.wave)) * o1.phaseRemain) >> 15);
-      o4.wave = o4.wave + ((((o4.nextwave - o4.wave)) * o4.phaseRemain) >> 15);
-      o3.wave = o3.wave + ((((o3.nextwave - o3.wave)) * o3.phaseRemain) >> 15);
 
-      o2.wave = ((o1.wave * (2047 - CZMix)) >> 8)  +  ((int32_t)(((o1.wave) * ((o2.wave * CZMix) >> 11)) >> 12));  //cz mixer
-      o4.wave = ((o3.wave * (2047 - CZMix)) >> 8)  +  ((int32_t)(((o3.wave) * ((o4.wave * CZMix) >> 11)) >> 12));  //cz mixer
 
 
+        break;
 
+    }
 
-      break;
+    o1.wave = (int32_t)(o2.wave >> 3) + (o4.wave >> 3);
+    o1.wave = (int32_t)(o1.wave * mixEffect) >> 8;
+    o1.wave = o1.wave + ((int32_t)(o2.wave * mixEffectDn) >> 10);
 
-  }
+    FinalOut = declickValue + ((o1.wave * declickRampIn) >> 12);
 
-  o1.wave = (int32_t)(o2.wave >> 3) + (o4.wave >> 3);
-  o1.wave = (int32_t)(o1.wave * mixEffect) >> 8;
-  o1.wave = o1.wave + ((int32_t)(o2.wave * mixEffectDn) >> 10);
+    analogWrite(aout2, FinalOut + 32000);
 
-  FinalOut = declickValue + ((o1.wave * declickRampIn) >> 12);
+    noiseTable[o1.phase >> 23] = randomVal(-32767, 32767); //replace noise cells with random values.
 
-  analogWrite(aout2, FinalOut + 32000);
+    out[i] = written;
+  }
 
-  noiseTable[o1.phase >> 23] = randomVal(-32767, 32767); //replace noise cells with random values.
+  this->o1 = o1;
+  this->o2 = o2;
+  this->o3 = o3;
+  this->o4 = o4;
+  this->delayCounter = delayCounter;
+  this->delayCounterShift = delayCounterShift;
+  this->delayTimeShift = delayTimeShift;
+}
 
+void FASTRUN outUpdateISR_WAVE_TWIN(void) {
+  float out;
+  renderISR_WAVE_TWIN(&out, 1);
 }
 
 
@@ -0,0 +1,162 @@
+//
+//  ModulationProgram.hpp
+//  Instrument
+//
+//  Modulation matrix of a kernel, compiled once and evaluated for all its playing voices at once.
+//
+
+#ifndef ModulationProgram_h
+#define ModulationProgram_h
+
+#import <atomic>
+
+/*
+ ModulationProgram
+ Running a ModulationEngine per voice walks every rule of the matrix for every voice, patched or
+ not. The program keeps only the routes of the rules which are patched, and is rebuilt when a rule
+ changes. Each patched output is the sum, in rule order, of input1 * input2 * depth over its rules,
+ input2 being ModInDirect (1.0) when the rule has a single input.
+
+ Inputs and outputs are stored per source and per destination, one lane per voice, so a route is
+ evaluated for all the playing voices in a single loop. The outputs which no route writes stay at 0.
+ */
+template<int kMaxVoices, int kNumInputs, int kNumOutputs, int kMaxRoutes>
+class ModulationProgram {
+public:
+    // The inputs or outputs of one voice, indexed as those of ModulationEngine.
+    class Lane {
+    public:
+        Lane() : rows(nullptr), voice(0) {}
+        Lane(float (*rows)[kMaxVoices], int voice) : rows(rows), voice(voice) {}
+
+        inline float& operator[](int i) { return rows[i][voice]; }
+        inline float operator[](int i) const { return rows[i][voice]; }
+
+    private:
+        float (*rows)[kMaxVoices];
+        int voice;
+    };
+
+    ModulationProgram() {
+        for (int i = 0; i < kNumInputs; i++) {
+            for (int v = 0; v < kMaxVoices; v++) {
+                in[i][v] = 0.0f;
+            }
+        }
+        for (int o = 0; o < kNumOutputs; o++) {
+            for (int v = 0; v < kMaxVoices; v++) {
+                out[o][v] = 0.0f;
+            }
+            patched[o] = false;
+        }
+        numRoutes = 0;
+        numPatched = 0;
+        dirty = true;
+    }
+
+    // The inputs and outputs of one voice.
+    struct VoiceLanes {
+        Lane in;
+        Lane out;
+    };
+
+    VoiceLanes lanes(int voice) {
+        VoiceLanes result = { Lane(in, voice), Lane(out, voice) };
+        return result;
+    }
+
+    // Any thread. The program is rebuilt at the next call to update().
+    void invalidate() {
+        dirty.store(true, std::memory_order_release);
+    }
+
+    // Render thread, between two blocks. Rebuilds the program from the rules if they changed
+    // since the last call. Nothing is allocated.
+    template<typename RuleList>
+    void update(RuleList& rules) {
+        if (!dirty.exchange(false, std::memory_order_acquire)) {
+            return;
+        }
+
+        bool wasPatched[kNumOutputs];
+        for (int o = 0; o < kNumOutputs; o++) {
+            wasPatched[o] = patched[o];
+            patched[o] = false;
+        }
+
+        numRoutes = 0;
+        for (int r = 0; r < kMaxRoutes; r++) {
+            int input1 = (int) rules.getParameter(r * 4 + 0);
+            int input2 = (int) rules.getParameter(r * 4 + 1);
+            float depth = rules.getParameter(r * 4 + 2);
+            int output = (int) rules.getParameter(r * 4 + 3);
+            if (output <= 0 || output >= kNumOutputs || depth == 0.0f ||
+                input1 < 0 || input1 >= kNumInputs || input2 < 0 || input2 >= kNumInputs) {
+                continue;
+            }
+            Route& route = routes[numRoutes++];
+            route.input1 = input1;
+            route.input2 = input2;
+            route.depth = depth;
+            route.output = output;
+            patched[output] = true;
+        }
+
+        numPatched = 0;
+        for (int o = 0; o < kNumOutputs; o++) {
+            if (patched[o]) {
+                patchedOutputs[numPatched++] = o;
+            } else if (wasPatched[o]) {
+                // Released by the last route which wrote it: back to its rest value for all voices.
+                for (int v = 0; v < kMaxVoices; v++) {
+                    out[o][v] = 0.0f;
+                }
+            }
+        }
+    }
+
+    inline bool isPatched(int output) const {
+        return patched[output];
+    }
+
+    // Render thread. Evaluates the routes for the count voices listed in voices.
+    void run(const int *voices, int count) {
+        for (int p = 0; p < numPatched; p++) {
+            float *o = out[patchedOutputs[p]];
+            for (int j = 0; j < count; j++) {
+                o[voices[j]] = 0.0f;
+            }
+        }
+        for (int r = 0; r < numRoutes; r++) {
+            const Route& route = routes[r];
+            const float *in1 = in[route.input1];
+            const float *in2 = in[route.input2];
+            float *o = out[route.output];
+            for (int j = 0; j < count; j++) {
+                int v = voices[j];
+                o[v] += in1[v] * in2[v] * route.depth;
+            }
+        }
+    }
+
+    float in[kNumInputs][kMaxVoices];
+    float out[kNumOutputs][kMaxVoices];
+
+private:
+    struct Route {
+        int input1;
+        int input2;
+        int output;
+        float depth;
+    };
+
+    Route routes[kMaxRoutes];
+    int numRoutes;
+    int patchedOutputs[kNumOutputs];
+    int numPatched;
+    bool patched[kNumOutputs];
+
+    std::atomic<bool> dirty;
+};
+
+#endif /* ModulationProgram_h */
@@ -0,0 +1,225 @@
+//
+//  PerformanceCounters.hpp
+//  Instrument
+//
+//  Render time statistics of a kernel, measured on the render thread and read from any other.
+//
+
+#ifndef PerformanceCounters_h
+#define PerformanceCounters_h
+
+#import <algorithm>
+#import <atomic>
+#import <chrono>
+#import <cstdint>
+#import <cstring>
+
+// All the values are accumulated since the counters were last reset. The load of a host buffer
+// is the time spent rendering it divided by the duration of its audio: above 1, the host drops
+// out.
+struct PerformanceSnapshot {
+    uint64_t buffers;
+    uint64_t frames;
+    // Buffers which took longer to render than they last.
+    uint64_t overloads;
+    // Subnormal samples in the output of the DSP, before the conversion to the host rate. They
+    // are the trace of denormal arithmetic in the feedback paths, which is many times slower.
+    uint64_t denormals;
+    // Internal blocks cut short by an event inside them. Only counted by the kernels which apply
+    // events at their exact frame.
+    uint64_t splitBlocks;
+    // Blocks not rendered by a voice because it was asleep. Only counted by the kernels which put
+    // silent voices to sleep.
+    uint64_t sleepingVoiceBlocks;
+
+    uint64_t lastNanoseconds;
+    float lastLoad;
+    float p99Load;
+    float maxLoad;
+
+    // Time spent in process(), split between the conversions to and from the host rate and the
+    // rest.
+    double dspSeconds;
+    double resamplerSeconds;
+
+    // Voices rendered in the last block, and at most.
+    int activeVoices;
+    int maxActiveVoices;
+};
+
+/*
+ PerformanceCounters
+ The render thread times each call to process() and the resampler calls within it. The calls
+ which share a host buffer are recognized by their buffer offset: the first starts at 0. When the
+ next buffer starts, the previous one is added to the statistics, which are then published.
+
+ Publishing does not wait for the reader, nor the reader for the render thread: the snapshots are
+ triple buffered. The render thread fills a back buffer and swaps it with the middle one, and
+ read() swaps the middle buffer with its own when a newer one is there. Only one thread may read.
+ */
+class PerformanceCounters {
+public:
+    PerformanceCounters() {
+        sampleRate = 0.0;
+        clear();
+        memset(snapshots, 0, sizeof(snapshots));
+        back = 0;
+        middle = 1;
+        front = 2;
+        resetRequested = false;
+    }
+
+    // Host sample rate. Not on the render thread: this also clears the statistics.
+    void init(double inSampleRate) {
+        sampleRate = inSampleRate;
+        clear();
+    }
+
+    // Any thread. Takes effect at the beginning of the next host buffer.
+    void reset() {
+        resetRequested.store(true, std::memory_order_relaxed);
+    }
+
+    // Any thread, but only one. Copies the latest published statistics into snapshot.
+    void read(PerformanceSnapshot *snapshot) {
+        if (middle.load(std::memory_order_relaxed) & kFresh) {
+            front = middle.exchange(front, std::memory_order_acq_rel) & kIndexMask;
+        }
+        *snapshot = snapshots[front];
+    }
+
+    // MARK: Render thread
+
+    // With the arguments of process().
+    inline void beginProcess(uint32_t frameCount, uint32_t bufferOffset) {
+        if (bufferOffset == 0 && bufferFrames > 0) {
+            endBuffer();
+        }
+        if (resetRequested.load(std::memory_order_relaxed) && bufferFrames == 0) {
+            resetRequested.store(false, std::memory_order_relaxed);
+            clear();
+        }
+        bufferFrames += frameCount;
+        processStart = Clock::now();
+    }
+
+    inline void endProcess() {
+        bufferSeconds += std::chrono::duration<double>(Clock::now() - processStart).count();
+    }
+
+    inline void beginResampler() {
+        resamplerStart = Clock::now();
+    }
+
+    inline void endResampler() {
+        bufferResamplerSeconds += std::chrono::duration<double>(Clock::now() - resamplerStart).count();
+    }
+
+    inline void setActiveVoices(int count) {
+        current.activeVoices = count;
+        if (count > current.maxActiveVoices) {
+            current.maxActiveVoices = count;
+        }
+    }
+
+    inline void countDenormals(const float *samples, int size) {
+        uint64_t count = 0;
+        for (int i = 0; i < size; i++) {
+            uint32_t bits;
+            memcpy(&bits, &samples[i], sizeof(bits));
+            count += (bits & 0x7f800000) == 0 && (bits & 0x007fffff) != 0;
+        }
+        current.denormals += count;
+    }
+
+    inline void countSplitBlock() {
+        current.splitBlocks++;
+    }
+
+    inline void countSleepingVoices(int count) {
+        current.sleepingVoiceBlocks += count;
+    }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    // Loads are histogrammed in steps of 1%, up to kMaxLoad.
+    static const int kLoadSteps = 100;
+    static const int kMaxLoad = 4;
+    static const int kNumBins = kMaxLoad * kLoadSteps + 1;
+
+    static const int kIndexMask = 3;
+    static const int kFresh = 4;
+
+    void clear() {
+        memset(&current, 0, sizeof(current));
+        memset(histogram, 0, sizeof(histogram));
+        bufferSeconds = 0.0;
+        bufferResamplerSeconds = 0.0;
+        bufferFrames = 0;
+    }
+
+    void endBuffer() {
+        float load = 0.0f;
+        if (sampleRate > 0.0) {
+            load = (float) (bufferSeconds * sampleRate / (double) bufferFrames);
+        }
+        int bin = (int) (load * kLoadSteps);
+        histogram[bin < kNumBins - 1 ? bin : kNumBins - 1]++;
+
+        current.buffers++;
+        current.frames += bufferFrames;
+        current.overloads += load > 1.0f;
+        current.lastNanoseconds = (uint64_t) (bufferSeconds * 1e9);
+        current.lastLoad = load;
+        if (load > current.maxLoad) {
+            current.maxLoad = load;
+        }
+        current.p99Load = percentile(0.99);
+        current.dspSeconds += bufferSeconds - bufferResamplerSeconds;
+        current.resamplerSeconds += bufferResamplerSeconds;
+
+        bufferSeconds = 0.0;
+        bufferResamplerSeconds = 0.0;
+        bufferFrames = 0;
+        publish();
+    }
+
+    // Upper edge of the bin holding the given fraction of the buffers, or the maximum load when
+    // it is in the last bin.
+    float percentile(double fraction) const {
+        uint64_t rank = (uint64_t) (fraction * (double) current.buffers);
+        uint64_t count = 0;
+        for (int bin = 0; bin < kNumBins - 1; bin++) {
+            count += histogram[bin];
+            if (count > rank) {
+                return std::min((float) (bin + 1) / kLoadSteps, current.maxLoad);
+            }
+        }
+        return current.maxLoad;
+    }
+
+    void publish() {
+        snapshots[back] = current;
+        back = middle.exchange(back | kFresh, std::memory_order_acq_rel) & kIndexMask;
+    }
+
+    double sampleRate;
+
+    PerformanceSnapshot current;
+    uint32_t histogram[kNumBins];
+    double bufferSeconds;
+    double bufferResamplerSeconds;
+    uint32_t bufferFrames;
+    Clock::time_point processStart;
+    Clock::time_point resamplerStart;
+
+    PerformanceSnapshot snapshots[3];
+    int back;
+    std::atomic<int> middle;
+    int front;
+
+    std::atomic<bool> resetRequested;
+};
+
+#endif /* PerformanceCounters_h */
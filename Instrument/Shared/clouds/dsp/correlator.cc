@@ -29,49 +29,212 @@
 #include "clouds/dsp/correlator.h"
 
 #include <algorithm>
+#include <cmath>
+
+#include "stmlib/dsp/simd.h"
 
 namespace clouds {
 
 using namespace std;
+using namespace stmlib;
 
-void Correlator::Init(uint32_t* source, uint32_t* destination) {
+void Correlator::Init(
+    uint32_t* source,
+    uint32_t* destination,
+    float* fft_buffer) {
   source_ = source;
   destination_ = destination;
+  if (fft_buffer) {
+    fft_source_ = &fft_buffer[0];
+    fft_destination_ = &fft_buffer[kCorrelatorMaxFftSize];
+    fft_product_ = &fft_buffer[kCorrelatorMaxFftSize * 2];
+    fft_energy_ = &fft_buffer[kCorrelatorMaxFftSize * 3];
+    fft_.Init();
+  } else {
+    fft_source_ = fft_destination_ = fft_product_ = fft_energy_ = NULL;
+  }
+  fft_search_ = false;
+  sample_search_ = false;
   offset_ = 0;
+  candidate_ = 0;
+  stage_ = SAMPLE_SEARCH_ENERGY;
+  best_score_ = 0;
   best_match_ = 0;
   done_ = true;
 }
 
-void Correlator::EvaluateNextCandidate() {
-  if (done_) {
-    return;
+uint32_t Correlator::CountMatchingBits(int32_t candidate) const {
+  const uint32_t num_words = size_ >> 5;
+  const uint32_t offset_bits = candidate & 0x1f;
+  const uint32_t* source = &source_[0];
+  const uint32_t* destination = &destination_[candidate >> 5];
+  const uint32_t width = sizeof(u32xN) / sizeof(uint32_t);
+  
+  // The words of the destination are realigned on those of the source. When
+  // they are already aligned, shifting the next word by 32 bits would be
+  // undefined.
+  u32xN count_v = { 0 };
+  uint32_t i = 0;
+  if (offset_bits == 0) {
+    for (; i + width <= num_words; i += width) {
+      u32xN source_bits = SimdLoad<u32xN>(&source[i]);
+      u32xN destination_bits = SimdLoad<u32xN>(&destination[i]);
+      count_v += SimdPopCount(~(source_bits ^ destination_bits));
+    }
+  } else {
+    for (; i + width <= num_words; i += width) {
+      u32xN source_bits = SimdLoad<u32xN>(&source[i]);
+      u32xN destination_bits = \
+          SimdLoad<u32xN>(&destination[i]) << offset_bits |
+          SimdLoad<u32xN>(&destination[i + 1]) >> (32 - offset_bits);
+      count_v += SimdPopCount(~(source_bits ^ destination_bits));
+    }
   }
-  uint32_t num_words = size_ >> 5;
-  uint32_t offset_words = candidate_ >> 5;
-  uint32_t offset_bits = candidate_ & 0x1f;
-  uint32_t* source = &source_[0];
-  uint32_t* destination = &destination_[offset_words];
   
-  uint32_t xcorr = 0;
-  for (uint32_t i = 0; i < num_words; ++i) {
+  uint32_t xcorr = SimdSumInt(count_v);
+  for (; i < num_words; ++i) {
     uint32_t source_bits = source[i];
-    uint32_t destination_bits = 0;
-    destination_bits |= destination[i] << offset_bits;
-    destination_bits |= destination[i + 1] >> (32 - offset_bits);
-    uint32_t count = ~(source_bits ^ destination_bits);
-    count = count - ((count >> 1) & 0x55555555);
-    count = (count & 0x33333333) + ((count >> 2) & 0x33333333);
-    count = (((count + (count >> 4)) & 0xf0f0f0f) * 0x1010101) >> 24;
-    xcorr += count;
+    uint32_t destination_bits = destination[i] << offset_bits;
+    if (offset_bits) {
+      destination_bits |= destination[i + 1] >> (32 - offset_bits);
+    }
+    xcorr += SimdPopCount(~(source_bits ^ destination_bits));
   }
-  if (xcorr > best_score_) {
-    best_match_ = candidate_;
-    best_score_ = xcorr;
+  return xcorr;
+}
+
+void Correlator::EvaluateSomeSignCandidates() {
+  int32_t end = min(candidate_ + (size_ >> 2) + 16, size_);
+  for (; candidate_ < end; ++candidate_) {
+    uint32_t xcorr = CountMatchingBits(candidate_);
+    if (xcorr > best_score_) {
+      best_match_ = candidate_;
+      best_score_ = xcorr;
+    }
   }
-  ++candidate_;
   done_ = candidate_ >= size_;
 }
 
+void Correlator::EvaluateSampleSearchStage() {
+  float* source = fft_source_;
+  float* destination = fft_destination_;
+  float* product = fft_product_;
+  
+  switch (stage_) {
+    case SAMPLE_SEARCH_ENERGY:
+      {
+        // The correlation is circular: the transform must be long enough for
+        // the source, placed at the last candidate, not to wrap around.
+        fft_size_ = 64;
+        fft_num_passes_ = 6;
+        while ((fft_size_ < static_cast<size_t>(destination_size_) ||
+                fft_size_ < static_cast<size_t>(size_) * 2) &&
+               fft_size_ < kCorrelatorMaxFftSize) {
+          fft_size_ <<= 1;
+          ++fft_num_passes_;
+        }
+        num_candidates_ = min(
+            size_,
+            static_cast<int32_t>(fft_size_) - size_);
+        fill(&source[size_], &source[fft_size_], 0.0f);
+        fill(&destination[destination_size_], &destination[fft_size_], 0.0f);
+        
+        // Energy of the destination under the source, at each candidate.
+        double energy = 0.0;
+        for (int32_t i = 0; i < size_; ++i) {
+          energy += destination[i] * destination[i];
+        }
+        for (int32_t candidate = 0; candidate < num_candidates_; ++candidate) {
+          fft_energy_[candidate] = static_cast<float>(energy);
+          float in = destination[candidate + size_];
+          float out = destination[candidate];
+          energy += in * in - out * out;
+        }
+        stage_ = SAMPLE_SEARCH_SOURCE_TRANSFORM;
+      }
+      break;
+    
+    // The input of a transform is used as its workspace.
+    case SAMPLE_SEARCH_SOURCE_TRANSFORM:
+      if (fft_size_ != FFT::max_size) {
+        fft_.Direct(source, product, fft_num_passes_);
+      } else {
+        fft_.Direct(source, product);
+      }
+      stage_ = SAMPLE_SEARCH_DESTINATION_TRANSFORM;
+      break;
+    
+    case SAMPLE_SEARCH_DESTINATION_TRANSFORM:
+      if (fft_size_ != FFT::max_size) {
+        fft_.Direct(destination, source, fft_num_passes_);
+      } else {
+        fft_.Direct(destination, source);
+      }
+      stage_ = SAMPLE_SEARCH_CORRELATION;
+      break;
+    
+    case SAMPLE_SEARCH_CORRELATION:
+      {
+        // The transforms hold the real parts of the bins in their first half,
+        // and their imaginary parts with the opposite sign in the second. The
+        // correlation is the product of the transform of the destination with
+        // the conjugate of the transform of the source.
+        const float* s = product;
+        const float* d = source;
+        size_t n_2 = fft_size_ >> 1;
+        destination[0] = s[0] * d[0];
+        destination[n_2] = s[n_2] * d[n_2];
+        for (size_t i = 1; i < n_2; ++i) {
+          float sr = s[i];
+          float si = s[n_2 + i];
+          float dr = d[i];
+          float di = d[n_2 + i];
+          destination[i] = sr * dr + si * di;
+          destination[n_2 + i] = sr * di - si * dr;
+        }
+        if (fft_size_ != FFT::max_size) {
+          fft_.Inverse(destination, product, fft_num_passes_);
+        } else {
+          fft_.Inverse(destination, product);
+        }
+        stage_ = SAMPLE_SEARCH_SCORES;
+      }
+      break;
+    
+    case SAMPLE_SEARCH_SCORES:
+      {
+        // Normalized by the energy of the destination, so that the loudest
+        // part of the destination does not always win. The scale of the
+        // inverse transform does not matter.
+        float best_score = 0.0f;
+        for (int32_t candidate = 0; candidate < num_candidates_; ++candidate) {
+          float energy = fft_energy_[candidate];
+          if (energy <= 0.0f) {
+            continue;
+          }
+          float score = product[candidate] / sqrtf(energy);
+          if (score > best_score) {
+            best_match_ = candidate;
+            best_score = score;
+          }
+        }
+        done_ = true;
+      }
+      break;
+  }
+}
+
+void Correlator::EvaluateSomeCandidates() {
+  if (done_) {
+    return;
+  }
+  if (sample_search_) {
+    EvaluateSampleSearchStage();
+  } else {
+    EvaluateSomeSignCandidates();
+  }
+}
+
 void Correlator::StartSearch(
     int32_t size,
     int32_t offset,
@@ -82,6 +245,23 @@ void Correlator::StartSearch(
   best_match_ = 0;
   candidate_ = 0;
   size_ = size;
+  destination_size_ = 0;
+  sample_search_ = false;
+  done_ = false;
+}
+
+void Correlator::StartSampleSearch(
+    int32_t size,
+    int32_t destination_size,
+    int32_t offset,
+    int32_t increment) {
+  offset_ = offset;
+  increment_ = increment;
+  best_match_ = 0;
+  size_ = min(size, static_cast<int32_t>(kCorrelatorMaxFftSize / 2));
+  destination_size_ = destination_size;
+  stage_ = SAMPLE_SEARCH_ENERGY;
+  sample_search_ = true;
   done_ = false;
 }
 
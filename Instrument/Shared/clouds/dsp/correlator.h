@@ -27,57 +27,121 @@
 // Search for stretch/shift splicing points by maximizing correlation.
 // Correlation is computed by XOR-ing the bit sign of samples - this allows
 // 32 samples to be matched in one single XOR operation.
+//
+// Alternatively, the samples themselves can be correlated, at full resolution,
+// with FFTs. Either way, a search is spread over a few calls, so that no
+// block has to pay for all of it.
 
 #ifndef CLOUDS_DSP_CORRELATOR_H_
 #define CLOUDS_DSP_CORRELATOR_H_
 
 #include "stmlib/stmlib.h"
 
+#include "stmlib/fft/shy_fft.h"
+
 namespace clouds {
-  
+
+// Longest destination of a full resolution search, in samples.
+const size_t kCorrelatorMaxFftSize = 8192;
+
+// Source, destination, product and energies of a full resolution search.
+const size_t kCorrelatorFftBufferSize = \
+    kCorrelatorMaxFftSize * 3 + kCorrelatorMaxFftSize / 2;
+
 class Correlator {
  public:
   Correlator() { }
   ~Correlator() { }
   
-  void Init(uint32_t* source, uint32_t* destination);
+  // fft_buffer holds kCorrelatorFftBufferSize floats. Without it, only the
+  // sign bits are correlated.
+  void Init(uint32_t* source, uint32_t* destination, float* fft_buffer);
 
   void StartSearch(int32_t size, int32_t offset, int32_t increment);
   
+  // Full resolution search, among the first size samples of the source
+  // placed at every position of the destination.
+  void StartSampleSearch(
+      int32_t size,
+      int32_t destination_size,
+      int32_t offset,
+      int32_t increment);
+  
   inline int32_t best_match() const {
     return offset_ + (best_match_ * (increment_ >> 4) >> 12);
   }
 
-  inline void EvaluateSomeCandidates() {
-    size_t num_candidates = (size_ >> 2) + 16;
-    while (num_candidates) {
-      EvaluateNextCandidate();
-      --num_candidates;
+  // Evaluates the next slice of the last search: about a quarter of the
+  // candidates of a sign search, or one stage of a full resolution search.
+  // done() is set by the last slice.
+  void EvaluateSomeCandidates();
+  
+  // Evaluates what remains of the last search.
+  inline void EvaluateCandidates() {
+    while (!done_) {
+      EvaluateSomeCandidates();
     }
   }
 
-  void EvaluateNextCandidate();
-
   inline uint32_t* source() { return source_; }
   inline uint32_t* destination() { return destination_; }
-  inline int32_t candidate() { return candidate_; }
+  
+  inline float* source_samples() { return fft_source_; }
+  inline float* destination_samples() { return fft_destination_; }
+  
+  // Takes effect at the next search.
+  inline void set_fft_search(bool fft_search) {
+    fft_search_ = fft_search && fft_source_ != NULL;
+  }
+  
+  inline bool fft_search() const { return fft_search_; }
 
   inline bool done() { return done_; }
   
  private:
+  typedef stmlib::ShyFFT<
+      float,
+      kCorrelatorMaxFftSize,
+      stmlib::RotationPhasor> FFT;
+  
+  // Stages of a full resolution search, one per call.
+  enum SampleSearchStage {
+    SAMPLE_SEARCH_ENERGY,
+    SAMPLE_SEARCH_SOURCE_TRANSFORM,
+    SAMPLE_SEARCH_DESTINATION_TRANSFORM,
+    SAMPLE_SEARCH_CORRELATION,
+    SAMPLE_SEARCH_SCORES
+  };
+  
+  uint32_t CountMatchingBits(int32_t candidate) const;
+  void EvaluateSomeSignCandidates();
+  void EvaluateSampleSearchStage();
+  
   uint32_t* source_;
   uint32_t* destination_;
   
+  float* fft_source_;
+  float* fft_destination_;
+  float* fft_product_;
+  float* fft_energy_;
+  FFT fft_;
+  bool fft_search_;
+  bool sample_search_;
+  
   int32_t offset_;
   int32_t increment_;
   int32_t size_;
+  int32_t destination_size_;
+  
   int32_t candidate_;
+  SampleSearchStage stage_;
+  size_t fft_size_;
+  size_t fft_num_passes_;
+  int32_t num_candidates_;
 
   uint32_t best_score_;
   int32_t best_match_;
   
-  int32_t trace_;
-  
   bool done_;
   
   DISALLOW_COPY_AND_ASSIGN(Correlator);
@@ -31,7 +31,7 @@
 
 #include "stmlib/stmlib.h"
 
-#include "clouds/dsp/fx/fx_engine.h"
+#include "stmlib/dsp/fx_engine.h"
 
 namespace clouds {
 
@@ -45,6 +45,17 @@ class Diffuser {
   }
   
   void Process(FloatFrame* in_out, size_t size) {
+    size_t i = 0;
+    for (; i + stmlib::kSimdWidth <= size; i += stmlib::kSimdWidth) {
+      Process<stmlib::f32xN>(&in_out[i]);
+    }
+    for (; i < size; ++i) {
+      Process<float>(&in_out[i]);
+    }
+  }
+  
+  template<typename F>
+  inline void Process(FloatFrame* in_out) {
     typedef E::Reserve<126,
       E::Reserve<180,
       E::Reserve<269,
@@ -61,37 +72,44 @@ class Diffuser {
     E::DelayLine<Memory, 5> apr2;
     E::DelayLine<Memory, 6> apr3;
     E::DelayLine<Memory, 7> apr4;
-    E::Context c;
+    E::Context<F> c;
     const float kap = 0.625f;
-    while (size--) {
-      engine_.Start(&c);
-      
-      float wet = 0.0f;
-      c.Read(in_out->l);
-      c.Read(apl1 TAIL, kap);
-      c.WriteAllPass(apl1, -kap);
-      c.Read(apl2 TAIL, kap);
-      c.WriteAllPass(apl2, -kap);
-      c.Read(apl3 TAIL, kap);
-      c.WriteAllPass(apl3, -kap);
-      c.Read(apl4 TAIL, kap);
-      c.WriteAllPass(apl4, -kap);
-      c.Write(wet, 0.0f);
-      in_out->l += amount_ * (wet - in_out->l);
-      
-      c.Read(in_out->r);
-      c.Read(apr1 TAIL, kap);
-      c.WriteAllPass(apr1, -kap);
-      c.Read(apr2 TAIL, kap);
-      c.WriteAllPass(apr2, -kap);
-      c.Read(apr3 TAIL, kap);
-      c.WriteAllPass(apr3, -kap);
-      c.Read(apr4 TAIL, kap);
-      c.WriteAllPass(apr4, -kap);
-      c.Write(wet, 0.0f);
-      in_out->r += amount_ * (wet - in_out->r);
-
-      ++in_out;
+    F left;
+    F right;
+    for (size_t k = 0; k < c.width; ++k) {
+      stmlib::SimdSetLane(&left, k, in_out[k].l);
+      stmlib::SimdSetLane(&right, k, in_out[k].r);
+    }
+    engine_.Start(&c);
+    
+    F wet;
+    c.Read(left);
+    c.Read(apl1 TAIL, kap);
+    c.WriteAllPass(apl1, -kap);
+    c.Read(apl2 TAIL, kap);
+    c.WriteAllPass(apl2, -kap);
+    c.Read(apl3 TAIL, kap);
+    c.WriteAllPass(apl3, -kap);
+    c.Read(apl4 TAIL, kap);
+    c.WriteAllPass(apl4, -kap);
+    c.Write(wet, 0.0f);
+    left += amount_ * (wet - left);
+    
+    c.Read(right);
+    c.Read(apr1 TAIL, kap);
+    c.WriteAllPass(apr1, -kap);
+    c.Read(apr2 TAIL, kap);
+    c.WriteAllPass(apr2, -kap);
+    c.Read(apr3 TAIL, kap);
+    c.WriteAllPass(apr3, -kap);
+    c.Read(apr4 TAIL, kap);
+    c.WriteAllPass(apr4, -kap);
+    c.Write(wet, 0.0f);
+    right += amount_ * (wet - right);
+    
+    for (size_t k = 0; k < c.width; ++k) {
+      in_out[k].l = stmlib::SimdLane(left, k);
+      in_out[k].r = stmlib::SimdLane(right, k);
     }
   }
   
@@ -100,7 +118,7 @@ class Diffuser {
   }
   
  private:
-  typedef FxEngine<2048, FORMAT_32_BIT> E;
+  typedef stmlib::FxEngine<4096, stmlib::FORMAT_32_BIT> E;
   E engine_;
   
   float amount_;
@@ -32,7 +32,7 @@
 #include "stmlib/stmlib.h"
 
 #include "clouds/dsp/frame.h"
-#include "clouds/dsp/fx/fx_engine.h"
+#include "stmlib/dsp/fx_engine.h"
 
 namespace clouds {
 
@@ -52,44 +52,65 @@ class PitchShifter {
   }
 
   inline void Process(FloatFrame* input_output, size_t size) {
-    while (size--) {
-      Process(input_output);
-      ++input_output;
+    size_t i = 0;
+    for (; i + stmlib::kSimdWidth <= size; i += stmlib::kSimdWidth) {
+      Process<stmlib::f32xN>(&input_output[i]);
+    }
+    for (; i < size; ++i) {
+      Process<float>(&input_output[i]);
     }
   }
   
-  void Process(FloatFrame* input_output) {
+  template<typename F>
+  inline void Process(FloatFrame* input_output) {
     typedef E::Reserve<2047, E::Reserve<2047> > Memory;
     E::DelayLine<Memory, 0> left;
     E::DelayLine<Memory, 1> right;
-    E::Context c;
+    E::Context<F> c;
     engine_.Start(&c);
     
-    phase_ += (1.0f - ratio_) / size_;
-    if (phase_ >= 1.0f) {
-      phase_ -= 1.0f;
-    }
-    if (phase_ <= 0.0f) {
-      phase_ += 1.0f;
-    }
-    float tri = 2.0f * (phase_ >= 0.5f ? 1.0f - phase_ : phase_);
-    float phase = phase_ * size_;
-    float half = phase + size_ * 0.5f;
-    if (half >= size_) {
-      half -= size_;
+    F tri;
+    F phase;
+    F half;
+    F l;
+    F r;
+    for (size_t k = 0; k < c.width; ++k) {
+      phase_ += (1.0f - ratio_) / size_;
+      if (phase_ >= 1.0f) {
+        phase_ -= 1.0f;
+      }
+      if (phase_ <= 0.0f) {
+        phase_ += 1.0f;
+      }
+      float lane_phase = phase_ * size_;
+      float lane_half = lane_phase + size_ * 0.5f;
+      if (lane_half >= size_) {
+        lane_half -= size_;
+      }
+      stmlib::SimdSetLane(
+          &tri, k, 2.0f * (phase_ >= 0.5f ? 1.0f - phase_ : phase_));
+      stmlib::SimdSetLane(&phase, k, lane_phase);
+      stmlib::SimdSetLane(&half, k, lane_half);
+      stmlib::SimdSetLane(&l, k, input_output[k].l);
+      stmlib::SimdSetLane(&r, k, input_output[k].r);
     }
     
-    c.Read(input_output->l, 1.0f);
+    c.Read(l, 1.0f);
     c.Write(left, 0.0f);
     c.Interpolate(left, phase, tri);
     c.Interpolate(left, half, 1.0f - tri);
-    c.Write(input_output->l, 0.0f);
+    c.Write(l, 0.0f);
 
-    c.Read(input_output->r, 1.0f);
+    c.Read(r, 1.0f);
     c.Write(right, 0.0f);
     c.Interpolate(right, phase, tri);
     c.Interpolate(right, half, 1.0f - tri);
-    c.Write(input_output->r, 0.0f);
+    c.Write(r, 0.0f);
+    
+    for (size_t k = 0; k < c.width; ++k) {
+      input_output[k].l = stmlib::SimdLane(l, k);
+      input_output[k].r = stmlib::SimdLane(r, k);
+    }
   }
   
   inline void set_ratio(float ratio) {
@@ -102,7 +123,7 @@ class PitchShifter {
   }
   
  private:
-  typedef FxEngine<4096, FORMAT_16_BIT> E;
+  typedef stmlib::FxEngine<8192, stmlib::FORMAT_16_BIT> E;
   E engine_;
   float phase_;
   float ratio_;
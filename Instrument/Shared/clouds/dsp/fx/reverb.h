@@ -31,7 +31,7 @@
 
 #include "stmlib/stmlib.h"
 
-#include "clouds/dsp/fx/fx_engine.h"
+#include "stmlib/dsp/fx_engine.h"
 
 namespace clouds {
 
@@ -42,13 +42,24 @@ class Reverb {
   
   void Init(uint16_t* buffer) {
     engine_.Init(buffer);
-    engine_.SetLFOFrequency(LFO_1, 0.5f / 32000.0f);
-    engine_.SetLFOFrequency(LFO_2, 0.3f / 32000.0f);
+    engine_.SetLFOFrequency(stmlib::LFO_1, 0.5f / 32000.0f);
+    engine_.SetLFOFrequency(stmlib::LFO_2, 0.3f / 32000.0f);
     lp_ = 0.7f;
     diffusion_ = 0.625f;
   }
   
   void Process(FloatFrame* in_out, size_t size) {
+    size_t i = 0;
+    for (; i + stmlib::kSimdWidth <= size; i += stmlib::kSimdWidth) {
+      Process<stmlib::f32xN>(&in_out[i]);
+    }
+    for (; i < size; ++i) {
+      Process<float>(&in_out[i]);
+    }
+  }
+  
+  template<typename F>
+  inline void Process(FloatFrame* in_out) {
     // This is the Griesinger topology described in the Dattorro paper
     // (4 AP diffusers on the input, then a loop of 2x 2AP+1Delay).
     // Modulation is applied in the loop of the first diffuser AP for additional
@@ -73,7 +84,8 @@ class Reverb {
     E::DelayLine<Memory, 7> dap2a;
     E::DelayLine<Memory, 8> dap2b;
     E::DelayLine<Memory, 9> del2;
-    E::Context c;
+    E::Context<F> c;
+    engine_.Start(&c);
 
     const float kap = diffusion_;
     const float klp = lp_;
@@ -81,62 +93,63 @@ class Reverb {
     const float amount = amount_;
     const float gain = input_gain_;
 
-    float lp_1 = lp_decay_1_;
-    float lp_2 = lp_decay_2_;
+    F left;
+    F right;
+    for (size_t k = 0; k < c.width; ++k) {
+      stmlib::SimdSetLane(&left, k, in_out[k].l);
+      stmlib::SimdSetLane(&right, k, in_out[k].r);
+    }
 
-    while (size--) {
-      float wet;
-      float apout = 0.0f;
-      engine_.Start(&c);
-      
-      // Smear AP1 inside the loop.
-      c.Interpolate(ap1, 10.0f, LFO_1, 60.0f, 1.0f);
-      c.Write(ap1, 100, 0.0f);
-      
-      c.Read(in_out->l + in_out->r, gain);
+    F wet;
+    F apout;
+    
+    // Smear AP1 inside the loop.
+    c.Interpolate(ap1, 10.0f, stmlib::LFO_1, 60.0f, 1.0f);
+    c.Write(ap1, 100, 0.0f);
+    
+    c.Read(left + right, gain);
 
-      // Diffuse through 4 allpasses.
-      c.Read(ap1 TAIL, kap);
-      c.WriteAllPass(ap1, -kap);
-      c.Read(ap2 TAIL, kap);
-      c.WriteAllPass(ap2, -kap);
-      c.Read(ap3 TAIL, kap);
-      c.WriteAllPass(ap3, -kap);
-      c.Read(ap4 TAIL, kap);
-      c.WriteAllPass(ap4, -kap);
-      c.Write(apout);
-      
-      // Main reverb loop.
-      c.Load(apout);
-      c.Interpolate(del2, 4680.0f, LFO_2, 100.0f, krt);
-      c.Lp(lp_1, klp);
-      c.Read(dap1a TAIL, -kap);
-      c.WriteAllPass(dap1a, kap);
-      c.Read(dap1b TAIL, kap);
-      c.WriteAllPass(dap1b, -kap);
-      c.Write(del1, 2.0f);
-      c.Write(wet, 0.0f);
+    // Diffuse through 4 allpasses.
+    c.Read(ap1 TAIL, kap);
+    c.WriteAllPass(ap1, -kap);
+    c.Read(ap2 TAIL, kap);
+    c.WriteAllPass(ap2, -kap);
+    c.Read(ap3 TAIL, kap);
+    c.WriteAllPass(ap3, -kap);
+    c.Read(ap4 TAIL, kap);
+    c.WriteAllPass(ap4, -kap);
+    c.Write(apout);
+    
+    // Main reverb loop.
+    c.Load(apout);
+    c.Interpolate(del2, 4680.0f, stmlib::LFO_2, 100.0f, krt);
+    c.Lp(lp_decay_1_, klp);
+    c.Read(dap1a TAIL, -kap);
+    c.WriteAllPass(dap1a, kap);
+    c.Read(dap1b TAIL, kap);
+    c.WriteAllPass(dap1b, -kap);
+    c.Write(del1, 2.0f);
+    c.Write(wet, 0.0f);
 
-      in_out->l += (wet - in_out->l) * amount;
+    left += (wet - left) * amount;
 
-      c.Load(apout);
-      // c.Interpolate(del1, 4450.0f, LFO_1, 50.0f, krt);
-      c.Read(del1 TAIL, krt);
-      c.Lp(lp_2, klp);
-      c.Read(dap2a TAIL, kap);
-      c.WriteAllPass(dap2a, -kap);
-      c.Read(dap2b TAIL, -kap);
-      c.WriteAllPass(dap2b, kap);
-      c.Write(del2, 2.0f);
-      c.Write(wet, 0.0f);
+    c.Load(apout);
+    // c.Interpolate(del1, 4450.0f, LFO_1, 50.0f, krt);
+    c.Read(del1 TAIL, krt);
+    c.Lp(lp_decay_2_, klp);
+    c.Read(dap2a TAIL, kap);
+    c.WriteAllPass(dap2a, -kap);
+    c.Read(dap2b TAIL, -kap);
+    c.WriteAllPass(dap2b, kap);
+    c.Write(del2, 2.0f);
+    c.Write(wet, 0.0f);
 
-      in_out->r += (wet - in_out->r) * amount;
-      
-      ++in_out;
-    }
+    right += (wet - right) * amount;
     
-    lp_decay_1_ = lp_1;
-    lp_decay_2_ = lp_2;
+    for (size_t k = 0; k < c.width; ++k) {
+      in_out[k].l = stmlib::SimdLane(left, k);
+      in_out[k].r = stmlib::SimdLane(right, k);
+    }
   }
   
   inline void set_amount(float amount) {
@@ -160,7 +173,7 @@ class Reverb {
   }
   
  private:
-  typedef FxEngine<16384, FORMAT_12_BIT> E;
+  typedef stmlib::FxEngine<32768, stmlib::FORMAT_12_BIT> E;
   E engine_;
   
   float amount_;
@@ -169,7 +169,14 @@ class Grain {
       }
       phase += phase_increment;
     }
-    phase_ = phase;
+    // The integral part of the phase is moved to the start position after
+    // each block, so that the 16.16 phase does not overflow when a long grain
+    // is played at a high pitch from a large buffer.
+    first_sample_ = first_sample + (phase >> 16);
+    if (first_sample_ >= buffer->size()) {
+      first_sample_ -= buffer->size();
+    }
+    phase_ = phase & 0xffff;
   }
   
   inline bool active() { return active_; }
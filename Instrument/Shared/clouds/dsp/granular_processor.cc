@@ -50,16 +50,23 @@ void GranularProcessor::Init(
   
   num_channels_ = 2;
   low_fidelity_ = false;
+  float_storage_ = false;
+  fft_alignment_ = false;
   bypass_ = false;
   
   src_down_.Init();
   src_up_.Init();
+  random_.Init(0);
   
   ResetFilters();
   
   previous_playback_mode_ = PLAYBACK_MODE_LAST;
   reset_buffers_ = true;
   dry_wet_ = 0.0f;
+  
+  phase_vocoder_ready_ = false;
+  phase_vocoder_lock_ = false;
+  asynchronous_buffering_ = false;
 }
 
 void GranularProcessor::ResetFilters() {
@@ -82,9 +89,12 @@ void GranularProcessor::ProcessGranular(
       if (resolution() == 8) {
         buffer_8_[i].WriteFade(
             &input_samples[i], size, 2, !parameters_.freeze);
-      } else {
+      } else if (resolution() == 16) {
         buffer_16_[i].WriteFade(
             &input_samples[i], size, 2, !parameters_.freeze);
+      } else {
+        buffer_32_[i].WriteFade(
+            &input_samples[i], size, 2, !parameters_.freeze);
       }
     }
   }
@@ -106,24 +116,30 @@ void GranularProcessor::ProcessGranular(
   
       if (resolution() == 8) {
         player_.Play(buffer_8_, parameters_, &output[0].l, size);
-      } else {
+      } else if (resolution() == 16) {
         player_.Play(buffer_16_, parameters_, &output[0].l, size);
+      } else {
+        player_.Play(buffer_32_, parameters_, &output[0].l, size);
       }
       break;
 
     case PLAYBACK_MODE_STRETCH:
       if (resolution() == 8) {
         ws_player_.Play(buffer_8_, parameters_, &output[0].l, size);
-      } else {
+      } else if (resolution() == 16) {
         ws_player_.Play(buffer_16_, parameters_, &output[0].l, size);
+      } else {
+        ws_player_.Play(buffer_32_, parameters_, &output[0].l, size);
       }
       break;
 
     case PLAYBACK_MODE_LOOPING_DELAY:
       if (resolution() == 8) {
         looper_.Play(buffer_8_, parameters_, &output[0].l, size);
-      } else {
+      } else if (resolution() == 16) {
         looper_.Play(buffer_16_, parameters_, &output[0].l, size);
+      } else {
+        looper_.Play(buffer_32_, parameters_, &output[0].l, size);
       }
       break;
 
@@ -285,11 +301,17 @@ void GranularProcessor::Process(
 }
 
 void GranularProcessor::PreparePersistentData() {
-  persistent_state_.write_head[0] = low_fidelity_ ?
-      buffer_8_[0].head() : buffer_16_[0].head();
-  persistent_state_.write_head[1] = low_fidelity_ ?
-      buffer_8_[1].head() : buffer_16_[1].head();
+  for (int32_t i = 0; i < 2; ++i) {
+    if (resolution() == 8) {
+      persistent_state_.write_head[i] = buffer_8_[i].head();
+    } else if (resolution() == 16) {
+      persistent_state_.write_head[i] = buffer_16_[i].head();
+    } else {
+      persistent_state_.write_head[i] = buffer_32_[i].head();
+    }
+  }
   persistent_state_.quality = quality();
+  persistent_state_.float_storage = float_storage_;
   persistent_state_.spectral = playback_mode() == PLAYBACK_MODE_SPECTRAL;
 }
 
@@ -343,6 +365,7 @@ bool GranularProcessor::LoadPersistentData(const uint32_t* data) {
             : PLAYBACK_MODE_GRANULAR);
       }
       set_quality(persistent_state_.quality);
+      set_float_storage(persistent_state_.float_storage);
 
       // We can force a switch to this mode, and once everything has been
       // initialized for this mode, we continue with the loop to copy the
@@ -353,12 +376,14 @@ bool GranularProcessor::LoadPersistentData(const uint32_t* data) {
   }
   
   // We can finally reset the position of the write heads.
-  if (low_fidelity_) {
-    buffer_8_[0].Resync(persistent_state_.write_head[0]);
-    buffer_8_[1].Resync(persistent_state_.write_head[1]);
-  } else {
-    buffer_16_[0].Resync(persistent_state_.write_head[0]);
-    buffer_16_[1].Resync(persistent_state_.write_head[1]);
+  for (int32_t i = 0; i < 2; ++i) {
+    if (resolution() == 8) {
+      buffer_8_[i].Resync(persistent_state_.write_head[i]);
+    } else if (resolution() == 16) {
+      buffer_16_[i].Resync(persistent_state_.write_head[i]);
+    } else {
+      buffer_32_[i].Resync(persistent_state_.write_head[i]);
+    }
   }
   parameters_.freeze = true;
   silence_ = false;
@@ -382,6 +407,14 @@ void GranularProcessor::Prepare() {
   }
   
   if (reset_buffers_ || (playback_mode_changed && !benign_change)) {
+    // If a spectral frame is being transformed by the worker thread, the
+    // re-allocation is retried at the next block. Process() outputs silence
+    // in the meantime.
+    if (!TryLockPhaseVocoder()) {
+      return;
+    }
+    phase_vocoder_ready_ = false;
+    
     void* buffer[2];
     size_t buffer_size[2];
     void* workspace;
@@ -408,22 +441,24 @@ void GranularProcessor::Prepare() {
     float sr = sample_rate();
 
     BufferAllocator allocator(workspace, workspace_size);
-    diffuser_.Init(allocator.Allocate<float>(2048));
-    reverb_.Init(allocator.Allocate<uint16_t>(16384));
+    diffuser_.Init(diffuser_buffer_);
+    reverb_.Init(reverb_buffer_);
     
     size_t correlator_block_size = (kMaxWSOLASize / 32) + 2;
     uint32_t* correlator_data = allocator.Allocate<uint32_t>(
         correlator_block_size * 3);
     correlator_.Init(
         &correlator_data[0],
-        &correlator_data[correlator_block_size]);
-    pitch_shifter_.Init((uint16_t*)correlator_data);
+        &correlator_data[correlator_block_size],
+        correlator_fft_buffer_);
+    pitch_shifter_.Init(pitch_shifter_buffer_);
     
     if (playback_mode_ == PLAYBACK_MODE_SPECTRAL) {
       phase_vocoder_.Init(
           buffer, buffer_size,
           lut_sine_window_4096, 4096,
-          num_channels_, resolution(), sr);
+          num_channels_, resolution(), sr, &random_);
+      phase_vocoder_ready_ = true;
     } else {
       for (int32_t i = 0; i < num_channels_; ++i) {
         if (resolution() == 8) {
@@ -431,33 +466,57 @@ void GranularProcessor::Prepare() {
               buffer[i],
               (buffer_size[i]),
               tail_buffer_[i]);
-        } else {
+        } else if (resolution() == 16) {
           buffer_16_[i].Init(
               buffer[i],
               ((buffer_size[i]) >> 1),
               tail_buffer_[i]);
+        } else {
+          buffer_32_[i].Init(
+              buffer[i],
+              ((buffer_size[i]) >> 2),
+              tail_buffer_[i]);
         }
       }
       int32_t num_grains = (num_channels_ == 1 ? 40 : 32) * \
           (low_fidelity_ ? 23 : 16) >> 4;
-      player_.Init(num_channels_, num_grains);
+      player_.Init(num_channels_, num_grains, &random_);
       ws_player_.Init(&correlator_, num_channels_);
       looper_.Init(num_channels_);
     }
+    UnlockPhaseVocoder();
     reset_buffers_ = false;
     previous_playback_mode_ = playback_mode_;
   }
   
   if (playback_mode_ == PLAYBACK_MODE_SPECTRAL) {
-    phase_vocoder_.Buffer();
+    if (!asynchronous_buffering_ && TryLockPhaseVocoder()) {
+      phase_vocoder_.Buffer();
+      UnlockPhaseVocoder();
+    }
   } else if (playback_mode_ == PLAYBACK_MODE_STRETCH) {
+    correlator_.set_fft_search(fft_alignment_);
     if (resolution() == 8) {
       ws_player_.LoadCorrelator(buffer_8_);
-    } else {
+    } else if (resolution() == 16) {
       ws_player_.LoadCorrelator(buffer_16_);
+    } else {
+      ws_player_.LoadCorrelator(buffer_32_);
     }
     correlator_.EvaluateSomeCandidates();
   }
 }
 
+bool GranularProcessor::BufferSpectralFrames() {
+  if (!TryLockPhaseVocoder()) {
+    return false;
+  }
+  bool buffered = false;
+  if (phase_vocoder_ready_ && asynchronous_buffering_) {
+    buffered = phase_vocoder_.Buffer();
+  }
+  UnlockPhaseVocoder();
+  return buffered;
+}
+
 }  // namespace clouds
@@ -31,6 +31,9 @@
 
 #include "stmlib/stmlib.h"
 #include "stmlib/dsp/filter.h"
+#include "stmlib/utils/random_stream.h"
+
+#include <atomic>
 
 #include "clouds/dsp/correlator.h"
 #include "clouds/dsp/frame.h"
@@ -61,6 +64,7 @@ struct PersistentState {
   int32_t write_head[2];
   uint8_t quality;
   uint8_t spectral;
+  uint8_t float_storage;
 };
 
 // Data block as saved in one of the 4 sample memories.
@@ -88,6 +92,32 @@ class GranularProcessor {
   void Process(FloatFrame* input, FloatFrame* output, size_t size);
   void Prepare();
   
+  // On the module, the phase vocoder frames were transformed in the main
+  // loop, while Process() ran in the audio interrupt. In asynchronous mode,
+  // Prepare() leaves this work to BufferSpectralFrames(), which is meant to
+  // be called repeatedly from a worker thread. Returns true if a frame was
+  // transformed.
+  bool BufferSpectralFrames();
+  
+  inline void set_asynchronous_buffering(bool asynchronous_buffering) {
+    asynchronous_buffering_ = asynchronous_buffering;
+  }
+  
+  inline bool asynchronous_buffering() const {
+    return asynchronous_buffering_;
+  }
+  
+  // In stretch mode, aligns the windows by correlating the recorded samples
+  // at full resolution, rather than their signs.
+  inline void set_fft_alignment(bool fft_alignment) {
+    fft_alignment_ = fft_alignment;
+  }
+  
+  // Number of spectral frames that missed their deadline.
+  inline size_t late_frames() const {
+    return phase_vocoder_ready_ ? phase_vocoder_.late_frames() : 0;
+  }
+  
   inline Parameters* mutable_parameters() {
     return &parameters_;
   }
@@ -145,6 +175,15 @@ class GranularProcessor {
     low_fidelity_ = low_fidelity;
   }
   
+  // Records in floating point instead of 16-bit in the high fidelity
+  // qualities. The low fidelity qualities keep their 8-bit mu-law storage.
+  inline void set_float_storage(bool float_storage) {
+    reset_buffers_ = reset_buffers_ || float_storage != float_storage_;
+    float_storage_ = float_storage;
+  }
+  
+  inline bool float_storage() const { return float_storage_; }
+  
   inline int32_t quality() const {
     int32_t quality = 0;
     if (num_channels_ == 1) quality |= 1;
@@ -158,7 +197,7 @@ class GranularProcessor {
 
  private:
   inline int32_t resolution() const {
-    return low_fidelity_ ? 8 : 16;
+    return low_fidelity_ ? 8 : (float_storage_ ? 32 : 16);
   }
 
   inline float sample_rate() const {
@@ -167,12 +206,24 @@ class GranularProcessor {
   }
      
   void ResetFilters();
+  
+  // Guards the phase vocoder against being re-allocated while a frame is
+  // being transformed. Neither side ever waits for the other.
+  inline bool TryLockPhaseVocoder() {
+    return !phase_vocoder_lock_.exchange(true, std::memory_order_acquire);
+  }
+  
+  inline void UnlockPhaseVocoder() {
+    phase_vocoder_lock_.store(false, std::memory_order_release);
+  }
   void ProcessGranular(FloatFrame* input, FloatFrame* output, size_t size);
 
   PlaybackMode playback_mode_;
   PlaybackMode previous_playback_mode_;
   int32_t num_channels_;
   bool low_fidelity_;
+  bool float_storage_;
+  bool fft_alignment_;
   
   bool silence_;
   bool bypass_;
@@ -184,21 +235,32 @@ class GranularProcessor {
   size_t buffer_size_[2];
   
   Correlator correlator_;
+  stmlib::RandomStream random_;
   
   GranularSamplePlayer player_;
   WSOLASamplePlayer ws_player_;
   LoopingSamplePlayer looper_;
   PhaseVocoder phase_vocoder_;
+  bool phase_vocoder_ready_;
+  std::atomic<bool> phase_vocoder_lock_;
+  std::atomic<bool> asynchronous_buffering_;
   
   Diffuser diffuser_;
   Reverb reverb_;
   PitchShifter pitch_shifter_;
+  // With their delay lines laid out for SIMD processing, the effects no
+  // longer fit in the workspace left by the recording buffers.
+  float diffuser_buffer_[4096];
+  uint16_t reverb_buffer_[32768];
+  uint16_t pitch_shifter_buffer_[8192];
+  float correlator_fft_buffer_[kCorrelatorFftBufferSize];
   stmlib::Svf fb_filter_[2];
   stmlib::Svf hp_filter_[2];
   stmlib::Svf lp_filter_[2];
   
   AudioBuffer<RESOLUTION_8_BIT_MU_LAW> buffer_8_[2];
   AudioBuffer<RESOLUTION_16_BIT> buffer_16_[2];
+  AudioBuffer<RESOLUTION_32_BIT_FLOAT> buffer_32_[2];
   
   FloatFrame in_[kMaxBlockSize];
   FloatFrame in_downsampled_[kMaxBlockSize / kDownsamplingFactor];
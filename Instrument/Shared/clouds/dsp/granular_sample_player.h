@@ -35,7 +35,7 @@
 
 #include "stmlib/dsp/atan.h"
 #include "stmlib/dsp/units.h"
-#include "stmlib/utils/random.h"
+#include "stmlib/utils/random_stream.h"
 
 #include "clouds/dsp/audio_buffer.h"
 #include "clouds/dsp/frame.h"
@@ -55,7 +55,11 @@ class GranularSamplePlayer {
   GranularSamplePlayer() { }
   ~GranularSamplePlayer() { }
   
-  void Init(int32_t num_channels, int32_t max_num_grains) {
+  void Init(
+      int32_t num_channels,
+      int32_t max_num_grains,
+      stmlib::RandomStream* random) {
+    random_ = random;
     max_num_grains_ = max_num_grains;
     num_midfi_grains_ = 3 * max_num_grains / 4;
     gain_normalization_ = 1.0f;
@@ -90,7 +94,7 @@ class GranularSamplePlayer {
     bool seed_trigger = parameters.trigger;
     for (size_t t = 0; t < size; ++t) {
       grain_rate_phasor_ += 1.0f;
-      bool seed_probabilistic = Random::GetFloat() < p
+      bool seed_probabilistic = random_->GetFloat() < p
           && target_num_grains > num_grains_;
       bool seed_deterministic = grain_rate_phasor_ >= space_between_grains;
       bool seed = seed_probabilistic || seed_deterministic || seed_trigger;
@@ -188,7 +192,7 @@ class GranularSamplePlayer {
     float grain_size = Interpolate(lut_grain_size, parameters.size, 256.0f);
     float pitch_ratio = SemitonesToRatio(pitch);
     float inv_pitch_ratio = SemitonesToRatio(-pitch);
-    float pan = 0.5f + parameters.stereo_spread * (Random::GetFloat() - 0.5f);
+    float pan = 0.5f + parameters.stereo_spread * (random_->GetFloat() - 0.5f);
     float gain_l, gain_r;
     if (num_channels_ == 1) {
       gain_l = Interpolate(lut_sin, pan, 256.0f);
@@ -235,6 +239,8 @@ class GranularSamplePlayer {
     ONE_POLE(grain_size_hint_, grain_size, 0.1f);
   }
   
+  stmlib::RandomStream* random_;
+  
   int32_t max_num_grains_;
   int32_t num_midfi_grains_;
   int32_t num_channels_;
@@ -89,22 +89,25 @@ class LoopingSamplePlayer {
 
     if (!parameters.freeze) {
       while (size--) {
-        float target_delay = parameters.position * max_delay;
+        double target_delay = parameters.position * max_delay;
         if (synchronized_) {
           target_delay = tap_delay_;
         }
-        float error = (target_delay - current_delay_);
-        float delay = current_delay_ + 0.00005f * error;
+        double error = (target_delay - current_delay_);
+        double delay = current_delay_ + 0.00005f * error;
         current_delay_ = delay;
-        int32_t delay_int = (buffer->head() - 4 - size + buffer->size()) << 12;
-        delay_int -= static_cast<int32_t>(delay * 4096.0f);
+        int64_t delay_int = static_cast<int64_t>(
+            buffer->head() - 4 - size + buffer->size()) << 12;
+        delay_int -= static_cast<int64_t>(delay * 4096.0);
+        int32_t integral = static_cast<int32_t>(delay_int >> 12);
+        uint16_t fractional = static_cast<uint16_t>(delay_int << 4);
         
-        float l = buffer[0].ReadHermite((delay_int >> 12), delay_int << 4);
+        float l = buffer[0].ReadHermite(integral, fractional);
         if (num_channels_ == 1) {
           *out++ = l;
           *out++ = l;
         } else if (num_channels_ == 2) {
-          float r = buffer[1].ReadHermite((delay_int >> 12), delay_int << 4);
+          float r = buffer[1].ReadHermite(integral, fractional);
           *out++ = l;
           *out++ = r;
         }
@@ -145,33 +148,38 @@ class LoopingSamplePlayer {
         
         float gain = 1.0f;
         if (tail_duration_ != 0.0f) {
-          gain = phase_ / tail_duration_;
+          gain = static_cast<float>(phase_ / tail_duration_);
           CONSTRAIN(gain, 0.0f, 1.0f);
         }
-        int32_t delay_int = (buffer->head() - 4 + buffer->size()) << 12;
-        int32_t position = delay_int - static_cast<int32_t>(
-              (loop_duration_ - phase_ + loop_point_) * 4096.0f);
-        float l = buffer[0].ReadHermite((position >> 12), position << 4);
+        int64_t delay_int = static_cast<int64_t>(
+            buffer->head() - 4 + buffer->size()) << 12;
+        int64_t position = delay_int - static_cast<int64_t>(
+              (loop_duration_ - phase_ + loop_point_) * 4096.0);
+        int32_t integral = static_cast<int32_t>(position >> 12);
+        uint16_t fractional = static_cast<uint16_t>(position << 4);
+        float l = buffer[0].ReadHermite(integral, fractional);
         if (num_channels_ == 1) {
           out[0] = l * gain;
           out[1] = l * gain;
         } else if (num_channels_ == 2) {
-          float r = buffer[1].ReadHermite((position >> 12), position << 4);
+          float r = buffer[1].ReadHermite(integral, fractional);
           out[0] = l * gain;
           out[1] = r * gain;
         }
         
         if (gain != 1.0f) {
           gain = 1.0f - gain;
-          int32_t position = delay_int - static_cast<int32_t>(
-                (-phase_ + tail_start_) * 4096.0f);
+          int64_t position = delay_int - static_cast<int64_t>(
+                (-phase_ + tail_start_) * 4096.0);
+          int32_t integral = static_cast<int32_t>(position >> 12);
+          uint16_t fractional = static_cast<uint16_t>(position << 4);
         
-          float l = buffer[0].ReadHermite((position >> 12), position << 4);
+          float l = buffer[0].ReadHermite(integral, fractional);
           if (num_channels_ == 1) {
             out[0] += l * gain;
             out[1] += l * gain;
           } else if (num_channels_ == 2) {
-            float r = buffer[1].ReadHermite((position >> 12), position << 4);
+            float r = buffer[1].ReadHermite(integral, fractional);
             out[0] += l * gain;
             out[1] += r * gain;
           }
@@ -182,14 +190,16 @@ class LoopingSamplePlayer {
   }
   
  private:
-  float phase_;
-  float current_delay_;
+  // The positions are counted in samples from the write head. In single
+  // precision, they would lose their fractional part in large buffers.
+  double phase_;
+  double current_delay_;
 
-  float loop_point_;
-  float loop_duration_;
-  float tail_start_;
+  double loop_point_;
+  double loop_duration_;
+  double tail_start_;
   float tail_duration_;
-  float loop_reset_;
+  double loop_reset_;
   
   bool synchronized_;
   
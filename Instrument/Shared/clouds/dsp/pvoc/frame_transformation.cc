@@ -32,7 +32,6 @@
 
 #include "stmlib/dsp/atan.h"
 #include "stmlib/dsp/units.h"
-#include "stmlib/utils/random.h"
 
 #include "clouds/dsp/frame.h"
 #include "clouds/dsp/parameters.h"
@@ -45,7 +44,9 @@ using namespace stmlib;
 void FrameTransformation::Init(
     float* buffer,
     int32_t fft_size,
-    int32_t num_textures) {
+    int32_t num_textures,
+    RandomStream* random) {
+  random_ = random;
   fft_size_ = fft_size;
   size_ = (fft_size >> 1) - kHighFrequencyTruncation;
   
@@ -98,7 +99,7 @@ void FrameTransformation::Process(
   if (!glitch) {
     // Decide on which glitch algorithm will be used next time... if glitch
     // is enabled on the next frame!
-    glitch_algorithm_ = stmlib::Random::GetSample() & 3;
+    glitch_algorithm_ = random_->GetSample() & 3;
   }
 
   ifft_in[0] = 0.0f;
@@ -133,7 +134,7 @@ void FrameTransformation::SetPhases(
   int32_t amount = static_cast<int32_t>(r * 32768.0f);
   for (int32_t i = 0; i < size_; ++i) {
     synthesis_phase[i] += \
-        static_cast<int32_t>(stmlib::Random::GetSample()) * amount >> 14;
+        static_cast<int32_t>(random_->GetSample()) * amount >> 14;
   }
 }
 
@@ -159,7 +160,7 @@ void FrameTransformation::AddGlitch(float* xf_polar) {
         // Create trails
         float held = 0.0;
         for (int32_t i = 0; i < size_; ++i) {
-          if ((stmlib::Random::GetSample() & 15) == 0) {
+          if ((random_->GetSample() & 15) == 0) {
             held = x[i];
           }
           x[i] = held;
@@ -171,7 +172,7 @@ void FrameTransformation::AddGlitch(float* xf_polar) {
     case 1:
       // Spectral shift up with aliasing.
       {
-        float factor = 1.0f + (stmlib::Random::GetSample() & 7) / 4.0f;
+        float factor = 1.0f + (random_->GetSample() & 7) / 4.0f;
         float source = 0.0f;
         for (int32_t i = 0; i < size_; ++i) {
           source += factor;
@@ -193,7 +194,7 @@ void FrameTransformation::AddGlitch(float* xf_polar) {
       {
         // Nasty high-pass
         for (int32_t i = 0; i < size_; ++i) {
-          uint32_t random = stmlib::Random::GetSample() & 15;
+          uint32_t random = random_->GetSample() & 15;
           if (random == 0) {
             x[i] *= static_cast<float>(i) / 16.0f;
           }
@@ -339,7 +340,7 @@ void FrameTransformation::StoreMagnitudes(
     uint16_t threshold = feedback * 65535.0f;
     for (int32_t i = 0; i < size_; ++i) {
       float x = *xf_polar++;
-      float gain = static_cast<uint16_t>(Random::GetSample()) <= threshold
+      float gain = static_cast<uint16_t>(random_->GetSample()) <= threshold
           ? 1.0f : 0.0f;
       a[i] = Crossfade(a[i], x, gain_a * gain);
       b[i] = Crossfade(b[i], x, gain_b * gain);
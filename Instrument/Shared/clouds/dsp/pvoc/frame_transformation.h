@@ -31,6 +31,8 @@
 
 #include "stmlib/stmlib.h"
 
+#include "stmlib/utils/random_stream.h"
+
 #include "clouds/dsp/pvoc/stft.h"
 
 #include "clouds/resources.h"
@@ -47,7 +49,11 @@ class FrameTransformation {
   FrameTransformation() { }
   ~FrameTransformation() { }
   
-  void Init(float* buffer, int32_t fft_size, int32_t num_textures);
+  void Init(
+      float* buffer,
+      int32_t fft_size,
+      int32_t num_textures,
+      stmlib::RandomStream* random);
   void Reset();
   
   void Process(
@@ -79,6 +85,8 @@ class FrameTransformation {
     *im = magnitude * lut_sin[angle];
   }
   
+  stmlib::RandomStream* random_;
+  
   int32_t fft_size_;
   int32_t num_textures_;
   int32_t size_;
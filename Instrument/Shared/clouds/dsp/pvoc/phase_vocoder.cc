@@ -44,7 +44,8 @@ void PhaseVocoder::Init(
     size_t largest_fft_size,
     int32_t num_channels,
     int32_t resolution,
-    float sample_rate) {
+    float sample_rate,
+    RandomStream* random) {
   num_channels_ = num_channels;
 
   size_t fft_size = largest_fft_size;
@@ -78,7 +79,11 @@ void PhaseVocoder::Init(
   for (int32_t i = 0; i < num_channels_; ++i) {
     float* texture_buffer = allocator[i]->Allocate<float>(
         num_textures * texture_size);
-    frame_transformation_[i].Init(texture_buffer, fft_size, num_textures);
+    frame_transformation_[i].Init(
+        texture_buffer,
+        fft_size,
+        num_textures,
+        random);
   }
 }
 
@@ -98,10 +103,20 @@ void PhaseVocoder::Process(
   }
 }
 
-void PhaseVocoder::Buffer() {
+bool PhaseVocoder::Buffer() {
+  bool buffered = false;
+  for (int32_t i = 0; i < num_channels_; ++i) {
+    buffered = stft_[i].Buffer() || buffered;
+  }
+  return buffered;
+}
+
+size_t PhaseVocoder::late_frames() const {
+  size_t late_frames = 0;
   for (int32_t i = 0; i < num_channels_; ++i) {
-    stft_[i].Buffer();
+    late_frames += stft_[i].late_frames();
   }
+  return late_frames;
 }
 
 }  // namespace clouds
@@ -51,14 +51,16 @@ class PhaseVocoder {
       const float* large_window_lut, size_t largest_fft_size,
       int32_t num_channels,
       int32_t resolution,
-      float sample_rate);
+      float sample_rate,
+      stmlib::RandomStream* random);
 
   void Process(
       const Parameters& parameters,
       const FloatFrame* input,
       FloatFrame* output,
       size_t size);
-  void Buffer();
+  bool Buffer();
+  size_t late_frames() const;
   
  private:
   FFT fft_;
@@ -72,8 +72,6 @@ void STFT::Init(
   window_stride_ = LUT_SINE_WINDOW_4096_SIZE / fft_size;
   modifier_ = modifier;
   
-  parameters_ = NULL;
-  
   Reset();
 }
 
@@ -85,6 +83,7 @@ void STFT::Reset() {
   fill(&synthesis_[0], &synthesis_[buffer_size_], 0);
   ready_ = 0;
   done_ = 0;
+  late_frames_.store(0, std::memory_order_relaxed);
 }
 
 void STFT::Process(
@@ -93,7 +92,6 @@ void STFT::Process(
     float* output,
     size_t size,
     size_t stride) {
-  parameters_ = &parameters;
   while (size) {
     size_t processed = min(size, hop_size_ - block_size_);
     for (size_t i = 0; i < processed; ++i) {
@@ -112,14 +110,27 @@ void STFT::Process(
     }
     if (block_size_ >= hop_size_) {
       block_size_ -= hop_size_;
-      ++ready_;
+      size_t ready = ready_.load(std::memory_order_relaxed);
+      size_t done = done_.load(std::memory_order_acquire);
+      // The previous frame must be done by now: its synthesis output is
+      // about to be read.
+      if (ready != done) {
+        late_frames_.fetch_add(1, std::memory_order_relaxed);
+      }
+      // Two or more frames behind, the worker may be reading this slot: the
+      // frame keeps the parameters of the one two frames before it.
+      if (ready - done < 2) {
+        parameters_[ready & 1] = parameters;
+      }
+      ready_.store(ready + 1, std::memory_order_release);
     }
   }
 }
 
-void STFT::Buffer() {
-  if (ready_ == done_) {
-    return;
+bool STFT::Buffer() {
+  size_t done = done_.load(std::memory_order_relaxed);
+  if (ready_.load(std::memory_order_acquire) == done) {
+    return false;
   }
   
   // Copy block to FFT buffer and apply window.
@@ -151,8 +162,8 @@ void STFT::Buffer() {
   }
 #endif  // USE_ARM_FFT
   // Process in the frequency domain.
-  if (modifier_ != NULL && parameters_ != NULL) {
-    modifier_->Process(*parameters_, &fft_out_[0], &ifft_in_[0]);
+  if (modifier_ != NULL) {
+    modifier_->Process(parameters_[done & 1], &fft_out_[0], &ifft_in_[0]);
   } else {
     copy(&fft_out_[0], &fft_out_[fft_size_], &ifft_in_[0]);
   }
@@ -200,11 +211,12 @@ void STFT::Buffer() {
     w += window_stride_;
   }
 
-  ++done_;
   process_ptr_ += hop_size_;
   if (process_ptr_ >= buffer_size_) {
     process_ptr_ -= buffer_size_;
   }
+  done_.store(done + 1, std::memory_order_release);
+  return true;
 }
 
 }  // namespace clouds
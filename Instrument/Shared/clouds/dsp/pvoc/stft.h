@@ -31,6 +31,10 @@
 
 #include "stmlib/stmlib.h"
 
+#include <atomic>
+
+#include "clouds/dsp/parameters.h"
+
 // #define USE_ARM_FFT
 
 #ifdef USE_ARM_FFT
@@ -41,8 +45,6 @@
 
 namespace clouds {
 
-struct Parameters;
-
 const size_t kMaxFftSize = 4096;
 #ifdef USE_ARM_FFT
   typedef arm_rfft_fast_instance_f32 FFT;
@@ -78,7 +80,16 @@ class STFT {
       size_t size,
       size_t stride);
 
-  void Buffer();
+  // Transforms the next frame, if there is one ready. Returns true if a
+  // frame was transformed. Process() and Buffer() may run on different
+  // threads, as long as Buffer() completes each frame within one hop.
+  bool Buffer();
+  
+  // Number of frames which were not transformed yet when the next hop of
+  // samples was ready.
+  inline size_t late_frames() const {
+    return late_frames_.load(std::memory_order_relaxed);
+  }
   
  private:
   FFT* fft_;
@@ -101,10 +112,14 @@ class STFT {
   size_t process_ptr_;
   size_t block_size_;
   
-  size_t ready_;
-  size_t done_;
+  std::atomic<size_t> ready_;
+  std::atomic<size_t> done_;
+  // Written by Process(), read from any thread.
+  std::atomic<size_t> late_frames_;
   
-  const Parameters* parameters_;
+  // Parameters captured when each frame was ready, so that a frame can be
+  // transformed on another thread while Process() keeps running.
+  Parameters parameters_[2];
   
   Modifier* modifier_;
   
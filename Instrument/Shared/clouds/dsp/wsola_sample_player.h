@@ -168,11 +168,41 @@ class WSOLASamplePlayer {
     return num_samples;
   }
   
+  template<int32_t num_channels, Resolution resolution>
+  int32_t ReadSamples(
+      const AudioBuffer<resolution>* buffer,
+      int32_t phase_increment,
+      int32_t source,
+      int32_t size,
+      float* destination,
+      int32_t capacity) {
+    int32_t phase = 0;
+    int32_t num_samples = 0;
+    if (source < 0) {
+      source += buffer->size();
+    }
+    while ((phase >> 16) < size && num_samples < capacity) {
+      int32_t integral = source + (phase >> 16);
+      uint16_t fractional = phase & 0xffff;
+      float s = buffer[0].ReadLinear(integral, fractional);
+      if (num_channels == 2) {
+        s += buffer[1].ReadLinear(integral, fractional);
+      }
+      destination[num_samples++] = s;
+      phase += phase_increment;
+    }
+    return num_samples;
+  }
+  
   template<Resolution resolution>
   void LoadCorrelator(const AudioBuffer<resolution>* buffer) {
     if (correlator_loaded_) {
       return;
     }
+    if (correlator_->fft_search()) {
+      LoadCorrelatorSamples(buffer);
+      return;
+    }
     float stride = window_size_ / 2048.0f;
     CONSTRAIN(stride, 1.0f, 2.0f);
     stride *= 65536.0f;
@@ -213,10 +243,63 @@ class WSOLASamplePlayer {
     correlator_loaded_ = true;
   }
  private:
+  template<Resolution resolution>
+  void LoadCorrelatorSamples(const AudioBuffer<resolution>* buffer) {
+    float stride = window_size_ / 2048.0f;
+    CONSTRAIN(stride, 1.0f, 2.0f);
+    stride *= 65536.0f;
+    int32_t increment = static_cast<int32_t>(
+          stride * (next_pitch_ratio_ < 1.25f ? 1.25f : next_pitch_ratio_));
+    const int32_t capacity = kCorrelatorMaxFftSize;
+    int32_t num_samples = 0;
+    int32_t num_destination_samples = 0;
+    if (num_channels_ == 1) {
+      num_samples = ReadSamples<1>(
+          buffer,
+          increment,
+          search_source_,
+          window_size_,
+          correlator_->source_samples(),
+          capacity);
+      num_destination_samples = ReadSamples<1>(
+          buffer,
+          increment,
+          search_target_ - window_size_,
+          window_size_ * 2,
+          correlator_->destination_samples(),
+          capacity);
+    } else {
+      num_samples = ReadSamples<2>(
+          buffer,
+          increment,
+          search_source_,
+          window_size_,
+          correlator_->source_samples(),
+          capacity);
+      num_destination_samples = ReadSamples<2>(
+          buffer,
+          increment,
+          search_target_ - window_size_,
+          window_size_ * 2,
+          correlator_->destination_samples(),
+          capacity);
+    }
+    correlator_->StartSampleSearch(
+        num_samples,
+        num_destination_samples,
+        search_target_ - window_size_ + (window_size_ >> 1),
+        increment);
+    correlator_loaded_ = true;
+  }
+
   template<Resolution resolution>
   void ScheduleAlignedWindow(
       const AudioBuffer<resolution>* buffer,
       Window* window) {
+    // A window is normally due a few blocks after its search has ended. Only
+    // the shortest windows come sooner: the rest of their search, which is
+    // short too, is evaluated here.
+    correlator_->EvaluateCandidates();
     int32_t next_window_position = correlator_->best_match();
     correlator_loaded_ = false;
     window->Start(
@@ -35,7 +35,10 @@
 
 namespace elements {
   
-static const float kSampleRate = 32000.0f;
+// Rate of the module. The lookup tables and the samples are computed for it;
+// the voices scale what they read from them when they run at another rate
+// (see Part::Init).
+static const float kNativeSampleRate = 32000.0f;
 const size_t kMaxBlockSize = 16;
 
 }  // namespace elements
@@ -35,6 +35,7 @@
 
 #include "stmlib/dsp/delay_line.h"
 #include "stmlib/dsp/filter.h"
+#include "stmlib/utils/random_stream.h"
 
 namespace elements {
 
@@ -96,7 +97,10 @@ class String {
   String() { }
   ~String() { }
   
-  void Init(bool enable_dispersion);
+  void Init(
+      bool enable_dispersion,
+      float sample_rate,
+      stmlib::RandomStream* random);
   void Process(const float* in, float* out, float* aux, size_t size);
   
   inline void set_frequency(float frequency) {
@@ -142,6 +146,8 @@ class String {
   float clamped_position_;
   float previous_dispersion_;
   float previous_damping_compensation_;
+  float sample_rate_;
+  stmlib::RandomStream* random_;
   
   bool enable_dispersion_;
   bool enable_iir_damping_;
@@ -41,7 +41,32 @@ namespace elements {
 using namespace std;
 using namespace stmlib;
 
-void Exciter::Init() {
+void Exciter::Init(float sample_rate, RandomStream* random) {
+  sample_rate_ = sample_rate;
+  rate_ratio_ = kNativeSampleRate / sample_rate;
+  random_ = random;
+  set_samples(NULL, NULL, NULL);
+  if (sample_rate == kNativeSampleRate) {
+    copy(&lut_approx_svf_gain[0], &lut_approx_svf_gain[LUT_APPROX_SVF_GAIN_SIZE],
+        &svf_gain_[0]);
+    copy(&lut_approx_svf_g[0], &lut_approx_svf_g[LUT_APPROX_SVF_G_SIZE],
+        &svf_g_[0]);
+    copy(&lut_approx_svf_h[0], &lut_approx_svf_h[LUT_APPROX_SVF_H_SIZE],
+        &svf_h_[0]);
+  } else {
+    // Same cutoff frequencies as in resources/lookup_tables.py: 32Hz to 16kHz.
+    for (size_t i = 0; i < LUT_APPROX_SVF_G_SIZE; ++i) {
+      float f = 32.0f * powf(10.0f, 2.7f * i / 256.0f) / sample_rate;
+      if (f >= 0.499f) {
+        f = 0.499f;
+      }
+      float g = tanf(M_PI_F * f);
+      svf_gain_[i] = (0.42f / f) * powf(4.0f, f * f);
+      svf_g_[i] = g;
+      svf_h_[i] = 1.0f / (1.0f + 2.0f * g + g * g);
+    }
+  }
+
   set_model(EXCITER_MODEL_MALLET);
   set_parameter(0.0f);
   set_timbre(0.99f);
@@ -55,9 +80,21 @@ void Exciter::Init() {
   signature_ = 0.0f;
 }
 
+void Exciter::set_samples(
+    const int16_t* sample_data,
+    const uint32_t* boundaries,
+    const int16_t* noise_sample) {
+  sample_data_ = sample_data ? sample_data : smp_sample_data;
+  for (size_t i = 0; i < SMP_BOUNDARIES_SIZE; ++i) {
+    boundaries_[i] = static_cast<uint32_t>(
+        sample_data ? boundaries[i] : smp_boundaries[i]);
+  }
+  noise_sample_ = noise_sample ? noise_sample : smp_noise_sample;
+}
+
 float Exciter::GetPulseAmplitude(float cutoff) {
   uint32_t cutoff_index = static_cast<uint32_t>(cutoff * 256.0f);
-  return lut_approx_svf_gain[cutoff_index];
+  return svf_gain_[cutoff_index];
 }
 
 void Exciter::Process(const uint8_t flags, float* out, size_t size) {
@@ -70,13 +107,13 @@ void Exciter::Process(const uint8_t flags, float* out, size_t size) {
     if (model_ == EXCITER_MODEL_NOISE) {
       uint32_t resonance_index = static_cast<uint32_t>(parameter_ * 256.0f);
       lp_.set_g_r(
-          lut_approx_svf_g[cutoff_index],
+          svf_g_[cutoff_index],
           lut_approx_svf_r[resonance_index]);
     } else {
       lp_.set_g_r_h(
-          lut_approx_svf_g[cutoff_index],
+          svf_g_[cutoff_index],
           2.0f,
-          lut_approx_svf_h[cutoff_index]);
+          svf_h_[cutoff_index]);
     }
     lp_.Process<FILTER_MODE_LOW_PASS>(out, out, size);
   }
@@ -84,11 +121,12 @@ void Exciter::Process(const uint8_t flags, float* out, size_t size) {
 
 void Exciter::ProcessGranularSamplePlayer(
     const uint8_t flags, float* out, size_t size) {
-  const uint32_t restart_prob = uint32_t(0.01f * 4294967296.0f);
+  const uint32_t restart_prob = uint32_t(
+      0.01f * rate_ratio_ * 4294967296.0f);
   const uint32_t restart_point = uint32_t(parameter_ * 32767.0f) << 17;
   const uint32_t phase_increment = static_cast<uint32_t>(
-      131072.0f * SemitonesToRatio(72.0f * timbre_ - 60.0f));
-  const int16_t* base = &smp_noise_sample[static_cast<size_t>(
+      131072.0f * SemitonesToRatio(72.0f * timbre_ - 60.0f) * rate_ratio_);
+  const int16_t* base = &noise_sample_[static_cast<size_t>(
       signature_ * 8192.0f)];
   
   uint32_t phase = phase_;
@@ -99,7 +137,7 @@ void Exciter::ProcessGranularSamplePlayer(
     float b = static_cast<float>(base[phase_integral + 1]);
     *out++ = (a + (b - a) * phase_fractional) / 32768.0f;
     phase += phase_increment;
-    if (Random::GetWord() < restart_prob) {
+    if (random_->GetWord() < restart_prob) {
       phase = restart_point;
     }
   }
@@ -116,12 +154,13 @@ void Exciter::ProcessSamplePlayer(
     index_fractional = 1.0f;
   }
   
-  const uint32_t offset_1 = smp_boundaries[index_integral];
-  const uint32_t offset_2 = smp_boundaries[index_integral + 1];
+  const uint32_t offset_1 = boundaries_[index_integral];
+  const uint32_t offset_2 = boundaries_[index_integral + 1];
   const uint32_t length_1 = offset_2 - offset_1 - 1;
-  const uint32_t length_2 = smp_boundaries[index_integral + 2] - offset_2 - 1;
+  const uint32_t length_2 = boundaries_[index_integral + 2] - offset_2 - 1;
   const uint32_t phase_increment = static_cast<uint32_t>(
-      65536.0f * SemitonesToRatio(72.0f * timbre_ - 36.0f + 7.0f));
+      65536.0f * SemitonesToRatio(72.0f * timbre_ - 36.0f + 7.0f) * \
+          rate_ratio_);
   
   float damp = damp_state_;
   uint32_t phase = phase_;
@@ -141,14 +180,14 @@ void Exciter::ProcessSamplePlayer(
     float sample_2 = 0.0f;
     bool step = false;
     if (phase_integral < length_1) {
-      const int16_t* base = &smp_sample_data[offset_1 + phase_integral];
+      const int16_t* base = &sample_data_[offset_1 + phase_integral];
       float a = static_cast<float>(base[0]);
       float b = static_cast<float>(base[1]);
       sample_1 = a + (b - a) * phase_fractional;
       step = true;
     }
     if (phase_integral < length_2) {
-      const int16_t* base = &smp_sample_data[offset_2 + phase_integral];
+      const int16_t* base = &sample_data_[offset_2 + phase_integral];
       float a = static_cast<float>(base[0]);
       float b = static_cast<float>(base[1]);
       sample_2 = a + (b - a) * phase_fractional;
@@ -187,7 +226,7 @@ void Exciter::ProcessPlectrum(
   if (flags & EXCITER_FLAG_RISING_EDGE) {
     impulse = -amplitude * (0.05f + signature_ * 0.2f);
     plectrum_delay_ = static_cast<uint32_t>(
-        4096.0f * parameter_ * parameter_) + 64;
+        (4096.0f * parameter_ * parameter_ + 64.0f) / rate_ratio_);
   }
   while (size--) {
     if (plectrum_delay_) {
@@ -211,7 +250,7 @@ void Exciter::ProcessParticles(
     float* out,
     size_t size) {
   if (flags & EXCITER_FLAG_RISING_EDGE) {
-    particle_state_ = RandomSample();
+    particle_state_ = random_->GetFloat();
     particle_state_ = 1.0f - 0.6f * particle_state_ * particle_state_;
     delay_ = 0;
     particle_range_ = 1.0f;
@@ -223,20 +262,20 @@ void Exciter::ProcessParticles(
     const float amplitude = GetPulseAmplitude(timbre_);
     while (size--) {
       if (delay_ == 0) {
-        float amount = RandomSample();
+        float amount = random_->GetFloat();
         amount = 1.05f + 0.5f * amount * amount;
-        if (Random::GetWord() > up_probability) {
+        if (random_->GetWord() > up_probability) {
           particle_state_ *= amount;
           if (particle_state_ >= (particle_range_ + 0.25f)) {
             particle_state_ = particle_range_ + 0.25f;
           }
-        } else if (Random::GetWord() < down_probability) {
+        } else if (random_->GetWord() < down_probability) {
           particle_state_ /= amount;
           if (particle_state_ <= 0.02f) {
             particle_state_ = 0.02f;
           }
         }
-        delay_ = static_cast<uint32_t>(particle_state_ * 0.15f * kSampleRate);
+        delay_ = static_cast<uint32_t>(particle_state_ * 0.15f * sample_rate_);
         float gain = 1.0f - particle_range_;
         gain *= gain;
         *out = particle_state_ * amplitude * (1.0f - gain);
@@ -256,12 +295,13 @@ void Exciter::ProcessFlow(
     float* out,
     size_t size) {
   float scale = parameter_ * parameter_ * parameter_ * parameter_;
-  float threshold = 0.0001f + scale * 0.125f;
+  float threshold = (0.0001f + scale * 0.125f) * rate_ratio_;
   if (flags & EXCITER_FLAG_RISING_EDGE) {
     particle_state_ = 0.5f;
   }
+  random_->Fill(out, size);
   while (size--) {
-    float sample = RandomSample();
+    float sample = *out;
     if (sample < threshold) {
       particle_state_ = -particle_state_;
     }
@@ -270,8 +310,9 @@ void Exciter::ProcessFlow(
 }
 
 void Exciter::ProcessNoise(const uint8_t flags, float* out, size_t size) {
+  random_->Fill(out, size);
   while (size--) {
-    *out++ = RandomSample() - 0.5f;
+    *out++ -= 0.5f;
   }
 }
 
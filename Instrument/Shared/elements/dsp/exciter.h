@@ -32,7 +32,9 @@
 #include "stmlib/stmlib.h"
 #include "stmlib/dsp/dsp.h"
 #include "stmlib/dsp/filter.h"
-#include "stmlib/utils/random.h"
+#include "stmlib/utils/random_stream.h"
+
+#include "elements/resources.h"
 
 namespace elements {
 
@@ -59,7 +61,7 @@ class Exciter {
   Exciter() { }
   ~Exciter() { }
   
-  void Init();
+  void Init(float sample_rate, stmlib::RandomStream* random);
   
   inline void set_signature(float signature) {
     signature_ = signature;
@@ -77,6 +79,15 @@ class Exciter {
     timbre_ = timbre;
   }
   
+  // Samples played instead of the ones of the module, in the format of
+  // smp_sample_data, smp_boundaries (SMP_BOUNDARIES_SIZE offsets) and
+  // smp_noise_sample (at least SMP_NOISE_SAMPLE_SIZE samples). NULL restores
+  // the module's.
+  void set_samples(
+      const int16_t* sample_data,
+      const uint32_t* boundaries,
+      const int16_t* noise_sample);
+  
   inline void set_meta(float meta, ExciterModel first, ExciterModel last) {
     meta *= static_cast<float>(last - first + 1);
     MAKE_INTEGRAL_FRACTIONAL(meta);
@@ -105,10 +116,6 @@ class Exciter {
  private:
   float GetPulseAmplitude(float cutoff);
 
-  inline float RandomSample() const {
-    return static_cast<float>(stmlib::Random::GetWord()) / 4294967296.0f;
-  }
-
   ExciterModel model_;
   float parameter_;
   float timbre_;
@@ -123,6 +130,19 @@ class Exciter {
   uint32_t delay_;
   uint32_t plectrum_delay_;
   
+  float sample_rate_;
+  float rate_ratio_;
+  stmlib::RandomStream* random_;
+  
+  const int16_t* sample_data_;
+  uint32_t boundaries_[SMP_BOUNDARIES_SIZE];
+  const int16_t* noise_sample_;
+  
+  // The lut_approx_svf_* tables, recomputed for sample_rate_.
+  float svf_gain_[LUT_APPROX_SVF_GAIN_SIZE];
+  float svf_g_[LUT_APPROX_SVF_G_SIZE];
+  float svf_h_[LUT_APPROX_SVF_H_SIZE];
+  
   static ProcessFn fn_table_[];
   
   DISALLOW_COPY_AND_ASSIGN(Exciter);
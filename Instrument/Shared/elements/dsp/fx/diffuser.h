@@ -31,7 +31,7 @@
 
 #include "stmlib/stmlib.h"
 
-#include "elements/dsp/fx/fx_engine.h"
+#include "stmlib/dsp/fx_engine.h"
 
 namespace elements {
 
@@ -45,6 +45,17 @@ class Diffuser {
   }
   
   void Process(float* in_out, size_t size) {
+    size_t i = 0;
+    for (; i + stmlib::kSimdWidth <= size; i += stmlib::kSimdWidth) {
+      Process<stmlib::f32xN>(&in_out[i]);
+    }
+    for (; i < size; ++i) {
+      Process<float>(&in_out[i]);
+    }
+  }
+  
+  template<typename F>
+  inline void Process(float* in_out) {
     typedef E::Reserve<126,
       E::Reserve<180,
       E::Reserve<269,
@@ -53,26 +64,25 @@ class Diffuser {
     E::DelayLine<Memory, 1> ap2;
     E::DelayLine<Memory, 2> ap3;
     E::DelayLine<Memory, 3> ap4;
-    E::Context c;
+    E::Context<F> c;
     const float kap = 0.625f;
-    while (size--) {
-      engine_.Start(&c);
-      c.Read(*in_out);
-      c.Read(ap1 TAIL, kap);
-      c.WriteAllPass(ap1, -kap);
-      c.Read(ap2 TAIL, kap);
-      c.WriteAllPass(ap2, -kap);
-      c.Read(ap3 TAIL, kap);
-      c.WriteAllPass(ap3, -kap);
-      c.Read(ap4 TAIL, kap);
-      c.WriteAllPass(ap4, -kap);
-      c.Write(*in_out, 0.0f);
-      ++in_out;
-    }
+    F x = stmlib::SimdLoad<F>(in_out);
+    engine_.Start(&c);
+    c.Read(x);
+    c.Read(ap1 TAIL, kap);
+    c.WriteAllPass(ap1, -kap);
+    c.Read(ap2 TAIL, kap);
+    c.WriteAllPass(ap2, -kap);
+    c.Read(ap3 TAIL, kap);
+    c.WriteAllPass(ap3, -kap);
+    c.Read(ap4 TAIL, kap);
+    c.WriteAllPass(ap4, -kap);
+    c.Write(x, 0.0f);
+    stmlib::SimdStore(in_out, x);
   }
   
  private:
-  typedef FxEngine<1024, FORMAT_32_BIT> E;
+  typedef stmlib::FxEngine<2048, stmlib::FORMAT_32_BIT> E;
   E engine_;
   
   DISALLOW_COPY_AND_ASSIGN(Diffuser);
@@ -35,7 +35,9 @@ namespace elements {
 using namespace std;
 using namespace stmlib;
 
-void MultistageEnvelope::Init() {
+void MultistageEnvelope::Init(float sample_rate) {
+  // The increments table is for blocks at kNativeSampleRate.
+  increment_scale_ = kNativeSampleRate / sample_rate;
   set_adsr(0, 0.25f, 0.25f, 0.5f);
   segment_ = num_segments_;
   phase_ = 0.0f;
@@ -31,6 +31,7 @@
 
 #include "stmlib/stmlib.h"
 
+#include "elements/dsp/dsp.h"
 #include "elements/resources.h"
 
 namespace elements {
@@ -54,7 +55,8 @@ class MultistageEnvelope {
   MultistageEnvelope() { }
   ~MultistageEnvelope() { }
   
-  void Init();
+  // Process(flags) is called once per block of kMaxBlockSize samples.
+  void Init(float sample_rate);
   inline float Process(uint8_t flags) {
     if (flags & ENVELOPE_FLAG_RISING_EDGE) {
       start_value_ = (segment_ == num_segments_ || hard_reset_)
@@ -81,7 +83,8 @@ class MultistageEnvelope {
   
     float phase_increment = 0.0f;
     if (!sustained && !done) {
-      phase_increment = Interpolate8(lut_env_increments, time_[segment_]);
+      phase_increment = Interpolate8(lut_env_increments, time_[segment_]) * \
+          increment_scale_;
     }
     float t = Interpolate8(
         lookup_table_table[LUT_ENV_LINEAR + shape_[segment_]],
@@ -343,6 +346,7 @@ class MultistageEnvelope {
   float value_;
 
   float phase_;
+  float increment_scale_;
   
   uint16_t num_segments_;
   uint16_t sustain_point_;
@@ -66,14 +66,44 @@ const float kDownsamplingFilter[] = {
   -0.001859272945f,
 };
 
-void Spatializer::Init(float fixed_position) {
+// Least-squares designs with the same band edges, and a weight of 100 on the
+// stopband: it peaks at -45dB for the 4x filter, and at -52dB for the 2x one.
+const float kDownsamplingFilter4x[] = {
+  0.000733165031f,  0.001408953477f,  0.001792724332f,  0.001412430137f,
+ -0.000027751114f, -0.002371461656f, -0.004884478226f, -0.006377277971f,
+ -0.005636458505f, -0.002022105883f,  0.003981064647f,  0.010576142207f,
+  0.015005826212f,  0.014478697004f,  0.007392944746f, -0.005559464107f,
+ -0.020932083953f, -0.033016023386f, -0.035328354566f, -0.022694679933f,
+  0.006712714274f,  0.050153794304f,  0.100427086761f,  0.147445469764f,
+  0.180856670874f,  0.192944911062f,  0.180856670874f,  0.147445469764f,
+  0.100427086761f,  0.050153794304f,  0.006712714274f, -0.022694679933f,
+ -0.035328354566f, -0.033016023386f, -0.020932083953f, -0.005559464107f,
+  0.007392944746f,  0.014478697004f,  0.015005826212f,  0.010576142207f,
+  0.003981064647f, -0.002022105883f, -0.005636458505f, -0.006377277971f,
+ -0.004884478226f, -0.002371461656f, -0.000027751114f,  0.001412430137f,
+  0.001792724332f,  0.001408953477f,  0.000733165031f,
+};
+
+const float kDownsamplingFilter2x[] = {
+  0.001892650069f,  0.004647938696f,  0.002591722665f, -0.007073556325f,
+ -0.013806138021f, -0.001570916715f,  0.024132713437f,  0.027794421774f,
+ -0.015444941478f, -0.067347158754f, -0.041283291397f,  0.104039471818f,
+  0.291986180584f,  0.378881807291f,  0.291986180584f,  0.104039471818f,
+ -0.041283291397f, -0.067347158754f, -0.015444941478f,  0.027794421774f,
+  0.024132713437f, -0.001570916715f, -0.013806138021f, -0.007073556325f,
+  0.002591722665f,  0.004647938696f,  0.001892650069f,
+};
+
+void Spatializer::Init(float fixed_position, float sample_rate) {
   angle_ = 0.0f;
   fixed_position_ = fixed_position;
   left_ = 0.0f;
   right_ = 0.0f;
   distance_ = 0.0f;
   behind_filter_.Init();
-  behind_filter_.set_f_q<FREQUENCY_EXACT>(0.05f, 1.0f);
+  behind_filter_.set_f_q<FREQUENCY_EXACT>(
+      0.05f * (kNativeSampleRate / sample_rate),
+      1.0f);
 }
   
 void Spatializer::Process(
@@ -137,7 +167,7 @@ void FmOscillator::Process(
   
   // To prevent aliasing, reduce FM amount when frequency or feedback are
   // too high.
-  float brightness = frequency + ratio * 0.75f - 60.0f + \
+  float brightness = frequency + brightness_offset_ + ratio * 0.75f - 60.0f + \
       feedback_amount * 24.0f;
   float amount_attenuation = brightness <= 0.0f
       ? 1.0f
@@ -163,29 +193,57 @@ void FmOscillator::Process(
 }
 
 
-void OminousVoice::Init() {
-  envelope_.Init();
+void OminousVoice::Init(float sample_rate) {
+  rate_ratio_ = kNativeSampleRate / sample_rate;
+  envelope_.Init(sample_rate);
   envelope_.set_adsr(0.5f, 0.5f, 0.5f, 0.5f);
   previous_gate_ = false;
   level_state_ = 0.0f;
   
   for (size_t i = 0; i < kNumOscillators; ++i) {
     external_fm_state_[i] = 0.0f;
-    oscillator_[i].Init();
+    oscillator_[i].Init(sample_rate);
+    
+    osc_level_[i] = 0.0f;
+    filter_[i].Init();
+    
+    spatializer_[i].Init(i == 0 ? - 0.7f : 0.7f, sample_rate);
+  }
+  set_oversampling(kOversamplingUp);
+}
+
+void OminousVoice::set_oversampling(size_t oversampling) {
+  const float* filter = kDownsamplingFilter;
+  size_t filter_size = sizeof(kDownsamplingFilter) / sizeof(float);
+  if (oversampling <= 2) {
+    oversampling = 2;
+    filter = kDownsamplingFilter2x;
+    filter_size = sizeof(kDownsamplingFilter2x) / sizeof(float);
+  } else if (oversampling < kOversamplingUp) {
+    oversampling = 4;
+    filter = kDownsamplingFilter4x;
+    filter_size = sizeof(kDownsamplingFilter4x) / sizeof(float);
+  } else {
+    oversampling = kOversamplingUp;
+  }
+  oversampling_ = oversampling;
+  oversampling_down_midi_ = oversampling == 2
+      ? -12.0f
+      : (oversampling == 4 ? -24.0f : kOversamplingDownMidi);
+  
+  for (size_t i = 0; i < kNumOscillators; ++i) {
+    external_fm_state_[i] = 0.0f;
+    oscillator_[i].set_oversampling_midi(oversampling_down_midi_);
 
     // Downsampling is done mostly by the FIR, but since the stopband
     // attenuation peaks at -48dB, we can get a few extra dB of attenution with
-    // the IIR for the highest frequencies.
-    fir_downsampler_[i].Init(kDownsamplingFilter);
+    // the IIR for the highest frequencies. At lower oversampling factors, its
+    // cutoff would be too high for the naive SVF to remain stable.
+    fir_downsampler_[i].Init(filter, filter_size, oversampling);
     iir_downsampler_[i].Init();
     iir_downsampler_[i].set_f_q<FREQUENCY_EXACT>(
         1.0f / kOversamplingUp * 0.8f,
         0.5f);
-    
-    osc_level_[i] = 0.0f;
-    filter_[i].Init();
-    
-    spatializer_[i].Init(i == 0 ? - 0.7f : 0.7f);
   }
 }
 
@@ -249,9 +307,10 @@ void OminousVoice::Process(
   
   const float rotation_speed[2] = { 1.0f, 1.123456f };
   feedback_ += 0.01f * (patch.exciter_bow_timbre - feedback_);
-  frequency += kOversamplingDownMidi;
+  frequency += oversampling_down_midi_;
   for (size_t i = 0; i < 2; ++i) {
-    Upsample<kOversamplingUp>(
+    Upsample(
+        oversampling_,
         &external_fm_state_[i],
         i == 0 ? blow_in : strike_in,
         external_fm_oversampled_, size);
@@ -276,14 +335,16 @@ void OminousVoice::Process(
         (2.0f - patch.exciter_signature * feedback_) * amount,
         external_fm_oversampled_,
         osc_oversampled_,
-        size * kOversamplingUp);
+        size * oversampling_);
     
-    iir_downsampler_[i].Process<FILTER_MODE_LOW_PASS>(
-        osc_oversampled_,
-        osc_oversampled_,
-        size * kOversamplingUp,
-        1);
-    fir_downsampler_[i].Process(osc_oversampled_, osc_, size * kOversamplingUp);
+    if (oversampling_ == kOversamplingUp) {
+      iir_downsampler_[i].Process<FILTER_MODE_LOW_PASS>(
+          osc_oversampled_,
+          osc_oversampled_,
+          size * oversampling_,
+          1);
+    }
+    fir_downsampler_[i].Process(osc_oversampled_, osc_, size * oversampling_);
     
     // Copy to raw buffer.
     float level_state = osc_level_[i];
@@ -310,7 +371,7 @@ void OminousVoice::Process(
     float f = patch.resonator_position * patch.resonator_position * 0.001f;
     float distance = patch.resonator_position;
     
-    spatializer_[i].Rotate(f * rotation_speed[i]);
+    spatializer_[i].Rotate(f * rotation_speed[i] * rate_ratio_);
     spatializer_[i].set_distance(distance * (2.0f - distance));
     spatializer_[i].Process(osc_, center, sides, size);
   }
@@ -35,6 +35,7 @@
 
 #include "stmlib/dsp/dsp.h"
 #include "stmlib/dsp/filter.h"
+#include "stmlib/dsp/simd.h"
 
 #include "elements/dsp/dsp.h"
 #include "elements/dsp/multistage_envelope.h"
@@ -43,41 +44,56 @@
 
 namespace elements {
 
+// The oscillators run at kOversamplingUp times the sample rate by default.
+// set_oversampling() lowers the factor to 4 or 2, with shorter filters: less
+// CPU, more aliasing.
 const float kOversamplingDownMidi = -36.0f;
 const size_t kOversamplingUp = 8;
+const size_t kMaxDownsamplingFilterSize = 101;
 
 const size_t kNumOscillators = 2;
 
-template<int32_t filter_size, int32_t buffer_size, int32_t ratio>
+// Polyphase decimator. Only the output samples which are kept are computed,
+// each as the dot product of the filter with the last filter_size input
+// samples, accumulated in SIMD lanes. The input is appended to a linear
+// history, so that these samples are contiguous.
+template<size_t max_filter_size, size_t max_size>
 class FIRDownsampler {
  public:
   FIRDownsampler() { }
   ~FIRDownsampler() { }
-  void Init(const float* filter_coefficients) {
-    coefficients_ = filter_coefficients;
-    std::fill(&buffer_[0], &buffer_[buffer_size * 2], 0.0f);
-    ptr_ = 0;
+  void Init(
+      const float* filter_coefficients,
+      size_t filter_size,
+      size_t ratio) {
+    filter_size_ = filter_size;
+    ratio_ = ratio;
+    // Reversed, so that the oldest sample of the window is in tap 0.
+    std::reverse_copy(
+        &filter_coefficients[0],
+        &filter_coefficients[filter_size],
+        &coefficients_[0]);
+    std::fill(&history_[0], &history_[max_filter_size - 1 + max_size], 0.0f);
   }
   // size is expected to be a multiple of the downsampling ratio.
   void Process(const float* in, float* out, size_t size) {
-    while (size) {
-      for (int32_t i = 0; i < ratio; ++i) {
-        buffer_[ptr_ + buffer_size] = buffer_[ptr_] = *in++;
-        ptr_ = (ptr_ + (buffer_size - 1)) & (buffer_size - 1);
-        size--;
-      }
-      float s = 0.0f;
-      for (int32_t i = 0; i < filter_size; ++i) {
-        s += buffer_[ptr_ + i + 1] * coefficients_[i];
-      }
-      *out++ = s;
+    std::copy(&in[0], &in[size], &history_[filter_size_ - 1]);
+    const float* window = &history_[ratio_ - 1];
+    for (size_t i = 0; i < size / ratio_; ++i) {
+      out[i] = stmlib::SimdDot(window, coefficients_, filter_size_);
+      window += ratio_;
     }
+    std::copy(
+        &history_[size],
+        &history_[size + filter_size_ - 1],
+        &history_[0]);
   }
   
  private:
-  int32_t ptr_;
-  const float* coefficients_;
-  float buffer_[buffer_size * 2];
+  size_t filter_size_;
+  size_t ratio_;
+  float coefficients_[max_filter_size];
+  float history_[max_filter_size - 1 + max_size];
   
   DISALLOW_COPY_AND_ASSIGN(FIRDownsampler);
 };
@@ -86,7 +102,7 @@ class Spatializer {
  public:
   Spatializer() { }
   ~Spatializer() { }
-  void Init(float fixed_position);
+  void Init(float fixed_position, float sample_rate);
 
   inline void Rotate(float rotation_speed) {
     angle_ += rotation_speed;
@@ -121,9 +137,11 @@ class FmOscillator {
  public:
   FmOscillator() { }
   ~FmOscillator() { }
-  void Init() {
+  void Init(float sample_rate) {
     fm_amount_ = 0.0f;
     previous_sample_ = 0.0f;
+    brightness_offset_ = 0.0f;
+    rate_ratio_ = kNativeSampleRate / sample_rate;
   }
 
   void Process(float frequency,
@@ -134,13 +152,19 @@ class FmOscillator {
       float* destination,
       size_t size);
 
+  // Pitch offset applied to the frequency to run at the oversampled rate.
+  // The FM amount is attenuated at the same pitches whatever the offset.
+  inline void set_oversampling_midi(float oversampling_midi) {
+    brightness_offset_ = kOversamplingDownMidi - oversampling_midi;
+  }
+
  private:
   inline float midi_to_increment(float midi_pitch) const {
     int32_t pitch = static_cast<int32_t>(midi_pitch * 256.0f);
     pitch = 32768 + stmlib::Clip16(pitch - 20480);
     float increment = lut_midi_to_increment_high[pitch >> 8] * \
         lut_midi_to_f_low[pitch & 0xff];
-    return increment;
+    return increment * rate_ratio_;
   }
   
   inline float Sine(uint32_t phase) const {
@@ -162,6 +186,8 @@ class FmOscillator {
   
   float fm_amount_;
   float previous_sample_;
+  float rate_ratio_;
+  float brightness_offset_;
   uint32_t phase_carrier_;
   uint32_t phase_mod_;
    
@@ -173,7 +199,12 @@ class OminousVoice {
   OminousVoice() { }
   ~OminousVoice() { }
   
-  void Init();
+  void Init(float sample_rate);
+  
+  // 2, 4 or kOversamplingUp. Resets the downsampling filters.
+  void set_oversampling(size_t oversampling);
+  inline size_t oversampling() const { return oversampling_; }
+  
   void Process(
       const Patch& patch,
       float frequency,
@@ -189,8 +220,8 @@ class OminousVoice {
  private:
   void ConfigureEnvelope(const Patch& patch);
 
-  template<int up>
   void Upsample(
+      size_t up,
       float* state,
       const float* source,
       float* destination,
@@ -227,7 +258,8 @@ class OminousVoice {
     }
     int32_t pitch = static_cast<int32_t>(midi_pitch * 256.0f);
     pitch = 32768 + stmlib::Clip16(pitch - 20480);
-    return lut_midi_to_f_high[pitch >> 8] * lut_midi_to_f_low[pitch & 0xff];
+    return lut_midi_to_f_high[pitch >> 8] * lut_midi_to_f_low[pitch & 0xff] * \
+        rate_ratio_;
   }
   
   float external_fm_oversampled_[kOversamplingUp * kMaxBlockSize];
@@ -236,6 +268,11 @@ class OminousVoice {
   
   bool previous_gate_;
   MultistageEnvelope envelope_;
+  
+  float rate_ratio_;
+  
+  size_t oversampling_;
+  float oversampling_down_midi_;
 
   float level_[kMaxBlockSize];
   float level_state_;
@@ -250,7 +287,9 @@ class OminousVoice {
   FmOscillator oscillator_[kNumOscillators];
   
   stmlib::NaiveSvf iir_downsampler_[kNumOscillators];
-  FIRDownsampler<101, 128, kOversamplingUp> fir_downsampler_[kNumOscillators];
+  FIRDownsampler<
+      kMaxDownsamplingFilterSize,
+      kOversamplingUp * kMaxBlockSize> fir_downsampler_[kNumOscillators];
 
   stmlib::Svf filter_[kNumOscillators];
   
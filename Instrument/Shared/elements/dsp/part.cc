@@ -35,7 +35,15 @@ namespace elements {
 using namespace std;
 using namespace stmlib;
 
-void Part::Init(uint16_t* reverb_buffer) {
+const size_t kNoNote = kMaxPolyphony;
+
+// Mean square level below which a released voice is silent, and is no longer
+// rendered (-90dB).
+const float kIdleLevel = 1.0e-9f;
+
+void Part::Init(uint16_t* reverb_buffer, float sample_rate) {
+  sample_rate_ = sample_rate;
+  
   patch_.exciter_envelope_shape = 1.0f;
   patch_.exciter_bow_level = 0.0f;
   patch_.exciter_bow_timbre = 0.5f;
@@ -50,23 +58,29 @@ void Part::Init(uint16_t* reverb_buffer) {
   patch_.resonator_brightness = 0.5f;
   patch_.resonator_damping = 0.25f;
   patch_.resonator_position = 0.3f;
-  patch_.resonator_modulation_frequency = 0.5f / kSampleRate;
+  patch_.resonator_modulation_frequency = 0.5f / sample_rate_;
   patch_.resonator_modulation_offset = 0.1f;
   patch_.reverb_diffusion = 0.625f;
   patch_.reverb_lp = 0.7f;
   patch_.space = 0.5f;
   previous_gate_ = false;
   active_voice_ = 0;
+  num_triggers_ = 0;
   
   fill(&silence_[0], &silence_[kMaxBlockSize], 0.0f);
   fill(&note_[0], &note_[kNumVoices], 69.0f);
+  fill(&voice_strength_[0], &voice_strength_[kNumVoices], 0.0f);
+  fill(&voice_age_[0], &voice_age_[kNumVoices], 0);
+  fill(&voice_level_[0], &voice_level_[kNumVoices], 0.0f);
+  polyphony_ = 0;
+  set_polyphony(1);
   
   for (size_t i = 0; i < kNumVoices; ++i) {
-    voice_[i].Init();
-    ominous_voice_[i].Init();
+    voice_[i].Init(sample_rate, i);
+    ominous_voice_[i].Init(sample_rate);
   }
   
-  reverb_.Init(reverb_buffer);
+  reverb_.Init(reverb_buffer, sample_rate);
   
   scaled_exciter_level_ = 0.0f;
   scaled_resonator_level_ = 0.0f;
@@ -77,6 +91,45 @@ void Part::Init(uint16_t* reverb_buffer) {
   resonator_model_ = RESONATOR_MODEL_MODAL;
 }
 
+void Part::set_polyphony(size_t polyphony) {
+  polyphony = max(min(polyphony, kMaxPolyphony), size_t(1));
+  if (polyphony == polyphony_) {
+    return;
+  }
+  polyphony_ = polyphony;
+  
+  // With a single note, a new note restrikes the voice that is still ringing,
+  // as on the module.
+  num_voices_ = polyphony_ == 1 ? 1 : polyphony_ + kNumTailVoices;
+  mix_gain_ = 1.0f / powf(static_cast<float>(polyphony_), 0.35f);
+  for (size_t i = 0; i < kMaxPolyphony; ++i) {
+    note_gate_[i] = false;
+    note_voice_[i] = i < polyphony_ ? i : 0;
+  }
+  for (size_t i = 0; i < kNumVoices; ++i) {
+    voice_note_[i] = i < polyphony_ ? i : kNoNote;
+    voice_gate_[i] = false;
+  }
+  active_voice_ = 0;
+}
+
+size_t Part::AllocateVoice() {
+  // Take the quietest of the voices which do not play a note - the idle ones,
+  // then the tails. Steal the oldest note when there is none.
+  size_t quietest = kNumVoices;
+  size_t oldest = 0;
+  for (size_t i = 0; i < num_voices_; ++i) {
+    if (voice_age_[i] < voice_age_[oldest]) {
+      oldest = i;
+    }
+    if (voice_note_[i] == kNoNote && (quietest == kNumVoices || \
+            voice_level_[i] < voice_level_[quietest])) {
+      quietest = i;
+    }
+  }
+  return quietest != kNumVoices ? quietest : oldest;
+}
+
 void Part::Seed(uint32_t* seed, size_t size) {
   // Scramble all bits from the serial number.
   uint32_t signature = 0xf0cacc1a;
@@ -88,7 +141,7 @@ void Part::Seed(uint32_t* seed, size_t size) {
 
   x = static_cast<float>(signature & 7) / 8.0f;
   signature >>= 3;
-  patch_.resonator_modulation_frequency = (0.4f + 0.8f * x) / kSampleRate;
+  patch_.resonator_modulation_frequency = (0.4f + 0.8f * x) / sample_rate_;
   
   x = static_cast<float>(signature & 7) / 8.0f;
   signature >>= 3;
@@ -108,7 +161,7 @@ void Part::Seed(uint32_t* seed, size_t size) {
 }
 
 void Part::Process(
-    const PerformanceState& performance_state,
+    const PerformanceState* performance_state,
     const float* blow_in,
     const float* strike_in,
     float* main,
@@ -132,16 +185,40 @@ void Part::Process(
     return;
   }
 
-  // When a new note is played, cycle to the next voice.
-  if (performance_state.gate && !previous_gate_) {
-    ++active_voice_;
-    if (active_voice_ >= kNumVoices) {
-      active_voice_ = 0;
+  // When a new note is played, it gets a voice of its own. The voice which
+  // played the previous note renders its tail, and the external inputs go to
+  // the most recent voice.
+  previous_gate_ = false;
+  for (size_t i = 0; i < polyphony_; ++i) {
+    const PerformanceState& note = performance_state[i];
+    if (note.gate && !note_gate_[i]) {
+      if (voice_note_[note_voice_[i]] == i) {
+        voice_note_[note_voice_[i]] = kNoNote;
+        voice_gate_[note_voice_[i]] = false;
+      }
+      size_t voice = AllocateVoice();
+      voice_note_[voice] = i;
+      voice_age_[voice] = ++num_triggers_;
+      note_voice_[i] = voice;
+      active_voice_ = voice;
+    }
+    note_gate_[i] = note.gate;
+    previous_gate_ = previous_gate_ || note.gate;
+    
+    // A note whose voice has been stolen is silent until it is played again.
+    size_t voice = note_voice_[i];
+    if (voice_note_[voice] == i) {
+      voice_gate_[voice] = note.gate;
+      voice_strength_[voice] = note.strength;
+      note_[voice] = note.note + note.modulation;
     }
   }
   
-  previous_gate_ = performance_state.gate;
-  note_[active_voice_] = performance_state.note;
+  bool input = false;
+  for (size_t i = 0; i < size; ++i) {
+    input = input || blow_in[i] != 0.0f || strike_in[i] != 0.0f;
+  }
+  
   fill(&main[0], &main[size], 0.0f);
   fill(&aux[0], &aux[size], 0.0f);
   
@@ -155,15 +232,24 @@ void Part::Process(
   float reverb_amount = space >= 0.5f ? 1.0f * (space - 0.5f) : 0.0f;
   float reverb_time = 0.35f + 1.2f * reverb_amount;
   
-  // Render each voice.
-  for (size_t i = 0; i < kNumVoices; ++i) {
-    float midi_pitch = note_[i] + performance_state.modulation;
+  // Render each voice. Released voices are skipped once their exciter and
+  // their resonator have decayed.
+  for (size_t i = 0; i < num_voices_; ++i) {
+    bool idle = !voice_gate_[i] && \
+        voice_level_[i] < kIdleLevel && \
+        (easter_egg_ || voice_[i].exciter_level() < kIdleLevel) && \
+        !(i == active_voice_ && input);
+    if (num_voices_ > 1 && idle) {
+      continue;
+    }
+    
+    float midi_pitch = note_[i];
     if (easter_egg_) {
       ominous_voice_[i].Process(
           patch_,
           midi_pitch,
-          performance_state.strength,
-          i == active_voice_ && performance_state.gate,
+          voice_strength_[i],
+          voice_gate_[i],
           (i == active_voice_) ? blow_in : silence_,
           (i == active_voice_) ? strike_in : silence_,
           raw_buffer_,
@@ -182,9 +268,10 @@ void Part::Process(
       // Render the voice signal.
       voice_[i].Process(
           patch_,
-          lut_midi_to_f_high[pitch >> 8] * lut_midi_to_f_low[pitch & 0xff],
-          performance_state.strength,
-          i == active_voice_ && performance_state.gate,
+          lut_midi_to_f_high[pitch >> 8] * lut_midi_to_f_low[pitch & 0xff] * \
+              (kNativeSampleRate / sample_rate_),
+          voice_strength_[i],
+          voice_gate_[i],
           (i == active_voice_) ? blow_in : silence_,
           (i == active_voice_) ? strike_in : silence_,
           raw_buffer_,
@@ -194,12 +281,25 @@ void Part::Process(
     }
     
     // Mixdown.
+    float level = voice_level_[i];
     for (size_t j = 0; j < size; ++j) {
       float side = sides_buffer_[j] * spread;
       float r = center_buffer_[j] - side;
       float l = center_buffer_[j] + side;;
       main[j] += r;
       aux[j] += l + (raw_buffer_[j] - l) * raw_gain;
+      
+      float error = center_buffer_[j] * center_buffer_[j] + \
+          sides_buffer_[j] * sides_buffer_[j] - level;
+      level += error * (error > 0.0f ? 0.05f : 0.0005f);
+    }
+    voice_level_[i] = level;
+  }
+  
+  if (polyphony_ > 1) {
+    for (size_t i = 0; i < size; ++i) {
+      main[i] *= mix_gain_;
+      aux[i] *= mix_gain_;
     }
   }
   
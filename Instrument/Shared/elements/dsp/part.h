@@ -47,17 +47,25 @@ struct PerformanceState {
 
 // Polyphony is actually possible, but you have to reduce the number of modes
 // to 16, and this doesn't sound very good...
-const size_t kNumVoices = 1;
+// Up to kMaxPolyphony notes are held at once. Each note is played by a voice
+// of its own, and kNumTailVoices more let released notes ring while new ones
+// are played.
+const size_t kMaxPolyphony = 6;
+const size_t kNumTailVoices = 2;
+const size_t kNumVoices = kMaxPolyphony + kNumTailVoices;
 
 class Part {
  public:
   Part() { }
   ~Part() { }
   
-  void Init(uint16_t* reverb_buffer);
+  // The voices run at sample_rate. Everything is tuned for kNativeSampleRate,
+  // the rate of the module.
+  void Init(uint16_t* reverb_buffer, float sample_rate);
   
+  // performance_state holds one entry per note, polyphony() of them.
   void Process(
-      const PerformanceState& performance_state,
+      const PerformanceState* performance_state,
       const float* blow_in,
       const float* strike_in,
       float* main,
@@ -73,12 +81,32 @@ class Part {
   inline float exciter_level() const { return scaled_exciter_level_; }
   inline float resonator_level() const { return scaled_resonator_level_; }
   inline bool gate() const { return previous_gate_; }
+  
+  inline size_t polyphony() const { return polyphony_; }
+  void set_polyphony(size_t polyphony);
   inline bool bypass() const { return bypass_; }
   inline void set_bypass(bool bypass) { bypass_ = bypass; }
 
   inline bool easter_egg() const { return easter_egg_; }
   inline void set_easter_egg(bool easter_egg) { easter_egg_ = easter_egg; }
 
+  // See OminousVoice::set_oversampling().
+  void set_ominous_oversampling(size_t oversampling) {
+    for (size_t i = 0; i < kNumVoices; ++i) {
+      ominous_voice_[i].set_oversampling(oversampling);
+    }
+  }
+
+  // See Exciter::set_samples().
+  void set_samples(
+      const int16_t* sample_data,
+      const uint32_t* boundaries,
+      const int16_t* noise_sample) {
+    for (size_t i = 0; i < kNumVoices; ++i) {
+      voice_[i].set_samples(sample_data, boundaries, noise_sample);
+    }
+  }
+
   inline ResonatorModel resonator_model() const { return resonator_model_; }
   inline void set_resonator_model(ResonatorModel r) {
       if (r < 3) {
@@ -92,16 +120,32 @@ bool easter_egg_;
   
  private:
   Patch patch_;
+  size_t AllocateVoice();
+  
   Voice voice_[kNumVoices];
   OminousVoice ominous_voice_[kNumVoices];
   
   bool panic_;
   bool bypass_;
   bool previous_gate_;
+  
+  size_t polyphony_;
+  bool note_gate_[kMaxPolyphony];
+  size_t note_voice_[kMaxPolyphony];
+  
+  // A voice either plays a note, or renders the tail of a released one
+  // (voice_note_ is then kNoNote).
+  size_t voice_note_[kNumVoices];
+  bool voice_gate_[kNumVoices];
+  float voice_strength_[kNumVoices];
+  uint32_t voice_age_[kNumVoices];
+  float voice_level_[kNumVoices];
   float note_[kNumVoices];
   
   size_t num_voices_;
   size_t active_voice_;
+  uint32_t num_triggers_;
+  float mix_gain_;
   
   float silence_[kMaxBlockSize];
   
@@ -115,6 +159,8 @@ bool easter_egg_;
   
   Reverb reverb_;
   
+  float sample_rate_;
+  
   ResonatorModel resonator_model_;
   
   DISALLOW_COPY_AND_ASSIGN(Part);
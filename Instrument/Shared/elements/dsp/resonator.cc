@@ -39,23 +39,22 @@ namespace elements {
 using namespace std;
 using namespace stmlib;
 
-void Resonator::Init() {
-  for (size_t i = 0; i < kMaxModes; ++i) {
-    f_[i].Init();
-  }
-
+void Resonator::Init(float sample_rate) {
+  rate_ratio_ = kNativeSampleRate / sample_rate;
+  f_.Init();
+  f_bow_.Init();
   for (size_t i = 0; i < kMaxBowedModes; ++i) {
-    f_bow_[i].Init();
     d_bow_[i].Init();
   }
   
-  set_frequency(220.0f / kSampleRate);
+  set_frequency(220.0f / sample_rate);
   set_geometry(0.25f);
   set_brightness(0.5f);
   set_damping(0.3f);
   set_position(0.999f);
   previous_position_ = 0.0f;
   set_resolution(kMaxModes);
+  set_kernel(SVF_BANK_KERNEL_SIMD);
   
   bow_signal_ = 0.0f;
 }
@@ -65,7 +64,8 @@ size_t Resonator::ComputeFilters() {
   float stiffness = Interpolate(lut_stiffness, geometry_, 256.0f);
   float harmonic = frequency_;
   float stretch_factor = 1.0f; 
-  float q = 500.0f * Interpolate(
+  // The decay time in samples is about q.
+  float q = 500.0f / rate_ratio_ * Interpolate(
       lut_4_decades,
       damping_ * 0.8f,
       256.0f);
@@ -79,27 +79,21 @@ size_t Resonator::ComputeFilters() {
   float q_loss = brightness * (2.0f - brightness) * 0.85f + 0.15f;
   float q_loss_damping_rate = geometry_ * (2.0f - geometry_) * 0.1f;
   size_t num_modes = 0;
-  for (size_t i = 0; i < min(kMaxModes, resolution_); ++i) {
-    // Update the first 24 modes every time (2kHz). The higher modes are
-    // refreshed as a slowest rate.
-    bool update = i <= 24 || ((i & 1) == (clock_divider_ & 1));
-    float partial_frequency = harmonic * stretch_factor;
-    if (partial_frequency >= 0.49f) {
-      partial_frequency = 0.49f;
+  size_t num_filters = min(kMaxModes, resolution_);
+  
+  // The recurrences are evaluated first, then the filter coefficients are
+  // computed for the whole bank at once.
+  float partial_frequency[kMaxModes];
+  float partial_resonance[kMaxModes];
+  for (size_t i = 0; i < num_filters; ++i) {
+    float f = harmonic * stretch_factor;
+    if (f >= 0.49f) {
+      f = 0.49f;
     } else {
       num_modes = i + 1;
     }
-    if (update) {
-      f_[i].set_f_q<FREQUENCY_FAST>(
-          partial_frequency,
-          1.0f + partial_frequency * q);
-      if (i < kMaxBowedModes) {
-        size_t period = 1.0f / partial_frequency;
-        while (period >= kMaxDelayLineSize) period >>= 1;
-        d_bow_[i].set_delay(period);
-        f_bow_[i].set_g_q(f_[i].g(), 1.0f + partial_frequency * 1500.0f);
-      }
-    }
+    partial_frequency[i] = f;
+    partial_resonance[i] = 1.0f + f * q;
     stretch_factor += stiffness;
     if (stiffness < 0.0f) {
       // Make sure that the partials do not fold back into negative frequencies.
@@ -114,6 +108,34 @@ size_t Resonator::ComputeFilters() {
     q *= q_loss;
   }
   
+  if (kernel_ == SVF_BANK_KERNEL_SIMD) {
+    f_.set_f_q<FREQUENCY_FAST>(
+        kernel_,
+        partial_frequency,
+        partial_resonance,
+        num_filters);
+  } else {
+    for (size_t i = 0; i < num_filters; ++i) {
+      // Update the first 24 modes every time (2kHz). The higher modes are
+      // refreshed as a slowest rate.
+      bool update = i <= 24 || ((i & 1) == (clock_divider_ & 1));
+      if (update) {
+        f_.set_f_q<FREQUENCY_FAST>(
+            i,
+            partial_frequency[i],
+            partial_resonance[i]);
+      }
+    }
+  }
+  
+  for (size_t i = 0; i < min(kMaxBowedModes, num_filters); ++i) {
+    float f = partial_frequency[i];
+    size_t period = 1.0f / f;
+    while (period >= kMaxDelayLineSize) period >>= 1;
+    d_bow_[i].set_delay(period);
+    f_bow_.set_g_q(i, f_.g(i), 1.0f + f * 1500.0f / rate_ratio_);
+  }
+  
   return num_modes;
 }
 
@@ -124,10 +146,27 @@ void Resonator::Process(
     float* sides,
     size_t size) {
   size_t num_modes = ComputeFilters();
+  if (kernel_ == SVF_BANK_KERNEL_SIMD) {
+    ProcessSimd(num_modes, bow_strength, in, center, sides, size);
+  } else {
+    ProcessScalar(num_modes, bow_strength, in, center, sides, size);
+  }
+}
+
+void Resonator::ProcessScalar(
+    size_t num_modes,
+    const float* bow_strength,
+    const float* in,
+    float* center,
+    float* sides,
+    size_t size) {
   size_t num_banded_wg = min(kMaxBowedModes, num_modes);
   // Linearly interpolate position. This parameter is extremely sensitive to
   // zipper noise.
   float position_increment = (position_ - previous_position_) / size;
+  float band_pass[kMaxModes];
+  float bow_input[kMaxBowedModes];
+  float bow_output[kMaxBowedModes];
   while (size--) {
     float s;
 
@@ -158,10 +197,15 @@ void Resonator::Process(
     // partials may not be in an integer ratios, what we are doing here is
     // approximative when the stretch factor is non null.
     // It sounds interesting nevertheless.
+    f_.Process<FILTER_MODE_BAND_PASS>(
+        SVF_BANK_KERNEL_SCALAR,
+        input,
+        band_pass,
+        num_modes);
     amplitudes.Start();
     aux_amplitudes.Start();
     for (size_t i = 0; i < num_modes; i++) {
-      s = f_[i].Process<FILTER_MODE_BAND_PASS>(input);
+      s = band_pass[i];
       sum_center += s * amplitudes.Next();
       sum_side += s * aux_amplitudes.Next();
     }
@@ -170,11 +214,19 @@ void Resonator::Process(
     // Render bowed modes.
     float bow_signal = 0.0f;
     input += bow_signal_;
-    amplitudes.Start();
     for (size_t i = 0; i < num_banded_wg; ++i) {
       s = 0.99f * d_bow_[i].Read();
       bow_signal += s;
-      s = f_bow_[i].Process<FILTER_MODE_BAND_PASS_NORMALIZED>(input + s);
+      bow_input[i] = input + s;
+    }
+    f_bow_.Process<FILTER_MODE_BAND_PASS_NORMALIZED>(
+        SVF_BANK_KERNEL_SCALAR,
+        bow_input,
+        bow_output,
+        num_banded_wg);
+    amplitudes.Start();
+    for (size_t i = 0; i < num_banded_wg; ++i) {
+      s = bow_output[i];
       d_bow_[i].Write(s);
       sum_center += s * amplitudes.Next() * 8.0f;
     }
@@ -183,4 +235,65 @@ void Resonator::Process(
   }
 }
 
+void Resonator::ProcessSimd(
+    size_t num_modes,
+    const float* bow_strength,
+    const float* in,
+    float* center,
+    float* sides,
+    size_t size) {
+  size_t num_banded_wg = min(kMaxBowedModes, num_modes);
+  float position_increment = (position_ - previous_position_) / size;
+  float band_pass[kMaxModes];
+  float amplitude[kMaxModes];
+  float aux_amplitude[kMaxModes];
+  float bow_input[kMaxBowedModes];
+  float bow_output[kMaxBowedModes];
+  while (size--) {
+    lfo_phase_ += modulation_frequency_;
+    if (lfo_phase_ >= 1.0f) {
+      lfo_phase_ -= 1.0f;
+    }
+    previous_position_ += position_increment;
+    float lfo = lfo_phase_ > 0.5f ? 1.0f - lfo_phase_ : lfo_phase_;
+    CosineOscillator amplitudes;
+    CosineOscillator aux_amplitudes;
+    amplitudes.Init<COSINE_OSCILLATOR_APPROXIMATE>(previous_position_);
+    aux_amplitudes.Init<COSINE_OSCILLATOR_APPROXIMATE>(
+        modulation_offset_ + lfo);
+    for (size_t i = 0; i < num_modes; ++i) {
+      amplitude[i] = amplitudes.Next();
+      aux_amplitude[i] = aux_amplitudes.Next();
+    }
+    
+    // Normal modes, with the pickup amplitudes applied as two dot products.
+    float input = *in++ * 0.125f;
+    f_.Process<FILTER_MODE_BAND_PASS>(kernel_, input, band_pass, num_modes);
+    float sum_center = SimdDot(band_pass, amplitude, num_modes);
+    float sum_side = SimdDot(band_pass, aux_amplitude, num_modes);
+    *sides++ = sum_side - sum_center;
+    
+    // Bowed modes. The delay lines have different lengths, so the reads and
+    // writes are gathered/scattered around the filters, which run in lanes.
+    float bow_signal = 0.0f;
+    input += bow_signal_;
+    for (size_t i = 0; i < num_banded_wg; ++i) {
+      float s = 0.99f * d_bow_[i].Read();
+      bow_signal += s;
+      bow_input[i] = input + s;
+    }
+    f_bow_.Process<FILTER_MODE_BAND_PASS_NORMALIZED>(
+        kernel_,
+        bow_input,
+        bow_output,
+        num_banded_wg);
+    for (size_t i = 0; i < num_banded_wg; ++i) {
+      d_bow_[i].Write(bow_output[i]);
+    }
+    sum_center += 8.0f * SimdDot(bow_output, amplitude, num_banded_wg);
+    bow_signal_ = BowTable(bow_signal, *bow_strength++);
+    *center++ = sum_center;
+  }
+}
+
 }  // namespace elements
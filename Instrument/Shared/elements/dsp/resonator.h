@@ -37,6 +37,7 @@
 #include "elements/dsp/dsp.h"
 #include "stmlib/dsp/filter.h"
 #include "stmlib/dsp/delay_line.h"
+#include "stmlib/dsp/svf_bank.h"
 
 namespace elements {
 
@@ -49,7 +50,7 @@ class Resonator {
   Resonator() { }
   ~Resonator() { }
   
-  void Init();
+  void Init(float sample_rate);
   void Process(
       const float* bow_strength,
       const float* in,
@@ -89,6 +90,18 @@ class Resonator {
     modulation_offset_ = modulation_offset;
   }
   
+  // The scalar kernel is the reference implementation. The SIMD kernel
+  // refreshes all the modes at every block instead of updating the higher
+  // modes at half rate, and sums the modes in a different order, so its
+  // output is not bit-identical to the scalar one.
+  inline void set_kernel(stmlib::SvfBankKernel kernel) {
+    kernel_ = kernel;
+  }
+  
+  inline stmlib::SvfBankKernel kernel() const {
+    return kernel_;
+  }
+  
   inline float BowTable(float x, float velocity) const {
     x = 0.13f * velocity - x;
     float bow = x;
@@ -104,6 +117,20 @@ class Resonator {
   
  private:
   size_t ComputeFilters();
+  void ProcessScalar(
+      size_t num_modes,
+      const float* bow_strength,
+      const float* in,
+      float* center,
+      float* sides,
+      size_t size);
+  void ProcessSimd(
+      size_t num_modes,
+      const float* bow_strength,
+      const float* in,
+      float* center,
+      float* sides,
+      size_t size);
   
   float frequency_;
   float geometry_;
@@ -111,6 +138,7 @@ class Resonator {
   float position_;
   float previous_position_;
   float damping_;
+  float rate_ratio_;
   
   float modulation_frequency_;
   float modulation_offset_;
@@ -119,9 +147,10 @@ class Resonator {
   float bow_signal_;
   
   size_t resolution_;
+  stmlib::SvfBankKernel kernel_;
   
-  stmlib::Svf f_[kMaxModes];
-  stmlib::Svf f_bow_[kMaxBowedModes];
+  stmlib::SvfBank<kMaxModes> f_;
+  stmlib::SvfBank<kMaxBowedModes> f_bow_;
   stmlib::DelayLine<float, kMaxDelayLineSize> d_bow_[kMaxBowedModes];
   
   size_t clock_divider_;
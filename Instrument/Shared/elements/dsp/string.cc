@@ -33,7 +33,6 @@
 #include "stmlib/dsp/dsp.h"
 #include "stmlib/dsp/parameter_interpolator.h"
 #include "stmlib/dsp/units.h"
-#include "stmlib/utils/random.h"
 
 #include "elements/dsp/dsp.h"
 #include "elements/resources.h"
@@ -43,15 +42,20 @@ namespace elements {
 using namespace std;
 using namespace stmlib;
 
-void String::Init(bool enable_dispersion) {
+void String::Init(
+    bool enable_dispersion,
+    float sample_rate,
+    RandomStream* random) {
   enable_dispersion_ = enable_dispersion;
+  sample_rate_ = sample_rate;
+  random_ = random;
   
   string_.Init();
   stretch_.Init();
   fir_damping_filter_.Init();
   iir_damping_filter_.Init();
   
-  set_frequency(220.0f / kSampleRate);
+  set_frequency(220.0f / sample_rate);
   set_dispersion(0.25f);
   set_brightness(0.5f);
   set_damping(0.3f);
@@ -67,7 +71,7 @@ void String::Init(bool enable_dispersion) {
   out_sample_[0] = out_sample_[1] = 0.0f;
   aux_sample_[0] = aux_sample_[1] = 0.0f;
   
-  dc_blocker_.Init(1.0f - 20.0f / kSampleRate);
+  dc_blocker_.Init(1.0f - 20.0f / sample_rate);
 }
 
 template<bool enable_dispersion>
@@ -102,7 +106,7 @@ void String::ProcessInternal(
   
   // For damping/absorption, the interpolation is done in the filter code.
   float lf_damping = damping_ * (2.0f - damping_);
-  float rt60 = 0.07f * SemitonesToRatio(lf_damping * 96.0f) * kSampleRate;
+  float rt60 = 0.07f * SemitonesToRatio(lf_damping * 96.0f) * sample_rate_;
   float rt60_base_2_12 = max(-120.0f * delay / src_ratio / rt60, -127.0f);
   float damping_coefficient = SemitonesToRatio(rt60_base_2_12);
   float brightness = brightness_ * brightness_;
@@ -144,7 +148,7 @@ void String::ProcessInternal(
       float s = 0.0f;
 
       if (enable_dispersion) {
-        float noise = 2.0f * Random::GetFloat() - 1.0f;
+        float noise = 2.0f * random_->GetFloat() - 1.0f;
         noise *= 1.0f / (0.2f + noise_filter);
         dispersion_noise_ += noise_filter * (noise - dispersion_noise_);
 
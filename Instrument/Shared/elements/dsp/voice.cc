@@ -38,11 +38,13 @@ namespace elements {
 using namespace std;
 using namespace stmlib;
 
-void Voice::Init() {
-  envelope_.Init();
-  bow_.Init();
-  blow_.Init();
-  strike_.Init();
+void Voice::Init(float sample_rate, uint32_t seed) {
+  sample_rate_ = sample_rate;
+  random_.Init(seed);
+  envelope_.Init(sample_rate);
+  bow_.Init(sample_rate, &random_);
+  blow_.Init(sample_rate, &random_);
+  strike_.Init(sample_rate, &random_);
   diffuser_.Init(diffuser_buffer_);
   
   ResetResonator();
@@ -65,11 +67,11 @@ void Voice::Init() {
 }
 
 void Voice::ResetResonator() {
-  resonator_.Init();
+  resonator_.Init(sample_rate_);
   for (size_t i = 0; i < kNumStrings; ++i) {
-    string_[i].Init(true);
+    string_[i].Init(true, sample_rate_, &random_);
   }
-  dc_blocker_.Init(1.0f - 10.0f / kSampleRate);
+  dc_blocker_.Init(1.0f - 10.0f / sample_rate_);
   resonator_.set_resolution(52);  // Runs with 56 extremely tightly.
 }
 
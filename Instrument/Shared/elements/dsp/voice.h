@@ -32,6 +32,7 @@
 #include "stmlib/stmlib.h"
 
 #include "stmlib/dsp/filter.h"
+#include "stmlib/utils/random_stream.h"
 
 #include "elements/dsp/dsp.h"
 #include "elements/dsp/exciter.h"
@@ -58,7 +59,7 @@ class Voice {
   Voice() { }
   ~Voice() { }
   
-  void Init();
+  void Init(float sample_rate, uint32_t seed);
   void Process(
       const Patch& patch,
       float frequency,
@@ -78,6 +79,13 @@ class Voice {
   void set_resonator_model(ResonatorModel resonator_model) {
     resonator_model_ = resonator_model;
   }
+  void set_samples(
+      const int16_t* sample_data,
+      const uint32_t* boundaries,
+      const int16_t* noise_sample) {
+    blow_.set_samples(sample_data, boundaries, noise_sample);
+    strike_.set_samples(sample_data, boundaries, noise_sample);
+  }
   
  private:
   void ResetResonator();
@@ -104,6 +112,9 @@ class Voice {
   Resonator resonator_;
   String string_[kNumStrings];
   stmlib::DCBlocker dc_blocker_;
+  stmlib::RandomStream random_;
+  
+  float sample_rate_;
   
   float strength_;
   float envelope_value_;
@@ -116,7 +127,7 @@ class Voice {
   float strike_buffer_[kMaxBlockSize];
   float external_buffer_[kMaxBlockSize];
   
-  float diffuser_buffer_[1024];
+  float diffuser_buffer_[2048];
   
   bool previous_gate_;
   
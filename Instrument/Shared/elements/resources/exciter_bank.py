@@ -0,0 +1,85 @@
+#!/usr/bin/python
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+# See http://creativecommons.org/licenses/MIT/ for more information.
+#
+# -----------------------------------------------------------------------------
+#
+# Sample bank for the exciters.
+#
+# Usage: exciter_bank.py hit_01.wav ... hit_09.wav [--noise noise.wav] out.bank
+#
+# Same material as samples.py: the 9 hits played by the strike sample player,
+# and the noise played by the granular sample player of the blow exciter.
+# All are mono 16-bit files. Without --noise, the exciter keeps the noise of
+# the module.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.path.dirname(__file__), '../../stmlib/utils'))
+
+import sample_bank
+
+NUM_HITS = 9
+
+# The granular player reads up to 8192 + 32768 samples into the noise.
+MIN_NOISE_SIZE = 40963
+
+
+def Quantize(audio_data):
+  return [max(min(int(round(x * 32767.0)), 32767), -32767)
+          for x in audio_data]
+
+
+def main(argv):
+  args = argv[1:]
+  noise = None
+  if '--noise' in args:
+    i = args.index('--noise')
+    noise = args[i + 1]
+    del args[i:i + 2]
+  if len(args) != NUM_HITS + 1:
+    sys.exit('usage: %s hit_01.wav ... hit_%02d.wav [--noise noise.wav] '
+             'out.bank' % (argv[0], NUM_HITS))
+
+  boundaries = [0]
+  sample_data = []
+  for file_name in args[:NUM_HITS]:
+    audio_data = sample_bank.ReadWavFile(file_name)
+    if not audio_data:
+      sys.exit('%s: empty file' % file_name)
+    audio_data += [audio_data[-1]]  # Add interpolation tail
+    sample_data += Quantize(audio_data)
+    boundaries.append(boundaries[-1] + len(audio_data))
+
+  sections = [
+      ('HITS', 'h', 0, sample_data),
+      ('BNDS', 'I', 0, boundaries)]
+  if noise:
+    audio_data = sample_bank.ReadWavFile(noise)
+    if len(audio_data) < MIN_NOISE_SIZE:
+      sys.exit('%s: at least %d samples needed' % (noise, MIN_NOISE_SIZE))
+    sections += [('NOIS', 'h', 0, Quantize(audio_data))]
+  sample_bank.WriteSampleBank(args[NUM_HITS], sections)
+
+
+if __name__ == '__main__':
+  main(sys.argv)
@@ -35,7 +35,7 @@
 #include "stmlib/dsp/filter.h"
 #include "stmlib/dsp/parameter_interpolator.h"
 #include "stmlib/dsp/units.h"
-#include "stmlib/utils/random.h"
+#include "stmlib/utils/random_stream.h"
 
 #include "plaits/dsp/dsp.h"
 #include "plaits/dsp/oscillator/sine_oscillator.h"
@@ -49,7 +49,8 @@ class AnalogSnareDrum {
 
   static const int kNumModes = 5;
 
-  void Init() {
+  void Init(stmlib::RandomStream* random) {
+    random_ = random;
     pulse_remaining_samples_ = 0;
     pulse_ = 0.0f;
     pulse_height_ = 0.0f;
@@ -136,6 +137,9 @@ class AnalogSnareDrum {
         accent * decay,
         size);
     
+    // The noise is generated in the output buffer, and replaced sample by
+    // sample.
+    random_->Fill(out, size);
     while (size--) {
       // Q45 / Q46
       float pulse = 0.0f;
@@ -166,7 +170,7 @@ class AnalogSnareDrum {
       shell = stmlib::SoftClip(shell);
       
       // C56 / R194 / Q48 / C54 / R188 / D54
-      float noise = 2.0f * stmlib::Random::GetFloat() - 1.0f;
+      float noise = 2.0f * *out - 1.0f;
       if (noise < 0.0f) noise = 0.0f;
       noise_envelope_ *= noise_envelope_decay;
       noise *= (sustain ? sustain_gain_value : noise_envelope_) * snappy * 2.0f;
@@ -180,6 +184,8 @@ class AnalogSnareDrum {
   }
 
  private:
+  stmlib::RandomStream* random_;
+  
   int pulse_remaining_samples_;
   float pulse_;
   float pulse_height_;
@@ -37,7 +37,7 @@
 #include "stmlib/dsp/filter.h"
 #include "stmlib/dsp/parameter_interpolator.h"
 #include "stmlib/dsp/units.h"
-#include "stmlib/utils/random.h"
+#include "stmlib/utils/random_stream.h"
 
 #include "plaits/dsp/dsp.h"
 #include "plaits/dsp/oscillator/oscillator.h"
@@ -166,7 +166,8 @@ class HiHat {
   HiHat() { }
   ~HiHat() { }
 
-  void Init() {
+  void Init(stmlib::RandomStream* random) {
+    random_ = random;
     envelope_ = 0.0f;
     noise_clock_ = 0.0f;
     noise_sample_ = 0.0f;
@@ -221,7 +222,7 @@ class HiHat {
       noise_clock_ += noise_f;
       if (noise_clock_ >= 1.0f) {
         noise_clock_ -= 1.0f;
-        noise_sample_ = stmlib::Random::GetFloat() - 0.5f;
+        noise_sample_ = random_->GetFloat() - 0.5f;
       }
       out[i] += noisiness * (noise_sample_ - out[i]);
     }
@@ -242,6 +243,8 @@ class HiHat {
   }
 
  private:
+  stmlib::RandomStream* random_;
+  
   float envelope_;
   float noise_clock_;
   float noise_sample_;
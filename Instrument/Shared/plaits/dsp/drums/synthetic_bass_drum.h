@@ -32,7 +32,7 @@
 
 #include "stmlib/dsp/dsp.h"
 #include "stmlib/dsp/units.h"
-#include "stmlib/utils/random.h"
+#include "stmlib/utils/random_stream.h"
 
 #include "plaits/dsp/dsp.h"
 #include "plaits/resources.h"
@@ -70,19 +70,21 @@ class SyntheticBassDrumAttackNoise {
   SyntheticBassDrumAttackNoise() { }
   ~SyntheticBassDrumAttackNoise() { }
   
-  void Init() {
+  void Init(stmlib::RandomStream* random) {
+    random_ = random;
     lp_ = 0.0f;
     hp_ = 0.0f;
   }
   
   float Render() {
-    float sample = stmlib::Random::GetFloat();
+    float sample = random_->GetFloat();
     ONE_POLE(lp_, sample, 0.05f);
     ONE_POLE(hp_, lp_, 0.005f);
     return lp_ - hp_;
   }
   
  private:
+  stmlib::RandomStream* random_;
   float lp_;
   float hp_;
   
@@ -94,7 +96,8 @@ class SyntheticBassDrum {
   SyntheticBassDrum() { }
   ~SyntheticBassDrum() { }
 
-  void Init() {
+  void Init(stmlib::RandomStream* random) {
+    random_ = random;
     phase_ = 0.0f;
     phase_noise_ = 0.0f;
     f0_ = 0.0f;
@@ -108,7 +111,7 @@ class SyntheticBassDrum {
     sustain_gain_ = 0.0f;
     
     click_.Init();
-    noise_.Init();
+    noise_.Init(random);
   }
   
   inline float DistortedSine(float phase, float phase_noise, float dirtiness) {
@@ -170,7 +173,7 @@ class SyntheticBassDrum {
         size);
     
     while (size--) {
-      ONE_POLE(phase_noise_, stmlib::Random::GetFloat() - 0.5f, 0.002f);
+      ONE_POLE(phase_noise_, random_->GetFloat() - 0.5f, 0.002f);
       
       float mix = 0.0f;
 
@@ -220,6 +223,8 @@ class SyntheticBassDrum {
   }
 
  private:
+  stmlib::RandomStream* random_;
+  
   float f0_;
   float phase_;
   float phase_noise_;
@@ -38,6 +38,7 @@
 #include "stmlib/dsp/dsp.h"
 #include "stmlib/dsp/parameter_interpolator.h"
 #include "stmlib/dsp/units.h"
+#include "stmlib/utils/random_stream.h"
 
 #include "plaits/dsp/dsp.h"
 
@@ -48,7 +49,8 @@ class SyntheticSnareDrum {
   SyntheticSnareDrum() { }
   ~SyntheticSnareDrum() { }
 
-  void Init() {
+  void Init(stmlib::RandomStream* random) {
+    random_ = random;
     phase_[0] = 0.0f;
     phase_[1] = 0.0f;
     drum_amplitude_ = 0.0f;
@@ -111,6 +113,10 @@ class SyntheticSnareDrum {
         &sustain_gain_,
         accent * decay,
         size);
+    
+    // The raw noise is generated in the output buffer, and replaced sample by
+    // sample.
+    random_->Fill(out, size);
     while (size--) {
       if (sustain) {
         snare_amplitude_ = sustain_gain.Next();
@@ -169,7 +175,7 @@ class SyntheticSnareDrum {
       drum *= drum_amplitude_ * drum_level;
       drum = drum_lp_.Process<stmlib::FILTER_MODE_LOW_PASS>(drum);
       
-      float noise = stmlib::Random::GetFloat();
+      float noise = *out;
       float snare = snare_lp_.Process<stmlib::FILTER_MODE_LOW_PASS>(noise);
       snare = snare_hp_.Process<stmlib::FILTER_MODE_HIGH_PASS>(snare);
       snare = (snare + 0.1f) * (snare_amplitude_ + fm_) * snare_level;
@@ -179,6 +185,8 @@ class SyntheticSnareDrum {
   }
 
  private:
+  stmlib::RandomStream* random_;
+  
   float phase_[2];
   float drum_amplitude_;
   float snare_amplitude_;
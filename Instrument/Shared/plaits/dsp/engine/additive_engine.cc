@@ -39,7 +39,7 @@ namespace plaits {
 using namespace std;
 using namespace stmlib;
 
-void AdditiveEngine::Init(BufferAllocator* allocator) {
+void AdditiveEngine::Init(BufferAllocator* allocator, RandomStream* random) {
   fill(
       &amplitudes_[0],
       &amplitudes_[kNumHarmonics],
@@ -106,9 +106,13 @@ inline float Bump(float x, float centroid, float slope) {
   return bump + fabsf(bump);
 }
 
-const int integer_harmonics[24] = {
+const int integer_harmonics[96] = {
   0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
-  16, 17, 18, 19, 20, 21, 22, 23
+  16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+  32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47,
+  48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63,
+  64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79,
+  80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95
 };
 
 const int organ_harmonics[8] = {
@@ -134,19 +138,26 @@ void AdditiveEngine::Render(
       bumps,
       &amplitudes_[0],
       integer_harmonics,
-      24);
-  harmonic_oscillator_[0].Render<1>(f0, &amplitudes_[0], out, size);
-  harmonic_oscillator_[1].Render<13>(f0, &amplitudes_[12], out, size);
+      kNumIntegerHarmonics);
+  for (int i = 0; i < kNumIntegerHarmonics / kHarmonicBatchSize; ++i) {
+    harmonic_oscillator_[i].Render(
+        1 + i * kHarmonicBatchSize,
+        f0,
+        &amplitudes_[i * kHarmonicBatchSize],
+        out,
+        size);
+  }
 
   UpdateAmplitudes(
       centroid,
       slope,
       bumps,
-      &amplitudes_[24],
+      &amplitudes_[kNumIntegerHarmonics],
       organ_harmonics,
-      8);
+      kNumOrganHarmonics);
 
-  harmonic_oscillator_[2].Render<1>(f0, &amplitudes_[24], aux, size);
+  harmonic_oscillator_[kNumHarmonicOscillators - 1].Render(
+      1, f0, &amplitudes_[kNumIntegerHarmonics], aux, size);
 }
 
 }  // namespace plaits
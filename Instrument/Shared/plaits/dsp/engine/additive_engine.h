@@ -24,7 +24,8 @@
 //
 // -----------------------------------------------------------------------------
 //
-// Additive synthesis with 24+8 partials.
+// Additive synthesis with 24+8 partials (or more, see
+// PLAITS_NUM_ADDITIVE_HARMONICS).
 
 #ifndef PLAITS_DSP_ENGINE_ADDITIVE_ENGINE_H_
 #define PLAITS_DSP_ENGINE_ADDITIVE_ENGINE_H_
@@ -34,16 +35,34 @@
 
 namespace plaits {
   
+// Integer harmonics of the main output. The module renders 24 of them; with
+// the oscillators rendering several samples at once, builds for faster
+// targets can afford more, and raise the count with
+// PLAITS_NUM_ADDITIVE_HARMONICS. The aux output always renders the 8 organ
+// harmonics, in a batch of their own.
+#ifndef PLAITS_NUM_ADDITIVE_HARMONICS
+#define PLAITS_NUM_ADDITIVE_HARMONICS 24
+#endif  // PLAITS_NUM_ADDITIVE_HARMONICS
+
 const int kHarmonicBatchSize = 12;
-const int kNumHarmonics = 36;
+const int kNumIntegerHarmonics = PLAITS_NUM_ADDITIVE_HARMONICS;
+const int kNumOrganHarmonics = 8;
+const int kNumHarmonics = kNumIntegerHarmonics + kHarmonicBatchSize;
 const int kNumHarmonicOscillators = kNumHarmonics / kHarmonicBatchSize;
 
+STATIC_ASSERT(
+    kNumIntegerHarmonics % kHarmonicBatchSize == 0 && \
+        kNumIntegerHarmonics <= 96,
+    num_additive_harmonics_must_be_a_multiple_of_the_batch_size);
+
 class AdditiveEngine : public Engine {
  public:
   AdditiveEngine() { }
   ~AdditiveEngine() { }
   
-  virtual void Init(stmlib::BufferAllocator* allocator);
+  virtual void Init(
+      stmlib::BufferAllocator* allocator,
+      stmlib::RandomStream* random);
   virtual void Reset();
   virtual void Render(const EngineParameters& parameters,
       float* out,
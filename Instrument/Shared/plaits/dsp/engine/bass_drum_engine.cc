@@ -35,9 +35,9 @@ namespace plaits {
 using namespace std;
 using namespace stmlib;
 
-void BassDrumEngine::Init(BufferAllocator* allocator) {
+void BassDrumEngine::Init(BufferAllocator* allocator, RandomStream* random) {
   analog_bass_drum_.Init();
-  synthetic_bass_drum_.Init();
+  synthetic_bass_drum_.Init(random);
   overdrive_.Init();
 }
 
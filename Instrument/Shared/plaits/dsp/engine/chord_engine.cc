@@ -51,7 +51,7 @@ const float chords[kChordNumChords][kChordNumNotes] = {
   { 0.00f, 4.00f,  7.00f, 12.00f },  // M
 };
 
-void ChordEngine::Init(BufferAllocator* allocator) {
+void ChordEngine::Init(BufferAllocator* allocator, RandomStream* random) {
   for (int i = 0; i < kChordNumVoices; ++i) {
     divide_down_voice_[i].Init();
     wavetable_voice_[i].Init();
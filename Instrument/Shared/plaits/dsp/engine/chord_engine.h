@@ -47,7 +47,9 @@ class ChordEngine : public Engine {
   ChordEngine() { }
   ~ChordEngine() { }
   
-  virtual void Init(stmlib::BufferAllocator* allocator);
+  virtual void Init(
+      stmlib::BufferAllocator* allocator,
+      stmlib::RandomStream* random);
   virtual void Reset();
   virtual void Render(const EngineParameters& parameters,
       float* out,
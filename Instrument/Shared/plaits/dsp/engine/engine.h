@@ -33,6 +33,7 @@
 
 #include "stmlib/dsp/units.h"
 #include "stmlib/utils/buffer_allocator.h"
+#include "stmlib/utils/random_stream.h"
 
 namespace plaits {
 
@@ -79,7 +80,9 @@ class Engine {
  public:
   Engine() { }
   ~Engine() { }
-  virtual void Init(stmlib::BufferAllocator* allocator) = 0;
+  virtual void Init(
+      stmlib::BufferAllocator* allocator,
+      stmlib::RandomStream* random) = 0;
   virtual void Reset() = 0;
   virtual void Render(
       const EngineParameters& parameters,
@@ -36,7 +36,7 @@ namespace plaits {
 
 using namespace stmlib;
 
-void FMEngine::Init(BufferAllocator* allocator) {
+void FMEngine::Init(BufferAllocator* allocator, RandomStream* random) {
   carrier_phase_ = 0;
   modulator_phase_ = 0;
   sub_phase_ = 0;
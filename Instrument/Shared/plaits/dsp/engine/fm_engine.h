@@ -38,7 +38,9 @@ class FMEngine : public Engine {
   FMEngine() { }
   ~FMEngine() { }
   
-  virtual void Init(stmlib::BufferAllocator* allocator);
+  virtual void Init(
+      stmlib::BufferAllocator* allocator,
+      stmlib::RandomStream* random);
   virtual void Reset();
   virtual void Render(const EngineParameters& parameters,
       float* out,
@@ -35,7 +35,7 @@ namespace plaits {
 using namespace std;
 using namespace stmlib;
 
-void GrainEngine::Init(BufferAllocator* allocator) {
+void GrainEngine::Init(BufferAllocator* allocator, RandomStream* random) {
   grainlet_[0].Init();
   grainlet_[1].Init();
   // vosim_oscillator_.Init();
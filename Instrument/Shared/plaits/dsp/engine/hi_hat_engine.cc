@@ -33,9 +33,9 @@ namespace plaits {
 
 using namespace stmlib;
 
-void HiHatEngine::Init(BufferAllocator* allocator) {
-  hi_hat_1_.Init();
-  hi_hat_2_.Init();
+void HiHatEngine::Init(BufferAllocator* allocator, RandomStream* random) {
+  hi_hat_1_.Init(random);
+  hi_hat_2_.Init(random);
   temp_buffer_[0] = allocator->Allocate<float>(kMaxBlockSize);
   temp_buffer_[1] = allocator->Allocate<float>(kMaxBlockSize);
 }
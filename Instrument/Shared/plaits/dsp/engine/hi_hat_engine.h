@@ -40,7 +40,9 @@ class HiHatEngine : public Engine {
   HiHatEngine() { }
   ~HiHatEngine() { }
   
-  virtual void Init(stmlib::BufferAllocator* allocator);
+  virtual void Init(
+      stmlib::BufferAllocator* allocator,
+      stmlib::RandomStream* random);
   virtual void Reset();
   virtual void Render(const EngineParameters& parameters,
       float* out,
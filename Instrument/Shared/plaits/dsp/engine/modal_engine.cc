@@ -35,14 +35,14 @@ namespace plaits {
 using namespace std;
 using namespace stmlib;
 
-void ModalEngine::Init(BufferAllocator* allocator) {
+void ModalEngine::Init(BufferAllocator* allocator, RandomStream* random) {
   temp_buffer_ = allocator->Allocate<float>(kMaxBlockSize);
   harmonics_lp_ = 0.0f;
-  Reset();
+  voice_.Init(random);
 }
 
 void ModalEngine::Reset() {
-  voice_.Init();
+  voice_.Reset();
 }
 
 void ModalEngine::Render(
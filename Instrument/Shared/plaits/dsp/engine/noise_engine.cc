@@ -35,9 +35,9 @@ namespace plaits {
 using namespace std;
 using namespace stmlib;
 
-void NoiseEngine::Init(BufferAllocator* allocator) {
-  clocked_noise_[0].Init();
-  clocked_noise_[1].Init();
+void NoiseEngine::Init(BufferAllocator* allocator, RandomStream* random) {
+  clocked_noise_[0].Init(random);
+  clocked_noise_[1].Init(random);
   lp_hp_filter_.Init();
   bp_filter_[0].Init();
   bp_filter_[1].Init();
@@ -41,7 +41,9 @@ class NoiseEngine : public Engine {
   NoiseEngine() { }
   ~NoiseEngine() { }
   
-  virtual void Init(stmlib::BufferAllocator* allocator);
+  virtual void Init(
+      stmlib::BufferAllocator* allocator,
+      stmlib::RandomStream* random);
   virtual void Reset();
   virtual void Render(const EngineParameters& parameters,
       float* out,
@@ -35,9 +35,9 @@ namespace plaits {
 using namespace std;
 using namespace stmlib;
 
-void ParticleEngine::Init(BufferAllocator* allocator) {
+void ParticleEngine::Init(BufferAllocator* allocator, RandomStream* random) {
   for (int i = 0; i < kNumParticles; ++i) {
-    particle_[i].Init();
+    particle_[i].Init(random);
   }
   diffuser_.Init(allocator->Allocate<uint16_t>(8192));
   post_filter_.Init();
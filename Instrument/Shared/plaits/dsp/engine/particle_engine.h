@@ -42,7 +42,9 @@ class ParticleEngine : public Engine {
   ParticleEngine() { }
   ~ParticleEngine() { }
   
-  virtual void Init(stmlib::BufferAllocator* allocator);
+  virtual void Init(
+      stmlib::BufferAllocator* allocator,
+      stmlib::RandomStream* random);
   virtual void Reset();
   virtual void Render(const EngineParameters& parameters,
       float* out,
@@ -35,9 +35,9 @@ namespace plaits {
 using namespace std;
 using namespace stmlib;
 
-void SnareDrumEngine::Init(BufferAllocator* allocator) {
-  analog_snare_drum_.Init();
-  synthetic_snare_drum_.Init();
+void SnareDrumEngine::Init(BufferAllocator* allocator, RandomStream* random) {
+  analog_snare_drum_.Init(random);
+  synthetic_snare_drum_.Init(random);
 }
 
 void SnareDrumEngine::Reset() {
@@ -40,7 +40,9 @@ class SnareDrumEngine : public Engine {
   SnareDrumEngine() { }
   ~SnareDrumEngine() { }
   
-  virtual void Init(stmlib::BufferAllocator* allocator);
+  virtual void Init(
+      stmlib::BufferAllocator* allocator,
+      stmlib::RandomStream* random);
   virtual void Reset();
   virtual void Render(const EngineParameters& parameters,
       float* out,
@@ -35,14 +35,14 @@ namespace plaits {
 using namespace std;
 using namespace stmlib;
 
-void SpeechEngine::Init(BufferAllocator* allocator) {
+void SpeechEngine::Init(BufferAllocator* allocator, RandomStream* random) {
   sam_speech_synth_.Init();
   naive_speech_synth_.Init();
   lpc_speech_synth_word_bank_.Init(
       word_banks_,
       LPC_SPEECH_SYNTH_NUM_WORD_BANKS,
       allocator);
-  lpc_speech_synth_controller_.Init(&lpc_speech_synth_word_bank_);
+  lpc_speech_synth_controller_.Init(&lpc_speech_synth_word_bank_, random);
   word_bank_quantizer_.Init();
   
   temp_buffer_[0] = allocator->Allocate<float>(kMaxBlockSize);
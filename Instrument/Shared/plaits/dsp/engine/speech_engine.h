@@ -43,7 +43,9 @@ class SpeechEngine : public Engine {
   SpeechEngine() { }
   ~SpeechEngine() { }
   
-  virtual void Init(stmlib::BufferAllocator* allocator);
+  virtual void Init(
+      stmlib::BufferAllocator* allocator,
+      stmlib::RandomStream* random);
   virtual void Reset();
   virtual void Render(const EngineParameters& parameters,
       float* out,
@@ -35,10 +35,10 @@ namespace plaits {
 using namespace std;
 using namespace stmlib;
 
-void StringEngine::Init(BufferAllocator* allocator) {
+void StringEngine::Init(BufferAllocator* allocator, RandomStream* random) {
   temp_buffer_ = allocator->Allocate<float>(kMaxBlockSize);
   for (int i = 0; i < kNumStrings; ++i) {
-    voice_[i].Init(allocator);
+    voice_[i].Init(allocator, random);
     f0_[i] = 0.01f;
   }
   active_string_ = kNumStrings - 1;
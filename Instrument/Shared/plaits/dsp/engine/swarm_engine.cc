@@ -35,11 +35,11 @@ namespace plaits {
 using namespace std;
 using namespace stmlib;
 
-void SwarmEngine::Init(BufferAllocator* allocator) {
+void SwarmEngine::Init(BufferAllocator* allocator, RandomStream* random) {
   const float n = (kNumSwarmVoices - 1) / 2;
   for (int i = 0; i < kNumSwarmVoices; ++i) {
     float rank = (static_cast<float>(i) - n) / n;
-    swarm_voice_[i].Init(rank);
+    swarm_voice_[i].Init(rank, random);
   }
 }
 
@@ -31,7 +31,7 @@
 
 #include "stmlib/dsp/polyblep.h"
 #include "stmlib/dsp/units.h"
-#include "stmlib/utils/random.h"
+#include "stmlib/utils/random_stream.h"
 
 #include "plaits/dsp/engine/engine.h"
 #include "plaits/dsp/oscillator/oscillator.h"
@@ -48,7 +48,8 @@ class GrainEnvelope {
   GrainEnvelope() { }
   ~GrainEnvelope() { }
   
-  void Init() {
+  void Init(stmlib::RandomStream* random) {
+    random_ = random;
     from_ = 0.0f;
     interval_ = 1.0f;
     phase_ = 1.0f;
@@ -73,12 +74,12 @@ class GrainEnvelope {
     
     if (randomize) {
       from_ += interval_;
-      interval_ = stmlib::Random::GetFloat() - from_;
+      interval_ = random_->GetFloat() - from_;
       // Randomize the duration of the grain.
       if (burst_mode) {
-        fm_ *= 0.8f + 0.2f * stmlib::Random::GetFloat();
+        fm_ *= 0.8f + 0.2f * random_->GetFloat();
       } else {
-        fm_ = 0.5f + 1.5f * stmlib::Random::GetFloat();
+        fm_ = 0.5f + 1.5f * random_->GetFloat();
       }
     }
   }
@@ -115,6 +116,7 @@ class GrainEnvelope {
   }
   
  private:
+  stmlib::RandomStream* random_;
   float from_;
   float interval_;
   float phase_;
@@ -191,9 +193,9 @@ class SwarmVoice {
   SwarmVoice() { }
   ~SwarmVoice() { }
   
-  void Init(float rank) {
+  void Init(float rank, stmlib::RandomStream* random) {
     rank_ = rank;
-    envelope_.Init();
+    envelope_.Init(random);
     saw_.Init();
     sine_.Init();
   }
@@ -236,7 +238,9 @@ class SwarmEngine : public Engine {
   SwarmEngine() { }
   ~SwarmEngine() { }
   
-  virtual void Init(stmlib::BufferAllocator* allocator);
+  virtual void Init(
+      stmlib::BufferAllocator* allocator,
+      stmlib::RandomStream* random);
   virtual void Reset();
   virtual void Render(const EngineParameters& parameters,
       float* out,
@@ -37,7 +37,9 @@ namespace plaits {
 using namespace std;
 using namespace stmlib;
 
-void VirtualAnalogEngine::Init(BufferAllocator* allocator) {
+void VirtualAnalogEngine::Init(
+    BufferAllocator* allocator,
+    RandomStream* random) {
   primary_.Init();
   auxiliary_.Init();
   sync_.Init();
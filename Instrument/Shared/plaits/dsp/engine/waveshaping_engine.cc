@@ -40,7 +40,7 @@ namespace plaits {
 using namespace std;
 using namespace stmlib;
 
-void WaveshapingEngine::Init(BufferAllocator* allocator) {
+void WaveshapingEngine::Init(BufferAllocator* allocator, RandomStream* random) {
   slope_.Init();
   triangle_.Init();
   previous_shape_ = 0.0f;
@@ -39,7 +39,9 @@ class WaveshapingEngine : public Engine {
   WaveshapingEngine() { }
   ~WaveshapingEngine() { }
   
-  virtual void Init(stmlib::BufferAllocator* allocator);
+  virtual void Init(
+      stmlib::BufferAllocator* allocator,
+      stmlib::RandomStream* random);
   virtual void Reset();
   virtual void Render(const EngineParameters& parameters,
       float* out,
@@ -30,14 +30,13 @@
 
 #include <algorithm>
 
-#include "plaits/resources.h"
-
 namespace plaits {
 
 using namespace std;
 using namespace stmlib;
 
-void WavetableEngine::Init(BufferAllocator* allocator) {
+void WavetableEngine::Init(BufferAllocator* allocator, RandomStream* random) {
+  set_waves(NULL, 0);
   phase_ = 0.0f;
 
   x_lp_ = 0.0f;
@@ -71,16 +70,16 @@ inline float Clamp(float x, float amount) {
 const size_t table_size = 256;
 const float table_size_f = float(table_size);
 
-inline float ReadWave(
+inline float WavetableEngine::ReadWave(
     int x,
     int y,
     int z,
     int randomize,
     int phase_integral,
-    float phase_fractional) {
-  int wave = ((x + y * 8 + z * 64) * randomize) % 192;
+    float phase_fractional) const {
+  int wave = ((x + y * 8 + z * 64) * randomize) % num_waves_;
   return InterpolateWaveHermite(
-      wav_integrated_waves + wave * (table_size + 4),
+      waves_ + wave * (table_size + 4),
       phase_integral,
       phase_fractional);
 }
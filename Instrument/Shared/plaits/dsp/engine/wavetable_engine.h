@@ -33,6 +33,7 @@
 
 #include "plaits/dsp/engine/engine.h"
 #include "plaits/dsp/oscillator/wavetable_oscillator.h"
+#include "plaits/resources.h"
 
 namespace plaits {
 
@@ -41,7 +42,9 @@ class WavetableEngine : public Engine {
   WavetableEngine() { }
   ~WavetableEngine() { }
   
-  virtual void Init(stmlib::BufferAllocator* allocator);
+  virtual void Init(
+      stmlib::BufferAllocator* allocator,
+      stmlib::RandomStream* random);
   virtual void Reset();
   virtual void Render(const EngineParameters& parameters,
       float* out,
@@ -49,7 +52,25 @@ class WavetableEngine : public Engine {
       size_t size,
       bool* already_enveloped);
   
+  // Integrated waves of 260 samples (256 + 4 for the interpolation), in the
+  // format of wav_integrated_waves. NULL selects the waves of the module.
+  inline void set_waves(const int16_t* waves, size_t num_waves) {
+    waves_ = waves ? waves : wav_integrated_waves;
+    num_waves_ = waves ? static_cast<int>(num_waves) : 192;
+  }
+  
  private:
+  inline float ReadWave(
+      int x,
+      int y,
+      int z,
+      int randomize,
+      int phase_integral,
+      float phase_fractional) const;
+  
+  const int16_t* waves_;
+  int num_waves_;
+  
   float phase_;
   
   float x_pre_lp_;
@@ -31,7 +31,7 @@
 
 #include "stmlib/stmlib.h"
 
-#include "plaits/dsp/fx/fx_engine.h"
+#include "stmlib/dsp/fx_engine.h"
 
 namespace plaits {
 
@@ -42,7 +42,7 @@ class Diffuser {
   
   void Init(uint16_t* buffer) {
     engine_.Init(buffer);
-    engine_.SetLFOFrequency(LFO_1, 0.3f / 48000.0f);
+    engine_.SetLFOFrequency(stmlib::LFO_1, 0.3f / 48000.0f);
     lp_decay_ = 0.0f;
   }
   
@@ -51,6 +51,17 @@ class Diffuser {
   }
   
   void Process(float amount, float rt, float* in_out, size_t size) {
+    size_t i = 0;
+    for (; i + stmlib::kSimdWidth <= size; i += stmlib::kSimdWidth) {
+      Process<stmlib::f32xN>(amount, rt, &in_out[i]);
+    }
+    for (; i < size; ++i) {
+      Process<float>(amount, rt, &in_out[i]);
+    }
+  }
+  
+  template<typename F>
+  inline void Process(float amount, float rt, float* in_out) {
     typedef E::Reserve<126,
       E::Reserve<180,
       E::Reserve<269,
@@ -65,38 +76,35 @@ class Diffuser {
     E::DelayLine<Memory, 4> dapa;
     E::DelayLine<Memory, 5> dapb;
     E::DelayLine<Memory, 6> del;
-    E::Context c;
+    E::Context<F> c;
     const float kap = 0.625f;
     const float klp = 0.75f;
-    float lp = lp_decay_;
-    while (size--) {
-      float wet;
-      engine_.Start(&c);
-      c.Read(*in_out);
-      c.Read(ap1 TAIL, kap);
-      c.WriteAllPass(ap1, -kap);
-      c.Read(ap2 TAIL, kap);
-      c.WriteAllPass(ap2, -kap);
-      c.Read(ap3 TAIL, kap);
-      c.WriteAllPass(ap3, -kap);
-      c.Interpolate(ap4, 400.0f, LFO_1, 43.0f, kap);
-      c.WriteAllPass(ap4, -kap);
-      c.Interpolate(del, 3070.0f, LFO_1, 340.0f, rt);
-      c.Lp(lp, klp);
-      c.Read(dapa TAIL, -kap);
-      c.WriteAllPass(dapa, kap);
-      c.Read(dapb TAIL, kap);
-      c.WriteAllPass(dapb, -kap);
-      c.Write(del, 2.0f);
-      c.Write(wet, 0.0f);
-      *in_out += amount * (wet - *in_out);
-      ++in_out;
-    }
-    lp_decay_ = lp;
+    F x = stmlib::SimdLoad<F>(in_out);
+    F wet;
+    engine_.Start(&c);
+    c.Read(x);
+    c.Read(ap1 TAIL, kap);
+    c.WriteAllPass(ap1, -kap);
+    c.Read(ap2 TAIL, kap);
+    c.WriteAllPass(ap2, -kap);
+    c.Read(ap3 TAIL, kap);
+    c.WriteAllPass(ap3, -kap);
+    c.Interpolate(ap4, 400.0f, stmlib::LFO_1, 43.0f, kap);
+    c.WriteAllPass(ap4, -kap);
+    c.Interpolate(del, 3070.0f, stmlib::LFO_1, 340.0f, rt);
+    c.Lp(lp_decay_, klp);
+    c.Read(dapa TAIL, -kap);
+    c.WriteAllPass(dapa, kap);
+    c.Read(dapb TAIL, kap);
+    c.WriteAllPass(dapb, -kap);
+    c.Write(del, 2.0f);
+    c.Write(wet, 0.0f);
+    x += amount * (wet - x);
+    stmlib::SimdStore(in_out, x);
   }
   
  private:
-  typedef FxEngine<8192, FORMAT_12_BIT> E;
+  typedef stmlib::FxEngine<8192, stmlib::FORMAT_12_BIT> E;
   E engine_;
   float lp_decay_;
   
@@ -80,6 +80,22 @@ class LowPassGate {
     }
   }
   
+  void Process(
+      float gain,
+      float frequency,
+      float hf_bleed,
+      const float* in,
+      float* out,
+      size_t size) {
+    stmlib::ParameterInterpolator gain_modulation(&previous_gain_, gain, size);
+    filter_.set_f_q<stmlib::FREQUENCY_DIRTY>(frequency, 0.4f);
+    while (size--) {
+      const float s = *in++ * gain_modulation.Next();
+      const float lp = filter_.Process<stmlib::FILTER_MODE_LOW_PASS>(s);
+      *out++ = lp + (s - lp) * hf_bleed;
+    }
+  }
+  
  private:
   float previous_gain_;
   stmlib::Svf filter_;
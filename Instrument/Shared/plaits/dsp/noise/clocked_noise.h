@@ -32,7 +32,7 @@
 #include "stmlib/dsp/dsp.h"
 #include "stmlib/dsp/parameter_interpolator.h"
 #include "stmlib/dsp/polyblep.h"
-#include "stmlib/utils/random.h"
+#include "stmlib/utils/random_stream.h"
 
 namespace plaits {
 
@@ -41,7 +41,8 @@ class ClockedNoise {
   ClockedNoise() { }
   ~ClockedNoise() { }
   
-  void Init() {
+  void Init(stmlib::RandomStream* random) {
+    random_ = random;
     phase_ = 0.0f;
     sample_ = 0.0f;
     next_sample_ = 0.0f;
@@ -59,13 +60,17 @@ class ClockedNoise {
     if (sync) {
       phase_ = 1.0f;
     }
+    
+    // The raw noise is generated in the output buffer, and replaced sample
+    // by sample.
+    random_->Fill(out, size);
 
     while (size--) {
       float this_sample = next_sample;
       next_sample = 0.0f;
 
       const float frequency = fm.Next();
-      const float raw_sample = stmlib::Random::GetFloat() * 2.0f - 1.0f;
+      const float raw_sample = *out * 2.0f - 1.0f;
       float raw_amount = 4.0f * (frequency - 0.25f);
       CONSTRAIN(raw_amount, 0.0f, 1.0f);
       
@@ -88,6 +93,8 @@ class ClockedNoise {
   }
   
  private:
+  stmlib::RandomStream* random_;
+  
   // Oscillator state.
   float phase_;
   float sample_;
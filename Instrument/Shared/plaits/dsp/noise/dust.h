@@ -29,17 +29,20 @@
 #ifndef PLAITS_DSP_NOISE_DUST_H_
 #define PLAITS_DSP_NOISE_DUST_H_
 
-#include "stmlib/utils/random.h"
+#include "stmlib/utils/random_stream.h"
 
 namespace plaits {
 
-inline float Dust(float frequency) {
+inline void Dust(
+    stmlib::RandomStream* random,
+    float frequency,
+    float* out,
+    size_t size) {
   float inv_frequency = 1.0f / frequency;
-  float u = stmlib::Random::GetFloat();
-  if (u < frequency) {
-    return u * inv_frequency;
-  } else {
-    return 0.0f;
+  random->Fill(out, size);
+  for (size_t i = 0; i < size; ++i) {
+    float u = out[i];
+    out[i] = u < frequency ? u * inv_frequency : 0.0f;
   }
 }
 
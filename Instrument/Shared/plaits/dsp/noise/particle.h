@@ -31,7 +31,7 @@
 
 #include "stmlib/dsp/dsp.h"
 #include "stmlib/dsp/filter.h"
-#include "stmlib/utils/random.h"
+#include "stmlib/utils/random_stream.h"
 
 namespace plaits {
 
@@ -40,7 +40,8 @@ class Particle {
   Particle() { }
   ~Particle() { }
 
-  inline void Init() {
+  inline void Init(stmlib::RandomStream* random) {
+    random_ = random;
     pre_gain_ = 0.0f;
     filter_.Init();
   }
@@ -55,7 +56,7 @@ class Particle {
       float* out,
       float* aux,
       size_t size) {
-    float u = stmlib::Random::GetFloat();
+    float u = random_->GetFloat();
     if (sync) {
       u = density;
     }
@@ -65,7 +66,7 @@ class Particle {
       if (u <= density) {
         s = u * gain;
         if (can_radomize_frequency) {
-          const float u = 2.0f * stmlib::Random::GetFloat() - 1.0f;
+          const float u = 2.0f * random_->GetFloat() - 1.0f;
           const float f = std::min(
               stmlib::SemitonesToRatio(spread * u) * frequency,
               0.25f);
@@ -77,11 +78,12 @@ class Particle {
       }
       *aux++ += s;
       *out++ += filter_.Process<stmlib::FILTER_MODE_BAND_PASS>(pre_gain_ * s);
-      u = stmlib::Random::GetFloat();
+      u = random_->GetFloat();
     }
   }
  
  private:
+  stmlib::RandomStream* random_;
   float pre_gain_;
   stmlib::Svf filter_;
   
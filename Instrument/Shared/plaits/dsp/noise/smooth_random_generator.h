@@ -30,7 +30,7 @@
 #define PLAITS_DSP_NOISE_SMOOTH_RANDOM_GENERATOR_H_
 
 #include "stmlib/stmlib.h"
-#include "stmlib/utils/random.h"
+#include "stmlib/utils/random_stream.h"
 
 namespace plaits {
 
@@ -39,7 +39,8 @@ class SmoothRandomGenerator {
   SmoothRandomGenerator() { }
   ~SmoothRandomGenerator() { }
   
-  void Init() {
+  void Init(stmlib::RandomStream* random) {
+    random_ = random;
     phase_ = 0.0f;
     from_ = 0.0f;
     interval_ = 0.0f;
@@ -50,13 +51,14 @@ class SmoothRandomGenerator {
     if (phase_ >= 1.0f) {
       phase_ -= 1.0f;
       from_ += interval_;
-      interval_ = stmlib::Random::GetFloat() * 2.0f - 1.0f - from_;
+      interval_ = random_->GetFloat() * 2.0f - 1.0f - from_;
     }
     float t = phase_ * phase_ * (3.0f - 2.0f * phase_);
     return from_ + interval_ * t;
   }
   
  private:
+  stmlib::RandomStream* random_;
   float phase_;
   float from_;
   float interval_;
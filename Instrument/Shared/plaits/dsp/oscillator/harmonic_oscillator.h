@@ -27,12 +27,18 @@
 // Harmonic oscillator based on Chebyshev polynomials.
 // Works well for a small number of harmonics. For the higher order harmonics,
 // we need to reinitialize the recurrence by computing two high harmonics.
+//
+// The recurrence runs through the harmonics one after the other, but the
+// samples are independent: they are rendered in the lanes of vectors, each
+// lane running the recurrence over all the harmonics for its sample. The
+// amplitude of each harmonic is ramped linearly over the block.
 
 #ifndef PLAITS_DSP_OSCILLATOR_HARMONIC_OSCILLATOR_H_
 #define PLAITS_DSP_OSCILLATOR_HARMONIC_OSCILLATOR_H_
 
 #include "stmlib/dsp/dsp.h"
 #include "stmlib/dsp/parameter_interpolator.h"
+#include "stmlib/dsp/simd.h"
 
 #include "plaits/resources.h"
 
@@ -52,56 +58,110 @@ class HarmonicOscillator {
     }
   }
   
-  template<int first_harmonic_index>
+  // Renders the harmonics first_harmonic_index to first_harmonic_index +
+  // num_harmonics - 1. The first batch (first_harmonic_index == 1) writes to
+  // out, the next ones add to it.
   void Render(
+      int first_harmonic_index,
       float frequency,
       const float* amplitudes,
       float* out,
       size_t size) {
+    typedef stmlib::f32xN Vector;
+    const size_t width = stmlib::kSimdWidth;
+    
     if (frequency >= 0.5f) {
       frequency = 0.5f;
     }
     
-    stmlib::ParameterInterpolator am[num_harmonics];
     stmlib::ParameterInterpolator fm(&frequency_, frequency, size);
     
+    float am_start[num_harmonics];
+    float am_increment[num_harmonics];
+    const float step = 1.0f / static_cast<float>(size);
     for (int i = 0; i < num_harmonics; ++i) {
       float f = frequency * static_cast<float>(first_harmonic_index + i);
       if (f >= 0.5f) {
         f = 0.5f;
       }
-      am[i].Init(&amplitude_[i], amplitudes[i] * (1.0f - f * 2.0f), size);
+      const float target = amplitudes[i] * (1.0f - f * 2.0f);
+      am_start[i] = amplitude_[i];
+      am_increment[i] = (target - amplitude_[i]) * step;
+      amplitude_[i] = target;
     }
-
-    while (size--) {
-      phase_ += fm.Next();
-      if (phase_ >= 1.0f) {
-        phase_ -= 1.0f;
-      }
-      const float two_x = 2.0f * stmlib::Interpolate(lut_sine, phase_, 1024.0f);
-      float previous, current;
-      if (first_harmonic_index == 1) {
-        previous = 1.0f;
-        current = two_x * 0.5f;
-      } else {
-        const float k = first_harmonic_index;
-        previous = stmlib::InterpolateWrap(
-            lut_sine, phase_ * (k - 1.0f) + 0.25f, 1024.0f);
-        current = stmlib::InterpolateWrap(lut_sine, phase_ * k, 1024.0f);
+    
+    const float k = static_cast<float>(first_harmonic_index);
+    const size_t chunk_size = kInterleave * width;
+    float position = 0.0f;
+    while (size) {
+      const size_t n = size < chunk_size ? size : chunk_size;
+      
+      // Phase and first two harmonics of each sample, and its position in the
+      // amplitude ramps. The lanes past the end of the block stay silent.
+      float two_x[chunk_size];
+      float previous[chunk_size];
+      float current[chunk_size];
+      float t[chunk_size];
+      for (size_t j = 0; j < chunk_size; ++j) {
+        t[j] = position + static_cast<float>(j + 1);
+        if (j >= n) {
+          two_x[j] = previous[j] = current[j] = 0.0f;
+          continue;
+        }
+        phase_ += fm.Next();
+        if (phase_ >= 1.0f) {
+          phase_ -= 1.0f;
+        }
+        two_x[j] = 2.0f * stmlib::Interpolate(lut_sine, phase_, 1024.0f);
+        if (first_harmonic_index == 1) {
+          previous[j] = 1.0f;
+          current[j] = two_x[j] * 0.5f;
+        } else {
+          previous[j] = stmlib::InterpolateWrap(
+              lut_sine, phase_ * (k - 1.0f) + 0.25f, 1024.0f);
+          current[j] = stmlib::InterpolateWrap(
+              lut_sine, phase_ * k, 1024.0f);
+        }
       }
       
-      float sum = 0.0f;
+      Vector two_x_v[kInterleave];
+      Vector t_v[kInterleave];
+      Vector previous_v[kInterleave];
+      Vector current_v[kInterleave];
+      Vector sum[kInterleave];
+      for (size_t v = 0; v < kInterleave; ++v) {
+        two_x_v[v] = stmlib::SimdLoad<Vector>(&two_x[v * width]);
+        t_v[v] = stmlib::SimdLoad<Vector>(&t[v * width]);
+        previous_v[v] = stmlib::SimdLoad<Vector>(&previous[v * width]);
+        current_v[v] = stmlib::SimdLoad<Vector>(&current[v * width]);
+        sum[v] = stmlib::SimdSplat<Vector>(0.0f);
+      }
       for (int i = 0; i < num_harmonics; ++i) {
-        sum += am[i].Next() * current;
-        float temp = current;
-        current = two_x * current - previous;
-        previous = temp;
+        const Vector am_start_v = stmlib::SimdSplat<Vector>(am_start[i]);
+        const Vector am_increment_v = stmlib::SimdSplat<Vector>(
+            am_increment[i]);
+        for (size_t v = 0; v < kInterleave; ++v) {
+          sum[v] += (am_start_v + am_increment_v * t_v[v]) * current_v[v];
+          const Vector temp = current_v[v];
+          current_v[v] = two_x_v[v] * current_v[v] - previous_v[v];
+          previous_v[v] = temp;
+        }
       }
-      if (first_harmonic_index == 1) {
-        *out++ = sum;
-      } else {
-        *out++ += sum;
+      
+      float rendered[chunk_size];
+      for (size_t v = 0; v < kInterleave; ++v) {
+        stmlib::SimdStore(&rendered[v * width], sum[v]);
       }
+      for (size_t j = 0; j < n; ++j) {
+        if (first_harmonic_index == 1) {
+          out[j] = rendered[j];
+        } else {
+          out[j] += rendered[j];
+        }
+      }
+      out += n;
+      size -= n;
+      position += static_cast<float>(n);
     }
   }
 
@@ -113,6 +173,11 @@ class HarmonicOscillator {
   float frequency_;
   float amplitude_[num_harmonics];
   
+  // Each step of the recurrence waits for the previous one. Interleaving
+  // the recurrences of 3 vectors of samples keeps the arithmetic units busy
+  // while it does.
+  static const size_t kInterleave = 3;
+  
   DISALLOW_COPY_AND_ASSIGN(HarmonicOscillator);
 };
 
@@ -35,6 +35,7 @@
 
 #include "stmlib/dsp/filter.h"
 #include "stmlib/utils/buffer_allocator.h"
+#include "stmlib/utils/random_stream.h"
 
 #include "plaits/dsp/physical_modelling/delay_line.h"
 
@@ -52,7 +53,9 @@ class String {
   String() { }
   ~String() { }
   
-  void Init(stmlib::BufferAllocator* allocator);
+  void Init(
+      stmlib::BufferAllocator* allocator,
+      stmlib::RandomStream* random);
   void Reset();
   void Process(
       float f0,
@@ -79,6 +82,7 @@ class String {
   
   stmlib::Svf iir_damping_filter_;
   stmlib::DCBlocker dc_blocker_;
+  stmlib::RandomStream* random_;
   
   float delay_;
   float dispersion_noise_;
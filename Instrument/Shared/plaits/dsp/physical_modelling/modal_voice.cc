@@ -35,7 +35,6 @@
 #include <algorithm>
 
 #include "stmlib/dsp/units.h"
-#include "stmlib/utils/random.h"
 
 #include "plaits/dsp/noise/dust.h"
 
@@ -44,7 +43,12 @@ namespace plaits {
 using namespace std;
 using namespace stmlib;
 
-void ModalVoice::Init() {
+void ModalVoice::Init(RandomStream* random) {
+  random_ = random;
+  Reset();
+}
+
+void ModalVoice::Reset() {
   excitation_filter_.Init();
   resonator_.Init(0.015f, kMaxNumModes);
 }
@@ -76,8 +80,10 @@ void ModalVoice::Render(
   // Synthesize excitation signal.
   if (sustain) {
     const float dust_f = 0.00005f + 0.99995f * density * density;
+    const float dust_gain = (4.0f - dust_f * 3.0f) * accent;
+    Dust(random_, dust_f, temp, size);
     for (size_t i = 0; i < size; ++i) {
-      temp[i] = Dust(dust_f) * (4.0f - dust_f * 3.0f) * accent;
+      temp[i] *= dust_gain;
     }
   } else {
     fill(&temp[0], &temp[size], 0.0f);
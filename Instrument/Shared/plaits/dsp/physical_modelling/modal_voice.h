@@ -33,6 +33,8 @@
 #ifndef PLAITS_DSP_PHYSICAL_MODELLING_MODAL_VOICE_H_
 #define PLAITS_DSP_PHYSICAL_MODELLING_MODAL_VOICE_H_
 
+#include "stmlib/utils/random_stream.h"
+
 #include "plaits/dsp/physical_modelling/resonator.h"
 
 namespace plaits {
@@ -42,7 +44,8 @@ class ModalVoice {
   ModalVoice() { }
   ~ModalVoice() { }
   
-  void Init();
+  void Init(stmlib::RandomStream* random);
+  void Reset();
   void Render(
       bool sustain,
       bool trigger,
@@ -59,6 +62,7 @@ class ModalVoice {
  private:
   ResonatorSvf<1> excitation_filter_;
   Resonator resonator_;
+  stmlib::RandomStream* random_;
   
   DISALLOW_COPY_AND_ASSIGN(ModalVoice);
 };
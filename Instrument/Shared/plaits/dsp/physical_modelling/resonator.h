@@ -29,20 +29,36 @@
 #ifndef PLAITS_DSP_PHYSICAL_MODELLING_RESONATOR_H_
 #define PLAITS_DSP_PHYSICAL_MODELLING_RESONATOR_H_
 
+#include <algorithm>
+
 #include "stmlib/dsp/filter.h"
+#include "stmlib/dsp/simd.h"
 
 namespace plaits {
 
-const int kMaxNumModes = 24;
-const int kModeBatchSize = 4;
+// Modes are rendered in batches of kModeBatchSize, one per lane of the widest
+// vector of the target: 8 with AVX, 4 with NEON or SSE. The module renders 24
+// modes; builds for targets with wider vectors can afford more, and raise the
+// count with PLAITS_MAX_NUM_MODES. It must be a multiple of the batch size:
+// the modes of an incomplete batch are not rendered.
+#ifndef PLAITS_MAX_NUM_MODES
+#define PLAITS_MAX_NUM_MODES 24
+#endif  // PLAITS_MAX_NUM_MODES
+
+const int kModeBatchSize = stmlib::kSimdWidth;
+const int kMaxNumModes = PLAITS_MAX_NUM_MODES;
+
+STATIC_ASSERT(
+    kMaxNumModes % kModeBatchSize == 0,
+    max_num_modes_must_be_a_multiple_of_the_batch_size);
 
 // We render 4 modes simultaneously since there are enough registers to hold
 // all state variables.
 template<int batch_size>
-class ResonatorSvf {
+class ScalarResonatorSvf {
  public:
-  ResonatorSvf() { }
-  ~ResonatorSvf() { }
+  ScalarResonatorSvf() { }
+  ~ScalarResonatorSvf() { }
   
   void Init() {
     for (int i = 0; i < batch_size; ++i) {
@@ -102,9 +118,87 @@ class ResonatorSvf {
   float state_1_[batch_size];
   float state_2_[batch_size];
   
-  DISALLOW_COPY_AND_ASSIGN(ResonatorSvf);
+  DISALLOW_COPY_AND_ASSIGN(ScalarResonatorSvf);
+};
+
+// The same filters, one per lane of a T: f32x4 (a NEON or SSE register), or
+// f32x8 (an AVX register, or a pair of 4-wide ones on the targets without
+// AVX). The lanes follow the arithmetic of the scalar version, and are summed
+// in the same order, so the output only differs from it where the compiler
+// fuses the multiplication by the gain with the sum in the scalar code.
+template<typename T>
+class SimdResonatorSvf {
+ public:
+  SimdResonatorSvf() { }
+  ~SimdResonatorSvf() { }
+  
+  void Init() {
+    std::fill(&state_1_[0], &state_1_[kWidth], 0.0f);
+    std::fill(&state_2_[0], &state_2_[kWidth], 0.0f);
+  }
+  
+  template<stmlib::FilterMode mode, bool add>
+  void Process(
+      const float* f,
+      const float* q,
+      const float* gain,
+      const float* in,
+      float* out,
+      size_t size) {
+    T g, r, h;
+    for (size_t i = 0; i < kWidth; ++i) {
+      const float g_i = stmlib::OnePole::tan<stmlib::FREQUENCY_FAST>(f[i]);
+      const float r_i = 1.0f / q[i];
+      stmlib::SimdSetLane(&g, i, g_i);
+      stmlib::SimdSetLane(&r, i, r_i);
+      stmlib::SimdSetLane(&h, i, 1.0f / (1.0f + r_i * g_i + g_i * g_i));
+    }
+    const T r_plus_g = r + g;
+    const T gains = stmlib::SimdLoad<T>(gain);
+    T state_1 = stmlib::SimdLoad<T>(state_1_);
+    T state_2 = stmlib::SimdLoad<T>(state_2_);
+    
+    while (size--) {
+      const T s_in = stmlib::SimdSplat<T>(*in++);
+      const T hp = (s_in - r_plus_g * state_1 - state_2) * h;
+      const T bp = g * hp + state_1;
+      state_1 = g * hp + bp;
+      const T lp = g * bp + state_2;
+      state_2 = g * bp + lp;
+      const float s_out = stmlib::SimdSum(
+          gains * ((mode == stmlib::FILTER_MODE_LOW_PASS) ? lp : bp));
+      if (add) {
+        *out++ += s_out;
+      } else {
+        *out++ = s_out;
+      }
+    }
+    stmlib::SimdStore(state_1_, state_1);
+    stmlib::SimdStore(state_2_, state_2);
+  }
+  
+ private:
+  static const size_t kWidth = stmlib::SimdTraits<T>::width;
+  
+  // Not stored as vectors, which would require an alignment that the kernels
+  // do not guarantee.
+  float state_1_[kWidth];
+  float state_2_[kWidth];
+  
+  DISALLOW_COPY_AND_ASSIGN(SimdResonatorSvf);
 };
 
+// The batches which fill a vector are rendered in its lanes, the others one
+// mode at a time.
+template<int batch_size>
+class ResonatorSvf : public ScalarResonatorSvf<batch_size> { };
+
+template<>
+class ResonatorSvf<4> : public SimdResonatorSvf<stmlib::f32x4> { };
+
+template<>
+class ResonatorSvf<8> : public SimdResonatorSvf<stmlib::f32x8> { };
+
 class Resonator {
  public:
   Resonator() { }
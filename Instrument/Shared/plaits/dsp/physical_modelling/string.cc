@@ -33,7 +33,6 @@
 #include "stmlib/dsp/dsp.h"
 #include "stmlib/dsp/parameter_interpolator.h"
 #include "stmlib/dsp/units.h"
-#include "stmlib/utils/random.h"
 
 #include "plaits/dsp/dsp.h"
 #include "plaits/resources.h"
@@ -43,7 +42,8 @@ namespace plaits {
 using namespace std;
 using namespace stmlib;
 
-void String::Init(BufferAllocator* allocator) {
+void String::Init(BufferAllocator* allocator, RandomStream* random) {
+  random_ = random;
   string_.Init(allocator->Allocate<float>(kDelayLineSize));
   stretch_.Init(allocator->Allocate<float>(kDelayLineSize / 4));
   delay_ = 100.0f;
@@ -146,7 +146,7 @@ void String::ProcessInternal(
       float s = 0.0f;
       
       if (non_linearity == STRING_NON_LINEARITY_DISPERSION) {
-        float noise = Random::GetFloat() - 0.5f;
+        float noise = random_->GetFloat() - 0.5f;
         ONE_POLE(dispersion_noise_, noise, noise_filter)
         delay *= 1.0f + dispersion_noise_ * noise_amount;
       } else {
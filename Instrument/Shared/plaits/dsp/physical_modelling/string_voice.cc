@@ -31,7 +31,6 @@
 #include <algorithm>
 
 #include "stmlib/dsp/units.h"
-#include "stmlib/utils/random.h"
 
 #include "plaits/dsp/noise/dust.h"
 
@@ -40,9 +39,10 @@ namespace plaits {
 using namespace std;
 using namespace stmlib;
 
-void StringVoice::Init(BufferAllocator* allocator) {
+void StringVoice::Init(BufferAllocator* allocator, RandomStream* random) {
+  random_ = random;
   excitation_filter_.Init();
-  string_.Init(allocator);
+  string_.Init(allocator, random);
   remaining_noise_samples_ = 0;
 }
 
@@ -81,20 +81,19 @@ void StringVoice::Render(
 
   if (sustain) {
     const float dust_f = 0.00005f + 0.99995f * density * density;
+    const float dust_gain = (8.0f - dust_f * 6.0f) * accent;
+    Dust(random_, dust_f, temp, size);
     for (size_t i = 0; i < size; ++i) {
-      temp[i] = Dust(dust_f) * (8.0f - dust_f * 6.0f) * accent;
+      temp[i] *= dust_gain;
     }
   } else if (remaining_noise_samples_) {
     size_t noise_samples = min(remaining_noise_samples_, size);
     remaining_noise_samples_ -= noise_samples;
-    size_t tail = size - noise_samples;
-    float* start = temp;
-    while (noise_samples--) {
-      *start++ = 2.0f * Random::GetFloat() - 1.0f;
-    }
-    while (tail--) {
-      *start++ = 0.0f;
+    random_->Fill(temp, noise_samples);
+    for (size_t i = 0; i < noise_samples; ++i) {
+      temp[i] = 2.0f * temp[i] - 1.0f;
     }
+    fill(&temp[noise_samples], &temp[size], 0.0f);
   } else {
     fill(&temp[0], &temp[size], 0.0f);
   }
@@ -41,7 +41,9 @@ class StringVoice {
   StringVoice() { }
   ~StringVoice() { }
   
-  void Init(stmlib::BufferAllocator* allocator);
+  void Init(
+      stmlib::BufferAllocator* allocator,
+      stmlib::RandomStream* random);
   void Reset();
   void Render(
       bool sustain,
@@ -59,6 +61,7 @@ class StringVoice {
  private:
   stmlib::Svf excitation_filter_;
   String string_;
+  stmlib::RandomStream* random_;
   size_t remaining_noise_samples_;
   
   DISALLOW_COPY_AND_ASSIGN(StringVoice);
@@ -30,8 +30,6 @@
 
 #include <algorithm>
 
-#include "stmlib/utils/random.h"
-
 #include "plaits/dsp/oscillator/oscillator.h"
 #include "plaits/resources.h"
 
@@ -40,7 +38,8 @@ namespace plaits {
 using namespace std;
 using namespace stmlib;
 
-void LPCSpeechSynth::Init() {
+void LPCSpeechSynth::Init(RandomStream* random) {
+  random_ = random;
   phase_ = 0.0f;
   frequency_ = 0.0125f;
   noise_energy_ = 0.0f;
@@ -90,7 +89,7 @@ void LPCSpeechSynth::Render(
     }
     
     float e[11];
-    e[10] = Random::GetSample() > 0 ? noise_energy_ : -noise_energy_;
+    e[10] = random_->GetSample() > 0 ? noise_energy_ : -noise_energy_;
     if (excitation_pulse_sample_index_ < LUT_LPC_EXCITATION_PULSE_SIZE) {
       int8_t s = lut_lpc_excitation_pulse[excitation_pulse_sample_index_];
       next_sample += static_cast<float>(s) / 128.0f * pulse_energy_;
@@ -30,6 +30,7 @@
 #define PLAITS_DSP_SPEECH_LPC_SPEECH_SYNTH_H_
 
 #include "stmlib/dsp/dsp.h"
+#include "stmlib/utils/random_stream.h"
 
 #include "plaits/dsp/dsp.h"
 
@@ -60,7 +61,7 @@ class LPCSpeechSynth {
     int8_t k9;
   };
 
-  void Init();
+  void Init(stmlib::RandomStream* random);
   
   void Render(
       float prosody_amount,
@@ -91,6 +92,8 @@ class LPCSpeechSynth {
     return a_f + (b_f - a_f) * blend;
   }
   
+  stmlib::RandomStream* random_;
+  
   float phase_;
   float frequency_;
   float noise_energy_;
@@ -31,7 +31,6 @@
 #include <algorithm>
 
 #include "stmlib/dsp/units.h"
-#include "stmlib/utils/random.h"
 
 #include "plaits/dsp/oscillator/oscillator.h"
 
@@ -203,7 +202,9 @@ bool LPCSpeechSynthWordBank::Load(int bank) {
   return true;
 }
 
-void LPCSpeechSynthController::Init(LPCSpeechSynthWordBank* word_bank) {
+void LPCSpeechSynthController::Init(
+    LPCSpeechSynthWordBank* word_bank,
+    RandomStream* random) {
   word_bank_ = word_bank;
   
   clock_phase_ = 0.0f;
@@ -216,7 +217,7 @@ void LPCSpeechSynthController::Init(LPCSpeechSynthWordBank* word_bank) {
 
   gain_ = 0.0f;
   
-  synth_.Init();
+  synth_.Init(random);
 }
 
 void LPCSpeechSynthController::Render(
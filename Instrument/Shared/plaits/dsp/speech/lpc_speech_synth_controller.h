@@ -158,7 +158,9 @@ class LPCSpeechSynthController {
   LPCSpeechSynthController() { }
   ~LPCSpeechSynthController() { }
   
-  void Init(LPCSpeechSynthWordBank* word_bank);
+  void Init(
+      LPCSpeechSynthWordBank* word_bank,
+      stmlib::RandomStream* random);
   
   void Render(
       bool free_running,
@@ -28,35 +28,56 @@
 
 #include "plaits/dsp/voice.h"
 
+#include <cstring>
+#include <new>
+
 namespace plaits {
 
 using namespace std;
 using namespace stmlib;
 
-void Voice::Init(BufferAllocator* allocator) {
-  engines_.Init();
-  engines_.RegisterInstance(&virtual_analog_engine_, false, 0.8f, 0.8f);
-  engines_.RegisterInstance(&waveshaping_engine_, false, 0.7f, 0.6f);
-  engines_.RegisterInstance(&fm_engine_, false, 0.6f, 0.6f);
-  engines_.RegisterInstance(&grain_engine_, false, 0.7f, 0.6f);
-  engines_.RegisterInstance(&additive_engine_, false, 0.8f, 0.8f);
-  engines_.RegisterInstance(&wavetable_engine_, false, 0.6f, 0.6f);
-  engines_.RegisterInstance(&chord_engine_, false, 0.8f, 0.8f);
-  engines_.RegisterInstance(&speech_engine_, false, -0.7f, 0.8f);
-
-  engines_.RegisterInstance(&swarm_engine_, false, -3.0f, 1.0f);
-  engines_.RegisterInstance(&noise_engine_, false, -1.0f, -1.0f);
-  engines_.RegisterInstance(&particle_engine_, false, -2.0f, 1.0f);
-  engines_.RegisterInstance(&string_engine_, true, -1.0f, 0.8f);
-  engines_.RegisterInstance(&modal_engine_, true, -1.0f, 0.8f);
-  engines_.RegisterInstance(&bass_drum_engine_, true, 0.8f, 0.8f);
-  engines_.RegisterInstance(&snare_drum_engine_, true, 0.8f, 0.8f);
-  engines_.RegisterInstance(&hi_hat_engine_, true, 0.8f, 0.8f);
-  for (int i = 0; i < engines_.size(); ++i) {
-    // All engines will share the same RAM space.
-    allocator->Free();
-    engines_.get(i)->Init(allocator);
-  }
+namespace {
+
+template<typename T>
+Engine* ConstructEngine(void* storage) {
+  return new(storage) T;
+}
+
+struct EngineDescription {
+  Engine* (*construct)(void* storage);
+  bool already_enveloped;
+  float out_gain;
+  float aux_gain;
+};
+
+const EngineDescription engine_descriptions[kMaxEngines] = {
+  { &ConstructEngine<VirtualAnalogEngine>, false, 0.8f, 0.8f },
+  { &ConstructEngine<WaveshapingEngine>, false, 0.7f, 0.6f },
+  { &ConstructEngine<FMEngine>, false, 0.6f, 0.6f },
+  { &ConstructEngine<GrainEngine>, false, 0.7f, 0.6f },
+  { &ConstructEngine<AdditiveEngine>, false, 0.8f, 0.8f },
+  { &ConstructEngine<WavetableEngine>, false, 0.6f, 0.6f },
+  { &ConstructEngine<ChordEngine>, false, 0.8f, 0.8f },
+  { &ConstructEngine<SpeechEngine>, false, -0.7f, 0.8f },
+
+  { &ConstructEngine<SwarmEngine>, false, -3.0f, 1.0f },
+  { &ConstructEngine<NoiseEngine>, false, -1.0f, -1.0f },
+  { &ConstructEngine<ParticleEngine>, false, -2.0f, 1.0f },
+  { &ConstructEngine<StringEngine>, true, -1.0f, 0.8f },
+  { &ConstructEngine<ModalEngine>, true, -1.0f, 0.8f },
+  { &ConstructEngine<BassDrumEngine>, true, 0.8f, 0.8f },
+  { &ConstructEngine<SnareDrumEngine>, true, 0.8f, 0.8f },
+  { &ConstructEngine<HiHatEngine>, true, 0.8f, 0.8f },
+};
+
+}  // namespace
+
+void Voice::Init(EngineSlot* slot, uint32_t seed) {
+  slot_ = slot;
+  engine_ = NULL;
+  random_.Init(seed);
+  waves_ = NULL;
+  num_waves_ = 0;
   
   engine_quantizer_.Init();
   previous_engine_index_ = -1;
@@ -67,24 +88,77 @@ void Voice::Init(BufferAllocator* allocator) {
 
   decay_envelope_.Init();
   lpg_envelope_.Init();
+  lpg_bypass_ = false;
   
   trigger_state_ = false;
   previous_note_ = 0.0f;
   
-  trigger_delay_.Init(trigger_delay_line_);
+  trigger_transitions_head_ = 0;
+  num_trigger_transitions_ = 0;
+  trigger_input_ = 0.0f;
+  delayed_trigger_ = 0.0f;
 }
 
-void Voice::Render(
+float Voice::DelayTrigger(float trigger, size_t size) {
+  if (trigger != trigger_input_) {
+    trigger_input_ = trigger;
+    if (num_trigger_transitions_ == kMaxTriggerTransitions) {
+      // More changes than blocks within the delay: the last one is replaced.
+      --num_trigger_transitions_;
+    }
+    TriggerTransition& t = trigger_transitions_[
+        (trigger_transitions_head_ + num_trigger_transitions_) % \
+            kMaxTriggerTransitions];
+    t.value = trigger;
+    t.delay = kTriggerDelaySamples;
+    ++num_trigger_transitions_;
+  }
+  
+  while (num_trigger_transitions_ && \
+         trigger_transitions_[trigger_transitions_head_].delay <= 0) {
+    delayed_trigger_ = trigger_transitions_[trigger_transitions_head_].value;
+    trigger_transitions_head_ = (trigger_transitions_head_ + 1) % \
+        kMaxTriggerTransitions;
+    --num_trigger_transitions_;
+  }
+  
+  for (int i = 0; i < num_trigger_transitions_; ++i) {
+    trigger_transitions_[(trigger_transitions_head_ + i) % \
+        kMaxTriggerTransitions].delay -= static_cast<int>(size);
+  }
+  return delayed_trigger_;
+}
+
+Engine* Voice::CreateEngine(int index) {
+  const EngineDescription& d = engine_descriptions[index];
+  
+  // Engines do not own any resource, so the previous one is just overwritten.
+  // Not all engines initialize all their members (FMEngine's FIR states, for
+  // example): they start from zero rather than from the previous engine.
+  // Like on the module, all engines share the same RAM space.
+  memset(&slot_->engine, 0, sizeof(slot_->engine));
+  Engine* e = d.construct(&slot_->engine);
+  BufferAllocator allocator(slot_->ram, kEngineRamSize);
+  e->Init(&allocator, &random_);
+  e->Reset();
+  
+  PostProcessingSettings* s = &e->post_processing_settings;
+  s->already_enveloped = d.already_enveloped;
+  s->out_gain = d.out_gain;
+  s->aux_gain = d.aux_gain;
+  return e;
+}
+
+bool Voice::RenderEngine(
     const Patch& patch,
     const Modulations& modulations,
-    Frame* frames,
-    size_t size) {
+    size_t size,
+    const PostProcessingSettings** settings) {
   // Trigger, LPG, internal envelope.
       
   // Delay trigger by 1ms to deal with sequencers or MIDI interfaces whose
   // CV out lags behind the GATE out.
-  trigger_delay_.Write(modulations.trigger);
-  float trigger_value = trigger_delay_.Read(kTriggerDelay);
+  float trigger_value = DelayTrigger(modulations.trigger, size);
   
   bool previous_trigger_state = trigger_state_;
   if (!previous_trigger_state) {
@@ -109,16 +183,15 @@ void Voice::Render(
   int engine_index = engine_quantizer_.Process(
       patch.engine,
       engine_cv_,
-      engines_.size(),
+      kMaxEngines,
       0.25f);
   
-  Engine* e = engines_.get(engine_index);
-  
   if (engine_index != previous_engine_index_) {
-    e->Reset();
+    engine_ = CreateEngine(engine_index);
     out_post_processor_.Reset();
     previous_engine_index_ = engine_index;
   }
+  Engine* e = engine_;
   EngineParameters p;
 
   bool rising_edge = trigger_state_ && !previous_trigger_state;
@@ -132,8 +205,13 @@ void Voice::Render(
     p.trigger = TRIGGER_UNPATCHED;
   }
   
+  // The envelopes advance once per call, at rates calibrated for blocks of
+  // kMaxBlockSize samples. A shorter block, cut where an event happens,
+  // advances them by its share of a full one.
+  const float block_scale = static_cast<float>(size) / kMaxBlockSize;
+
   const float short_decay = (200.0f * kBlockSize) / kSampleRate *
-      SemitonesToRatio(-96.0f * patch.decay);
+      SemitonesToRatio(-96.0f * patch.decay) * block_scale;
 
   decay_envelope_.Process(short_decay * 2.0f);
 
@@ -150,13 +228,16 @@ void Voice::Render(
   CONSTRAIN(p.harmonics, 0.0f, 1.0f);
 
   float internal_envelope_amplitude = 1.0f;
-  if (engine_index == 7) {
+  if (engine_index == 5) {
+    static_cast<WavetableEngine*>(e)->set_waves(waves_, num_waves_);
+  } else if (engine_index == 7) {
     internal_envelope_amplitude = 2.0f - p.harmonics * 6.0f;
     CONSTRAIN(internal_envelope_amplitude, 0.0f, 1.0f);
-    speech_engine_.set_prosody_amount(
+    SpeechEngine* speech_engine = static_cast<SpeechEngine*>(e);
+    speech_engine->set_prosody_amount(
         !modulations.trigger_patched || modulations.frequency_patched ?
             0.0f : patch.frequency_modulation_amount);
-    speech_engine_.set_speed( 
+    speech_engine->set_speed(
         !modulations.trigger_patched || modulations.morph_patched ?
             0.0f : patch.morph_modulation_amount);
   }
@@ -205,18 +286,33 @@ void Voice::Render(
   if (!lpg_bypass) {
     const float hf = patch.lpg_colour;
     const float decay_tail = (20.0f * kBlockSize) / kSampleRate *
-        SemitonesToRatio(-72.0f * patch.decay + 12.0f * hf) - short_decay;
+        SemitonesToRatio(-72.0f * patch.decay + 12.0f * hf) * block_scale -
+        short_decay;
     
     if (modulations.level_patched) {
       lpg_envelope_.ProcessLP(compressed_level, short_decay, decay_tail, hf);
     } else {
-      const float attack = NoteToFrequency(p.note) * float(kBlockSize) * 2.0f;
+      const float attack = NoteToFrequency(p.note) * float(kBlockSize) * 2.0f *
+          block_scale;
       lpg_envelope_.ProcessPing(attack, short_decay, decay_tail, hf);
     }
   }
   
+  *settings = &pp_s;
+  lpg_bypass_ = lpg_bypass;
+  return lpg_bypass;
+}
+
+void Voice::Render(
+    const Patch& patch,
+    const Modulations& modulations,
+    Frame* frames,
+    size_t size) {
+  const PostProcessingSettings* pp_s;
+  bool lpg_bypass = RenderEngine(patch, modulations, size, &pp_s);
+  
   out_post_processor_.Process(
-      pp_s.out_gain,
+      pp_s->out_gain,
       lpg_bypass,
       lpg_envelope_.gain(),
       lpg_envelope_.frequency(),
@@ -227,7 +323,7 @@ void Voice::Render(
       2);
 
   aux_post_processor_.Process(
-      pp_s.aux_gain,
+      pp_s->aux_gain,
       lpg_bypass,
       lpg_envelope_.gain(),
       lpg_envelope_.frequency(),
@@ -237,5 +333,35 @@ void Voice::Render(
       size,
       2);
 }
+
+void Voice::Render(
+    const Patch& patch,
+    const Modulations& modulations,
+    float* out,
+    float* aux,
+    size_t size) {
+  const PostProcessingSettings* pp_s;
+  bool lpg_bypass = RenderEngine(patch, modulations, size, &pp_s);
+  
+  out_post_processor_.Process(
+      pp_s->out_gain,
+      lpg_bypass,
+      lpg_envelope_.gain(),
+      lpg_envelope_.frequency(),
+      lpg_envelope_.hf_bleed(),
+      out_buffer_,
+      out,
+      size);
+
+  aux_post_processor_.Process(
+      pp_s->aux_gain,
+      lpg_bypass,
+      lpg_envelope_.gain(),
+      lpg_envelope_.frequency(),
+      lpg_envelope_.hf_bleed(),
+      aux_buffer_,
+      aux,
+      size);
+}
   
 }  // namespace plaits
@@ -31,9 +31,13 @@
 
 #include "stmlib/stmlib.h"
 
+#include <type_traits>
+
 #include "stmlib/dsp/filter.h"
 #include "stmlib/dsp/limiter.h"
+#include "stmlib/dsp/simd.h"
 #include "stmlib/utils/buffer_allocator.h"
+#include "stmlib/utils/random_stream.h"
 
 #include "plaits/dsp/engine/additive_engine.h"
 #include "plaits/dsp/engine/bass_drum_engine.h"
@@ -60,8 +64,12 @@
 namespace plaits {
 
 const int kMaxEngines = 16;
-const int kMaxTriggerDelay = 8;
+const size_t kEngineRamSize = 16384;
 const int kTriggerDelay = 5;
+// The trigger is delayed by kTriggerDelay full blocks, counted in samples so
+// that blocks cut short by events do not shorten the delay.
+const int kTriggerDelaySamples = kTriggerDelay * kMaxBlockSize;
+const int kMaxTriggerTransitions = 8;
 
 class ChannelPostProcessor {
  public:
@@ -108,6 +116,44 @@ class ChannelPostProcessor {
     }
   }
   
+  // Same as above, with a float output scaled to [-1, 1] instead of the
+  // 16-bit range. The output is neither quantized nor clipped.
+  void Process(
+      float gain,
+      bool bypass_lpg,
+      float low_pass_gate_gain,
+      float low_pass_gate_frequency,
+      float low_pass_gate_hf_bleed,
+      float* in,
+      float* out,
+      size_t size) {
+    if (gain < 0.0f) {
+      limiter_.Process(-gain, in, size);
+    }
+    const float post_gain = (gain < 0.0f ? 1.0f : gain) * -1.0f;
+    if (!bypass_lpg) {
+      lpg_.Process(
+          post_gain * low_pass_gate_gain,
+          low_pass_gate_frequency,
+          low_pass_gate_hf_bleed,
+          in,
+          out,
+          size);
+    } else {
+      const size_t width = stmlib::SimdTraits<stmlib::f32xN>::width;
+      const stmlib::f32xN post_gain_v = stmlib::SimdSplat<stmlib::f32xN>(
+          post_gain);
+      size_t i = 0;
+      for (; i + width <= size; i += width) {
+        stmlib::SimdStore(
+            &out[i], stmlib::SimdLoad<stmlib::f32xN>(&in[i]) * post_gain_v);
+      }
+      for (; i < size; ++i) {
+        out[i] = in[i] * post_gain;
+      }
+    }
+  }
+  
  private:
   stmlib::Limiter limiter_;
   LowPassGate lpg_;
@@ -146,6 +192,57 @@ struct Modulations {
   bool level_patched;
 };
 
+// Storage for the engine of a voice. Only the engine currently selected is
+// constructed in it, along with the buffers it allocates from ram.
+struct EngineSlot {
+  std::aligned_union<
+      0,
+      AdditiveEngine,
+      BassDrumEngine,
+      ChordEngine,
+      FMEngine,
+      GrainEngine,
+      HiHatEngine,
+      ModalEngine,
+      NoiseEngine,
+      ParticleEngine,
+      SnareDrumEngine,
+      SpeechEngine,
+      StringEngine,
+      SwarmEngine,
+      VirtualAnalogEngine,
+      WaveshapingEngine,
+      WavetableEngine>::type engine;
+  char ram[kEngineRamSize];
+};
+
+// Engine slots of a set of voices, reserved in a single block.
+class EngineArena {
+ public:
+  EngineArena() : slots_(NULL), num_slots_(0) { }
+  ~EngineArena() {
+    delete[] slots_;
+  }
+  
+  void Init(size_t num_slots) {
+    delete[] slots_;
+    slots_ = new EngineSlot[num_slots];
+    num_slots_ = num_slots;
+  }
+  
+  inline EngineSlot* slot(size_t index) {
+    return index < num_slots_ ? &slots_[index] : NULL;
+  }
+  
+  inline size_t size() const { return num_slots_; }
+  
+ private:
+  EngineSlot* slots_;
+  size_t num_slots_;
+  
+  DISALLOW_COPY_AND_ASSIGN(EngineArena);
+};
+
 class Voice {
  public:
   Voice() { }
@@ -156,21 +253,68 @@ class Voice {
     short aux;
   };
   
-  void Init(stmlib::BufferAllocator* allocator);
+  // Voices initialized with different seeds have independent noise sources.
+  void Init(EngineSlot* slot, uint32_t seed);
   void Render(
       const Patch& patch,
       const Modulations& modulations,
       Frame* frames,
       size_t size);
+  // Same as above, with planar float outputs in the [-1, 1] range.
+  void Render(
+      const Patch& patch,
+      const Modulations& modulations,
+      float* out,
+      float* aux,
+      size_t size);
   inline int active_engine() const { return previous_engine_index_; }
+  
+  // Waves played by the wavetable engine instead of the ones of the module,
+  // in the format of wav_integrated_waves. NULL restores the module's.
+  inline void set_wavetable(const int16_t* waves, size_t num_waves) {
+    waves_ = waves;
+    num_waves_ = num_waves;
+  }
 
     bool lpg_active() {
         return lpg_envelope_.gain() > 0.000001f;
     }
+  
+  // True when the last block bypassed the LPG: lpg_active() is then stale.
+  inline bool lpg_bypassed() const { return lpg_bypass_; }
+  
+  // Samples after which a delayed trigger change takes effect, or 0 when none
+  // is pending. A block which starts then applies it at its exact sample.
+  inline int pending_trigger_delay() const {
+    for (int i = 0; i < num_trigger_transitions_; ++i) {
+      const TriggerTransition& t = trigger_transitions_[
+          (trigger_transitions_head_ + i) % kMaxTriggerTransitions];
+      if (t.delay > 0) {
+        return t.delay;
+      }
+    }
+    return 0;
+  }
     
  private:
   void ComputeDecayParameters(const Patch& settings);
   
+  // Constructs, initializes and resets the engine at index in the slot,
+  // in place of the previous one.
+  Engine* CreateEngine(int index);
+  
+  // Delays the trigger input by kTriggerDelaySamples. Returns its value at the
+  // start of the block of size samples.
+  float DelayTrigger(float trigger, size_t size);
+  
+  // Renders the active engine into out_buffer_ and aux_buffer_, and computes
+  // the LPG envelope. Returns true when the LPG is bypassed.
+  bool RenderEngine(
+      const Patch& patch,
+      const Modulations& modulations,
+      size_t size,
+      const PostProcessingSettings** settings);
+  
   inline float ApplyModulations(
       float base_value,
       float modulation_amount,
@@ -193,22 +337,12 @@ class Voice {
     return value;
   }
   
-  AdditiveEngine additive_engine_;
-  BassDrumEngine bass_drum_engine_;
-  ChordEngine chord_engine_;
-  FMEngine fm_engine_;
-  GrainEngine grain_engine_;
-  HiHatEngine hi_hat_engine_;
-  ModalEngine modal_engine_;
-  NoiseEngine noise_engine_;
-  ParticleEngine particle_engine_;
-  SnareDrumEngine snare_drum_engine_;
-  SpeechEngine speech_engine_;
-  StringEngine string_engine_;
-  SwarmEngine swarm_engine_;
-  VirtualAnalogEngine virtual_analog_engine_;
-  WaveshapingEngine waveshaping_engine_;
-  WavetableEngine wavetable_engine_;
+  EngineSlot* slot_;
+  Engine* engine_;
+  
+  const int16_t* waves_;
+  size_t num_waves_;
+  stmlib::RandomStream random_;
 
   stmlib::HysteresisQuantizer engine_quantizer_;
   
@@ -220,15 +354,24 @@ class Voice {
   
   DecayEnvelope decay_envelope_;
   LPGEnvelope lpg_envelope_;
+  bool lpg_bypass_;
   
-  float trigger_delay_line_[kMaxTriggerDelay];
-  DelayLine<float, kMaxTriggerDelay> trigger_delay_;
+  struct TriggerTransition {
+    float value;
+    int delay;
+  };
+  
+  // Changes of the trigger input, oldest first, with the samples left before
+  // they reach the delayed trigger.
+  TriggerTransition trigger_transitions_[kMaxTriggerTransitions];
+  int trigger_transitions_head_;
+  int num_trigger_transitions_;
+  float trigger_input_;
+  float delayed_trigger_;
   
   ChannelPostProcessor out_post_processor_;
   ChannelPostProcessor aux_post_processor_;
   
-  EngineRegistry<kMaxEngines> engines_;
-  
   float out_buffer_[kMaxBlockSize];
   float aux_buffer_[kMaxBlockSize];
   
@@ -0,0 +1,82 @@
+#!/usr/bin/python
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+# See http://creativecommons.org/licenses/MIT/ for more information.
+#
+# -----------------------------------------------------------------------------
+#
+# Wavetable bank for the wavetable engine.
+#
+# Usage: wavetable_bank.py waves.wav waves.bank
+#
+# waves.wav is a mono 16-bit file holding a sequence of single cycles of 256
+# samples. The engine plays its 8x8x3 terrain from the first 192 of them, and
+# wraps around when there are fewer. Like wav_integrated_waves, the bank
+# stores the waves integrated - the engine differentiates its output, which
+# keeps the aliasing down at high pitches - with 4 samples of wrap-around for
+# the interpolation.
+
+import os
+import sys
+
+sys.path.append(os.path.join(os.path.dirname(__file__), '../../stmlib/utils'))
+
+import sample_bank
+
+WAVETABLE_SIZE = 256
+GUARD_SIZE = 4
+
+# Scale of the integrated waves: the steepest slope of each wave is 512.
+SLOPE = 512.0
+
+
+def Integrate(wave):
+  mean = sum(wave) / len(wave)
+  wave = [x - mean for x in wave]
+  peak = max(abs(x) for x in wave) or 1.0
+  integrated = []
+  total = 0.0
+  for x in wave:
+    total += x / peak * SLOPE
+    integrated.append(total)
+  mean = sum(integrated) / len(integrated)
+  # Only a square wave reaches the limits of the 16-bit range.
+  integrated = [
+      max(min(int(round(x - mean)), 32767), -32767) for x in integrated]
+  return integrated + integrated[:GUARD_SIZE]
+
+
+def main(argv):
+  if len(argv) != 3:
+    sys.exit('usage: %s waves.wav waves.bank' % argv[0])
+  samples = sample_bank.ReadWavFile(argv[1])
+  num_waves = len(samples) // WAVETABLE_SIZE
+  if not num_waves:
+    sys.exit('%s: no complete wave' % argv[1])
+  waves = []
+  for i in range(num_waves):
+    waves += Integrate(samples[i * WAVETABLE_SIZE:(i + 1) * WAVETABLE_SIZE])
+  sample_bank.WriteSampleBank(
+      argv[2],
+      [('WAVS', 'h', WAVETABLE_SIZE + GUARD_SIZE, waves)])
+
+
+if __name__ == '__main__':
+  main(sys.argv)
@@ -33,7 +33,7 @@
 
 #include "stmlib/dsp/dsp.h"
 
-#include "rings/dsp/fx/fx_engine.h"
+#include "stmlib/dsp/fx_engine.h"
 #include "rings/resources.h"
 
 namespace rings {
@@ -50,15 +50,30 @@ class Chorus {
   }
   
   void Process(float* left, float* right, size_t size) {
+    size_t i = 0;
+    for (; i + stmlib::kSimdWidth <= size; i += stmlib::kSimdWidth) {
+      Process<stmlib::f32xN>(&left[i], &right[i]);
+    }
+    for (; i < size; ++i) {
+      Process<float>(&left[i], &right[i]);
+    }
+  }
+  
+  template<typename F>
+  inline void Process(float* left_in_out, float* right_in_out) {
     typedef E::Reserve<2047> Memory;
     E::DelayLine<Memory, 0> line;
-    E::Context c;
+    E::Context<F> c;
     
-    while (size--) {
-      engine_.Start(&c);
-      float dry_amount = 1.0f - amount_ * 0.5f;
+    engine_.Start(&c);
+    float dry_amount = 1.0f - amount_ * 0.5f;
     
-      // Update LFO.
+    // Update LFO.
+    F sin_1;
+    F cos_1;
+    F sin_2;
+    F cos_2;
+    for (size_t k = 0; k < c.width; ++k) {
       phase_1_ += 4.17e-06f;
       if (phase_1_ >= 1.0f) {
         phase_1_ -= 1.0f;
@@ -67,30 +82,37 @@ class Chorus {
       if (phase_2_ >= 1.0f) {
         phase_2_ -= 1.0f;
       }
-      float sin_1 = stmlib::Interpolate(lut_sine, phase_1_, 4096.0f);
-      float cos_1 = stmlib::Interpolate(lut_sine, phase_1_ + 0.25f, 4096.0f);
-      float sin_2 = stmlib::Interpolate(lut_sine, phase_2_, 4096.0f);
-      float cos_2 = stmlib::Interpolate(lut_sine, phase_2_ + 0.25f, 4096.0f);
+      stmlib::SimdSetLane(
+          &sin_1, k, stmlib::Interpolate(lut_sine, phase_1_, 4096.0f));
+      stmlib::SimdSetLane(
+          &cos_1, k, stmlib::Interpolate(lut_sine, phase_1_ + 0.25f, 4096.0f));
+      stmlib::SimdSetLane(
+          &sin_2, k, stmlib::Interpolate(lut_sine, phase_2_, 4096.0f));
+      stmlib::SimdSetLane(
+          &cos_2, k, stmlib::Interpolate(lut_sine, phase_2_ + 0.25f, 4096.0f));
+    }
     
-      float wet;
+    F left = stmlib::SimdLoad<F>(left_in_out);
+    F right = stmlib::SimdLoad<F>(right_in_out);
+    F wet;
     
-      // Sum L & R channel to send to chorus line.
-      c.Read(*left, 0.5f);
-      c.Read(*right, 0.5f);
-      c.Write(line, 0.0f);
+    // Sum L & R channel to send to chorus line.
+    c.Read(left, 0.5f);
+    c.Read(right, 0.5f);
+    c.Write(line, 0.0f);
     
-      c.Interpolate(line, sin_1 * depth_ + 1200, 0.5f);
-      c.Interpolate(line, sin_2 * depth_ + 800, 0.5f);
-      c.Write(wet, 0.0f);
-      *left = wet * amount_ + *left * dry_amount;
-      
-      c.Interpolate(line, cos_1 * depth_ + 800 + cos_2 * 0, 0.5f);
-      c.Interpolate(line, cos_2 * depth_ + 1200, 0.5f);
-      c.Write(wet, 0.0f);
-      *right = wet * amount_ + *right * dry_amount;
-      left++;
-      right++;
-    }
+    c.Interpolate(line, sin_1 * depth_ + 1200.0f, 0.5f);
+    c.Interpolate(line, sin_2 * depth_ + 800.0f, 0.5f);
+    c.Write(wet, 0.0f);
+    left = wet * amount_ + left * dry_amount;
+    
+    c.Interpolate(line, cos_1 * depth_ + 800.0f + cos_2 * 0.0f, 0.5f);
+    c.Interpolate(line, cos_2 * depth_ + 1200.0f, 0.5f);
+    c.Write(wet, 0.0f);
+    right = wet * amount_ + right * dry_amount;
+    
+    stmlib::SimdStore(left_in_out, left);
+    stmlib::SimdStore(right_in_out, right);
   }
   
   inline void set_amount(float amount) {
@@ -102,7 +124,7 @@ class Chorus {
   }
   
  private:
-  typedef FxEngine<2048, FORMAT_16_BIT> E;
+  typedef stmlib::FxEngine<4096, stmlib::FORMAT_16_BIT> E;
   E engine_;
   
   float amount_;
@@ -33,7 +33,7 @@
 
 #include "stmlib/dsp/dsp.h"
 
-#include "rings/dsp/fx/fx_engine.h"
+#include "stmlib/dsp/fx_engine.h"
 #include "rings/resources.h"
 
 namespace rings {
@@ -50,16 +50,30 @@ class Ensemble {
   }
   
   void Process(float* left, float* right, size_t size) {
+    size_t i = 0;
+    for (; i + stmlib::kSimdWidth <= size; i += stmlib::kSimdWidth) {
+      Process<stmlib::f32xN>(&left[i], &right[i]);
+    }
+    for (; i < size; ++i) {
+      Process<float>(&left[i], &right[i]);
+    }
+  }
+  
+  template<typename F>
+  inline void Process(float* left_in_out, float* right_in_out) {
     typedef E::Reserve<2047, E::Reserve<2047> > Memory;
     E::DelayLine<Memory, 0> line_l;
     E::DelayLine<Memory, 1> line_r;
-    E::Context c;
+    E::Context<F> c;
     
-    while (size--) {
-      engine_.Start(&c);
-      float dry_amount = 1.0f - amount_ * 0.5f;
+    engine_.Start(&c);
+    float dry_amount = 1.0f - amount_ * 0.5f;
     
-      // Update LFO.
+    // Update LFO.
+    F mod_1;
+    F mod_2;
+    F mod_3;
+    for (size_t k = 0; k < c.width; ++k) {
       phase_1_ += 1.57e-05f;
       if (phase_1_ >= 1.0f) {
         phase_1_ -= 1.0f;
@@ -80,32 +94,35 @@ class Ensemble {
       float a = depth_ * 1.0f;
       float b = depth_ * 0.1f;
       
-      float mod_1 = slow_0 * a + fast_0 * b;
-      float mod_2 = slow_120 * a + fast_120 * b;
-      float mod_3 = slow_240 * a + fast_240 * b;
+      stmlib::SimdSetLane(&mod_1, k, slow_0 * a + fast_0 * b);
+      stmlib::SimdSetLane(&mod_2, k, slow_120 * a + fast_120 * b);
+      stmlib::SimdSetLane(&mod_3, k, slow_240 * a + fast_240 * b);
+    }
     
-      float wet = 0.0f;
+    F left = stmlib::SimdLoad<F>(left_in_out);
+    F right = stmlib::SimdLoad<F>(right_in_out);
+    F wet;
     
-      // Sum L & R channel to send to chorus line.
-      c.Read(*left, 1.0f);
-      c.Write(line_l, 0.0f);
-      c.Read(*right, 1.0f);
-      c.Write(line_r, 0.0f);
+    // Sum L & R channel to send to chorus line.
+    c.Read(left, 1.0f);
+    c.Write(line_l, 0.0f);
+    c.Read(right, 1.0f);
+    c.Write(line_r, 0.0f);
     
-      c.Interpolate(line_l, mod_1 + 1024, 0.33f);
-      c.Interpolate(line_l, mod_2 + 1024, 0.33f);
-      c.Interpolate(line_r, mod_3 + 1024, 0.33f);
-      c.Write(wet, 0.0f);
-      *left = wet * amount_ + *left * dry_amount;
-      
-      c.Interpolate(line_r, mod_1 + 1024, 0.33f);
-      c.Interpolate(line_r, mod_2 + 1024, 0.33f);
-      c.Interpolate(line_l, mod_3 + 1024, 0.33f);
-      c.Write(wet, 0.0f);
-      *right = wet * amount_ + *right * dry_amount;
-      left++;
-      right++;
-    }
+    c.Interpolate(line_l, mod_1 + 1024.0f, 0.33f);
+    c.Interpolate(line_l, mod_2 + 1024.0f, 0.33f);
+    c.Interpolate(line_r, mod_3 + 1024.0f, 0.33f);
+    c.Write(wet, 0.0f);
+    left = wet * amount_ + left * dry_amount;
+    
+    c.Interpolate(line_r, mod_1 + 1024.0f, 0.33f);
+    c.Interpolate(line_r, mod_2 + 1024.0f, 0.33f);
+    c.Interpolate(line_l, mod_3 + 1024.0f, 0.33f);
+    c.Write(wet, 0.0f);
+    right = wet * amount_ + right * dry_amount;
+    
+    stmlib::SimdStore(left_in_out, left);
+    stmlib::SimdStore(right_in_out, right);
   }
   
   inline void set_amount(float amount) {
@@ -117,7 +134,7 @@ class Ensemble {
   }
   
  private:
-  typedef FxEngine<4096, FORMAT_16_BIT> E;
+  typedef stmlib::FxEngine<8192, stmlib::FORMAT_16_BIT> E;
   E engine_;
   
   float amount_;
@@ -44,12 +44,16 @@ void Part::Init(uint16_t* reverb_buffer) {
   
   bypass_ = false;
   polyphony_ = 1;
+  resolution_ = 0;
+  resolution_scale_ = 1.0f;
   model_ = RESONATOR_MODEL_MODAL;
+  resonator_kernel_ = SVF_BANK_KERNEL_SIMD;
   dirty_ = true;
   
   for (int32_t i = 0; i < kMaxPolyphony; ++i) {
+    random_[i].Init(i);
     excitation_filter_[i].Init();
-    plucker_[i].Init();
+    plucker_[i].Init(&random_[i]);
     dc_blocker_[i].Init(1.0f - 10.0f / kSampleRate);
   }
   
@@ -72,11 +76,11 @@ void Part::ConfigureResonators() {
   switch (model_) {
     case RESONATOR_MODEL_MODAL:
       {
-        int32_t resolution = 64 / polyphony_ - 4;
         for (int32_t i = 0; i < polyphony_; ++i) {
           resonator_[i].Init();
-          resonator_[i].set_resolution(resolution);
+          resonator_[i].set_kernel(resonator_kernel_);
         }
+        UpdateResolution();
       }
       break;
     
@@ -85,20 +89,21 @@ void Part::ConfigureResonators() {
     case RESONATOR_MODEL_SYMPATHETIC_STRING_QUANTIZED:
     case RESONATOR_MODEL_STRING_AND_REVERB:
       {
-        float lfo_frequencies[kNumStrings] = {
+        float lfo_frequencies[kNumSympatheticStringsBudget] = {
           0.5f, 0.4f, 0.35f, 0.23f, 0.211f, 0.2f, 0.171f
         };
+        bool has_dispersion = model_ == RESONATOR_MODEL_STRING || \
+            model_ == RESONATOR_MODEL_STRING_AND_REVERB;
+        strings_.Init(has_dispersion);
         for (int32_t i = 0; i < kNumStrings; ++i) {
-          bool has_dispersion = model_ == RESONATOR_MODEL_STRING || \
-              model_ == RESONATOR_MODEL_STRING_AND_REVERB;
-          string_[i].Init(has_dispersion);
+          strings_.set_random(i, &random_[i % polyphony_]);
 
           float f_lfo = float(kMaxBlockSize) / float(kSampleRate);
-          f_lfo *= lfo_frequencies[i];
+          f_lfo *= lfo_frequencies[i % kNumSympatheticStringsBudget];
           lfo_[i].Init<COSINE_OSCILLATOR_APPROXIMATE>(f_lfo);
         }
         for (int32_t i = 0; i < polyphony_; ++i) {
-          plucker_[i].Init();
+          plucker_[i].Init(&random_[i]);
         }
       }
       break;
@@ -121,10 +126,26 @@ void Part::ConfigureResonators() {
   dirty_ = false;
 }
 
+void Part::UpdateResolution() {
+  int32_t resolution = resolution_
+      ? resolution_
+      : kNumModesBudget / polyphony_ - 4;
+  resolution = static_cast<int32_t>(
+      static_cast<float>(resolution) * resolution_scale_);
+  resolution = max(resolution, kMinResolution);
+  for (int32_t i = 0; i < kMaxPolyphony; ++i) {
+    resonator_[i].set_resolution(resolution);
+  }
+}
+
+// One table per polyphony of the module. Above 4 voices, every voice has 2
+// strings, as with 4 voices.
+const int32_t kNumChordTables = 4;
+
 #ifdef BRYAN_CHORDS
 
 // Chord table by Bryan Noll:
-float chords[kMaxPolyphony][11][8] = {
+float chords[kNumChordTables][11][8] = {
   {
     { -12.0f, -0.01f, 0.0f,  0.01f, 0.02f, 11.98f, 11.99f, 12.0f }, // OCT
     { -12.0f, -5.0f,  0.0f,  6.99f, 7.0f,  11.99f, 12.0f,  19.0f }, // 5
@@ -182,7 +203,7 @@ float chords[kMaxPolyphony][11][8] = {
 #else
 
 // Original chord table
-float chords[kMaxPolyphony][11][8] = {
+float chords[kNumChordTables][11][8] = {
   {
     { -12.0f, 0.0f, 0.01f, 0.02f, 0.03f, 11.98f, 11.99f, 12.0f },
     { -12.0f, 0.0f, 3.0f,  3.01f, 7.0f,  9.99f,  10.0f,  19.0f },
@@ -265,7 +286,8 @@ void Part::ComputeSympatheticStringsNotes(
   if (parameter >= 2.0f) {
     // Quantized chords
     int32_t chord_index = parameter - 2.0f;
-    const float* chord = chords[polyphony_ - 1][chord_index];
+    int32_t table = min(polyphony_, kNumChordTables) - 1;
+    const float* chord = chords[table][chord_index];
     for (size_t i = 0; i < num_strings; ++i) {
       destination[i] = chord[i] + note;
     }
@@ -347,7 +369,7 @@ void Part::RenderFMVoice(
   v.Process(resonator_input_, out_buffer_, aux_buffer_, size);
 }
 
-void Part::RenderStringVoice(
+void Part::PrepareStringVoice(
     int32_t voice,
     const PerformanceState& performance_state,
     const Patch& patch,
@@ -355,12 +377,10 @@ void Part::RenderStringVoice(
     float filter_cutoff,
     size_t size) {
   // Compute number of strings and frequency.
-  int32_t num_strings = 1;
+  int32_t num_strings = num_strings_per_voice();
   float frequencies[kNumStrings];
 
-  if (model_ == RESONATOR_MODEL_SYMPATHETIC_STRING ||
-      model_ == RESONATOR_MODEL_SYMPATHETIC_STRING_QUANTIZED) {
-    num_strings = 2 * kMaxPolyphony / polyphony_;
+  if (num_strings > 1) {
     float parameter = model_ == RESONATOR_MODEL_SYMPATHETIC_STRING
         ? patch.structure
         : 2.0f + performance_state.chord;
@@ -399,9 +419,7 @@ void Part::RenderStringVoice(
     }
   }
   dc_blocker_[voice].Process(resonator_input_, size);
-  
-  fill(&out_buffer_[0], &out_buffer_[size], 0.0f);
-  fill(&aux_buffer_[0], &aux_buffer_[size], 0.0f);
+  copy(&resonator_input_[0], &resonator_input_[size], &string_input_[voice][0]);
   
   float structure = patch.structure;
   float dispersion = structure < 0.24f
@@ -410,7 +428,6 @@ void Part::RenderStringVoice(
   
   for (int32_t string = 0; string < num_strings; ++string) {
     int32_t i = voice + string * polyphony_;
-    String& s = string_[i];
     float lfo_value = lfo_[i].Next();
     
     float brightness = patch.brightness;
@@ -418,7 +435,6 @@ void Part::RenderStringVoice(
     float position = patch.position;
     float glide = 1.0f;
     float string_index = static_cast<float>(string) / static_cast<float>(num_strings);
-    const float* input = resonator_input_;
     
     if (model_ == RESONATOR_MODEL_STRING_AND_REVERB) {
       damping *= (2.0f - damping);
@@ -435,24 +451,92 @@ void Part::RenderStringVoice(
       float amount = (0.5f - fabs(0.5f - patch.position)) * 0.9f;
       position = patch.position + lfo_value * amount;
       glide = SemitonesToRatio((brightness - 1.0f) * 36.0f);
-      input = sympathetic_resonator_input_;
     }
     
-    s.set_dispersion(dispersion);
-    s.set_frequency(frequencies[string], glide);
-    s.set_brightness(brightness);
-    s.set_position(position);
-    s.set_damping(damping + string_index * (0.95f - damping));
-    s.Process(input, out_buffer_, aux_buffer_, size);
-    
-    if (string == 0) {
-      // Was 0.1f, Ben Wilson -> 0.2f
-      float gain = 0.2f / static_cast<float>(num_strings);
+    strings_.set_dispersion(i, dispersion);
+    strings_.set_frequency(i, frequencies[string], glide);
+    strings_.set_brightness(i, brightness);
+    strings_.set_position(i, position);
+    strings_.set_damping(i, damping + string_index * (0.95f - damping));
+  }
+}
+
+void Part::RenderStrings(
+    const PerformanceState& performance_state,
+    float* out,
+    float* aux,
+    size_t size) {
+  int32_t num_strings = num_strings_per_voice();
+  const float* string_input[kNumStrings];
+  float* string_out[kNumStrings];
+  float* string_aux[kNumStrings];
+  for (int32_t i = 0; i < num_strings * polyphony_; ++i) {
+    int32_t voice = i % polyphony_;
+    bool sympathetic = i >= polyphony_ && performance_state.internal_exciter;
+    string_input[i] = sympathetic
+        ? sympathetic_string_input_[voice]
+        : string_input_[voice];
+    string_out[i] = string_out_[voice];
+    string_aux[i] = string_aux_[voice];
+  }
+  for (int32_t voice = 0; voice < polyphony_; ++voice) {
+    fill(&string_out_[voice][0], &string_out_[voice][size], 0.0f);
+    fill(&string_aux_[voice][0], &string_aux_[voice][size], 0.0f);
+  }
+  
+  // The first string of every voice is rendered first, since it drives the
+  // other strings of its voice.
+  strings_.Process(
+      resonator_kernel_,
+      0,
+      polyphony_,
+      string_input,
+      string_out,
+      string_aux,
+      size);
+  if (num_strings > 1) {
+    // Was 0.1f, Ben Wilson -> 0.2f
+    float gain = 0.2f / static_cast<float>(num_strings);
+    for (int32_t voice = 0; voice < polyphony_; ++voice) {
       for (size_t i = 0; i < size; ++i) {
-        float sum = out_buffer_[i] - aux_buffer_[i];
-        sympathetic_resonator_input_[i] = gain * sum;
+        float sum = string_out_[voice][i] - string_aux_[voice][i];
+        sympathetic_string_input_[voice][i] = gain * sum;
       }
     }
+    strings_.Process(
+        resonator_kernel_,
+        polyphony_,
+        (num_strings - 1) * polyphony_,
+        string_input,
+        string_out,
+        string_aux,
+        size);
+  }
+  
+  for (int32_t voice = 0; voice < polyphony_; ++voice) {
+    MixVoice(voice, string_out_[voice], string_aux_[voice], out, aux, size);
+  }
+}
+
+void Part::MixVoice(
+    int32_t voice,
+    const float* voice_out,
+    const float* voice_aux,
+    float* out,
+    float* aux,
+    size_t size) {
+  if (polyphony_ == 1) {
+    // Send the two sets of harmonics / pickups to individual outputs.
+    for (size_t i = 0; i < size; ++i) {
+      out[i] += voice_out[i];
+      aux[i] += voice_aux[i];
+    }
+  } else {
+    // Dispatch odd/even voices to individual outputs.
+    float* destination = voice & 1 ? aux : out;
+    for (size_t i = 0; i < size; ++i) {
+      destination[i] += voice_out[i] - voice_aux[i];
+    }
   }
 }
 
@@ -483,7 +567,7 @@ void Part::Process(
 
   if (performance_state.strum) {
     note_[active_voice_] = note_filter_.stable_note();
-    if (polyphony_ > 1 && polyphony_ & 1) {
+    if (polyphony_ == 3) {
       active_voice_ = kPingPattern[step_counter_ % 8];
       step_counter_ = (step_counter_ + 1) % 8;
     } else {
@@ -520,27 +604,19 @@ void Part::Process(
     if (model_ == RESONATOR_MODEL_MODAL) {
       RenderModalVoice(
           voice, performance_state, patch, frequency, filter_cutoff, size);
+      MixVoice(voice, out_buffer_, aux_buffer_, out, aux, size);
     } else if (model_ == RESONATOR_MODEL_FM_VOICE) {
       RenderFMVoice(
           voice, performance_state, patch, frequency, filter_cutoff, size);
+      MixVoice(voice, out_buffer_, aux_buffer_, out, aux, size);
     } else {
-      RenderStringVoice(
+      PrepareStringVoice(
           voice, performance_state, patch, frequency, filter_cutoff, size);
     }
-    
-    if (polyphony_ == 1) {
-      // Send the two sets of harmonics / pickups to individual outputs.
-      for (size_t i = 0; i < size; ++i) {
-        out[i] += out_buffer_[i];
-        aux[i] += aux_buffer_[i];
-      }
-    } else {
-      // Dispatch odd/even voices to individual outputs.
-      float* destination = voice & 1 ? aux : out;
-      for (size_t i = 0; i < size; ++i) {
-        destination[i] += out_buffer_[i] - aux_buffer_[i];
-      }
-    }
+  }
+  
+  if (model_ != RESONATOR_MODEL_MODAL && model_ != RESONATOR_MODEL_FM_VOICE) {
+    RenderStrings(performance_state, out, aux, size);
   }
   
   if (model_ == RESONATOR_MODEL_STRING_AND_REVERB) {
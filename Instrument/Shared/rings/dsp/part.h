@@ -34,6 +34,7 @@
 #include "stmlib/stmlib.h"
 #include "stmlib/dsp/cosine_oscillator.h"
 #include "stmlib/dsp/delay_line.h"
+#include "stmlib/utils/random_stream.h"
 
 #include "rings/dsp/dsp.h"
 #include "rings/dsp/fm_voice.h"
@@ -44,7 +45,7 @@
 #include "rings/dsp/performance_state.h"
 #include "rings/dsp/plucker.h"
 #include "rings/dsp/resonator.h"
-#include "rings/dsp/rings_string.h"
+#include "rings/dsp/string_bank.h"
 
 namespace rings {
 
@@ -60,9 +61,16 @@ enum ResonatorModel {
   RESONATOR_MODEL_LAST
 };
 
-const int32_t kMaxPolyphony = 4;
+const int32_t kMaxPolyphony = 16;
 const int32_t kNumStrings = kMaxPolyphony * 2;
 
+// The module shares 64 modes and 8 sympathetic strings among its (up to 4)
+// voices. These budgets are kept by default, but each voice always gets at
+// least 2 strings, and the number of modes per voice can be set explicitly.
+const int32_t kNumModesBudget = 64;
+const int32_t kNumSympatheticStringsBudget = 8;
+const int32_t kMinResolution = 4;
+
 class Part {
  public:
   Part() { }
@@ -84,7 +92,7 @@ class Part {
   inline int32_t polyphony() const { return polyphony_; }
   inline void set_polyphony(int32_t polyphony) {
     int32_t old_polyphony = polyphony_;
-    polyphony_ = std::min(polyphony, kMaxPolyphony);
+    polyphony_ = std::max(std::min(polyphony, kMaxPolyphony), int32_t(1));
     for (int32_t i = old_polyphony; i < polyphony_; ++i) {
       note_[i] = note_[0] + i * 0.05f;
     }
@@ -98,9 +106,36 @@ class Part {
       dirty_ = true;
     }
   }
+  
+  // Number of modes of each voice of the modal resonator, up to 64. With 0,
+  // the mode budget of the module is divided among the voices.
+  inline int32_t resolution() const { return resolution_; }
+  inline void set_resolution(int32_t resolution) {
+    resolution_ = resolution;
+    UpdateResolution();
+  }
+  
+  // Fraction of these modes actually rendered. Lowered when the CPU cannot
+  // keep up: the highest modes, which are the quietest, are dropped first.
+  inline float resolution_scale() const { return resolution_scale_; }
+  inline void set_resolution_scale(float resolution_scale) {
+    resolution_scale_ = resolution_scale;
+    UpdateResolution();
+  }
+  
+  inline stmlib::SvfBankKernel resonator_kernel() const {
+    return resonator_kernel_;
+  }
+  inline void set_resonator_kernel(stmlib::SvfBankKernel kernel) {
+    resonator_kernel_ = kernel;
+    for (int32_t i = 0; i < kMaxPolyphony; ++i) {
+      resonator_[i].set_kernel(kernel);
+    }
+  }
 
  private:
   void ConfigureResonators();
+  void UpdateResolution();
   void RenderModalVoice(
       int32_t voice,
       const PerformanceState& performance_state,
@@ -108,13 +143,20 @@ class Part {
       float frequency,
       float filter_cutoff,
       size_t size);
-  void RenderStringVoice(
+  // Computes the excitation of the strings of a voice, and sets their
+  // parameters. The strings of all voices are then rendered together.
+  void PrepareStringVoice(
       int32_t voice,
       const PerformanceState& performance_state,
       const Patch& patch,
       float frequency,
       float filter_cutoff,
       size_t size);
+  void RenderStrings(
+      const PerformanceState& performance_state,
+      float* out,
+      float* aux,
+      size_t size);
   void RenderFMVoice(
       int32_t voice,
       const PerformanceState& performance_state,
@@ -122,7 +164,20 @@ class Part {
       float frequency,
       float filter_cutoff,
       size_t size);
+  void MixVoice(
+      int32_t voice,
+      const float* voice_out,
+      const float* voice_aux,
+      float* out,
+      float* aux,
+      size_t size);
   
+  inline int32_t num_strings_per_voice() const {
+    return model_ == RESONATOR_MODEL_SYMPATHETIC_STRING ||
+        model_ == RESONATOR_MODEL_SYMPATHETIC_STRING_QUANTIZED
+        ? std::max(kNumSympatheticStringsBudget / polyphony_, int32_t(2))
+        : 1;
+  }
 
   inline float Squash(float x) const {
     if (x < 0.5f) {
@@ -154,28 +209,39 @@ class Part {
   bool dirty_;
 
   ResonatorModel model_;
+  stmlib::SvfBankKernel resonator_kernel_;
 
   int32_t num_voices_;
   int32_t active_voice_;
   uint32_t step_counter_;
   int32_t polyphony_;
+  int32_t resolution_;
+  float resolution_scale_;
   
   Resonator resonator_[kMaxPolyphony];
-  String string_[kNumStrings];
+  // String i belongs to voice i % polyphony_.
+  StringBank<kNumStrings> strings_;
   stmlib::CosineOscillator lfo_[kNumStrings];
   FMVoice fm_voice_[kMaxPolyphony];
   
   stmlib::Svf excitation_filter_[kMaxPolyphony];
   stmlib::DCBlocker dc_blocker_[kMaxPolyphony];
   Plucker plucker_[kMaxPolyphony];
+  
+  // One noise source per voice, shared by its plucker and strings.
+  stmlib::RandomStream random_[kMaxPolyphony];
 
   float note_[kMaxPolyphony];
   NoteFilter note_filter_;
   
   float resonator_input_[kMaxBlockSize];
-  float sympathetic_resonator_input_[kMaxBlockSize];
   float noise_burst_buffer_[kMaxBlockSize];
   
+  float string_input_[kMaxPolyphony][kMaxBlockSize];
+  float sympathetic_string_input_[kMaxPolyphony][kMaxBlockSize];
+  float string_out_[kMaxPolyphony][kMaxBlockSize];
+  float string_aux_[kMaxPolyphony][kMaxBlockSize];
+  
   float out_buffer_[kMaxBlockSize];
   float aux_buffer_[kMaxBlockSize];
   
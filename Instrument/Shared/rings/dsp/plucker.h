@@ -35,7 +35,7 @@
 
 #include "stmlib/dsp/filter.h"
 #include "stmlib/dsp/delay_line.h"
-#include "stmlib/utils/random.h"
+#include "stmlib/utils/random_stream.h"
 
 namespace rings {
 
@@ -44,7 +44,8 @@ class Plucker {
   Plucker() { }
   ~Plucker() { }
   
-  void Init() {
+  void Init(stmlib::RandomStream* random) {
+    random_ = random;
     svf_.Init();
     comb_filter_.Init();
     remaining_samples_ = 0;
@@ -66,12 +67,11 @@ class Plucker {
   void Process(float* out, size_t size) {
     const float comb_gain = comb_filter_gain_;
     const float comb_delay = comb_filter_period_;
+    const size_t burst_size = std::min(remaining_samples_, size);
+    random_->Fill(out, burst_size);
+    remaining_samples_ -= burst_size;
     for (size_t i = 0; i < size; ++i) {
-      float in = 0.0f;
-      if (remaining_samples_) {
-        in = 2.0f * Random::GetFloat() - 1.0f;
-        --remaining_samples_;
-      }
+      float in = i < burst_size ? 2.0f * out[i] - 1.0f : 0.0f;
       out[i] = in + comb_gain * comb_filter_.Read(comb_delay);
       comb_filter_.Write(out[i]);
     }
@@ -79,6 +79,7 @@ class Plucker {
   }
 
  private:
+  stmlib::RandomStream* random_;
   stmlib::Svf svf_;
   stmlib::DelayLine<float, 256> comb_filter_;
   size_t remaining_samples_;
@@ -40,9 +40,7 @@ using namespace std;
 using namespace stmlib;
 
 void Resonator::Init() {
-  for (int32_t i = 0; i < kMaxModes; ++i) {
-    f_[i].Init();
-  }
+  f_.Init();
 
   set_frequency(220.0f / kSampleRate);
   set_structure(0.25f);
@@ -51,6 +49,7 @@ void Resonator::Init() {
   set_position(0.999f);
   previous_position_ = 0.0f;
   set_resolution(kMaxModes);
+  set_kernel(SVF_BANK_KERNEL_SIMD);
 }
 
 int32_t Resonator::ComputeFilters() {
@@ -78,7 +77,8 @@ int32_t Resonator::ComputeFilters() {
     } else {
       num_modes = i + 1;
     }
-    f_[i].set_f_q<FREQUENCY_FAST>(
+    f_.set_f_q<FREQUENCY_FAST>(
+        i,
         partial_frequency,
         1.0f + partial_frequency * q);
     stretch_factor += stiffness;
@@ -102,17 +102,27 @@ void Resonator::Process(const float* in, float* out, float* aux, size_t size) {
   int32_t num_modes = ComputeFilters();
   
   ParameterInterpolator position(&previous_position_, position_, size);
+  float band_pass[kMaxModes];
   while (size--) {
     CosineOscillator amplitudes;
     amplitudes.Init<COSINE_OSCILLATOR_APPROXIMATE>(position.Next());
     
     float input = *in++ * 0.125f;
+    // Modes are processed in pairs, hence the rounding.
+    f_.Process<FILTER_MODE_BAND_PASS>(
+        kernel_,
+        input,
+        band_pass,
+        (num_modes + 1) & ~1);
+    
+    // The modes are summed in the same order as they used to be when each
+    // filter was processed individually.
     float odd = 0.0f;
     float even = 0.0f;
     amplitudes.Start();
     for (int32_t i = 0; i < num_modes;) {
-      odd += amplitudes.Next() * f_[i++].Process<FILTER_MODE_BAND_PASS>(input);
-      even += amplitudes.Next() * f_[i++].Process<FILTER_MODE_BAND_PASS>(input);
+      odd += amplitudes.Next() * band_pass[i++];
+      even += amplitudes.Next() * band_pass[i++];
     }
     *out++ = odd;
     *aux++ = even;
@@ -36,6 +36,7 @@
 #include "rings/dsp/dsp.h"
 #include "stmlib/dsp/filter.h"
 #include "stmlib/dsp/delay_line.h"
+#include "stmlib/dsp/svf_bank.h"
 
 namespace rings {
 
@@ -78,6 +79,16 @@ class Resonator {
     resolution_ = std::min(resolution, kMaxModes);
   }
   
+  // The SIMD kernel produces the same output as the scalar one; the latter
+  // is kept as a reference.
+  inline void set_kernel(stmlib::SvfBankKernel kernel) {
+    kernel_ = kernel;
+  }
+  
+  inline stmlib::SvfBankKernel kernel() const {
+    return kernel_;
+  }
+  
  private:
   int32_t ComputeFilters();
   float frequency_;
@@ -88,8 +99,9 @@ class Resonator {
   float damping_;
   
   int32_t resolution_;
+  stmlib::SvfBankKernel kernel_;
   
-  stmlib::Svf f_[kMaxModes];
+  stmlib::SvfBank<kMaxModes> f_;
   
   DISALLOW_COPY_AND_ASSIGN(Resonator);
 };
@@ -35,6 +35,7 @@
 
 #include "stmlib/dsp/delay_line.h"
 #include "stmlib/dsp/filter.h"
+#include "stmlib/utils/random_stream.h"
 
 #include "rings/dsp/dsp.h"
 
@@ -98,7 +99,7 @@ class String {
   String() { }
   ~String() { }
   
-  void Init(bool enable_dispersion);
+  void Init(bool enable_dispersion, stmlib::RandomStream* random);
   void Process(const float* in, float* out, float* aux, size_t size);
   
   inline void set_frequency(float frequency) {
@@ -142,6 +143,8 @@ class String {
   float previous_dispersion_;
   float previous_damping_compensation_;
   
+  stmlib::RandomStream* random_;
+  
   bool enable_dispersion_;
   bool enable_iir_damping_;
   float dispersion_noise_;
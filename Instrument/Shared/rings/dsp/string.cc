@@ -33,7 +33,6 @@
 #include "stmlib/dsp/dsp.h"
 #include "stmlib/dsp/parameter_interpolator.h"
 #include "stmlib/dsp/units.h"
-#include "stmlib/utils/random.h"
 
 #include "rings/resources.h"
 
@@ -42,8 +41,9 @@ namespace rings {
 using namespace std;
 using namespace stmlib;
 
-void String::Init(bool enable_dispersion) {
+void String::Init(bool enable_dispersion, RandomStream* random) {
   enable_dispersion_ = enable_dispersion;
+  random_ = random;
   
   string_.Init();
   stretch_.Init();
@@ -143,7 +143,7 @@ void String::ProcessInternal(
       float s = 0.0f;
 
       if (enable_dispersion) {
-        float noise = 2.0f * Random::GetFloat() - 1.0f;
+        float noise = 2.0f * random_->GetFloat() - 1.0f;
         noise *= 1.0f / (0.2f + noise_filter);
         dispersion_noise_ += noise_filter * (noise - dispersion_noise_);
 
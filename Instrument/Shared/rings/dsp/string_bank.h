@@ -0,0 +1,497 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Bank of KS strings advanced together, one sample at a time. Same model as
+// String, with the per-string state stored as a structure of arrays: the delay
+// lines are read and written string by string, and everything else (dispersion
+// modulation, bridge, damping filters) runs in the lanes of a SIMD vector.
+//
+// Strings whose period does not fit in the delay line (f0 < 11.7 Hz) go
+// through the same linear upsampler as in String. Since their samples are not
+// computed at every tick, a block in which such a string is present is
+// rendered string by string.
+
+#ifndef RINGS_DSP_STRING_BANK_H_
+#define RINGS_DSP_STRING_BANK_H_
+
+#include "stmlib/stmlib.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "stmlib/dsp/dsp.h"
+#include "stmlib/dsp/filter.h"
+#include "stmlib/dsp/simd.h"
+#include "stmlib/dsp/svf_bank.h"
+#include "stmlib/dsp/units.h"
+#include "stmlib/utils/random_stream.h"
+
+#include "rings/dsp/dsp.h"
+#include "rings/dsp/rings_string.h"
+#include "rings/resources.h"
+
+namespace rings {
+
+template<size_t max_num_strings>
+class StringBank {
+ public:
+  StringBank() { }
+  ~StringBank() { }
+
+  void Init(bool enable_dispersion) {
+    enable_dispersion_ = enable_dispersion;
+    for (size_t i = 0; i < max_num_strings; ++i) {
+      string_[i].Init();
+      stretch_[i].Init();
+      random_[i] = NULL;
+
+      set_frequency(i, 220.0f / kSampleRate);
+      set_dispersion(i, 0.25f);
+      set_brightness(i, 0.5f);
+      set_damping(i, 0.3f);
+      set_position(i, 0.8f);
+
+      delay_[i] = 1.0f / frequency_[i];
+      clamped_position_[i] = 0.0f;
+      previous_dispersion_[i] = 0.0f;
+      dispersion_noise_[i] = 0.0f;
+      curved_bridge_[i] = 0.0f;
+      previous_damping_compensation_[i] = 0.0f;
+
+      fir_x_[i] = fir_x__[i] = 0.0f;
+      fir_brightness_[i] = fir_damping_[i] = 0.0f;
+
+      set_iir_f_q<stmlib::FREQUENCY_DIRTY>(i, 0.01f, 100.0f);
+      iir_state_1_[i] = iir_state_2_[i] = 0.0f;
+
+      dc_x_[i] = dc_y_[i] = 0.0f;
+
+      src_phase_[i] = 0.0f;
+      out_sample_[0][i] = out_sample_[1][i] = 0.0f;
+      aux_sample_[0][i] = aux_sample_[1][i] = 0.0f;
+    }
+  }
+
+  // Source of the dispersion noise of string i.
+  inline void set_random(size_t i, stmlib::RandomStream* random) {
+    random_[i] = random;
+  }
+
+  inline void set_frequency(size_t i, float frequency) {
+    frequency_[i] = frequency;
+  }
+
+  inline void set_frequency(size_t i, float frequency, float coefficient) {
+    frequency_[i] += coefficient * (frequency - frequency_[i]);
+  }
+
+  inline void set_dispersion(size_t i, float dispersion) {
+    dispersion_[i] = dispersion;
+  }
+
+  inline void set_brightness(size_t i, float brightness) {
+    brightness_[i] = brightness;
+  }
+
+  inline void set_damping(size_t i, float damping) {
+    damping_[i] = damping;
+  }
+
+  inline void set_position(size_t i, float position) {
+    position_[i] = position;
+  }
+
+  // Renders strings first to first + num_strings - 1. String i reads its
+  // excitation from in[i], and adds its two pickups to out[i] and aux[i].
+  void Process(
+      stmlib::SvfBankKernel kernel,
+      size_t first,
+      size_t num_strings,
+      const float* const* in,
+      float* const* out,
+      float* const* aux,
+      size_t size) {
+    if (enable_dispersion_) {
+      ProcessInternal<true>(kernel, first, num_strings, in, out, aux, size);
+    } else {
+      ProcessInternal<false>(kernel, first, num_strings, in, out, aux, size);
+    }
+  }
+
+ private:
+  template<bool enable_dispersion>
+  void ProcessInternal(
+      stmlib::SvfBankKernel kernel,
+      size_t first,
+      size_t num_strings,
+      const float* const* in,
+      float* const* out,
+      float* const* aux,
+      size_t size) {
+    const size_t last = first + num_strings;
+    for (size_t i = first; i < last; ++i) {
+      Configure(i, size);
+      if (src_ratio_[i] < 1.0f) {
+        kernel = stmlib::SVF_BANK_KERNEL_SCALAR;
+      }
+    }
+
+    for (size_t t = 0; t < size; ++t) {
+      for (size_t i = first; i < last; ++i) {
+        src_phase_[i] += src_ratio_[i];
+        tick_[i] = src_phase_[i] > 1.0f;
+        if (tick_[i]) {
+          src_phase_[i] -= 1.0f;
+        }
+      }
+
+      if (enable_dispersion) {
+        for (size_t i = first; i < last; ++i) {
+          if (tick_[i]) {
+            noise_[i] = 2.0f * random_[i]->GetFloat() - 1.0f;
+          }
+        }
+      }
+
+      size_t i = first;
+      if (kernel == stmlib::SVF_BANK_KERNEL_SIMD) {
+        for (; i + stmlib::kSimdWidth <= last; i += stmlib::kSimdWidth) {
+          Modulate<stmlib::f32xN, enable_dispersion>(i);
+        }
+      }
+      for (; i < last; ++i) {
+        if (tick_[i]) {
+          Modulate<float, enable_dispersion>(i);
+        }
+      }
+
+      // Delay line reads.
+      for (size_t i = first; i < last; ++i) {
+        if (!tick_[i]) {
+          continue;
+        }
+        float s = string_[i].ReadHermite(main_delay_[i]);
+        if (enable_dispersion && ap_delay_[i] >= 4.0f) {
+          s = stretch_[i].Allpass(s, ap_delay_[i], ap_gain_[i]);
+        }
+        s_[i] = s;
+        in_[i] = in[i][t];
+      }
+
+      i = first;
+      if (kernel == stmlib::SVF_BANK_KERNEL_SIMD) {
+        for (; i + stmlib::kSimdWidth <= last; i += stmlib::kSimdWidth) {
+          Filter<stmlib::f32xN, enable_dispersion>(i);
+        }
+      }
+      for (; i < last; ++i) {
+        if (tick_[i]) {
+          Filter<float, enable_dispersion>(i);
+        }
+      }
+
+      // Delay line writes and pickups.
+      for (size_t i = first; i < last; ++i) {
+        if (tick_[i]) {
+          string_[i].Write(s_[i]);
+          out_sample_[1][i] = out_sample_[0][i];
+          aux_sample_[1][i] = aux_sample_[0][i];
+          out_sample_[0][i] = s_[i];
+          aux_sample_[0][i] = string_[i].Read(comb_delay_[i]);
+        }
+        const float phase = src_phase_[i];
+        out[i][t] += stmlib::Crossfade(
+            out_sample_[1][i], out_sample_[0][i], phase);
+        aux[i][t] += stmlib::Crossfade(
+            aux_sample_[1][i], aux_sample_[0][i], phase);
+      }
+    }
+  }
+
+  // Computes the coefficients of string i for a block of size samples, and
+  // the increments of the parameters interpolated during the block. Same
+  // computations as in String::ProcessInternal.
+  inline void Configure(size_t i, size_t size) {
+    const float step = 1.0f / static_cast<float>(size);
+
+    float delay = 1.0f / frequency_[i];
+    CONSTRAIN(delay, 4.0f, kDelayLineSize - 4.0f);
+
+    float src_ratio = delay * frequency_[i];
+    if (src_ratio >= 0.9999f) {
+      src_phase_[i] = 1.0f;
+      src_ratio = 1.0f;
+    }
+    src_ratio_[i] = src_ratio;
+
+    float clamped_position = 0.5f - 0.98f * fabs(position_[i] - 0.5f);
+
+    float damping = damping_[i];
+    float lf_damping = damping * (2.0f - damping);
+    float rt60 = 0.07f * stmlib::SemitonesToRatio(lf_damping * 96.0f) * \
+        kSampleRate;
+    float rt60_base_2_12 = std::max(
+        -120.0f * delay / src_ratio / rt60,
+        -127.0f);
+    float damping_coefficient = stmlib::SemitonesToRatio(rt60_base_2_12);
+    float brightness = brightness_[i] * brightness_[i];
+    float noise_filter = stmlib::SemitonesToRatio(
+        (brightness_[i] - 1.0f) * 48.0f);
+    float damping_cutoff = std::min(
+        24.0f + damping * damping * 48.0f + \
+            brightness_[i] * brightness_[i] * 24.0f,
+        84.0f);
+    float damping_f = std::min(
+        frequency_[i] * stmlib::SemitonesToRatio(damping_cutoff),
+        0.499f);
+
+    // Crossfade to infinite decay.
+    if (damping >= 0.95f) {
+      float to_infinite = 20.0f * (damping - 0.95f);
+      damping_coefficient += to_infinite * (1.0f - damping_coefficient);
+      brightness += to_infinite * (1.0f - brightness);
+      damping_f += to_infinite * (0.4999f - damping_f);
+      damping_cutoff += to_infinite * (128.0f - damping_cutoff);
+    }
+
+    const float block_size = static_cast<float>(size);
+    delay_increment_[i] = (delay - delay_[i]) / block_size;
+    clamped_position_increment_[i] = \
+        (clamped_position - clamped_position_[i]) / block_size;
+    dispersion_increment_[i] = \
+        (dispersion_[i] - previous_dispersion_[i]) / block_size;
+    damping_compensation_increment_[i] = (1.0f - stmlib::Interpolate(
+        lut_svf_shift,
+        damping_cutoff,
+        1.0f) - previous_damping_compensation_[i]) / block_size;
+
+    noise_filter_[i] = noise_filter;
+    noise_gain_[i] = 1.0f / (0.2f + noise_filter);
+
+    fir_damping_increment_[i] = (damping_coefficient - fir_damping_[i]) * step;
+    fir_brightness_increment_[i] = (brightness - fir_brightness_[i]) * step;
+
+    set_iir_f_q<stmlib::FREQUENCY_ACCURATE>(i, damping_f, 0.5f);
+  }
+
+  // Same coefficient computations as Svf::set_f_q.
+  template<stmlib::FrequencyApproximation approximation>
+  inline void set_iir_f_q(size_t i, float f, float resonance) {
+    iir_g_[i] = stmlib::OnePole::tan<approximation>(f);
+    iir_r_[i] = 1.0f / resonance;
+    iir_h_[i] = 1.0f / (1.0f + iir_r_[i] * iir_g_[i] + iir_g_[i] * iir_g_[i]);
+  }
+
+  // Advances the interpolated parameters of strings i to i + width - 1 (or
+  // just i in the scalar case), and computes their delay line taps.
+  template<typename T, bool enable_dispersion>
+  inline void Modulate(size_t i) {
+    using namespace stmlib;
+
+    T delay = SimdLoad<T>(&delay_[i]) + SimdLoad<T>(&delay_increment_[i]);
+    T clamped_position = SimdLoad<T>(&clamped_position_[i]) + \
+        SimdLoad<T>(&clamped_position_increment_[i]);
+    T damping_compensation = SimdLoad<T>(&previous_damping_compensation_[i]) + \
+        SimdLoad<T>(&damping_compensation_increment_[i]);
+    SimdStore(&delay_[i], delay);
+    SimdStore(&clamped_position_[i], clamped_position);
+    SimdStore(&previous_damping_compensation_[i], damping_compensation);
+
+    SimdStore(&comb_delay_[i], delay * clamped_position);
+#ifndef MIC_W
+    delay *= damping_compensation;  // IIR delay.
+#endif  // MIC_W
+    delay -= 1.0f;  // FIR delay.
+
+    if (enable_dispersion) {
+      const T zero = SimdSplat<T>(0.0f);
+      const T noise_filter = SimdLoad<T>(&noise_filter_[i]);
+      T noise = SimdLoad<T>(&noise_[i]) * SimdLoad<T>(&noise_gain_[i]);
+      T dispersion_noise = SimdLoad<T>(&dispersion_noise_[i]);
+      dispersion_noise += noise_filter * (noise - dispersion_noise);
+      SimdStore(&dispersion_noise_[i], dispersion_noise);
+
+      T dispersion = SimdLoad<T>(&previous_dispersion_[i]) + \
+          SimdLoad<T>(&dispersion_increment_[i]);
+      SimdStore(&previous_dispersion_[i], dispersion);
+      T stretch_point = SimdSelect(
+          dispersion <= 0.0f,
+          zero,
+          dispersion * (2.0f - dispersion) * 0.475f);
+      T noise_amount = SimdSelect(
+          dispersion > 0.75f,
+          4.0f * (dispersion - 0.75f),
+          zero);
+      T bridge_curving = SimdSelect(dispersion < 0.0f, -dispersion, zero);
+
+      noise_amount = noise_amount * noise_amount * 0.025f;
+      SimdStore(&ac_blocking_amount_[i], bridge_curving);
+
+      bridge_curving = bridge_curving * bridge_curving * 0.01f;
+      SimdStore(
+          &ap_gain_[i],
+          -0.618f * dispersion / (0.15f + SimdAbs(dispersion)));
+
+      T delay_fm = SimdSplat<T>(1.0f);
+      delay_fm += dispersion_noise * noise_amount;
+      delay_fm -= SimdLoad<T>(&curved_bridge_[i]) * bridge_curving;
+      delay *= delay_fm;
+
+      // The stretching allpass is bypassed (and its delay set to 0) when
+      // one of the two delays would be too short.
+      T ap_delay = delay * stretch_point;
+      T main_delay = delay - ap_delay;
+      auto allpass = (ap_delay >= 4.0f) & (main_delay >= 4.0f);
+      SimdStore(&ap_delay_[i], SimdSelect(allpass, ap_delay, zero));
+      delay = SimdSelect(allpass, main_delay, delay);
+    }
+    SimdStore(&main_delay_[i], delay);
+  }
+
+  // Runs the bridge and damping filters of strings i to i + width - 1 on the
+  // samples read from their delay lines.
+  template<typename T, bool enable_dispersion>
+  inline void Filter(size_t i) {
+    using namespace stmlib;
+
+    T s = SimdLoad<T>(&s_[i]);
+    if (enable_dispersion) {
+      // DC blocker.
+      T x = SimdLoad<T>(&dc_x_[i]);
+      T y = SimdLoad<T>(&dc_y_[i]) * (1.0f - 20.0f / kSampleRate) + s - x;
+      SimdStore(&dc_x_[i], s);
+      SimdStore(&dc_y_[i], y);
+      s += SimdLoad<T>(&ac_blocking_amount_[i]) * (y - s);
+
+      T value = SimdAbs(s) - 0.025f;
+      T sign = SimdSelect(
+          s > 0.0f,
+          SimdSplat<T>(1.0f),
+          SimdSplat<T>(-1.5f));
+      SimdStore(&curved_bridge_[i], (SimdAbs(value) + value) * sign);
+    }
+
+    s += SimdLoad<T>(&in_[i]);
+
+    // FIR damping filter.
+    T brightness = SimdLoad<T>(&fir_brightness_[i]);
+    T damping = SimdLoad<T>(&fir_damping_[i]);
+    T x_ = SimdLoad<T>(&fir_x_[i]);
+    T h0 = (1.0f + brightness) * 0.5f;
+    T h1 = (1.0f - brightness) * 0.25f;
+    T y = damping * (h0 * x_ + h1 * (s + SimdLoad<T>(&fir_x__[i])));
+    SimdStore(&fir_x__[i], x_);
+    SimdStore(&fir_x_[i], s);
+    SimdStore(
+        &fir_brightness_[i],
+        brightness + SimdLoad<T>(&fir_brightness_increment_[i]));
+    SimdStore(
+        &fir_damping_[i],
+        damping + SimdLoad<T>(&fir_damping_increment_[i]));
+    s = y;
+
+#ifndef MIC_W
+    // IIR damping filter, same arithmetic as Svf::Process.
+    const T g = SimdLoad<T>(&iir_g_[i]);
+    const T r = SimdLoad<T>(&iir_r_[i]);
+    const T h = SimdLoad<T>(&iir_h_[i]);
+    T state_1 = SimdLoad<T>(&iir_state_1_[i]);
+    T state_2 = SimdLoad<T>(&iir_state_2_[i]);
+    T hp, bp, lp;
+    hp = (s - r * state_1 - g * state_1 - state_2) * h;
+    bp = g * hp + state_1;
+    state_1 = g * hp + bp;
+    lp = g * bp + state_2;
+    state_2 = g * bp + lp;
+    SimdStore(&iir_state_1_[i], state_1);
+    SimdStore(&iir_state_2_[i], state_2);
+    s = lp;
+#endif  // MIC_W
+
+    SimdStore(&s_[i], s);
+  }
+
+  bool enable_dispersion_;
+
+  float frequency_[max_num_strings];
+  float dispersion_[max_num_strings];
+  float brightness_[max_num_strings];
+  float damping_[max_num_strings];
+  float position_[max_num_strings];
+
+  // Parameters interpolated during a block, and their increments.
+  float delay_[max_num_strings];
+  float delay_increment_[max_num_strings];
+  float clamped_position_[max_num_strings];
+  float clamped_position_increment_[max_num_strings];
+  float previous_dispersion_[max_num_strings];
+  float dispersion_increment_[max_num_strings];
+  float previous_damping_compensation_[max_num_strings];
+  float damping_compensation_increment_[max_num_strings];
+
+  float noise_filter_[max_num_strings];
+  float noise_gain_[max_num_strings];
+  float dispersion_noise_[max_num_strings];
+  float curved_bridge_[max_num_strings];
+
+  float fir_x_[max_num_strings];
+  float fir_x__[max_num_strings];
+  float fir_brightness_[max_num_strings];
+  float fir_brightness_increment_[max_num_strings];
+  float fir_damping_[max_num_strings];
+  float fir_damping_increment_[max_num_strings];
+
+  float iir_g_[max_num_strings];
+  float iir_r_[max_num_strings];
+  float iir_h_[max_num_strings];
+  float iir_state_1_[max_num_strings];
+  float iir_state_2_[max_num_strings];
+
+  float dc_x_[max_num_strings];
+  float dc_y_[max_num_strings];
+
+  // Values passed between the lane-wise and string-wise steps of a sample.
+  float noise_[max_num_strings];
+  float main_delay_[max_num_strings];
+  float ap_delay_[max_num_strings];
+  float ap_gain_[max_num_strings];
+  float comb_delay_[max_num_strings];
+  float ac_blocking_amount_[max_num_strings];
+  float in_[max_num_strings];
+  float s_[max_num_strings];
+  bool tick_[max_num_strings];
+
+  float src_ratio_[max_num_strings];
+  float src_phase_[max_num_strings];
+  float out_sample_[2][max_num_strings];
+  float aux_sample_[2][max_num_strings];
+
+  stmlib::RandomStream* random_[max_num_strings];
+  StringDelayLine string_[max_num_strings];
+  StiffnessDelayLine stretch_[max_num_strings];
+
+  DISALLOW_COPY_AND_ASSIGN(StringBank);
+};
+
+}  // namespace rings
+
+#endif  // RINGS_DSP_STRING_BANK_H_
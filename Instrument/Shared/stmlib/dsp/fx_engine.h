@@ -24,10 +24,25 @@
 //
 // -----------------------------------------------------------------------------
 //
-// Base class for building reverbs.
+// Base class for building reverbs and other delay-based effects.
+//
+// An effect is a chain of operations on an accumulator, run by a Context once
+// per sample. A Context<f32xN> runs the chain for kSimdWidth consecutive
+// samples at once, one per lane. The samples of a block only interact through
+// the delay lines, so the lanes are independent as long as a delay line read
+// before being written in the chain is read at least kSimdWidth samples back
+// (the shortest taps of the reverbs are 10 samples long). The one-pole filters
+// of the feedback loops run lane after lane.
+//
+// The writes of the last lanes land up to kSimdWidth - 1 positions below the
+// base of a delay line, where the scalar chain would only write them a few
+// samples later. The delay lines are thus kSimdWidth positions apart in
+// memory, instead of one: the layout costs a few more words than the delay
+// times add up to, and a chain that filled its memory exactly needs twice as
+// much.
 
-#ifndef CLOUDS_DSP_FX_FX_ENGINE_H_
-#define CLOUDS_DSP_FX_FX_ENGINE_H_
+#ifndef STMLIB_DSP_FX_ENGINE_H_
+#define STMLIB_DSP_FX_ENGINE_H_
 
 #include <algorithm>
 
@@ -35,8 +50,9 @@
 
 #include "stmlib/dsp/dsp.h"
 #include "stmlib/dsp/cosine_oscillator.h"
+#include "stmlib/dsp/simd.h"
 
-namespace clouds {
+namespace stmlib {
 
 #define TAIL , -1
 
@@ -87,7 +103,7 @@ struct DataType<FORMAT_32_BIT> {
   typedef float T;
   
   static inline float Decompress(T value) {
-    return value;;
+    return value;
   }
   
   static inline T Compress(float value) {
@@ -128,7 +144,8 @@ class FxEngine {
   struct DelayLine {
     enum {
       length = DelayLine<typename Memory::Tail, index - 1>::length,
-      base = DelayLine<Memory, index - 1>::base + DelayLine<Memory, index - 1>::length + 1
+      base = DelayLine<Memory, index - 1>::base + \
+          DelayLine<Memory, index - 1>::length + kSimdWidth
     };
   };
 
@@ -140,41 +157,50 @@ class FxEngine {
     };
   };
 
+  // F is float, or f32xN to process kSimdWidth samples at once. Lane k is
+  // k samples after lane 0, and its write pointer is k positions lower.
+  template<typename F>
   class Context {
    friend class FxEngine;
    public:
     Context() { }
     ~Context() { }
     
-    inline void Load(float value) {
+    enum {
+      width = SimdTraits<F>::width
+    };
+    
+    inline void Load(F value) {
       accumulator_ = value;
     }
 
-    inline void Read(float value, float scale) {
+    inline void Read(F value, float scale) {
       accumulator_ += value * scale;
     }
 
-    inline void Read(float value) {
+    inline void Read(F value) {
       accumulator_ += value;
     }
 
-    inline void Write(float& value) {
+    inline void Write(F& value) {
       value = accumulator_;
     }
 
-    inline void Write(float& value, float scale) {
+    inline void Write(F& value, float scale) {
       value = accumulator_;
       accumulator_ *= scale;
     }
     
     template<typename D>
     inline void Write(D& d, int32_t offset, float scale) {
-      STATIC_ASSERT(D::base + D::length <= size, delay_memory_full);
-      T w = DataType<format>::Compress(accumulator_);
-      if (offset == -1) {
-        buffer_[(write_ptr_ + D::base + D::length - 1) & MASK] = w;
-      } else {
-        buffer_[(write_ptr_ + D::base + offset) & MASK] = w;
+      STATIC_ASSERT(
+          D::base + D::length + kSimdWidth - 1 <= size,
+          delay_memory_full);
+      int32_t index = write_ptr_ + D::base + \
+          (offset == -1 ? D::length - 1 : offset);
+      for (size_t k = 0; k < width; ++k) {
+        buffer_[(index - static_cast<int32_t>(k)) & MASK] = \
+            DataType<format>::Compress(SimdLane(accumulator_, k));
       }
       accumulator_ *= scale;
     }
@@ -197,16 +223,18 @@ class FxEngine {
     
     template<typename D>
     inline void Read(D& d, int32_t offset, float scale) {
-      STATIC_ASSERT(D::base + D::length <= size, delay_memory_full);
-      T r;
-      if (offset == -1) {
-        r = buffer_[(write_ptr_ + D::base + D::length - 1) & MASK];
-      } else {
-        r = buffer_[(write_ptr_ + D::base + offset) & MASK];
+      STATIC_ASSERT(
+          D::base + D::length + kSimdWidth - 1 <= size,
+          delay_memory_full);
+      int32_t index = write_ptr_ + D::base + \
+          (offset == -1 ? D::length - 1 : offset);
+      F r;
+      for (size_t k = 0; k < width; ++k) {
+        SimdSetLane(&r, k, DataType<format>::Decompress(
+            buffer_[(index - static_cast<int32_t>(k)) & MASK]));
       }
-      float r_f = DataType<format>::Decompress(r);
-      previous_read_ = r_f;
-      accumulator_ += r_f * scale;
+      previous_read_ = r;
+      accumulator_ += r * scale;
     }
     
     template<typename D>
@@ -215,24 +243,30 @@ class FxEngine {
     }
     
     inline void Lp(float& state, float coefficient) {
-      state += coefficient * (accumulator_ - state);
-      accumulator_ = state;
+      for (size_t k = 0; k < width; ++k) {
+        state += coefficient * (SimdLane(accumulator_, k) - state);
+        SimdSetLane(&accumulator_, k, state);
+      }
     }
 
     inline void Hp(float& state, float coefficient) {
-      state += coefficient * (accumulator_ - state);
-      accumulator_ -= state;
+      for (size_t k = 0; k < width; ++k) {
+        float x = SimdLane(accumulator_, k);
+        state += coefficient * (x - state);
+        SimdSetLane(&accumulator_, k, x - state);
+      }
     }
     
-    template<typename D>
-    inline void Interpolate(D& d, float offset, float scale) {
-      STATIC_ASSERT(D::base + D::length <= size, delay_memory_full);
-      MAKE_INTEGRAL_FRACTIONAL(offset);
-      float a = DataType<format>::Decompress(
-          buffer_[(write_ptr_ + offset_integral + D::base) & MASK]);
-      float b = DataType<format>::Decompress(
-          buffer_[(write_ptr_ + offset_integral + D::base + 1) & MASK]);
-      float x = a + (b - a) * offset_fractional;
+    // The offset and the scale are either floats, or one value per lane.
+    template<typename D, typename O, typename S>
+    inline void Interpolate(D& d, O offset, S scale) {
+      STATIC_ASSERT(
+          D::base + D::length + kSimdWidth - 1 <= size,
+          delay_memory_full);
+      F x;
+      for (size_t k = 0; k < width; ++k) {
+        SimdSetLane(&x, k, Tap<D>(k, SimdLane(offset, k)));
+      }
       previous_read_ = x;
       accumulator_ += x * scale;
     }
@@ -240,22 +274,33 @@ class FxEngine {
     template<typename D>
     inline void Interpolate(
         D& d, float offset, LFOIndex index, float amplitude, float scale) {
-      STATIC_ASSERT(D::base + D::length <= size, delay_memory_full);
-      offset += amplitude * lfo_value_[index];
-      MAKE_INTEGRAL_FRACTIONAL(offset);
-      float a = DataType<format>::Decompress(
-          buffer_[(write_ptr_ + offset_integral + D::base) & MASK]);
-      float b = DataType<format>::Decompress(
-          buffer_[(write_ptr_ + offset_integral + D::base + 1) & MASK]);
-      float x = a + (b - a) * offset_fractional;
+      STATIC_ASSERT(
+          D::base + D::length + kSimdWidth - 1 <= size,
+          delay_memory_full);
+      F x;
+      for (size_t k = 0; k < width; ++k) {
+        float lane_offset = offset;
+        lane_offset += amplitude * SimdLane(lfo_value_[index], k);
+        SimdSetLane(&x, k, Tap<D>(k, lane_offset));
+      }
       previous_read_ = x;
       accumulator_ += x * scale;
     }
     
    private:
-    float accumulator_;
-    float previous_read_;
-    float lfo_value_[2];
+    template<typename D>
+    inline float Tap(size_t lane, float offset) const {
+      MAKE_INTEGRAL_FRACTIONAL(offset);
+      int32_t index = write_ptr_ - static_cast<int32_t>(lane) + \
+          offset_integral + D::base;
+      float a = DataType<format>::Decompress(buffer_[index & MASK]);
+      float b = DataType<format>::Decompress(buffer_[(index + 1) & MASK]);
+      return a + (b - a) * offset_fractional;
+    }
+    
+    F accumulator_;
+    F previous_read_;
+    F lfo_value_[2];
     T* buffer_;
     int32_t write_ptr_;
 
@@ -267,22 +312,27 @@ class FxEngine {
         frequency * 32.0f);
   }
   
-  inline void Start(Context* c) {
-    --write_ptr_;
-    if (write_ptr_ < 0) {
-      write_ptr_ += size;
+  template<typename F>
+  inline void Start(Context<F>* c) {
+    for (size_t k = 0; k < Context<F>::width; ++k) {
+      --write_ptr_;
+      if (write_ptr_ < 0) {
+        write_ptr_ += size;
+      }
+      if (k == 0) {
+        c->write_ptr_ = write_ptr_;
+      }
+      if ((write_ptr_ & 31) == 0) {
+        SimdSetLane(&c->lfo_value_[0], k, lfo_[0].Next());
+        SimdSetLane(&c->lfo_value_[1], k, lfo_[1].Next());
+      } else {
+        SimdSetLane(&c->lfo_value_[0], k, lfo_[0].value());
+        SimdSetLane(&c->lfo_value_[1], k, lfo_[1].value());
+      }
     }
-    c->accumulator_ = 0.0f;
-    c->previous_read_ = 0.0f;
+    c->accumulator_ = SimdSplat<F>(0.0f);
+    c->previous_read_ = SimdSplat<F>(0.0f);
     c->buffer_ = buffer_;
-    c->write_ptr_ = write_ptr_;
-    if ((write_ptr_ & 31) == 0) {
-      c->lfo_value_[0] = lfo_[0].Next();
-      c->lfo_value_[1] = lfo_[1].Next();
-    } else {
-      c->lfo_value_[0] = lfo_[0].value();
-      c->lfo_value_[1] = lfo_[1].value();
-    }
   }
   
  private:
@@ -297,6 +347,6 @@ class FxEngine {
   DISALLOW_COPY_AND_ASSIGN(FxEngine);
 };
 
-}  // namespace clouds
+}  // namespace stmlib
 
-#endif  // CLOUDS_DSP_FX_FX_ENGINE_H_
+#endif  // STMLIB_DSP_FX_ENGINE_H_
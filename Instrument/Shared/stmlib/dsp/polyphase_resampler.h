@@ -0,0 +1,303 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Streaming stereo resampler between arbitrary rates, with a polyphase
+// Kaiser-windowed sinc filter.
+//
+// When the ratio between the two rates reduces to a fraction whose numerator
+// is small enough (44.1k, 48k, 88.2k and 96k to and from 32k or 48k), there is
+// one row of coefficients per output phase, and the phase is tracked exactly
+// with integers. Other ratios interpolate between the rows of a table of
+// kInterpolatedPhases phases. Equal rates are passed through.
+
+#ifndef STMLIB_DSP_POLYPHASE_RESAMPLER_H_
+#define STMLIB_DSP_POLYPHASE_RESAMPLER_H_
+
+#include "stmlib/stmlib.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "stmlib/dsp/simd.h"
+
+namespace stmlib {
+
+enum ResamplerQuality {
+  RESAMPLER_QUALITY_DRAFT,
+  RESAMPLER_QUALITY_REALTIME,
+  RESAMPLER_QUALITY_OFFLINE
+};
+
+struct ResamplerResult {
+  size_t input_consumed;
+  size_t output_length;
+};
+
+class PolyphaseResampler {
+ public:
+  PolyphaseResampler() {
+    coefficients_ = NULL;
+    history_ = NULL;
+    num_taps_ = 0;
+  }
+
+  ~PolyphaseResampler() {
+    Free();
+  }
+
+  // Allocates the coefficient table, so it must not be called from the
+  // audio thread.
+  void Init(int input_rate, int output_rate, ResamplerQuality quality) {
+    Free();
+
+    input_rate_ = input_rate;
+    output_rate_ = output_rate;
+    quality_ = quality;
+    if (input_rate == output_rate) {
+      num_taps_ = 0;
+      return;
+    }
+
+    uint32_t divisor = Gcd(input_rate, output_rate);
+    uint32_t up = output_rate / divisor;
+    uint32_t down = input_rate / divisor;
+    interpolated_ = up > kMaxExactPhases;
+    if (interpolated_) {
+      num_phases_ = kInterpolatedPhases;
+      step_ = static_cast<uint64_t>(
+          static_cast<double>(input_rate) / output_rate * 4294967296.0 + 0.5);
+    } else {
+      num_phases_ = up;
+      step_ = down;
+    }
+
+    // Below the input rate, the filter cuts at the output Nyquist frequency
+    // and gets proportionally longer to keep the same transition band.
+    const Settings& settings = quality_settings(quality);
+    double cutoff = std::min(1.0, static_cast<double>(output_rate) / input_rate);
+    size_t taps = static_cast<size_t>(ceil(settings.taps / cutoff));
+    num_taps_ = (taps + kSimdWidth - 1) / kSimdWidth * kSimdWidth;
+    cutoff *= settings.rolloff;
+
+    // One more row than phases: interpolated lookups read the next row.
+    size_t num_rows = num_phases_ + 1;
+    coefficients_ = new float[num_rows * num_taps_];
+    for (size_t row = 0; row < num_rows; ++row) {
+      float* c = &coefficients_[row * num_taps_];
+      double fraction = static_cast<double>(row) / num_phases_;
+      double sum = 0.0;
+      for (size_t i = 0; i < num_taps_; ++i) {
+        // Distance between the output sample and the input sample in tap i.
+        // The oldest sample of the history is in tap 0.
+        double t = static_cast<double>(num_taps_ / 2) - 1.0 - i + fraction;
+        double h = cutoff * Sinc(cutoff * t) * Kaiser(
+            t / (num_taps_ / 2), settings.beta);
+        c[i] = static_cast<float>(h);
+        sum += h;
+      }
+      // Unity gain at DC for every phase.
+      for (size_t i = 0; i < num_taps_; ++i) {
+        c[i] = static_cast<float>(c[i] / sum);
+      }
+    }
+
+    // The history of each channel is written twice, num_taps_ apart, so that
+    // the last num_taps_ samples are always contiguous.
+    history_ = new float[4 * num_taps_];
+    Reset();
+  }
+
+  void Reset() {
+    phase_ = 0;
+    pending_ = 0;
+    write_ptr_ = 0;
+    if (history_) {
+      std::fill(&history_[0], &history_[4 * num_taps_], 0.0f);
+    }
+  }
+
+  // Converts as many samples as possible: stops when the input has been
+  // consumed, or when the output is full. The input samples needed by the
+  // next output sample are only consumed when there is room for it.
+  inline void Process(
+      const float* in_l,
+      const float* in_r,
+      size_t in_size,
+      float* out_l,
+      float* out_r,
+      size_t out_size,
+      ResamplerResult* result) {
+    if (!num_taps_) {
+      size_t size = std::min(in_size, out_size);
+      std::copy(&in_l[0], &in_l[size], &out_l[0]);
+      std::copy(&in_r[0], &in_r[size], &out_r[0]);
+      result->input_consumed = size;
+      result->output_length = size;
+      return;
+    }
+
+    size_t consumed = 0;
+    size_t produced = 0;
+    float* history_l = &history_[0];
+    float* history_r = &history_[2 * num_taps_];
+    while (produced < out_size) {
+      while (pending_ && consumed < in_size) {
+        history_l[write_ptr_] = history_l[write_ptr_ + num_taps_] =
+            in_l[consumed];
+        history_r[write_ptr_] = history_r[write_ptr_ + num_taps_] =
+            in_r[consumed];
+        ++consumed;
+        --pending_;
+        if (++write_ptr_ == num_taps_) {
+          write_ptr_ = 0;
+        }
+      }
+      if (pending_) {
+        break;
+      }
+
+      const float* l = &history_l[write_ptr_];
+      const float* r = &history_r[write_ptr_];
+      if (interpolated_) {
+        uint32_t phase = static_cast<uint32_t>(phase_);
+        uint32_t row = phase >> (32 - kInterpolatedPhasesShift);
+        float fraction = static_cast<float>(
+            phase & ((1 << (32 - kInterpolatedPhasesShift)) - 1)) * \
+                (1.0f / (1 << (32 - kInterpolatedPhasesShift)));
+        const float* c = &coefficients_[row * num_taps_];
+        const float* c_next = c + num_taps_;
+        float l_a = SimdDot(c, l, num_taps_);
+        float r_a = SimdDot(c, r, num_taps_);
+        float l_b = SimdDot(c_next, l, num_taps_);
+        float r_b = SimdDot(c_next, r, num_taps_);
+        out_l[produced] = l_a + (l_b - l_a) * fraction;
+        out_r[produced] = r_a + (r_b - r_a) * fraction;
+        phase_ = static_cast<uint64_t>(phase) + step_;
+        pending_ = static_cast<size_t>(phase_ >> 32);
+        phase_ &= 0xffffffff;
+      } else {
+        const float* c = &coefficients_[phase_ * num_taps_];
+        out_l[produced] = SimdDot(c, l, num_taps_);
+        out_r[produced] = SimdDot(c, r, num_taps_);
+        phase_ += step_;
+        pending_ = static_cast<size_t>(phase_ / num_phases_);
+        phase_ -= pending_ * num_phases_;
+      }
+      ++produced;
+    }
+    result->input_consumed = consumed;
+    result->output_length = produced;
+  }
+
+  inline int input_rate() const { return input_rate_; }
+  inline int output_rate() const { return output_rate_; }
+  inline ResamplerQuality quality() const { return quality_; }
+
+  // In input samples.
+  inline size_t latency() const { return num_taps_ / 2; }
+
+ private:
+  struct Settings {
+    size_t taps;
+    float rolloff;
+    double beta;
+  };
+
+  static const uint32_t kMaxExactPhases = 512;
+  static const size_t kInterpolatedPhasesShift = 8;
+  static const uint32_t kInterpolatedPhases = 1 << kInterpolatedPhasesShift;
+
+  // Taps at the input rate, passband edge relative to the Nyquist frequency
+  // of the slowest rate, and Kaiser window beta. Draft mode is for previews
+  // and slow devices, offline mode for bounces.
+  static const Settings& quality_settings(ResamplerQuality quality) {
+    static const Settings settings[] = {
+      { 8, 0.80f, 5.0 },
+      { 32, 0.90f, 8.0 },
+      { 96, 0.95f, 10.0 },
+    };
+    return settings[quality];
+  }
+
+  void Free() {
+    delete[] coefficients_;
+    delete[] history_;
+    coefficients_ = NULL;
+    history_ = NULL;
+  }
+
+  static uint32_t Gcd(uint32_t a, uint32_t b) {
+    while (b) {
+      uint32_t t = a % b;
+      a = b;
+      b = t;
+    }
+    return a;
+  }
+
+  static double Sinc(double x) {
+    if (fabs(x) < 1.0e-9) {
+      return 1.0;
+    }
+    return sin(M_PI * x) / (M_PI * x);
+  }
+
+  // Zeroth-order modified Bessel function of the first kind.
+  static double BesselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 32; ++k) {
+      term *= (x / (2.0 * k)) * (x / (2.0 * k));
+      sum += term;
+    }
+    return sum;
+  }
+
+  static double Kaiser(double x, double beta) {
+    if (fabs(x) >= 1.0) {
+      return 0.0;
+    }
+    return BesselI0(beta * sqrt(1.0 - x * x)) / BesselI0(beta);
+  }
+
+  int input_rate_;
+  int output_rate_;
+  ResamplerQuality quality_;
+
+  bool interpolated_;
+  uint64_t num_phases_;
+  uint64_t step_;
+  uint64_t phase_;
+  size_t pending_;
+
+  size_t num_taps_;
+  float* coefficients_;
+
+  float* history_;
+  size_t write_ptr_;
+
+  DISALLOW_COPY_AND_ASSIGN(PolyphaseResampler);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_DSP_POLYPHASE_RESAMPLER_H_
@@ -0,0 +1,201 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Packed float vectors. The GCC/clang vector extensions are lowered to NEON
+// registers on ARM, SSE registers on x86, and AVX registers for the 8-wide
+// type when the target supports it. Element-wise arithmetic on these types
+// follows the same rounding (and the same FP contraction rules) as the scalar
+// code it replaces, so lane-parallel kernels stay bit-exact with their scalar
+// reference.
+
+#ifndef STMLIB_DSP_SIMD_H_
+#define STMLIB_DSP_SIMD_H_
+
+#include "stmlib/stmlib.h"
+
+#include <cstring>
+
+namespace stmlib {
+
+typedef float f32x4 __attribute__((vector_size(16)));
+typedef float f32x8 __attribute__((vector_size(32)));
+
+typedef int32_t i32x4 __attribute__((vector_size(16)));
+typedef int32_t i32x8 __attribute__((vector_size(32)));
+typedef uint32_t u32x4 __attribute__((vector_size(16)));
+typedef uint32_t u32x8 __attribute__((vector_size(32)));
+
+// Widest vector natively supported by the target, and the integer vectors
+// with the same number of lanes.
+#if defined(__AVX__)
+typedef f32x8 f32xN;
+typedef i32x8 i32xN;
+typedef u32x8 u32xN;
+#else
+typedef f32x4 f32xN;
+typedef i32x4 i32xN;
+typedef u32x4 u32xN;
+#endif
+
+template<typename T>
+struct SimdTraits {
+  static const size_t width = sizeof(T) / sizeof(float);
+};
+
+template<>
+struct SimdTraits<float> {
+  static const size_t width = 1;
+};
+
+const size_t kSimdWidth = SimdTraits<f32xN>::width;
+
+// Loads and stores do not assume any alignment: the DSP objects are often
+// embedded in kernels allocated with a plain operator new.
+template<typename T>
+inline T SimdLoad(const float* source) {
+  T v;
+  memcpy(&v, source, sizeof(T));
+  return v;
+}
+
+template<typename T>
+inline void SimdStore(float* destination, T v) {
+  memcpy(destination, &v, sizeof(T));
+}
+
+template<typename T>
+inline T SimdLoad(const uint32_t* source) {
+  T v;
+  memcpy(&v, source, sizeof(T));
+  return v;
+}
+
+template<typename T>
+inline T SimdSplat(float x) {
+  T v;
+  for (size_t i = 0; i < SimdTraits<T>::width; ++i) {
+    v[i] = x;
+  }
+  return v;
+}
+
+template<>
+inline float SimdSplat<float>(float x) {
+  return x;
+}
+
+// Lane access, for the code which handles the lanes one at a time. A float
+// has a single lane.
+inline float SimdLane(float x, size_t i) {
+  return x;
+}
+
+template<typename T>
+inline float SimdLane(const T& x, size_t i) {
+  return x[i];
+}
+
+inline void SimdSetLane(float* x, size_t i, float value) {
+  *x = value;
+}
+
+template<typename T>
+inline void SimdSetLane(T* x, size_t i, float value) {
+  (*x)[i] = value;
+}
+
+template<typename T>
+inline float SimdSum(T v) {
+  float sum = 0.0f;
+  for (size_t i = 0; i < SimdTraits<T>::width; ++i) {
+    sum += v[i];
+  }
+  return sum;
+}
+
+// Lane-wise ternary operator, min, max and fabs. A comparison between two
+// vectors yields a vector of masks, and between two floats a bool.
+inline float SimdSelect(bool condition, float a, float b) {
+  return condition ? a : b;
+}
+
+template<typename T>
+inline T SimdSelect(decltype(T() < T()) condition, T a, T b) {
+  typedef decltype(condition) M;
+  return reinterpret_cast<T>(
+      (reinterpret_cast<M>(a) & condition) |
+      (reinterpret_cast<M>(b) & ~condition));
+}
+
+template<typename T>
+inline T SimdMin(T a, T b) {
+  return SimdSelect(b < a, b, a);
+}
+
+template<typename T>
+inline T SimdMax(T a, T b) {
+  return SimdSelect(a < b, b, a);
+}
+
+template<typename T>
+inline T SimdAbs(T x) {
+  return SimdSelect(x < SimdSplat<T>(0.0f), -x, x);
+}
+
+// Number of bits set in each lane of a vector of 32-bit integers, counted in
+// parallel in all the lanes.
+template<typename T>
+inline T SimdPopCount(T x) {
+  x = x - ((x >> 1) & 0x55555555);
+  x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+  return (((x + (x >> 4)) & 0x0f0f0f0f) * 0x01010101) >> 24;
+}
+
+template<typename T>
+inline uint32_t SimdSumInt(T v) {
+  uint32_t sum = 0;
+  for (size_t i = 0; i < sizeof(T) / sizeof(uint32_t); ++i) {
+    sum += v[i];
+  }
+  return sum;
+}
+
+// Dot product of two arrays, accumulated in the lanes of the widest vector.
+// The summation order differs from a sequential loop, so the result can
+// differ from it in the last bits.
+inline float SimdDot(const float* a, const float* b, size_t size) {
+  const size_t width = SimdTraits<f32xN>::width;
+  f32xN sum_v = SimdSplat<f32xN>(0.0f);
+  size_t i = 0;
+  for (; i + width <= size; i += width) {
+    sum_v += SimdLoad<f32xN>(&a[i]) * SimdLoad<f32xN>(&b[i]);
+  }
+  float sum = SimdSum(sum_v);
+  for (; i < size; ++i) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+}  // namespace stmlib
+
+#endif  // STMLIB_DSP_SIMD_H_
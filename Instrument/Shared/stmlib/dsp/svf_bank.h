@@ -0,0 +1,213 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Bank of SVFs fed by the same input, stored as a structure of arrays so that
+// several filters can be advanced in the lanes of a SIMD vector.
+
+#ifndef STMLIB_DSP_SVF_BANK_H_
+#define STMLIB_DSP_SVF_BANK_H_
+
+#include "stmlib/stmlib.h"
+
+#include <algorithm>
+
+#include "stmlib/dsp/filter.h"
+#include "stmlib/dsp/simd.h"
+
+namespace stmlib {
+
+enum SvfBankKernel {
+  SVF_BANK_KERNEL_SCALAR,
+  SVF_BANK_KERNEL_SIMD
+};
+
+template<size_t size>
+class SvfBank {
+ public:
+  SvfBank() { }
+  ~SvfBank() { }
+
+  void Init() {
+    for (size_t i = 0; i < size; ++i) {
+      set_f_q<FREQUENCY_DIRTY>(i, 0.01f, 100.0f);
+    }
+    Reset();
+  }
+
+  void Reset() {
+    std::fill(&state_1_[0], &state_1_[size], 0.0f);
+    std::fill(&state_2_[0], &state_2_[size], 0.0f);
+  }
+
+  // Same coefficient computations as Svf::set_f_q.
+  template<FrequencyApproximation approximation>
+  inline void set_f_q(size_t i, float f, float resonance) {
+    g_[i] = OnePole::tan<approximation>(f);
+    r_[i] = 1.0f / resonance;
+    h_[i] = 1.0f / (1.0f + r_[i] * g_[i] + g_[i] * g_[i]);
+  }
+
+  // Computes the coefficients of the first num_filters filters from arrays
+  // of frequencies and resonances.
+  template<FrequencyApproximation approximation>
+  inline void set_f_q(
+      SvfBankKernel kernel,
+      const float* f,
+      const float* resonance,
+      size_t num_filters) {
+    size_t i = 0;
+    if (kernel == SVF_BANK_KERNEL_SIMD) {
+      const size_t width = SimdTraits<f32xN>::width;
+      const f32xN one = SimdSplat<f32xN>(1.0f);
+      for (; i + width <= num_filters; i += width) {
+        f32xN g = Tan<approximation, f32xN>(SimdLoad<f32xN>(&f[i]));
+        f32xN r = one / SimdLoad<f32xN>(&resonance[i]);
+        SimdStore(&g_[i], g);
+        SimdStore(&r_[i], r);
+        SimdStore(&h_[i], one / (one + r * g + g * g));
+      }
+    }
+    for (; i < num_filters; ++i) {
+      set_f_q<approximation>(i, f[i], resonance[i]);
+    }
+  }
+
+  inline void set_g_q(size_t i, float g, float resonance) {
+    g_[i] = g;
+    r_[i] = 1.0f / resonance;
+    h_[i] = 1.0f / (1.0f + r_[i] * g_[i] + g_[i] * g_[i]);
+  }
+
+  inline void set_g_r_h(size_t i, float g, float r, float h) {
+    g_[i] = g;
+    r_[i] = r;
+    h_[i] = h;
+  }
+
+  inline float g(size_t i) const { return g_[i]; }
+  inline float r(size_t i) const { return r_[i]; }
+  inline float h(size_t i) const { return h_[i]; }
+
+  // Feeds the same sample to the first num_filters filters, and writes their
+  // individual outputs to out.
+  template<FilterMode mode>
+  inline void Process(
+      SvfBankKernel kernel,
+      float in,
+      float* out,
+      size_t num_filters) {
+    size_t i = 0;
+    if (kernel == SVF_BANK_KERNEL_SIMD) {
+      const size_t width = SimdTraits<f32xN>::width;
+      const f32xN in_v = SimdSplat<f32xN>(in);
+      for (; i + width <= num_filters; i += width) {
+        SimdStore(&out[i], Tick<mode, f32xN>(i, in_v));
+      }
+    }
+    // Filters past the last complete vector are processed one by one, so
+    // that the state of the filters beyond num_filters is never touched.
+    for (; i < num_filters; ++i) {
+      out[i] = Tick<mode, float>(i, in);
+    }
+  }
+
+  // Same as above, with a distinct input sample for each filter.
+  template<FilterMode mode>
+  inline void Process(
+      SvfBankKernel kernel,
+      const float* in,
+      float* out,
+      size_t num_filters) {
+    size_t i = 0;
+    if (kernel == SVF_BANK_KERNEL_SIMD) {
+      const size_t width = SimdTraits<f32xN>::width;
+      for (; i + width <= num_filters; i += width) {
+        SimdStore(&out[i], Tick<mode, f32xN>(i, SimdLoad<f32xN>(&in[i])));
+      }
+    }
+    for (; i < num_filters; ++i) {
+      out[i] = Tick<mode, float>(i, in[i]);
+    }
+  }
+
+ private:
+  // Advances the filters i to i + width - 1 (or just i in the scalar case).
+  // Same arithmetic as Svf::Process.
+  template<FilterMode mode, typename T>
+  inline T Tick(size_t i, T in) {
+    const T g = SimdLoad<T>(&g_[i]);
+    const T r = SimdLoad<T>(&r_[i]);
+    const T h = SimdLoad<T>(&h_[i]);
+    T state_1 = SimdLoad<T>(&state_1_[i]);
+    T state_2 = SimdLoad<T>(&state_2_[i]);
+    T hp, bp, lp;
+    hp = (in - r * state_1 - g * state_1 - state_2) * h;
+    bp = g * hp + state_1;
+    state_1 = g * hp + bp;
+    lp = g * bp + state_2;
+    state_2 = g * bp + lp;
+    SimdStore(&state_1_[i], state_1);
+    SimdStore(&state_2_[i], state_2);
+    
+    if (mode == FILTER_MODE_LOW_PASS) {
+      return lp;
+    } else if (mode == FILTER_MODE_BAND_PASS) {
+      return bp;
+    } else if (mode == FILTER_MODE_BAND_PASS_NORMALIZED) {
+      return bp * r;
+    } else {
+      return hp;
+    }
+  }
+
+  // Lane-wise version of OnePole::tan.
+  template<FrequencyApproximation approximation, typename T>
+  static inline T Tan(T f) {
+    if (approximation == FREQUENCY_DIRTY) {
+      const float a = 3.736e-01 * M_PI_POW_3;
+      return f * (SimdSplat<T>(M_PI_F) + SimdSplat<T>(a) * f * f);
+    } else if (approximation == FREQUENCY_FAST) {
+      const float a = 3.260e-01 * M_PI_POW_3;
+      const float b = 1.823e-01 * M_PI_POW_5;
+      T f2 = f * f;
+      return f * (SimdSplat<T>(M_PI_F) + f2 * (
+          SimdSplat<T>(a) + SimdSplat<T>(b) * f2));
+    } else {
+      for (size_t i = 0; i < SimdTraits<T>::width; ++i) {
+        f[i] = OnePole::tan<approximation>(f[i]);
+      }
+      return f;
+    }
+  }
+
+  float g_[size];
+  float r_[size];
+  float h_[size];
+  float state_1_[size];
+  float state_2_[size];
+
+  DISALLOW_COPY_AND_ASSIGN(SvfBank);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_DSP_SVF_BANK_H_
@@ -0,0 +1,95 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// CPU governor.
+//
+// Measures the time taken to render each block, relative to the duration of
+// the block, and derives from it a quality factor for the next blocks. The
+// quality drops quickly when the load exceeds the target, and recovers slowly
+// once it is comfortably below it, so that an overloaded patch loses detail
+// instead of dropping out.
+
+#ifndef STMLIB_UTILS_CPU_GOVERNOR_H_
+#define STMLIB_UTILS_CPU_GOVERNOR_H_
+
+#include "stmlib/stmlib.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace stmlib {
+
+class CpuGovernor {
+ public:
+  CpuGovernor() { }
+  ~CpuGovernor() { }
+
+  // block_duration is in seconds. The load is the fraction of it spent
+  // rendering.
+  void Init(double block_duration, float target_load, float min_quality) {
+    block_duration_ = block_duration;
+    target_load_ = target_load;
+    min_quality_ = min_quality;
+    load_ = 0.0f;
+    quality_ = 1.0f;
+  }
+
+  inline void Start() {
+    start_ = Clock::now();
+  }
+
+  inline void Stop() {
+    std::chrono::duration<double> elapsed = Clock::now() - start_;
+    float load = static_cast<float>(elapsed.count() / block_duration_);
+
+    // Peak follower: isolated slow blocks (preemption, page faults) are
+    // smoothed out, a sustained overload is not.
+    float error = load - load_;
+    load_ += error * (error > 0.0f ? 0.1f : 0.01f);
+
+    if (load_ > target_load_) {
+      quality_ = std::max(quality_ * 0.98f, min_quality_);
+    } else if (load_ < 0.75f * target_load_) {
+      quality_ = std::min(quality_ + 0.0005f, 1.0f);
+    }
+  }
+
+  inline float load() const { return load_; }
+  inline float quality() const { return quality_; }
+
+ private:
+  typedef std::chrono::steady_clock Clock;
+
+  double block_duration_;
+  float target_load_;
+  float min_quality_;
+
+  float load_;
+  float quality_;
+  Clock::time_point start_;
+
+  DISALLOW_COPY_AND_ASSIGN(CpuGovernor);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_UTILS_CPU_GOVERNOR_H_
@@ -0,0 +1,111 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Counter-based random number generator.
+//
+// The n-th word of a stream is a hash of n and of the key of the stream, so
+// a stream is only a key and a counter. Each voice owns one: its noise does
+// not depend on the other voices, nor on the order in which they are
+// rendered, and a render started from Init() is always the same.
+
+#ifndef STMLIB_UTILS_RANDOM_STREAM_H_
+#define STMLIB_UTILS_RANDOM_STREAM_H_
+
+#include "stmlib/stmlib.h"
+
+#include "stmlib/dsp/simd.h"
+
+namespace stmlib {
+
+class RandomStream {
+ public:
+  RandomStream() { Init(0); }
+  ~RandomStream() { }
+
+  // Streams initialized with different seeds are independent.
+  inline void Init(uint32_t seed) {
+    key_ = Hash(seed ^ 0x2545f491);
+    counter_ = 0;
+  }
+
+  inline uint32_t counter() const { return counter_; }
+  inline void set_counter(uint32_t counter) { counter_ = counter; }
+
+  inline uint32_t GetWord() {
+    return Hash(key_ + kGolden * counter_++);
+  }
+
+  inline int16_t GetSample() {
+    return static_cast<int16_t>(GetWord() >> 16);
+  }
+
+  // Uniform in [0, 1).
+  inline float GetFloat() {
+    return static_cast<float>(GetWord() >> 8) * (1.0f / 16777216.0f);
+  }
+
+  // Same values as size calls to GetFloat(), computed kSimdWidth at a time.
+  inline void Fill(float* out, size_t size) {
+    size_t i = 0;
+    if (size >= kSimdWidth) {
+      u32xN x;
+      for (size_t j = 0; j < kSimdWidth; ++j) {
+        x[j] = key_ + kGolden * (counter_ + static_cast<uint32_t>(j));
+      }
+      const uint32_t step = kGolden * static_cast<uint32_t>(kSimdWidth);
+      for (; i + kSimdWidth <= size; i += kSimdWidth) {
+        i32xN word = reinterpret_cast<i32xN>(Hash(x) >> 8);
+        SimdStore(
+            &out[i],
+            __builtin_convertvector(word, f32xN) * (1.0f / 16777216.0f));
+        x += step;
+      }
+      counter_ += static_cast<uint32_t>(i);
+    }
+    for (; i < size; ++i) {
+      out[i] = GetFloat();
+    }
+  }
+
+ private:
+  static const uint32_t kGolden = 0x9e3779b9;
+
+  // Chris Wellons' lowbias32, for scalars and for vectors of uint32_t.
+  template<typename T>
+  static inline T Hash(T x) {
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+  }
+
+  uint32_t key_;
+  uint32_t counter_;
+
+  DISALLOW_COPY_AND_ASSIGN(RandomStream);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_UTILS_RANDOM_STREAM_H_
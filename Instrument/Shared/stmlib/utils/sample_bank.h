@@ -0,0 +1,248 @@
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+// See http://creativecommons.org/licenses/MIT/ for more information.
+//
+// -----------------------------------------------------------------------------
+//
+// Memory-mapped sample bank.
+//
+// A bank file holds a few sections of samples, each identified by a four
+// character tag, in the form in which the DSP code reads them (for example,
+// the integrated waves of the Plaits wavetable engine). The sections are read
+// in place from the mapping: nothing is copied, and only the pages which are
+// played are loaded from disk.
+//
+// Layout, little-endian: a SampleBankHeader, num_sections SampleBankSection
+// descriptors, then the data of the sections, each aligned on 16 bytes.
+// stmlib/utils/sample_bank.py writes bank files.
+
+#ifndef STMLIB_UTILS_SAMPLE_BANK_H_
+#define STMLIB_UTILS_SAMPLE_BANK_H_
+
+#include "stmlib/stmlib.h"
+
+#include <atomic>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace stmlib {
+
+inline uint32_t SampleBankTag(char a, char b, char c, char d) {
+  return static_cast<uint32_t>(static_cast<uint8_t>(a)) |
+      static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8 |
+      static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16 |
+      static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24;
+}
+
+const uint32_t kSampleBankVersion = 1;
+
+struct SampleBankHeader {
+  uint32_t magic;  // "SBNK"
+  uint32_t version;
+  uint32_t num_sections;
+  uint32_t reserved;
+};
+
+struct SampleBankSection {
+  uint32_t tag;
+  uint32_t offset;  // In bytes, from the beginning of the file.
+  uint32_t size;  // In bytes.
+  uint32_t stride;  // In elements. Its meaning depends on the section.
+};
+
+class SampleBank {
+ public:
+  SampleBank() : data_(NULL), size_(0) { }
+  ~SampleBank() {
+    Close();
+  }
+
+  // Returns false, and leaves the bank closed, if the file cannot be mapped
+  // or is not a valid bank.
+  bool Open(const char* path) {
+    Close();
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat file_stat;
+    void* data = MAP_FAILED;
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+      data = mmap(
+          NULL,
+          static_cast<size_t>(file_stat.st_size),
+          PROT_READ,
+          MAP_SHARED,
+          fd,
+          0);
+    }
+    // The mapping outlives the descriptor.
+    close(fd);
+    if (data == MAP_FAILED) {
+      return false;
+    }
+    data_ = static_cast<const uint8_t*>(data);
+    size_ = static_cast<size_t>(file_stat.st_size);
+    if (!Validate()) {
+      Close();
+      return false;
+    }
+    // Start reading the pages in the background, so that the first notes
+    // played from the bank are less likely to wait for the disk.
+    madvise(const_cast<uint8_t*>(data_), size_, MADV_WILLNEED);
+    return true;
+  }
+
+  void Close() {
+    if (data_) {
+      munmap(const_cast<uint8_t*>(data_), size_);
+      data_ = NULL;
+      size_ = 0;
+    }
+  }
+
+  inline bool is_open() const { return data_ != NULL; }
+
+  // Returns NULL if the bank has no section with this tag, or if its size is
+  // not a multiple of sizeof(T). Otherwise, size receives its number of
+  // elements, and stride its stride.
+  template<typename T>
+  const T* section(uint32_t tag, size_t* size, size_t* stride) const {
+    const SampleBankSection* s = find(tag);
+    if (!s || s->size % sizeof(T)) {
+      return NULL;
+    }
+    *size = s->size / sizeof(T);
+    *stride = s->stride;
+    return reinterpret_cast<const T*>(data_ + s->offset);
+  }
+
+ private:
+  const SampleBankHeader* header() const {
+    return reinterpret_cast<const SampleBankHeader*>(data_);
+  }
+
+  const SampleBankSection* find(uint32_t tag) const {
+    if (!data_) {
+      return NULL;
+    }
+    const SampleBankSection* s = reinterpret_cast<const SampleBankSection*>(
+        header() + 1);
+    for (uint32_t i = 0; i < header()->num_sections; ++i) {
+      if (s[i].tag == tag) {
+        return &s[i];
+      }
+    }
+    return NULL;
+  }
+
+  bool Validate() const {
+    if (size_ < sizeof(SampleBankHeader)) {
+      return false;
+    }
+    const SampleBankHeader* h = header();
+    if (h->magic != SampleBankTag('S', 'B', 'N', 'K') ||
+        h->version != kSampleBankVersion) {
+      return false;
+    }
+    size_t table_size = sizeof(SampleBankSection) * h->num_sections;
+    if (h->num_sections > 256 ||
+        table_size > size_ - sizeof(SampleBankHeader)) {
+      return false;
+    }
+    const SampleBankSection* s = reinterpret_cast<const SampleBankSection*>(
+        h + 1);
+    for (uint32_t i = 0; i < h->num_sections; ++i) {
+      if (s[i].offset & 15 || s[i].offset > size_ ||
+          s[i].size > size_ - s[i].offset) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  const uint8_t* data_;
+  size_t size_;
+
+  DISALLOW_COPY_AND_ASSIGN(SampleBank);
+};
+
+// Hands banks over to the render thread. Load() maps a bank on another
+// thread, and the render thread switches to it at its next call to Acquire().
+// The bank it replaces is unmapped by the following Load(): by then, the
+// render thread has already moved to the new one. Until then, Acquire() leaves
+// any newer bank pending, so Load() unmaps the retired bank only after it has
+// published its own: a bank retired by an Acquire() in between is unmapped
+// at once, and the published one is never left waiting behind it.
+class SampleBankLoader {
+ public:
+  SampleBankLoader() : pending_(NULL), active_(NULL), retired_(NULL) { }
+  ~SampleBankLoader() {
+    delete pending_.load();
+    delete active_;
+    delete retired_.load();
+  }
+
+  // Must not be called from the render thread, nor from two threads at once.
+  // A NULL path switches back to no bank at all. Returns false, and keeps the
+  // current bank, if the file cannot be opened.
+  bool Load(const char* path) {
+    SampleBank* bank = new SampleBank();
+    if (path && !bank->Open(path)) {
+      delete bank;
+      return false;
+    }
+    // A bank which has been loaded but not acquired yet is replaced.
+    delete pending_.exchange(bank);
+    delete retired_.exchange(NULL);
+    return true;
+  }
+
+  // Render thread. Returns true when another bank has become active. Its
+  // sections must then be read again from bank(), before rendering.
+  bool Acquire() {
+    if (retired_.load() != NULL) {
+      return false;
+    }
+    SampleBank* bank = pending_.exchange(NULL);
+    if (!bank) {
+      return false;
+    }
+    retired_.store(active_);
+    active_ = bank;
+    return true;
+  }
+
+  // Render thread. NULL, or a closed bank, when there is no bank loaded.
+  inline const SampleBank* bank() const { return active_; }
+
+ private:
+  std::atomic<SampleBank*> pending_;
+  SampleBank* active_;
+  std::atomic<SampleBank*> retired_;
+
+  DISALLOW_COPY_AND_ASSIGN(SampleBankLoader);
+};
+
+}  // namespace stmlib
+
+#endif  // STMLIB_UTILS_SAMPLE_BANK_H_
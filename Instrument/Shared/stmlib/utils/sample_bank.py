@@ -0,0 +1,70 @@
+#!/usr/bin/python
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+#
+# See http://creativecommons.org/licenses/MIT/ for more information.
+#
+# -----------------------------------------------------------------------------
+#
+# Writer for the bank files read by stmlib/utils/sample_bank.h, and for the
+# mono 16-bit WAV files the banks are made of.
+
+import struct
+import wave
+
+VERSION = 1
+
+
+def ReadWavFile(file_name):
+  """Returns the samples of a mono 16-bit WAV file as a list of floats."""
+  f = wave.open(file_name, 'rb')
+  if f.getnchannels() != 1 or f.getsampwidth() != 2:
+    raise ValueError('%s: expected a mono 16-bit file' % file_name)
+  data = f.readframes(f.getnframes())
+  f.close()
+  num_samples = len(data) // 2
+  return [x / 32768.0 for x in struct.unpack('<%dh' % num_samples, data)]
+
+
+def WriteSampleBank(file_name, sections):
+  """Writes a bank.
+
+  sections is a list of (tag, type, stride, values) tuples, where tag is a
+  four character string and type a struct format character: 'h' for int16_t,
+  'I' for uint32_t.
+  """
+  offset = 16 + 16 * len(sections)
+  table = []
+  data = []
+  for tag, type, stride, values in sections:
+    offset = (offset + 15) & ~15
+    blob = struct.pack('<%d%s' % (len(values), type), *values)
+    table.append(struct.pack('<4sIII', tag.encode('ascii'), offset,
+                             len(blob), stride))
+    data.append((offset, blob))
+    offset += len(blob)
+
+  f = open(file_name, 'wb')
+  f.write(struct.pack('<4sIII', b'SBNK', VERSION, len(sections), 0))
+  for entry in table:
+    f.write(entry)
+  for offset, blob in data:
+    f.write(b'\0' * (offset - f.tell()))
+    f.write(blob)
+  f.close()
@@ -167,6 +167,26 @@
                                                                                                  ]
                                                         dependentParameters:nil];
     
+    NSMutableArray *polyphonyStrings = [NSMutableArray array];
+    for (int i = 1; i <= rings::kMaxPolyphony; i++) {
+        [polyphonyStrings addObject:[NSString stringWithFormat:@"%d", i]];
+    }
+    AUParameter *polyphonyParam = [AUParameterTree createParameterWithIdentifier:@"polyphony" name:@"Polyphony"
+                                                                         address:RingsParamPolyphony min:0.0 max:rings::kMaxPolyphony - 1
+                                                                            unit:kAudioUnitParameterUnit_Generic unitName:nil
+                                                                           flags:flags valueStrings:polyphonyStrings
+                                                             dependentParameters:nil];
+    
+    NSMutableArray *resolutionStrings = [NSMutableArray arrayWithObject:@"Auto"];
+    for (int i = 2; i <= rings::kMaxModes; i += 2) {
+        [resolutionStrings addObject:[NSString stringWithFormat:@"%d", i]];
+    }
+    AUParameter *resolutionParam = [AUParameterTree createParameterWithIdentifier:@"resolution" name:@"Modes"
+                                                                          address:RingsParamResolution min:0.0 max:rings::kMaxModes / 2
+                                                                             unit:kAudioUnitParameterUnit_Generic unitName:nil
+                                                                            flags:flags valueStrings:resolutionStrings
+                                                              dependentParameters:nil];
+    
     AUParameter *pitchParam = [AUParameterTree createParameterWithIdentifier:@"pitch" name:@"Pitch"
                                                                      address:RingsParamPitch
                                                                          min:-12.0 max:12.0 unit:kAudioUnitParameterUnit_Generic unitName:nil
@@ -177,7 +197,7 @@
                                                                           min:-1.0 max:1.0 unit:kAudioUnitParameterUnit_Generic unitName:nil
                                                                         flags: flags valueStrings:nil dependentParameters:nil];
     
-    AUParameterGroup *resonatorPage = [AUParameterTree createGroupWithIdentifier:@"resonator" name:@"Resonator" children:@[modeParam, pitchParam, detuneParam, structure, brightness, position, damping, volume, stereo, padX, padY, padGate]];
+    AUParameterGroup *resonatorPage = [AUParameterTree createGroupWithIdentifier:@"resonator" name:@"Resonator" children:@[modeParam, polyphonyParam, resolutionParam, pitchParam, detuneParam, structure, brightness, position, damping, volume, stereo, padX, padY, padGate]];
     
     // LFO
     AUParameter *lfoRate = [AUParameterTree createParameterWithIdentifier:@"lfoRate" name:@"LFO Rate"
@@ -301,6 +321,10 @@
             case RingsParamInputGain:
                 param.value = 1.0;
                 break;
+            
+            case RingsParamPolyphony:
+                param.value = 3.0f;
+                break;
             default:
                 param.value = 0.0f;
                 break;
@@ -401,6 +425,7 @@
         return NO;
     }
     
+    _kernel.setResamplerQuality(self.renderingOffline ? stmlib::RESAMPLER_QUALITY_OFFLINE : stmlib::RESAMPLER_QUALITY_REALTIME);
     _kernel.init(_audioBuffers.outputBus.format.channelCount, _audioBuffers.outputBus.format.sampleRate);
     _kernel.midiAllNotesOff();
     
@@ -487,11 +512,11 @@ static const FactoryPreset ringsPresets[kRingsNumPresets] =
 {
     {
         @"Init",
-        @"{\"414\":0,\"421\":0,\"407\":0,\"408\":0,\"415\":0,\"422\":1.1399997472763062,\"409\":0,\"416\":1,\"423\":3,\"430\":0,\"0\":0.24367509782314301,\"417\":0,\"424\":3,\"431\":0,\"1\":0.31490787863731384,\"2\":0,\"418\":0.94999980926513672,\"4\":0.21000000834465027,\"425\":0,\"432\":0,\"5\":0.29000008106231689,\"6\":0.51749980449676514,\"433\":0,\"7\":0.48499956727027893,\"419\":4,\"426\":0.71999990940093994,\"8\":1,\"9\":1,\"11\":0,\"427\":5,\"434\":0,\"12\":0,\"13\":0.090000338852405548,\"428\":0,\"435\":0,\"400\":0,\"20\":1,\"21\":0.39749985933303833,\"14\":0,\"429\":0,\"401\":0,\"15\":0,\"436\":0,\"16\":0,\"437\":0,\"402\":0,\"17\":0,\"18\":0,\"438\":0,\"403\":1,\"410\":0,\"19\":0,\"439\":0,\"404\":0,\"411\":0,\"405\":0,\"412\":0,\"420\":2,\"406\":0,\"413\":0}"
+        @"{\"414\":0,\"421\":0,\"407\":0,\"408\":0,\"415\":0,\"422\":1.1399997472763062,\"409\":0,\"416\":1,\"423\":3,\"430\":0,\"0\":0.24367509782314301,\"417\":0,\"424\":3,\"431\":0,\"1\":0.31490787863731384,\"2\":0,\"418\":0.94999980926513672,\"4\":0.21000000834465027,\"425\":0,\"432\":0,\"5\":0.29000008106231689,\"6\":0.51749980449676514,\"433\":0,\"7\":0.48499956727027893,\"419\":4,\"426\":0.71999990940093994,\"8\":1,\"9\":1,\"10\":3,\"11\":0,\"427\":5,\"434\":0,\"12\":0,\"13\":0.090000338852405548,\"428\":0,\"435\":0,\"400\":0,\"20\":1,\"21\":0.39749985933303833,\"14\":0,\"429\":0,\"401\":0,\"15\":0,\"436\":0,\"16\":0,\"437\":0,\"402\":0,\"17\":0,\"18\":0,\"438\":0,\"403\":1,\"410\":0,\"19\":0,\"439\":0,\"404\":0,\"411\":0,\"405\":0,\"412\":0,\"420\":2,\"406\":0,\"413\":0}"
     },
     {
         @"Blank",
-        @"{\"414\":0,\"421\":0,\"407\":0,\"408\":0,\"415\":0,\"422\":0,\"409\":0,\"416\":0,\"423\":0,\"430\":0,\"0\":0,\"417\":0,\"424\":0,\"431\":0,\"1\":0,\"2\":0,\"418\":0,\"4\":0,\"425\":0,\"432\":0,\"5\":0,\"6\":0,\"433\":0,\"7\":0,\"419\":0,\"426\":0,\"8\":1,\"9\":0,\"11\":0,\"427\":0,\"434\":0,\"12\":0,\"13\":0,\"428\":0,\"435\":0,\"400\":0,\"20\":1,\"21\":0,\"14\":0,\"429\":0,\"401\":0,\"15\":0,\"436\":0,\"16\":0,\"437\":0,\"402\":0,\"17\":0,\"18\":0,\"438\":0,\"403\":0,\"410\":0,\"19\":0,\"439\":0,\"404\":0,\"411\":0,\"405\":0,\"412\":0,\"420\":0,\"406\":0,\"413\":0}"
+        @"{\"414\":0,\"421\":0,\"407\":0,\"408\":0,\"415\":0,\"422\":0,\"409\":0,\"416\":0,\"423\":0,\"430\":0,\"0\":0,\"417\":0,\"424\":0,\"431\":0,\"1\":0,\"2\":0,\"418\":0,\"4\":0,\"425\":0,\"432\":0,\"5\":0,\"6\":0,\"433\":0,\"7\":0,\"419\":0,\"426\":0,\"8\":1,\"9\":0,\"10\":3,\"11\":0,\"427\":0,\"434\":0,\"12\":0,\"13\":0,\"428\":0,\"435\":0,\"400\":0,\"20\":1,\"21\":0,\"14\":0,\"429\":0,\"401\":0,\"15\":0,\"436\":0,\"16\":0,\"437\":0,\"402\":0,\"17\":0,\"18\":0,\"438\":0,\"403\":0,\"410\":0,\"19\":0,\"439\":0,\"404\":0,\"411\":0,\"405\":0,\"412\":0,\"420\":0,\"406\":0,\"413\":0}"
     },
 };
 
@@ -566,4 +591,28 @@ static const FactoryPreset ringsPresets[kRingsNumPresets] =
     return _kernel.lfoDrawingDirty();
 }
 
+// MARK - performance counters
+- (NSDictionary<NSString *, NSNumber *> *) performanceCounters {
+    PerformanceSnapshot snapshot;
+    _kernel.readPerformanceCounters(&snapshot);
+    return @{
+        @"buffers": @(snapshot.buffers),
+        @"frames": @(snapshot.frames),
+        @"overloads": @(snapshot.overloads),
+        @"denormals": @(snapshot.denormals),
+        @"lastNanoseconds": @(snapshot.lastNanoseconds),
+        @"lastLoad": @(snapshot.lastLoad),
+        @"p99Load": @(snapshot.p99Load),
+        @"maxLoad": @(snapshot.maxLoad),
+        @"dspSeconds": @(snapshot.dspSeconds),
+        @"resamplerSeconds": @(snapshot.resamplerSeconds),
+        @"activeVoices": @(snapshot.activeVoices),
+        @"maxActiveVoices": @(snapshot.maxActiveVoices),
+    };
+}
+
+- (void) resetPerformanceCounters {
+    _kernel.resetPerformanceCounters();
+}
+
 @end
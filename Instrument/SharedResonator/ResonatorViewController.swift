@@ -35,6 +35,7 @@ enum RingsParam: AUParameterAddress {
     case LfoTempoSync = 22
     case LfoResetPhase = 23
     case LfoKeyReset = 24
+    case Resolution = 25
     
     case ModMatrixStart = 400
     case ModMatrixEnd = 440 // 26 + 40 = 66
@@ -86,6 +87,10 @@ class ResonatorViewController: BaseAudioUnitViewController {
                             knob(RingsParam.Detune.rawValue),
                             menuPicker(RingsParam.Mode.rawValue)
                             ])),
+                        panel(HStack([
+                            menuPicker(RingsParam.Polyphony.rawValue),
+                            menuPicker(RingsParam.Resolution.rawValue)
+                            ])),
                         panel(HStack(main)),
                         panel(cStack([
                             HStack([
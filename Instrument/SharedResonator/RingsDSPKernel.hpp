@@ -12,7 +12,8 @@
 
 #import <BurnsAudioUnit/multistage_envelope.h>
 #import <BurnsAudioUnit/DSPKernel.hpp>
-#import <BurnsAudioUnit/converter.hpp>
+#import "stmlib/dsp/polyphase_resampler.h"
+#import "stmlib/utils/cpu_governor.h"
 
 #import <vector>
 
@@ -24,10 +25,17 @@
 #import <BurnsAudioUnit/MIDIProcessor.hpp>
 #import <BurnsAudioUnit/ModulationEngine.hpp>
 
+#import "PerformanceCounters.hpp"
+
 const size_t kAudioBlockSize = 16;
 const size_t kPolyphony = 1;
 const size_t kNumModulationRules = 10;
 
+// Fraction of the real-time budget the modal resonator may use before the
+// governor starts dropping modes, and the fraction of modes always kept.
+const float kGovernorTargetLoad = 0.5f;
+const float kGovernorMinQuality = 0.25f;
+
 enum {
     RingsParamPadX = 0,
     RingsParamPadY = 1,
@@ -53,6 +61,7 @@ enum {
     RingsParamLfoTempoSync = 22,
     RingsParamLfoResetPhase = 23,
     RingsParamLfoKeyReset = 24,
+    RingsParamResolution = 25,
     RingsParamModMatrixStart = 400,
     RingsParamModMatrixEnd = 400 + (kNumModulationRules * 4), // 26 + 40 = 66
     
@@ -122,22 +131,41 @@ public:
     }
     
     void init(int channelCount, double inSampleRate) {
-        if (inputSrc) {
-            delete inputSrc;
-        }
-        if (outputSrc) {
-            delete outputSrc;
-        }
-        inputSrc = new Converter((int) inSampleRate, 48000);
-        outputSrc = new Converter(48000, (int) inSampleRate);
+        inputSrc.Init((int) inSampleRate, 48000, resamplerQuality);
+        outputSrc.Init(48000, (int) inSampleRate, resamplerQuality);
         strummer.Init(0.01f, 48000 / kAudioBlockSize);
 
         midiAllNotesOff();
         envelope.Init();
         lfo.Init(48000);
+        governor.Init(kAudioBlockSize / 48000.0, kGovernorTargetLoad, kGovernorMinQuality);
         
         modEngine.rules = &modulationEngineRules;
         modEngine.in[ModInDirect] = 1.0f;
+        performanceCounters.init(inSampleRate);
+    }
+    
+    // Not on the render thread, and from one thread at a time.
+    void readPerformanceCounters(PerformanceSnapshot *snapshot) {
+        performanceCounters.read(snapshot);
+    }
+    
+    void resetPerformanceCounters() {
+        performanceCounters.reset();
+    }
+    
+    // Takes effect at the next init().
+    void setResamplerQuality(stmlib::ResamplerQuality quality) {
+        resamplerQuality = quality;
+    }
+    
+    // When disabled, the resonator always renders all its modes, and the
+    // output no longer depends on the speed of the machine.
+    void setCpuGovernor(bool enabled) {
+        governorEnabled = enabled;
+        if (!enabled) {
+            part.set_resolution_scale(1.0f);
+        }
     }
     
     void setupModulationRules() {
@@ -195,6 +223,13 @@ public:
                 }
                 break;
             }
+            case RingsParamPolyphony:
+                part.set_polyphony(1 + (int32_t) round(clamp(value, 0.0f, (float) (rings::kMaxPolyphony - 1))));
+                break;
+            case RingsParamResolution:
+                // 0 is automatic, then the number of modes in steps of 2.
+                part.set_resolution(2 * (int32_t) round(clamp(value, 0.0f, rings::kMaxModes / 2.0f)));
+                break;
             case RingsParamDetune:
                 detune = clamp(value, -1.0f, 1.0f);
                 break;
@@ -290,6 +325,12 @@ public:
                     return (float) part.model();
                 }
                 
+            case RingsParamPolyphony:
+                return (float) (part.polyphony() - 1);
+                
+            case RingsParamResolution:
+                return (float) (part.resolution() / 2);
+                
             case RingsParamDetune:
                 return detune;
                 
@@ -456,6 +497,8 @@ public:
     }
     
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        performanceCounters.beginProcess(frameCount, bufferOffset);
+        
         float* outL = (float*)outBufferListPtr->mBuffers[0].mData + bufferOffset;
         float* outR = (float*)outBufferListPtr->mBuffers[1].mData + bufferOffset;
         float *inL = 0;
@@ -477,11 +520,13 @@ public:
                 runModulations(kAudioBlockSize);
                 
                 if (useAudioInput) {
-                    ConverterResult result;
-                    inputSrc->convert(inL, inR, inputFramesRemaining, processedL + carriedInputFrames, processedR + carriedInputFrames, kAudioBlockSize - carriedInputFrames, &result);
-                    inL += result.inputConsumed;
-                    inR += result.inputConsumed;
-                    inputFramesRemaining -= result.inputConsumed;
+                    stmlib::ResamplerResult result;
+                    performanceCounters.beginResampler();
+                    inputSrc.Process(inL, inR, inputFramesRemaining, processedL + carriedInputFrames, processedR + carriedInputFrames, kAudioBlockSize - carriedInputFrames, &result);
+                    performanceCounters.endResampler();
+                    inL += result.input_consumed;
+                    inR += result.input_consumed;
+                    inputFramesRemaining -= (int) result.input_consumed;
                     
                     if (easterEgg) {
                         for (int i = 0; i < kAudioBlockSize; ++i) {
@@ -522,7 +567,17 @@ public:
                     string_synth.Process(performance, patch, input, renderedL, renderedR, kAudioBlockSize);
                 } else {
                     strummer.Process(input, kAudioBlockSize, &performance);
+                    // Only the modal model has modes to drop. The load of the other models
+                    // must not lower the resolution it will find when it is selected again.
+                    bool governed = governorEnabled && part.model() == rings::RESONATOR_MODEL_MODAL;
+                    if (governed) {
+                        governor.Start();
+                    }
                     part.Process(performance, patch, input, renderedL, renderedR, kAudioBlockSize);
+                    if (governed) {
+                        governor.Stop();
+                        part.set_resolution_scale(governor.quality());
+                    }
                 }
 
                 if (delayed_trigger) {
@@ -545,26 +600,36 @@ public:
                     renderedR[i] = (renderedR[i] + (renderedL[i] * mix)) * amount;
                 }
                 
+                performanceCounters.countDenormals(renderedL, kAudioBlockSize);
+                performanceCounters.countDenormals(renderedR, kAudioBlockSize);
+                performanceCounters.setActiveVoices(easterEgg ? 0 : part.polyphony());
+                
                 modEngine.in[ModInOut] = renderedL[kAudioBlockSize-1];
                 renderedFramesPos = 0;
             }
             
-            ConverterResult result;
+            stmlib::ResamplerResult result;
             
-            outputSrc->convert(renderedL + renderedFramesPos, renderedR + renderedFramesPos, kAudioBlockSize - renderedFramesPos, outL, outR, outputFramesRemaining, &result);
+            performanceCounters.beginResampler();
+            outputSrc.Process(renderedL + renderedFramesPos, renderedR + renderedFramesPos, kAudioBlockSize - renderedFramesPos, outL, outR, outputFramesRemaining, &result);
+            performanceCounters.endResampler();
             
-            outL += result.outputLength;
-            outR += result.outputLength;
+            outL += result.output_length;
+            outR += result.output_length;
             
-            renderedFramesPos += result.inputConsumed;
-            outputFramesRemaining -= result.outputLength;
+            renderedFramesPos += (int) result.input_consumed;
+            outputFramesRemaining -= (int) result.output_length;
         }
         
         if (useAudioInput && inputFramesRemaining > 0) {
-            ConverterResult result;
-            inputSrc->convert(inL, inR, inputFramesRemaining, processedL, processedR, kAudioBlockSize, &result);
-            carriedInputFrames = result.outputLength;
+            stmlib::ResamplerResult result;
+            performanceCounters.beginResampler();
+            inputSrc.Process(inL, inR, inputFramesRemaining, processedL, processedR, kAudioBlockSize, &result);
+            performanceCounters.endResampler();
+            carriedInputFrames = (int) result.output_length;
         }
+        
+        performanceCounters.endProcess();
     }
     
     void drawLFO(float *points, int count) {
@@ -583,10 +648,14 @@ private:
     
     unsigned int activePolyphony = 1;
     
+    PerformanceCounters performanceCounters;
+    
 public:
     rings::Part part;
     rings::StringSynthPart string_synth;
     rings::Strummer strummer;
+    stmlib::CpuGovernor governor;
+    bool governorEnabled = true;
     rings::Patch patch;
     rings::Patch basePatch;
     KernelTransportState transportState;
@@ -595,12 +664,13 @@ public:
     const float kNoiseGateThreshold = 0.00003f;
     float in_level = 0.0f;
     
-    Converter *inputSrc = 0;
+    stmlib::ResamplerQuality resamplerQuality = stmlib::RESAMPLER_QUALITY_REALTIME;
+    stmlib::PolyphaseResampler inputSrc;
     float processedL[kAudioBlockSize] = {};
     float processedR[kAudioBlockSize] = {};
     int carriedInputFrames = 0;
     
-    Converter *outputSrc = 0;
+    stmlib::PolyphaseResampler outputSrc;
     float renderedL[kAudioBlockSize] = {};
     float renderedR[kAudioBlockSize] = {};
     int renderedFramesPos = 0;
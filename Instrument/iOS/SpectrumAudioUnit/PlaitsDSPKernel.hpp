@@ -14,12 +14,17 @@
 #import "stmlib/dsp/parameter_interpolator.h"
 #import <BurnsAudioUnit/multistage_envelope.h>
 #import <BurnsAudioUnit/DSPKernel.hpp>
-#import <BurnsAudioUnit/converter.hpp>
+#import "stmlib/dsp/polyphase_resampler.h"
+#import "stmlib/utils/sample_bank.h"
 
 #import <BurnsAudioUnit/MIDIProcessor.hpp>
 #import <BurnsAudioUnit/ModulationEngine.hpp>
 #import <BurnsAudioUnit/LFOKernel.hpp>
 
+#import "VoiceRenderPool.hpp"
+#import "ModulationProgram.hpp"
+#import "PerformanceCounters.hpp"
+
 #ifdef DEBUG
 #define KERNEL_DEBUG_LOG(...) printf(__VA_ARGS__);
 #else
@@ -32,6 +37,21 @@ const size_t kAudioBlockSize = 24;
 const size_t kMaxPolyphony = 8;
 const size_t kNumModulationRules = 12;
 
+// Below this host buffer size, the render thread would spend more time handing voices over to
+// the workers than rendering them, so voices are rendered serially.
+const AUAudioFrameCount kMinParallelRenderFrames = 128;
+
+// A voice whose level (its amplitude envelope) and output both stay below kSilenceThreshold
+// (-100 dB) for kSleepFrames internal frames (100 ms), and whose LPG has closed, is put to sleep:
+// it is not rendered until something could make it audible again. A silent output alone is not
+// enough, since some engines are silent for long stretches while their note is held.
+const float kSilenceThreshold = 0.00001f;
+const int kSleepFrames = 4800;
+// Modulations which move by more than this wake a sleeping voice. The pitch is in semitones: a
+// vibrato does not wake a voice, a glide or a new note does.
+const float kWakeTolerance = 0.001f;
+const float kWakePitchTolerance = 0.5f;
+
 enum {
     PlaitsParamPadX = 0,
     PlaitsParamPadY = 1,
@@ -120,30 +140,45 @@ enum {
 class PlaitsDSPKernel : public DSPKernel {
 public:
     // MARK: Types
+    typedef ModulationProgram<kMaxPolyphony, NumModulationInputs, NumModulationOutputs, kNumModulationRules> PlaitsModulationProgram;
+    
+    // A MIDI or parameter event, and the internal frame where it takes effect.
+    struct ScheduledEvent {
+        int64_t time;
+        bool isMIDI;
+        AUMIDIEvent midi;
+        AUParameterAddress address;
+        AUValue value;
+    };
+    
     class VoiceState: public MIDIVoice {
     public:
         unsigned int state = 0;
         PlaitsDSPKernel *kernel = 0;
         
-        char ram_block[16 * 1024] = {};
         uint8_t note = 0;
         float noteTarget = 0.0f;
-        plaits::Voice::Frame frames[kAudioBlockSize];
-        size_t plaitsFramesIndex = 0;
+        float plaitsOut[kAudioBlockSize] = {};
+        float plaitsAux[kAudioBlockSize] = {};
+        
+        // Output of the voice when it is rendered by a worker thread.
+        float scratchL[kAudioBlockSize];
+        float scratchR[kAudioBlockSize];
         
         peaks::MultistageEnvelope envelope;
         peaks::MultistageEnvelope ampEnvelope;
         LFOKernel lfo;
-        float lfoOutput;
-        float out, aux;
-        float rightGain, leftGain, rightGainTarget, leftGainTarget;
-        float leftSource, rightSource, leftSourceTarget, rightSourceTarget;
+        float lfoOutput = 0.0f;
+        float out = 0.0f, aux = 0.0f;
+        float rightGain = 0.0f, leftGain = 0.0f, rightGainTarget = 0.0f, leftGainTarget = 0.0f;
+        float leftSource = 0.0f, rightSource = 0.0f, leftSourceTarget = 0.0f, rightSourceTarget = 0.0f;
 
         plaits::Voice *voice = nil;
         plaits::Modulations modulations;
-        ModulationEngine modEngine;
+        // Lanes of this voice in the modulation program of the kernel.
+        PlaitsModulationProgram::VoiceLanes modEngine;
         double portamento = 0.0;
-        float bendAmount;
+        float bendAmount = 0.0f;
         float panSpread = 0;
         
         float aftertouchTarget = 0.0f;
@@ -152,6 +187,16 @@ public:
         bool portamentoPatched = false;
         
         bool delayed_trigger = false;
+        // Frames before the delayed trigger, one full block whatever the length of the blocks.
+        int delayedTriggerFrames = 0;
+        
+        // A sleeping voice still runs its envelopes, LFO and modulations, but not its engine. It
+        // wakes up at the next note, parameter change, or when its modulations move away from
+        // those it fell asleep with, its level first. A released voice is freed instead.
+        bool asleep = false;
+        int silentFrames = 0;
+        uint32_t sleepParameterRevision = 0;
+        plaits::Modulations sleepModulations;
 
 #ifdef DEADVOICE
         int deadCount = 0;
@@ -162,8 +207,7 @@ public:
         int deadNotes = 0;
 #endif
         
-        VoiceState() : modEngine(NumModulationInputs, NumModulationOutputs),
-        lfo(PlaitsParamLfoRate, PlaitsParamLfoShape, PlaitsParamLfoShapeMod, PlaitsParamLfoTempoSync, PlaitsParamLfoResetPhase, PlaitsParamLfoKeyReset) {
+        VoiceState() : lfo(PlaitsParamLfoRate, PlaitsParamLfoShape, PlaitsParamLfoShapeMod, PlaitsParamLfoTempoSync, PlaitsParamLfoResetPhase, PlaitsParamLfoKeyReset) {
         }
         
         ~VoiceState() {
@@ -174,16 +218,14 @@ public:
             }
         }
         
-        void Init(ModulationEngineRuleList *rules) {
+        void Init(PlaitsModulationProgram::VoiceLanes lanes, plaits::EngineSlot *engineSlot, uint32_t seed) {
             KERNEL_DEBUG_LOG("kernel voice Init\n")
             voice = new plaits::Voice();
-            stmlib::BufferAllocator allocator(ram_block, 16384);
-            voice->Init(&allocator);
-            plaitsFramesIndex = kAudioBlockSize;
+            voice->Init(engineSlot, seed);
             envelope.Init();
             ampEnvelope.Init();
             lfo.Init(48000);
-            modEngine.rules = rules;
+            modEngine = lanes;
             modEngine.in[ModInDirect] = 1.0f;
         }
         
@@ -246,6 +288,8 @@ public:
         }
         
         void add() {
+            asleep = false;
+            silentFrames = 0;
             if (state == NoteStateUnused) {
                 modulations.trigger = 1.0f;
                 envelope.TriggerHigh();
@@ -259,11 +303,14 @@ public:
 #endif
             } else if (state == NoteStateReleasing) {
                 delayed_trigger = true;
+                delayedTriggerFrames = kAudioBlockSize;
             }
             state = NoteStatePlaying;
         }
         
         virtual void retrigger() override {
+            asleep = false;
+            silentFrames = 0;
             envelope.TriggerHigh();
             ampEnvelope.TriggerHigh();
             lfo.trigger();
@@ -290,17 +337,47 @@ public:
         
         // === MODULATIONS
         
+        // Coefficient of a one-pole filter run once per block, for a block of blockSize frames
+        // from the one of a full block, so that split blocks do not make it faster.
+        static float blockCoefficient(float coefficient, int blockSize) {
+            if (blockSize == kAudioBlockSize) {
+                return coefficient;
+            }
+            return 1.0f - powf(1.0f - coefficient, (float) blockSize / kAudioBlockSize);
+        }
+        
+        // Frames after which a delayed trigger takes effect, or 0 when none is pending.
+        int pendingTriggerFrames() const {
+            int frames = voice->pending_trigger_delay();
+            if (delayed_trigger && (frames == 0 || delayedTriggerFrames < frames)) {
+                frames = delayedTriggerFrames;
+            }
+            return frames;
+        }
+        
         void updatePortamento(float modulationAmount) {
             portamento = clamp(kernel->portamento + modulationAmount, 0.0, 0.9995);
             portamento = std::pow(portamento, 0.05f);
         }
         
-        void runModulations(int blockSize) {
+        // The modulations of a block are computed in two steps, between which the kernel runs its
+        // modulation program for all the playing voices: beginModulations() sets the inputs of
+        // the voice, then applyModulations() reads its outputs.
+        void beginModulations(int blockSize) {
+            if (state == NoteStateReleasing && !voice->lpg_active()) {
+                state = NoteStateUnused;
+            }
+            // The engine of a sleeping voice is not rendered, so its LPG does not decay anymore.
+            // This also frees the released voices of the engines which bypass the LPG.
+            if (asleep && state == NoteStateReleasing) {
+                state = NoteStateUnused;
+            }
+            
             envelope.Process(blockSize);
             ampEnvelope.Process(blockSize);
         
             float lfoAmount = 1.0;
-            if (kernel->modulationEngineRules.isPatched(ModOutLFOAmount)) {
+            if (kernel->modulationProgram.isPatched(ModOutLFOAmount)) {
                 lfoAmount = modEngine.out[ModOutLFOAmount];
             }
             
@@ -311,7 +388,7 @@ public:
             modEngine.in[ModInOut] = out;
             modEngine.in[ModInAux] = aux;
             
-            if (kernel->modulationEngineRules.isPatched(ModOutPortamento)) {
+            if (kernel->modulationProgram.isPatched(ModOutPortamento)) {
                 updatePortamento(modEngine.out[ModOutPortamento]);
                 portamentoPatched = true;
             } else if (portamentoPatched) {
@@ -319,12 +396,12 @@ public:
                 updatePortamento(0.0f);
             }
             
-            ONE_POLE(modulations.note, noteTarget, 1.0f - portamento);
-            ONE_POLE(modEngine.in[ModInAftertouch], aftertouchTarget, 0.1f);
-
-            modEngine.run();
-            
-            if (kernel->modulationEngineRules.isPatched(ModOutLFORate)) {
+            ONE_POLE(modulations.note, noteTarget, blockCoefficient(1.0f - portamento, blockSize));
+            ONE_POLE(modEngine.in[ModInAftertouch], aftertouchTarget, blockCoefficient(0.1f, blockSize));
+        }
+        
+        void applyModulations() {
+            if (kernel->modulationProgram.isPatched(ModOutLFORate)) {
                 lfo.updateRate(modEngine.out[ModOutLFORate]);
                 lfoRatePatched = true;
             } else if (lfoRatePatched) {
@@ -342,7 +419,7 @@ public:
             modulations.morph = kernel->modulations.morph + modEngine.out[ModOutMorph];
             
             float levelModulation = 1.0;
-            if (kernel->modulationEngineRules.isPatched(ModOutLevel)) {
+            if (kernel->modulationProgram.isPatched(ModOutLevel)) {
                 levelModulation = modEngine.out[ModOutLevel];
             }
             
@@ -367,58 +444,79 @@ public:
                 leftGainTarget = 1.0f;
                 rightGainTarget = 1.0f + pan;
             }
+            
+            if (asleep && shouldWake()) {
+                asleep = false;
+                silentFrames = 0;
+            }
+        }
+        
+        bool shouldWake() const {
+            return state == NoteStateUnused ||
+                kernel->parameterRevision.load(std::memory_order_relaxed) != sleepParameterRevision ||
+                fabsf(modulations.engine - sleepModulations.engine) > kWakeTolerance ||
+                fabsf(modulations.note - sleepModulations.note) > kWakePitchTolerance ||
+                fabsf(modulations.frequency - sleepModulations.frequency) > kWakePitchTolerance ||
+                fabsf(modulations.harmonics - sleepModulations.harmonics) > kWakeTolerance ||
+                fabsf(modulations.timbre - sleepModulations.timbre) > kWakeTolerance ||
+                fabsf(modulations.morph - sleepModulations.morph) > kWakeTolerance ||
+                modulations.level > sleepModulations.level + kWakeTolerance;
         }
         
+        void fallAsleep() {
+            asleep = true;
+            sleepParameterRevision = kernel->parameterRevision.load(std::memory_order_relaxed);
+            sleepModulations = modulations;
+            out = 0.0f;
+            aux = 0.0f;
+        }
+        
+        // Renders a block of n frames, at most kAudioBlockSize. Its modulations must have been
+        // computed before.
         void run(int n, float* outL, float* outR)
         {
-            int framesRemaining = n;
-            
-            while (framesRemaining) {
-                if (plaitsFramesIndex >= kAudioBlockSize) {
-                    
-                    if (state == NoteStateReleasing && !voice->lpg_active()) {
-                        state = NoteStateUnused;
-                    }
-                    
-                    runModulations(kAudioBlockSize);
-
 #ifdef DEADVOICE
-                    if (voiceIsDead) {
-                        printf("here\n");
-                        voiceIsDead = false;
-                    }
+            if (voiceIsDead) {
+                printf("here\n");
+                voiceIsDead = false;
+            }
 #endif
-                    voice->Render(kernel->patch, modulations, &frames[0], kAudioBlockSize);
-                    plaitsFramesIndex = 0;
-                    
-                    if (delayed_trigger) {
-                        delayed_trigger = false;
-                        modulations.trigger = 1.0f;
-                        envelope.TriggerHigh();
-                        ampEnvelope.TriggerHigh();
-                        lfo.trigger();
-                        modEngine.in[ModInGate] = 1.0f;
-                        assert(state == NoteStatePlaying);
-                        
+            voice->Render(kernel->patch, modulations, plaitsOut, plaitsAux, n);
+            
+            bool triggered = false;
+            if (delayed_trigger) {
+                delayedTriggerFrames -= n;
+            }
+            if (delayed_trigger && delayedTriggerFrames <= 0) {
+                triggered = true;
+                delayed_trigger = false;
+                modulations.trigger = 1.0f;
+                envelope.TriggerHigh();
+                ampEnvelope.TriggerHigh();
+                lfo.trigger();
+                modEngine.in[ModInGate] = 1.0f;
+                assert(state == NoteStatePlaying);
+                
 #ifdef DEADVOICE
-                        deadCount = 0;
-                        maxSample = 0.0f;
-                        maxAmpSample = 0.0f;
+                deadCount = 0;
+                maxSample = 0.0f;
+                maxAmpSample = 0.0f;
 #endif
-                    }
-                }
-                
-                out = ((float) frames[plaitsFramesIndex].out) / ((float) INT16_MAX);
-                aux = ((float) frames[plaitsFramesIndex].aux) / ((float) INT16_MAX);
+            }
+            
+            float peak = 0.0f;
+            for (int i = 0; i < n; i++) {
+                out = plaitsOut[i];
+                aux = plaitsAux[i];
                 ONE_POLE(leftSource, leftSourceTarget, 0.01);
                 ONE_POLE(rightSource, rightSourceTarget, 0.01);
                 ONE_POLE(leftGain, leftGainTarget, 0.01);
                 ONE_POLE(rightGain, rightGainTarget, 0.01);
                 
-#ifdef DEADVOICE
                 float l = ((out * (1.0f - leftSource)) + (aux * (leftSource))) * leftGain;
                 float r = ((out * (1.0f - rightSource)) + (aux * (rightSource))) * rightGain;
-                
+                peak = std::max(peak, std::max(fabsf(l), fabsf(r)));
+#ifdef DEADVOICE
                 if (abs(l) > maxSample) {
                     maxSample = abs(l);
                 }
@@ -441,15 +539,20 @@ public:
                         deadNotes = 0;
                     }
                 }
+#endif
                 *outL++ += l;
                 *outR++ += r;
-#else
-                *outL++ += ((out * (1.0f - leftSource)) + (aux * (leftSource))) * leftGain;
-                *outR++ += ((out * (1.0f - rightSource)) + (aux * (rightSource))) * rightGain;
-#endif
-                
-                plaitsFramesIndex++;
-                framesRemaining--;
+            }
+            
+            bool gated = modulations.level < kSilenceThreshold &&
+                (voice->lpg_bypassed() || !voice->lpg_active());
+            if (peak >= kSilenceThreshold || !gated || triggered) {
+                silentFrames = 0;
+            } else {
+                silentFrames += n;
+                if (silentFrames >= kSleepFrames && kernel->voiceSleep) {
+                    fallAsleep();
+                }
             }
         }
     };
@@ -460,14 +563,19 @@ public:
     {
         KERNEL_DEBUG_LOG("Kernel constructor")
 
+        // Each voice only constructs the engine it plays in its slot of the arena.
+        engineArena.Init(kMaxPolyphony);
         voices.resize(kMaxPolyphony);
-        for (VoiceState& voice : voices) {
+        for (int i = 0; i < kMaxPolyphony; i++) {
+            VoiceState& voice = voices[i];
             voice.kernel = this;
-            voice.Init(&modulationEngineRules);
+            voice.Init(modulationProgram.lanes(i), engineArena.slot(i), (uint32_t) i);
             midiProcessor.noteStack.addVoice(&voice);
         }
         envParameters[2] = UINT16_MAX;
         
+        renderPool.start(VoiceRenderPool::recommendedWorkerCount());
+        
         patch.engine = 8;
         patch.note = 48.0f;
         patch.harmonics = 0.3f;
@@ -483,6 +591,7 @@ public:
         modulations.engine = 0.0f;
         modulations.frequency = 0.0f;
         modulations.harmonics = 0.0f;
+        modulations.timbre = 0.0f;
         modulations.morph = 0.0;
         modulations.level = 0.0f;
         modulations.trigger = 0.0f;
@@ -495,17 +604,66 @@ public:
     
     ~PlaitsDSPKernel() {
         KERNEL_DEBUG_LOG("PlaitsDSPKernel destructor")
-        if (outputSrc != nil) {
-            delete outputSrc;
-        }
+        renderPool.stop();
     }
     
     void init(int channelCount, double inSampleRate) {
         KERNEL_DEBUG_LOG("Kernel init")
-        if (outputSrc) {
-            delete outputSrc;
+        outputSrc.Init(48000, (int) inSampleRate, resamplerQuality);
+        performanceCounters.init(inSampleRate);
+    }
+    
+    // Not on the render thread, and from one thread at a time.
+    void readPerformanceCounters(PerformanceSnapshot *snapshot) {
+        performanceCounters.read(snapshot);
+    }
+    
+    void resetPerformanceCounters() {
+        performanceCounters.reset();
+    }
+    
+    // When false, the voices are rendered until their LPG closes, however quiet they are. Takes
+    // effect from the next block on.
+    void setVoiceSleep(bool enabled) {
+        voiceSleep = enabled;
+    }
+    
+    // When false, the MIDI and parameter events of the render block take effect at the start of
+    // the next internal block, as they reach the kernel. Takes effect from the next event on.
+    void setSampleAccurateEvents(bool enabled) {
+        sampleAccurateEvents = enabled;
+    }
+    
+    // Takes effect at the next init().
+    void setResamplerQuality(stmlib::ResamplerQuality quality) {
+        resamplerQuality = quality;
+    }
+    
+    // Maps a bank written by plaits/resources/wavetable_bank.py. The wavetable engine plays it
+    // from the next render call on, or the waves of the module again if path is NULL. Must not
+    // be called from the render thread.
+    bool loadWavetableBank(const char* path) {
+        return wavetableBank.Load(path);
+    }
+    
+    // Render thread.
+    void applyWavetableBank() {
+        const stmlib::SampleBank* bank = wavetableBank.bank();
+        const int16_t* waves = nullptr;
+        size_t size = 0;
+        size_t stride = 0;
+        if (bank && bank->is_open()) {
+            waves = bank->section<int16_t>(stmlib::SampleBankTag('W', 'A', 'V', 'S'), &size, &stride);
+        }
+        // Waves of 256 samples, followed by 4 for the interpolation.
+        if (!waves || stride != 260 || size < stride) {
+            waves = nullptr;
+            stride = 260;
+            size = 0;
+        }
+        for (VoiceState& state : voices) {
+            state.voice->set_wavetable(waves, size / stride);
         }
-        outputSrc = new Converter(48000, (int) inSampleRate);
     }
     
     void setupModulationRules() {
@@ -515,17 +673,26 @@ public:
         modulationEngineRules.rules[1].input1 = ModInLFO;
         modulationEngineRules.rules[2].input1 = ModInEnvelope;
         modulationEngineRules.rules[3].input1 = ModInEnvelope;
+        modulationProgram.invalidate();
     }
     
     void reset() {
         for (VoiceState& state : voices) {
             state.midiAllNotesOff();
+            state.asleep = false;
+            state.silentFrames = 0;
         }
+        scheduledEventsHead = 0;
+        numScheduledEvents = 0;
     }
     
     void setParameter(AUParameterAddress address, AUValue value) {
+        // Any parameter may make a sleeping voice audible again.
+        parameterRevision.fetch_add(1, std::memory_order_relaxed);
+        
         if (address >= PlaitsParamModMatrixStart && address <= PlaitsParamModMatrixEnd) {
             modulationEngineRules.setParameter(address - PlaitsParamModMatrixStart, value);
+            modulationProgram.invalidate();
             
             return;
         }
@@ -842,7 +1009,14 @@ public:
     
     void startRamp(AUParameterAddress address, AUValue value, AUAudioFrameCount duration) override {
         // The attack and release parameters are not ramped.
-        setParameter(address, value);
+        ScheduledEvent *event = scheduleEvent();
+        if (!event) {
+            setParameter(address, value);
+            return;
+        }
+        event->isMIDI = false;
+        event->address = address;
+        event->value = value;
     }
     
     void setBuffers(AudioBufferList* outBufferList) {
@@ -850,7 +1024,75 @@ public:
     }
     
     virtual void handleMIDIEvent(AUMIDIEvent const& midiEvent) override {
-        midiProcessor.handleMIDIEvent(midiEvent);
+        ScheduledEvent *event = scheduleEvent();
+        if (!event) {
+            midiProcessor.handleMIDIEvent(midiEvent);
+            return;
+        }
+        event->isMIDI = true;
+        event->midi = midiEvent;
+    }
+    
+    // MARK: Event scheduling
+    
+    // Render thread. The events of the render block reach the kernel between two calls to
+    // process(), at the host frame where they happen. They are stamped with the internal frame
+    // which the resampler has reached there, one block later: that frame has not been rendered
+    // yet, whatever the position in the current block. Returns nullptr when the event must be
+    // applied at once. When the queue is full, the events in it are applied first, early but in
+    // order, so that a note-off never reaches a voice before its note-on.
+    ScheduledEvent *scheduleEvent() {
+        if (!sampleAccurateEvents) {
+            return nullptr;
+        }
+        if (numScheduledEvents == kMaxScheduledEvents) {
+            applyEventsDue(INT64_MAX);
+            return nullptr;
+        }
+        ScheduledEvent *event = &scheduledEvents[(scheduledEventsHead + numScheduledEvents) % kMaxScheduledEvents];
+        numScheduledEvents++;
+        int64_t consumedFrames = renderedFrames - (renderedCount - renderedFramesPos);
+        event->time = consumedFrames + kAudioBlockSize;
+        return event;
+    }
+    
+    // Render thread, before a block. Applies the events due at its start, and returns its length:
+    // up to the next event or delayed trigger, so that it starts the following block.
+    int applyScheduledEvents() {
+        applyEventsDue(renderedFrames);
+        
+        int blockSize = kAudioBlockSize;
+        if (numScheduledEvents > 0) {
+            int64_t nextEvent = scheduledEvents[scheduledEventsHead].time - renderedFrames;
+            if (nextEvent < blockSize) {
+                blockSize = (int) nextEvent;
+                performanceCounters.countSplitBlock();
+            }
+        }
+        // The delayed triggers also start a block, so that the onset of a note does not depend
+        // on how the blocks before it were split. With blocks of kAudioBlockSize frames, they
+        // always fall at the start of one.
+        for (int i = 0; i < midiProcessor.noteStack.getActivePolyphony(); i++) {
+            int frames = voices[i].state != NoteStateUnused ? voices[i].pendingTriggerFrames() : 0;
+            if (frames > 0 && frames < blockSize) {
+                blockSize = frames;
+            }
+        }
+        return blockSize;
+    }
+    
+    // Render thread. Applies the queued events stamped at frame or before, in order.
+    void applyEventsDue(int64_t frame) {
+        while (numScheduledEvents > 0 && scheduledEvents[scheduledEventsHead].time <= frame) {
+            const ScheduledEvent& event = scheduledEvents[scheduledEventsHead];
+            if (event.isMIDI) {
+                midiProcessor.handleMIDIEvent(event.midi);
+            } else {
+                setParameter(event.address, event.value);
+            }
+            scheduledEventsHead = (scheduledEventsHead + 1) % kMaxScheduledEvents;
+            numScheduledEvents--;
+        }
     }
     
     void setTransportState(KernelTransportState state) {
@@ -861,45 +1103,108 @@ public:
     }
     
     void process(AUAudioFrameCount frameCount, AUAudioFrameCount bufferOffset) override {
+        performanceCounters.beginProcess(frameCount, bufferOffset);
+        
         float* outL = (float*)outBufferListPtr->mBuffers[0].mData + bufferOffset;
         float* outR = (float*)outBufferListPtr->mBuffers[1].mData + bufferOffset;
         
+        if (wavetableBank.Acquire()) {
+            applyWavetableBank();
+        }
+        
         int playingNotes = 0;
+        bool parallel = renderPool.size() > 0 && frameCount >= kMinParallelRenderFrames;
         
         while (frameCount > 0) {
             
-            if (renderedFramesPos == kAudioBlockSize) {
-                memset(renderedL, 0, sizeof(float) * kAudioBlockSize);
-                memset(renderedR, 0, sizeof(float) * kAudioBlockSize);
+            if (renderedFramesPos == renderedCount) {
+                int blockSize = applyScheduledEvents();
+                renderedCount = blockSize;
+                
+                memset(renderedL, 0, sizeof(float) * blockSize);
+                memset(renderedR, 0, sizeof(float) * blockSize);
 
+                int numVoices = 0;
                 for (int i = 0; i < midiProcessor.noteStack.getActivePolyphony(); i++) {
                     if (voices[i].state != NoteStateUnused) {
-                        playingNotes++;
-                        
-                        voices[i].run(kAudioBlockSize, renderedL, renderedR);
+                        renderQueue[numVoices++] = i;
+                    }
+                }
+                
+                modulationProgram.update(modulationEngineRules);
+                for (int j = 0; j < numVoices; j++) {
+                    voices[renderQueue[j]].beginModulations(blockSize);
+                }
+                modulationProgram.run(renderQueue, numVoices);
+                for (int j = 0; j < numVoices; j++) {
+                    voices[renderQueue[j]].applyModulations();
+                }
+                
+                // Only the voices which are awake are rendered, in the same order.
+                int numPlaying = 0;
+                for (int j = 0; j < numVoices; j++) {
+                    if (!voices[renderQueue[j]].asleep) {
+                        renderQueue[numPlaying++] = renderQueue[j];
+                    }
+                }
+                performanceCounters.countSleepingVoices(numVoices - numPlaying);
+                playingNotes += numPlaying;
+                
+                if (parallel && numPlaying > 1) {
+                    renderPool.run(&PlaitsDSPKernel::renderVoiceJob, this, numPlaying);
+                    
+                    // Summed in voice order, so that the mix is the same as the serial one, bit for bit.
+                    for (int j = 0; j < numPlaying; j++) {
+                        VoiceState& voice = voices[renderQueue[j]];
+                        for (int i = 0; i < blockSize; i++) {
+                            renderedL[i] += voice.scratchL[i];
+                            renderedR[i] += voice.scratchR[i];
+                        }
+                    }
+                } else {
+                    for (int j = 0; j < numPlaying; j++) {
+                        voices[renderQueue[j]].run(blockSize, renderedL, renderedR);
                     }
                 }
                 
                 if (playingNotes > 0) {
-                    for (int i = 0; i < kAudioBlockSize; i++) {
+                    for (int i = 0; i < blockSize; i++) {
                         renderedL[i] *= gainCoefficient * volume;
                         renderedR[i] *= gainCoefficient * volume;
                     }
                 }
                 
+                performanceCounters.countDenormals(renderedL, blockSize);
+                performanceCounters.countDenormals(renderedR, blockSize);
+                performanceCounters.setActiveVoices(numPlaying);
+                renderedFrames += blockSize;
                 renderedFramesPos = 0;
             }
             
-            ConverterResult result;
+            stmlib::ResamplerResult result;
             
-            outputSrc->convert(renderedL + renderedFramesPos, renderedR + renderedFramesPos, kAudioBlockSize - renderedFramesPos, outL, outR, frameCount, &result);
+            performanceCounters.beginResampler();
+            outputSrc.Process(renderedL + renderedFramesPos, renderedR + renderedFramesPos, renderedCount - renderedFramesPos, outL, outR, frameCount, &result);
+            performanceCounters.endResampler();
             
-            outL += result.outputLength;
-            outR += result.outputLength;
+            outL += result.output_length;
+            outR += result.output_length;
             
-            renderedFramesPos += result.inputConsumed;
-            frameCount -= result.outputLength;
+            renderedFramesPos += (int) result.input_consumed;
+            frameCount -= (int) result.output_length;
         }
+        
+        performanceCounters.endProcess();
+    }
+    
+    // Runs on the render thread or on a worker of the render pool. A voice only reads the kernel
+    // state, which is not modified while the voices are rendered.
+    static void renderVoiceJob(void *context, int job) {
+        PlaitsDSPKernel *kernel = (PlaitsDSPKernel *) context;
+        VoiceState& voice = kernel->voices[kernel->renderQueue[job]];
+        memset(voice.scratchL, 0, sizeof(float) * kernel->renderedCount);
+        memset(voice.scratchR, 0, sizeof(float) * kernel->renderedCount);
+        voice.run(kernel->renderedCount, voice.scratchL, voice.scratchR);
     }
     
     float randomSignedFloat(float max) {
@@ -934,26 +1239,53 @@ public:
     // MARK: Member Variables
     
 private:
+    plaits::EngineArena engineArena;
     std::vector<VoiceState> voices;
     
     AudioBufferList* outBufferListPtr = nullptr;
     
+    VoiceRenderPool renderPool;
+    int renderQueue[kMaxPolyphony];
+    
+    stmlib::SampleBankLoader wavetableBank;
+    
+    PerformanceCounters performanceCounters;
+    
+    // MIDI and parameter events of the render block, waiting for the internal frame where they
+    // take effect. A queue in a fixed array, filled and emptied on the render thread.
+    static const int kMaxScheduledEvents = 256;
+    ScheduledEvent scheduledEvents[kMaxScheduledEvents];
+    int scheduledEventsHead = 0;
+    int numScheduledEvents = 0;
+    bool sampleAccurateEvents = true;
+    
+    bool voiceSleep = true;
+    // Incremented by each parameter change, from any thread.
+    std::atomic<uint32_t> parameterRevision {0};
+    
+    // Internal frames rendered since the kernel was created.
+    int64_t renderedFrames = 0;
+    
 public:
     MIDIProcessor midiProcessor;
 
     ModulationEngineRuleList modulationEngineRules;
+    PlaitsModulationProgram modulationProgram;
     
     plaits::Modulations modulations;
     plaits::Patch patch;
     KernelTransportState transportState;
     
-    Converter *outputSrc = 0;
+    stmlib::ResamplerQuality resamplerQuality = stmlib::RESAMPLER_QUALITY_REALTIME;
+    stmlib::PolyphaseResampler outputSrc;
     float renderedL[kAudioBlockSize] = {};
     float renderedR[kAudioBlockSize] = {};
+    // Length of the last block, of which the resampler has consumed renderedFramesPos frames.
+    int renderedCount = kAudioBlockSize;
     int renderedFramesPos = 0;
     
-    uint16_t envParameters[4];
-    uint16_t ampEnvParameters[4];
+    uint16_t envParameters[4] = {};
+    uint16_t ampEnvParameters[4] = {};
     
     bool lastPanSpreadWasNegative = 0;
     
@@ -12,6 +12,16 @@
 - (void) saveDefaults;
 - (void) loadFromDefaults;
 
+// Wavetable bank written by plaits/resources/wavetable_bank.py, or nil for the waves of the
+// module. Returns NO if the file is not a bank.
+- (BOOL) loadWavetableBank:(NSString *)path;
+
+// Render statistics of the kernel since the last reset, keyed by the fields of
+// PerformanceSnapshot. Never blocks the render thread; must only be polled from one thread, such
+// as the display link of the view controller.
+- (NSDictionary<NSString *, NSNumber *> *) performanceCounters;
+- (void) resetPerformanceCounters;
+
 @end
 
 #endif /* InstrumentDemo_h */
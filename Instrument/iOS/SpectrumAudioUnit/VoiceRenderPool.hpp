@@ -0,0 +1,211 @@
+//
+//  VoiceRenderPool.hpp
+//  Instrument
+//
+//  Pool of pre-spawned threads rendering independent voices in parallel with the render thread.
+//
+
+#ifndef VoiceRenderPool_h
+#define VoiceRenderPool_h
+
+#import <algorithm>
+#import <atomic>
+#import <thread>
+#import <pthread.h>
+
+#ifdef __APPLE__
+#import <mach/mach.h>
+#else
+#import <semaphore.h>
+#endif
+
+/*
+ VoiceRenderPool
+ The render thread publishes a batch of jobs, takes its share of them, then spins until the
+ workers are done. Nothing on that path allocates or takes a lock: workers that are already
+ spinning pick the batch up from an atomic generation counter, and only workers that went to
+ sleep are woken, through a semaphore signal.
+ */
+class VoiceRenderPool {
+public:
+    typedef void (*JobFunction)(void *context, int job);
+
+    static const int kMaxWorkers = 7;
+
+    VoiceRenderPool() {
+        numWorkers = 0;
+        running = false;
+        batch = 0;
+        jobsDone = 0;
+        jobFunction = nullptr;
+        jobContext = nullptr;
+    }
+
+    ~VoiceRenderPool() {
+        stop();
+    }
+
+    // Leaves one core to the render thread and one to the rest of the system. On machines with
+    // fewer than four cores, no worker is started and run() renders everything serially.
+    static int recommendedWorkerCount() {
+        int cores = (int) std::thread::hardware_concurrency();
+        return std::min(std::max(cores - 2, 0), (int) kMaxWorkers);
+    }
+
+    // Must not be called from the render thread.
+    void start(int count) {
+        stop();
+        numWorkers = std::min(std::max(count, 0), (int) kMaxWorkers);
+        if (numWorkers == 0) {
+            return;
+        }
+        running = true;
+        for (int i = 0; i < numWorkers; i++) {
+            workers[i].sleeping = false;
+            workers[i].create();
+            workers[i].thread = std::thread([this, i] { workerLoop(workers[i]); });
+        }
+    }
+
+    // Must not be called from the render thread.
+    void stop() {
+        if (numWorkers == 0) {
+            return;
+        }
+        running = false;
+        for (int i = 0; i < numWorkers; i++) {
+            workers[i].signal();
+        }
+        for (int i = 0; i < numWorkers; i++) {
+            workers[i].thread.join();
+            workers[i].destroy();
+        }
+        numWorkers = 0;
+    }
+
+    int size() const {
+        return numWorkers;
+    }
+
+    // Calls function(context, job) for every job in [0, count), and returns once they have all
+    // completed. Jobs are claimed in no particular order and must not depend on each other.
+    void run(JobFunction function, void *context, int count) {
+        if (numWorkers == 0 || count < 2) {
+            for (int job = 0; job < count; job++) {
+                function(context, job);
+            }
+            return;
+        }
+
+        // The previous batch is complete, so no worker reads the job description any more.
+        jobFunction = function;
+        jobContext = context;
+        jobsDone.store(0, std::memory_order_relaxed);
+        uint64_t generation = (batch.load(std::memory_order_relaxed) >> 32) + 1;
+        batch.store((generation << 32) | ((uint64_t) count << 16), std::memory_order_seq_cst);
+
+        for (int i = 0; i < numWorkers; i++) {
+            if (workers[i].sleeping.exchange(false, std::memory_order_seq_cst)) {
+                workers[i].signal();
+            }
+        }
+
+        runJobs(generation);
+
+        while (jobsDone.load(std::memory_order_acquire) != count) {
+            pause();
+        }
+    }
+
+private:
+    struct Worker {
+        std::thread thread;
+        std::atomic<bool> sleeping;
+#ifdef __APPLE__
+        semaphore_t semaphore;
+
+        void create() { semaphore_create(mach_task_self(), &semaphore, SYNC_POLICY_FIFO, 0); }
+        void destroy() { semaphore_destroy(mach_task_self(), semaphore); }
+        void signal() { semaphore_signal(semaphore); }
+        void wait() { semaphore_wait(semaphore); }
+#else
+        sem_t semaphore;
+
+        void create() { sem_init(&semaphore, 0, 0); }
+        void destroy() { sem_destroy(&semaphore); }
+        void signal() { sem_post(&semaphore); }
+        void wait() { while (sem_wait(&semaphore) != 0) { } }
+#endif
+    };
+
+    // About 50us of spinning before a worker goes back to sleep: long enough to catch the next
+    // 24-sample block while notes are playing, short enough not to burn a core when idle.
+    static const int kSpinIterations = 20000;
+
+    static inline void pause() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+#endif
+    }
+
+    // The batch word packs the generation (bits 32-63), the job count (bits 16-31) and the next
+    // job to claim (bits 0-15). A worker waking up late can only claim jobs from the generation
+    // it was woken for, never a job of the following batch with a stale job description.
+    void runJobs(uint64_t generation) {
+        uint64_t current = batch.load(std::memory_order_acquire);
+        while ((current >> 32) == generation) {
+            int count = (int) ((current >> 16) & 0xffff);
+            int job = (int) (current & 0xffff);
+            if (job >= count) {
+                break;
+            }
+            if (batch.compare_exchange_weak(current, current + 1, std::memory_order_acq_rel)) {
+                jobFunction(jobContext, job);
+                jobsDone.fetch_add(1, std::memory_order_release);
+                current = batch.load(std::memory_order_acquire);
+            }
+        }
+    }
+
+    void workerLoop(Worker &worker) {
+#ifdef __APPLE__
+        pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0);
+#endif
+        uint64_t seen = batch.load(std::memory_order_acquire) >> 32;
+        while (running) {
+            int spin = 0;
+            while ((batch.load(std::memory_order_acquire) >> 32) == seen && running) {
+                if (++spin < kSpinIterations) {
+                    pause();
+                    continue;
+                }
+                // Publish the intent to sleep before checking one last time, so that a batch
+                // published in between either is seen here or triggers a signal.
+                worker.sleeping.store(true, std::memory_order_seq_cst);
+                if ((batch.load(std::memory_order_seq_cst) >> 32) == seen && running) {
+                    worker.wait();
+                }
+                worker.sleeping.store(false, std::memory_order_relaxed);
+                spin = 0;
+            }
+            if (!running) {
+                break;
+            }
+            seen = batch.load(std::memory_order_acquire) >> 32;
+            runJobs(seen);
+        }
+    }
+
+    Worker workers[kMaxWorkers];
+    int numWorkers;
+    std::atomic<bool> running;
+
+    std::atomic<uint64_t> batch;
+    std::atomic<int> jobsDone;
+    JobFunction jobFunction;
+    void *jobContext;
+};
+
+#endif /* VoiceRenderPool_h */
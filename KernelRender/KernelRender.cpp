@@ -0,0 +1,499 @@
+//
+//  KernelRender.cpp
+//  KernelRender
+//
+//  Command line front end: parses the options and the timeline, renders a kernel, writes the
+//  result to a WAV file and reports the time spent per host block.
+//
+
+#include "KernelRender.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#ifndef KERNEL_RENDER_TIMELINES_DIR
+#define KERNEL_RENDER_TIMELINES_DIR "Timelines"
+#endif
+
+typedef void (*RenderFunction)(const RenderOptions& options, RenderResult *result);
+
+struct KernelEntry {
+    const char *name;
+    RenderFunction render;
+};
+
+static const KernelEntry kernels[] = {
+    { "plaits", &renderPlaits },
+    { "rings", &renderRings },
+    { "elements", &renderElements },
+    { "clouds", &renderClouds },
+    { "orgone", &renderOrgone },
+};
+
+static const int kNumKernels = sizeof(kernels) / sizeof(kernels[0]);
+
+// MARK: Input
+
+void generateInput(InputSignal signal, double sampleRate, int64_t position, float *left, float *right, int frames) {
+    switch (signal) {
+        case InputNoise: {
+            // Reseeded from the position, so the input does not depend on the block size.
+            for (int i = 0; i < frames; i++) {
+                uint32_t x = (uint32_t) (position + i) * 2654435761u;
+                x ^= x >> 15;
+                x *= 2246822519u;
+                x ^= x >> 13;
+                left[i] = right[i] = ((float) (x >> 8) / 8388608.0f - 1.0f) * 0.5f;
+            }
+            break;
+        }
+
+        case InputSaw: {
+            // A fifth on A2, retriggered every second.
+            for (int i = 0; i < frames; i++) {
+                double t = (double) (position + i) / sampleRate;
+                double envelope = std::exp(-2.0 * std::fmod(t, 1.0));
+                double a = std::fmod(t * 110.0, 1.0) * 2.0 - 1.0;
+                double e = std::fmod(t * 165.0, 1.0) * 2.0 - 1.0;
+                left[i] = (float) (0.25 * envelope * a);
+                right[i] = (float) (0.25 * envelope * e);
+            }
+            break;
+        }
+
+        default:
+            std::fill(left, left + frames, 0.0f);
+            std::fill(right, right + frames, 0.0f);
+            break;
+    }
+}
+
+int64_t renderLength(const RenderOptions& options) {
+    double duration = options.duration;
+    if (duration <= 0.0) {
+        duration = options.timeline.empty() ? 0.0 : options.timeline.back().time;
+        duration += options.tail;
+    }
+    return (int64_t) std::ceil(duration * options.sampleRate);
+}
+
+// MARK: Timeline
+
+/*
+ One event per line, times in seconds. Lines are sorted by time, events sharing a time keep
+ the order of the file.
+   0.0   param <address> <value>
+   0.5   note_on <note> <velocity> [channel]
+   1.0   note_off <note> [channel]
+   1.0   cc <controller> <value> [channel]
+   1.5   bend <value, 0-16383> [channel]
+   2.0   aftertouch <value> [channel]
+ Anything after a # is ignored.
+ */
+static bool loadTimeline(const std::string& path, std::vector<TimelineEvent>& timeline, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+
+        std::istringstream fields(line);
+        TimelineEvent event;
+        memset(&event, 0, sizeof(event));
+        std::string type;
+        if (!(fields >> event.time)) {
+            continue;
+        }
+        if (!(fields >> type)) {
+            error = path + ":" + std::to_string(lineNumber) + ": missing event type";
+            return false;
+        }
+
+        bool ok = true;
+        if (type == "param") {
+            double address, value;
+            ok = (bool) (fields >> address >> value);
+            event.type = TimelineEvent::Parameter;
+            event.address = (AUParameterAddress) address;
+            event.value = (AUValue) value;
+        } else {
+            int a = 0, b = 0, channel = 0;
+            event.type = TimelineEvent::MIDI;
+            event.length = 3;
+            if (type == "note_on") {
+                ok = (bool) (fields >> a >> b);
+                fields >> channel;
+                event.data[0] = 0x90;
+            } else if (type == "note_off") {
+                ok = (bool) (fields >> a);
+                fields >> channel;
+                event.data[0] = 0x80;
+            } else if (type == "cc") {
+                ok = (bool) (fields >> a >> b);
+                fields >> channel;
+                event.data[0] = 0xb0;
+            } else if (type == "bend") {
+                int value = 0;
+                ok = (bool) (fields >> value);
+                fields >> channel;
+                event.data[0] = 0xe0;
+                a = value & 0x7f;
+                b = (value >> 7) & 0x7f;
+            } else if (type == "aftertouch") {
+                ok = (bool) (fields >> a);
+                fields >> channel;
+                event.data[0] = 0xd0;
+                event.length = 2;
+            } else {
+                error = path + ":" + std::to_string(lineNumber) + ": unknown event type " + type;
+                return false;
+            }
+            event.data[0] |= (uint8_t) (channel & 0x0f);
+            event.data[1] = (uint8_t) (a & 0x7f);
+            event.data[2] = (uint8_t) (b & 0x7f);
+        }
+
+        if (!ok || event.time < 0.0) {
+            error = path + ":" + std::to_string(lineNumber) + ": malformed " + type + " event";
+            return false;
+        }
+        timeline.push_back(event);
+    }
+
+    std::stable_sort(timeline.begin(), timeline.end(), [](const TimelineEvent& a, const TimelineEvent& b) {
+        return a.time < b.time;
+    });
+    return true;
+}
+
+// MARK: WAV files
+
+static void writeUInt32(FILE *file, uint32_t value) {
+    uint8_t bytes[4] = { (uint8_t) value, (uint8_t) (value >> 8), (uint8_t) (value >> 16), (uint8_t) (value >> 24) };
+    fwrite(bytes, 1, 4, file);
+}
+
+static void writeUInt16(FILE *file, uint16_t value) {
+    uint8_t bytes[2] = { (uint8_t) value, (uint8_t) (value >> 8) };
+    fwrite(bytes, 1, 2, file);
+}
+
+// 32-bit float, stereo, interleaved.
+static bool writeWav(const std::string& path, const RenderResult& result, double sampleRate) {
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    uint32_t frames = (uint32_t) result.left.size();
+    uint32_t dataSize = frames * 2 * sizeof(float);
+
+    fwrite("RIFF", 1, 4, file);
+    writeUInt32(file, 4 + 8 + 16 + 8 + dataSize);
+    fwrite("WAVE", 1, 4, file);
+
+    fwrite("fmt ", 1, 4, file);
+    writeUInt32(file, 16);
+    writeUInt16(file, 3); // WAVE_FORMAT_IEEE_FLOAT
+    writeUInt16(file, 2);
+    writeUInt32(file, (uint32_t) sampleRate);
+    writeUInt32(file, (uint32_t) sampleRate * 2 * sizeof(float));
+    writeUInt16(file, 2 * sizeof(float));
+    writeUInt16(file, 32);
+
+    fwrite("data", 1, 4, file);
+    writeUInt32(file, dataSize);
+    for (uint32_t i = 0; i < frames; i++) {
+        float frame[2] = { result.left[i], result.right[i] };
+        uint32_t words[2];
+        memcpy(words, frame, sizeof(words));
+        writeUInt32(file, words[0]);
+        writeUInt32(file, words[1]);
+    }
+
+    bool ok = !ferror(file);
+    fclose(file);
+    return ok;
+}
+
+static uint32_t readUInt32(const uint8_t *bytes) {
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t) bytes[3] << 24);
+}
+
+// Reads back a file written by writeWav.
+static bool readWav(const std::string& path, std::vector<float>& left, std::vector<float>& right) {
+    std::ifstream file(path, std::ios::binary);
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (bytes.size() < 12 || memcmp(&bytes[0], "RIFF", 4) || memcmp(&bytes[8], "WAVE", 4)) {
+        return false;
+    }
+
+    bool isFloatStereo = false;
+    size_t offset = 12;
+    while (offset + 8 <= bytes.size()) {
+        uint32_t size = readUInt32(&bytes[offset + 4]);
+        const uint8_t *chunk = &bytes[offset + 8];
+        if (offset + 8 + size > bytes.size()) {
+            return false;
+        }
+        if (!memcmp(&bytes[offset], "fmt ", 4) && size >= 16) {
+            isFloatStereo = chunk[0] == 3 && chunk[2] == 2 && chunk[14] == 32;
+        } else if (!memcmp(&bytes[offset], "data", 4)) {
+            if (!isFloatStereo) {
+                return false;
+            }
+            for (uint32_t i = 0; i + 8 <= size; i += 8) {
+                uint32_t words[2] = { readUInt32(chunk + i), readUInt32(chunk + i + 4) };
+                float frame[2];
+                memcpy(frame, words, sizeof(frame));
+                left.push_back(frame[0]);
+                right.push_back(frame[1]);
+            }
+            return true;
+        }
+        offset += 8 + size + (size & 1);
+    }
+    return false;
+}
+
+// MARK: Report
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t index = (size_t) std::ceil(p * sorted.size()) - 1;
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+static void report(const RenderOptions& options, const RenderResult& result) {
+    std::vector<double> sorted(result.blockTimes);
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0.0;
+    for (double t : sorted) {
+        total += t;
+    }
+    double audioDuration = result.left.size() / options.sampleRate;
+    double realTimeFactor = audioDuration > 0.0 ? total / audioDuration : 0.0;
+    double p50 = percentile(sorted, 0.5);
+    double p99 = percentile(sorted, 0.99);
+    double max = sorted.empty() ? 0.0 : sorted.back();
+
+    // As counted by the kernel itself.
+    const PerformanceSnapshot& performance = result.performance;
+    double processSeconds = performance.dspSeconds + performance.resamplerSeconds;
+    double resamplerShare = processSeconds > 0.0 ? performance.resamplerSeconds / processSeconds : 0.0;
+
+    if (options.csv) {
+        printf("kernel,sample_rate,block_size,blocks,p50_us,p99_us,max_us,real_time_factor,resampler_share,denormals,max_voices,split_blocks,sleeping_voice_blocks\n");
+        printf("%s,%.0f,%d,%zu,%.3f,%.3f,%.3f,%.6f,%.4f,%llu,%d,%llu,%llu\n",
+               options.kernel.c_str(), options.sampleRate, options.blockSize, sorted.size(),
+               p50 * 1e6, p99 * 1e6, max * 1e6, realTimeFactor,
+               resamplerShare, (unsigned long long) performance.denormals, performance.maxActiveVoices,
+               (unsigned long long) performance.splitBlocks,
+               (unsigned long long) performance.sleepingVoiceBlocks);
+        return;
+    }
+
+    double budget = options.blockSize / options.sampleRate;
+    printf("kernel:           %s\n", options.kernel.c_str());
+    printf("rendered:         %.2f s at %.0f Hz, %zu blocks of %d frames\n",
+           audioDuration, options.sampleRate, sorted.size(), options.blockSize);
+    printf("block time p50:   %8.1f us (%5.1f%% of the block)\n", p50 * 1e6, 100.0 * p50 / budget);
+    printf("block time p99:   %8.1f us (%5.1f%% of the block)\n", p99 * 1e6, 100.0 * p99 / budget);
+    printf("block time max:   %8.1f us (%5.1f%% of the block)\n", max * 1e6, 100.0 * max / budget);
+    printf("real-time factor: %.4f (%.1fx faster than real time)\n",
+           realTimeFactor, realTimeFactor > 0.0 ? 1.0 / realTimeFactor : 0.0);
+    printf("kernel load p99:  %5.1f%% (max %.1f%%, %llu overloads)\n",
+           100.0 * performance.p99Load, 100.0 * performance.maxLoad, (unsigned long long) performance.overloads);
+    printf("resampler time:   %5.1f%% of process()\n", 100.0 * resamplerShare);
+    printf("denormals:        %llu samples\n", (unsigned long long) performance.denormals);
+    printf("voices:           %d at most\n", performance.maxActiveVoices);
+    if (performance.splitBlocks > 0) {
+        printf("split blocks:     %llu\n", (unsigned long long) performance.splitBlocks);
+    }
+    if (performance.sleepingVoiceBlocks > 0) {
+        printf("sleeping voices:  %llu blocks\n", (unsigned long long) performance.sleepingVoiceBlocks);
+    }
+}
+
+// Compares the rendering with a reference file. Returns false when they differ by more than
+// the tolerance.
+static bool compare(const RenderOptions& options, const RenderResult& result) {
+    std::vector<float> left, right;
+    if (!readWav(options.referencePath, left, right)) {
+        fprintf(stderr, "cannot read reference %s\n", options.referencePath.c_str());
+        return false;
+    }
+    if (left.size() != result.left.size()) {
+        printf("reference:        length differs (%zu frames, rendered %zu)\n", left.size(), result.left.size());
+        return false;
+    }
+    double maxDifference = 0.0;
+    double sumSquares = 0.0;
+    for (size_t i = 0; i < left.size(); i++) {
+        double l = std::fabs((double) left[i] - result.left[i]);
+        double r = std::fabs((double) right[i] - result.right[i]);
+        maxDifference = std::max(maxDifference, std::max(l, r));
+        sumSquares += l * l + r * r;
+    }
+    double rms = left.empty() ? 0.0 : std::sqrt(sumSquares / (2.0 * left.size()));
+    bool pass = maxDifference <= options.tolerance;
+    printf("reference:        max difference %g, rms %g (%s)\n", maxDifference, rms, pass ? "pass" : "FAIL");
+    return pass;
+}
+
+// MARK: Main
+
+static void usage() {
+    fprintf(stderr,
+            "usage: kernel-render <plaits|rings|elements|clouds|orgone> [options]\n"
+            "  --timeline <file>      MIDI and parameter events (default: Timelines/<kernel>.timeline)\n"
+            "  --output <file.wav>    write the rendering as 32-bit float stereo\n"
+            "  --reference <file.wav> compare the rendering with a previous one\n"
+            "  --tolerance <value>    maximum sample difference accepted by --reference (default 0)\n"
+            "  --sample-rate <hz>     host sample rate (default 48000)\n"
+            "  --block-size <frames>  host buffer size (default 256)\n"
+            "  --duration <seconds>   render length (default: last event + tail)\n"
+            "  --tail <seconds>       rendered after the last event (default 2)\n"
+            "  --input <silence|noise|saw>  signal fed to the effect inputs\n"
+            "  --resampler <draft|realtime|offline>  quality of the host rate conversion (default realtime)\n"
+            "  --host-rate            run the DSP at the host sample rate (elements only)\n"
+            "  --governor             let the CPU governor drop modes under load (rings only)\n"
+            "  --bank <file>          wavetable bank (plaits) or exciter sample bank (elements)\n"
+            "  --recording-buffer <seconds>  length of the recording buffers (clouds only)\n"
+            "  --float-storage        record in floating point instead of 16-bit (clouds only)\n"
+            "  --quantized-events     apply the events at the next internal block (plaits only)\n"
+            "  --no-voice-sleep       render the silent voices until their envelope closes (plaits only)\n"
+            "  --fft-alignment        align the stretch windows on the samples, not their signs (clouds only)\n"
+            "  --oversampling <2|4|8> oversampling factor of the easter egg FM voice (elements only, default 8)\n"
+            "  --csv                  print the timings as CSV\n");
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        usage();
+        return 2;
+    }
+
+    RenderOptions options;
+    options.kernel = argv[1];
+    for (int i = 2; i < argc; i++) {
+        std::string option = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (option == "--csv") {
+            options.csv = true;
+        } else if (option == "--host-rate") {
+            options.renderAtHostRate = true;
+        } else if (option == "--governor") {
+            options.cpuGovernor = true;
+        } else if (option == "--float-storage") {
+            options.floatStorage = true;
+        } else if (option == "--quantized-events") {
+            options.quantizedEvents = true;
+        } else if (option == "--no-voice-sleep") {
+            options.voiceSleep = false;
+        } else if (option == "--fft-alignment") {
+            options.fftAlignment = true;
+        } else if (option == "--timeline" && hasValue) {
+            options.timelinePath = argv[++i];
+        } else if (option == "--output" && hasValue) {
+            options.outputPath = argv[++i];
+        } else if (option == "--reference" && hasValue) {
+            options.referencePath = argv[++i];
+        } else if (option == "--tolerance" && hasValue) {
+            options.tolerance = atof(argv[++i]);
+        } else if (option == "--sample-rate" && hasValue) {
+            options.sampleRate = atof(argv[++i]);
+        } else if (option == "--block-size" && hasValue) {
+            options.blockSize = atoi(argv[++i]);
+        } else if (option == "--duration" && hasValue) {
+            options.duration = atof(argv[++i]);
+        } else if (option == "--tail" && hasValue) {
+            options.tail = atof(argv[++i]);
+        } else if (option == "--bank" && hasValue) {
+            options.bankPath = argv[++i];
+        } else if (option == "--oversampling" && hasValue) {
+            std::string oversampling = argv[++i];
+            if (oversampling == "2" || oversampling == "4" || oversampling == "8") {
+                options.oversampling = atoi(oversampling.c_str());
+            } else {
+                usage();
+                return 2;
+            }
+        } else if (option == "--recording-buffer" && hasValue) {
+            options.recordingBuffer = atof(argv[++i]);
+        } else if (option == "--input" && hasValue) {
+            std::string input = argv[++i];
+            if (input == "silence") {
+                options.input = InputSilence;
+            } else if (input == "noise") {
+                options.input = InputNoise;
+            } else if (input == "saw") {
+                options.input = InputSaw;
+            } else {
+                usage();
+                return 2;
+            }
+        } else if (option == "--resampler" && hasValue) {
+            std::string quality = argv[++i];
+            if (quality == "draft") {
+                options.resamplerQuality = stmlib::RESAMPLER_QUALITY_DRAFT;
+            } else if (quality == "realtime") {
+                options.resamplerQuality = stmlib::RESAMPLER_QUALITY_REALTIME;
+            } else if (quality == "offline") {
+                options.resamplerQuality = stmlib::RESAMPLER_QUALITY_OFFLINE;
+            } else {
+                usage();
+                return 2;
+            }
+        } else {
+            usage();
+            return 2;
+        }
+    }
+
+    const KernelEntry *entry = nullptr;
+    for (int i = 0; i < kNumKernels; i++) {
+        if (options.kernel == kernels[i].name) {
+            entry = &kernels[i];
+        }
+    }
+    if (!entry || options.sampleRate <= 0.0 || options.blockSize <= 0) {
+        usage();
+        return 2;
+    }
+
+    if (options.timelinePath.empty()) {
+        options.timelinePath = std::string(KERNEL_RENDER_TIMELINES_DIR) + "/" + options.kernel + ".timeline";
+    }
+    std::string error;
+    if (!loadTimeline(options.timelinePath, options.timeline, error)) {
+        fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    RenderResult result;
+    entry->render(options, &result);
+
+    report(options, result);
+
+    if (!options.outputPath.empty() && !writeWav(options.outputPath, result, options.sampleRate)) {
+        fprintf(stderr, "cannot write %s\n", options.outputPath.c_str());
+        return 1;
+    }
+    if (!options.referencePath.empty() && !compare(options, result)) {
+        return 1;
+    }
+    return 0;
+}
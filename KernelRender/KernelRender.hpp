@@ -0,0 +1,199 @@
+//
+//  KernelRender.hpp
+//  KernelRender
+//
+//  Drives a DSP kernel outside of an AUv3 host: feeds it a scripted timeline of MIDI and
+//  parameter events through processWithEvents, the same entry point the render block uses,
+//  and times every call.
+//
+
+#ifndef KernelRender_h
+#define KernelRender_h
+
+#include <AudioToolbox/AudioToolbox.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "stmlib/dsp/polyphase_resampler.h"
+
+#include "PerformanceCounters.hpp"
+
+struct TimelineEvent {
+    enum Type {
+        Parameter,
+        MIDI
+    };
+
+    double time;
+    Type type;
+    AUParameterAddress address;
+    AUValue value;
+    uint8_t data[3];
+    uint16_t length;
+};
+
+enum InputSignal {
+    InputDefault,
+    InputSilence,
+    InputNoise,
+    InputSaw
+};
+
+struct RenderOptions {
+    std::string kernel;
+    std::string timelinePath;
+    std::string outputPath;
+    std::string referencePath;
+    double sampleRate = 48000.0;
+    int blockSize = 256;
+    double duration = 0.0;
+    double tail = 2.0;
+    InputSignal input = InputDefault;
+    stmlib::ResamplerQuality resamplerQuality = stmlib::RESAMPLER_QUALITY_REALTIME;
+    bool renderAtHostRate = false;
+    bool cpuGovernor = false;
+    std::string bankPath;
+    double recordingBuffer = 0.0;
+    bool floatStorage = false;
+    bool quantizedEvents = false;
+    bool voiceSleep = true;
+    bool fftAlignment = false;
+    int oversampling = 8;
+    double tolerance = 0.0;
+    bool csv = false;
+
+    std::vector<TimelineEvent> timeline;
+};
+
+struct RenderResult {
+    std::vector<float> left;
+    std::vector<float> right;
+
+    // Wall-clock time spent in processWithEvents, per host block, in seconds.
+    std::vector<double> blockTimes;
+
+    // Counters of the kernel at the end of the render. They do not include the last host block,
+    // which the kernel only accounts for when the next one starts.
+    PerformanceSnapshot performance = {};
+};
+
+// Kernel entry points, one per translation unit: the kernel headers all declare the same
+// global constants and enums, so they cannot be included together.
+void renderPlaits(const RenderOptions& options, RenderResult *result);
+void renderRings(const RenderOptions& options, RenderResult *result);
+void renderElements(const RenderOptions& options, RenderResult *result);
+void renderClouds(const RenderOptions& options, RenderResult *result);
+void renderOrgone(const RenderOptions& options, RenderResult *result);
+
+void generateInput(InputSignal signal, double sampleRate, int64_t position, float *left, float *right, int frames);
+
+// Number of frames to render: the requested duration, or the last event plus the tail.
+int64_t renderLength(const RenderOptions& options);
+
+// Layout-compatible with an AudioBufferList holding two buffers.
+struct StereoBufferList {
+    UInt32 mNumberBuffers;
+    AudioBuffer mBuffers[2];
+
+    void set(float *left, float *right, int frames) {
+        mNumberBuffers = 2;
+        mBuffers[0].mNumberChannels = 1;
+        mBuffers[0].mDataByteSize = (UInt32) (frames * sizeof(float));
+        mBuffers[0].mData = left;
+        mBuffers[1].mNumberChannels = 1;
+        mBuffers[1].mDataByteSize = (UInt32) (frames * sizeof(float));
+        mBuffers[1].mData = right;
+    }
+
+    AudioBufferList *list() {
+        return reinterpret_cast<AudioBufferList *>(this);
+    }
+};
+
+/*
+ renderKernel
+ The kernel must already be initialized at options.sampleRate. setBuffers(input, output) hands the
+ buffer lists to the kernel, which differs between instruments and effects.
+ */
+template<typename Kernel, typename SetBuffers>
+void renderKernel(Kernel& kernel, const RenderOptions& options, InputSignal input, SetBuffers setBuffers, RenderResult *result) {
+    const int64_t length = renderLength(options);
+    const int blockSize = options.blockSize;
+
+    std::vector<float> inL(blockSize), inR(blockSize), outL(blockSize), outR(blockSize);
+    StereoBufferList inBuffers, outBuffers;
+
+    // Events are built once and linked block by block, so that nothing is allocated while
+    // the kernel is being timed.
+    std::vector<AURenderEvent> events(options.timeline.size());
+    for (size_t i = 0; i < options.timeline.size(); i++) {
+        const TimelineEvent& source = options.timeline[i];
+        AURenderEvent& event = events[i];
+        memset(&event, 0, sizeof(AURenderEvent));
+        AUEventSampleTime sampleTime = (AUEventSampleTime) llround(source.time * options.sampleRate);
+        if (source.type == TimelineEvent::Parameter) {
+            event.parameter.eventSampleTime = sampleTime;
+            event.parameter.eventType = AURenderEventParameter;
+            event.parameter.parameterAddress = source.address;
+            event.parameter.value = source.value;
+        } else {
+            event.MIDI.eventSampleTime = sampleTime;
+            event.MIDI.eventType = AURenderEventMIDI;
+            event.MIDI.length = source.length;
+            memcpy(event.MIDI.data, source.data, sizeof(event.MIDI.data));
+        }
+    }
+
+    result->left.clear();
+    result->right.clear();
+    result->left.reserve(length);
+    result->right.reserve(length);
+    result->blockTimes.clear();
+    result->blockTimes.reserve(length / blockSize + 1);
+
+    size_t nextEvent = 0;
+    for (int64_t position = 0; position < length; position += blockSize) {
+        int frames = (int) std::min((int64_t) blockSize, length - position);
+
+        AURenderEvent *head = nullptr;
+        AURenderEvent *last = nullptr;
+        while (nextEvent < events.size() && events[nextEvent].head.eventSampleTime < position + frames) {
+            AURenderEvent *event = &events[nextEvent++];
+            event->head.next = nullptr;
+            if (last) {
+                last->head.next = event;
+            } else {
+                head = event;
+            }
+            last = event;
+        }
+
+        generateInput(input, options.sampleRate, position, inL.data(), inR.data(), frames);
+        std::fill(outL.begin(), outL.end(), 0.0f);
+        std::fill(outR.begin(), outR.end(), 0.0f);
+        inBuffers.set(inL.data(), inR.data(), frames);
+        outBuffers.set(outL.data(), outR.data(), frames);
+        setBuffers(inBuffers.list(), outBuffers.list());
+
+        AudioTimeStamp timestamp;
+        memset(&timestamp, 0, sizeof(timestamp));
+        timestamp.mSampleTime = (Float64) position;
+        timestamp.mFlags = kAudioTimeStampSampleTimeValid;
+
+        auto start = std::chrono::steady_clock::now();
+        kernel.processWithEvents(&timestamp, frames, head);
+        auto end = std::chrono::steady_clock::now();
+
+        result->blockTimes.push_back(std::chrono::duration<double>(end - start).count());
+        result->left.insert(result->left.end(), outL.begin(), outL.begin() + frames);
+        result->right.insert(result->right.end(), outR.begin(), outR.begin() + frames);
+    }
+}
+
+#endif /* KernelRender_h */
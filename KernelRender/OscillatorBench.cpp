@@ -0,0 +1,69 @@
+//
+//  OscillatorBench.cpp
+//  KernelRender
+//
+//  Micro-benchmark of the harmonic oscillators of the Plaits additive engine: renders 24, 48 and
+//  96 harmonics in batches of kHarmonicBatchSize, with their amplitudes moving at every block,
+//  and reports the time per harmonic and per sample.
+//
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "plaits/dsp/engine/additive_engine.h"
+
+static const int kBlockSize = 24;
+static const int kMaxBatches = 8;
+
+static double run(int numHarmonics, int numBlocks, float *checksum) {
+    static plaits::HarmonicOscillator<plaits::kHarmonicBatchSize> oscillators[kMaxBatches];
+    int numBatches = numHarmonics / plaits::kHarmonicBatchSize;
+    for (int i = 0; i < numBatches; i++) {
+        oscillators[i].Init();
+    }
+    std::vector<float> amplitudes(numHarmonics);
+    float out[kBlockSize];
+    float sum = 0.0f;
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    for (int block = 0; block < numBlocks; block++) {
+        // A slowly sweeping spectrum on a slowly gliding 110 Hz note.
+        float f0 = 110.0f / 48000.0f * (1.0f + 0.1f * (float) ((block >> 6) & 7));
+        for (int i = 0; i < numHarmonics; i++) {
+            amplitudes[i] = 1.0f / (float) (i + 1 + ((block + i) & 15));
+        }
+        for (int i = 0; i < numBatches; i++) {
+            oscillators[i].Render(
+                1 + i * plaits::kHarmonicBatchSize, f0, &amplitudes[i * plaits::kHarmonicBatchSize],
+                out, kBlockSize);
+        }
+        sum += out[kBlockSize - 1];
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    *checksum = sum;
+    return seconds * 1e9 / ((double) numBlocks * kBlockSize * numHarmonics);
+}
+
+int main(int argc, char **argv) {
+    double duration = argc > 1 ? atof(argv[1]) : 60.0;
+    if (duration <= 0.0) {
+        fprintf(stderr, "usage: oscillator-bench [seconds of audio at 48 kHz, default 60]\n");
+        return 2;
+    }
+    int numBlocks = (int) (duration * 48000.0 / kBlockSize);
+
+    printf("%.0f s of audio, %d-sample blocks, widest vector of the target: %d lanes\n",
+           duration, kBlockSize, (int) stmlib::kSimdWidth);
+    printf("%-10s %12s %12s\n", "harmonics", "ns/harm/smp", "checksum");
+    const int counts[] = { 24, 48, 96 };
+    for (int i = 0; i < 3; i++) {
+        float checksum;
+        double nanoseconds = run(counts[i], numBlocks, &checksum);
+        printf("%-10d %12.3f %12g\n", counts[i], nanoseconds, checksum);
+    }
+    return 0;
+}
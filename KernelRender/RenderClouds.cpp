@@ -0,0 +1,27 @@
+//
+//  RenderClouds.cpp
+//  KernelRender
+//
+
+#include "KernelRender.hpp"
+#include "CloudsDSPKernel.hpp"
+
+void renderClouds(const RenderOptions& options, RenderResult *result) {
+    std::unique_ptr<CloudsDSPKernel> kernel(new CloudsDSPKernel());
+    kernel->setResamplerQuality(options.resamplerQuality);
+    kernel->setRecordingBuffer(options.recordingBuffer, options.floatStorage);
+    kernel->init(2, options.sampleRate);
+    kernel->setFftAlignment(options.fftAlignment);
+    kernel->setupModulationRules();
+    // As in GranularAudioUnit: the phase vocoder transforms run on the kernel's worker thread.
+    kernel->setAsynchronousSpectral(true);
+
+    KernelTransportState transportState = {};
+    kernel->setTransportState(transportState);
+
+    InputSignal input = options.input == InputDefault ? InputSaw : options.input;
+    renderKernel(*kernel, options, input, [&](AudioBufferList *inBufferList, AudioBufferList *outBufferList) {
+        kernel->setBuffers(inBufferList, outBufferList);
+    }, result);
+    kernel->readPerformanceCounters(&result->performance);
+}
@@ -0,0 +1,29 @@
+//
+//  RenderElements.cpp
+//  KernelRender
+//
+
+#include "KernelRender.hpp"
+#include "ElementsDSPKernel.hpp"
+
+void renderElements(const RenderOptions& options, RenderResult *result) {
+    std::unique_ptr<ElementsDSPKernel> kernel(new ElementsDSPKernel());
+    kernel->setResamplerQuality(options.resamplerQuality);
+    kernel->setRenderAtHostRate(options.renderAtHostRate);
+    kernel->setOminousOversampling(options.oversampling);
+    kernel->init(2, options.sampleRate);
+    kernel->setupModulationRules();
+    if (!options.bankPath.empty() && !kernel->loadSampleBank(options.bankPath.c_str())) {
+        fprintf(stderr, "cannot load %s\n", options.bankPath.c_str());
+        exit(1);
+    }
+
+    KernelTransportState transportState = {};
+    kernel->setTransportState(transportState);
+
+    InputSignal input = options.input == InputDefault ? InputSilence : options.input;
+    renderKernel(*kernel, options, input, [&](AudioBufferList *inBufferList, AudioBufferList *outBufferList) {
+        kernel->setBuffers(inBufferList, outBufferList);
+    }, result);
+    kernel->readPerformanceCounters(&result->performance);
+}
@@ -0,0 +1,24 @@
+//
+//  RenderOrgone.cpp
+//  KernelRender
+//
+
+#include "KernelRender.hpp"
+#include "OrgoneDSPKernel.hpp"
+
+void renderOrgone(const RenderOptions& options, RenderResult *result) {
+    std::unique_ptr<OrgoneDSPKernel> kernel(new OrgoneDSPKernel());
+    kernel->setResamplerQuality(options.resamplerQuality);
+    kernel->init(2, options.sampleRate);
+    kernel->reset();
+    kernel->setupModulationRules();
+
+    KernelTransportState transportState = {};
+    kernel->setTransportState(transportState);
+
+    InputSignal input = options.input == InputDefault ? InputSilence : options.input;
+    renderKernel(*kernel, options, input, [&](AudioBufferList *inBufferList, AudioBufferList *outBufferList) {
+        kernel->setBuffers(outBufferList);
+    }, result);
+    kernel->readPerformanceCounters(&result->performance);
+}
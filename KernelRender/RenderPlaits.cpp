@@ -0,0 +1,30 @@
+//
+//  RenderPlaits.cpp
+//  KernelRender
+//
+
+#include "KernelRender.hpp"
+#include "PlaitsDSPKernel.hpp"
+
+void renderPlaits(const RenderOptions& options, RenderResult *result) {
+    std::unique_ptr<PlaitsDSPKernel> kernel(new PlaitsDSPKernel());
+    kernel->setResamplerQuality(options.resamplerQuality);
+    kernel->setSampleAccurateEvents(!options.quantizedEvents);
+    kernel->setVoiceSleep(options.voiceSleep);
+    kernel->init(2, options.sampleRate);
+    kernel->setupModulationRules();
+    kernel->reset();
+    if (!options.bankPath.empty() && !kernel->loadWavetableBank(options.bankPath.c_str())) {
+        fprintf(stderr, "cannot load %s\n", options.bankPath.c_str());
+        exit(1);
+    }
+
+    KernelTransportState transportState = {};
+    kernel->setTransportState(transportState);
+
+    InputSignal input = options.input == InputDefault ? InputSilence : options.input;
+    renderKernel(*kernel, options, input, [&](AudioBufferList *inBufferList, AudioBufferList *outBufferList) {
+        kernel->setBuffers(outBufferList);
+    }, result);
+    kernel->readPerformanceCounters(&result->performance);
+}
@@ -0,0 +1,24 @@
+//
+//  RenderRings.cpp
+//  KernelRender
+//
+
+#include "KernelRender.hpp"
+#include "RingsDSPKernel.hpp"
+
+void renderRings(const RenderOptions& options, RenderResult *result) {
+    std::unique_ptr<RingsDSPKernel> kernel(new RingsDSPKernel());
+    kernel->setResamplerQuality(options.resamplerQuality);
+    kernel->setCpuGovernor(options.cpuGovernor);
+    kernel->init(2, options.sampleRate);
+    kernel->setupModulationRules();
+
+    KernelTransportState transportState = {};
+    kernel->setTransportState(transportState);
+
+    InputSignal input = options.input == InputDefault ? InputSilence : options.input;
+    renderKernel(*kernel, options, input, [&](AudioBufferList *inBufferList, AudioBufferList *outBufferList) {
+        kernel->setBuffers(inBufferList, outBufferList);
+    }, result);
+    kernel->readPerformanceCounters(&result->performance);
+}
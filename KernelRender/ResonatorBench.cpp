@@ -0,0 +1,97 @@
+//
+//  ResonatorBench.cpp
+//  KernelRender
+//
+//  Micro-benchmark of the mode filters of the Plaits physical models: renders the same bank of
+//  modes one mode at a time, and in batches of 4 and 8 modes, with the scalar code and in vector
+//  lanes, and reports the time per mode and per sample.
+//
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "plaits/dsp/physical_modelling/resonator.h"
+
+static const int kNumModes = 48;
+static const int kBlockSize = 24;
+
+struct BenchResult {
+    double nanoseconds;
+    std::vector<float> output;
+};
+
+// Modes spread from 50 Hz to Nyquist at 48 kHz, excited by an impulse every 4096 samples. The
+// parameters are set again for each block, as Resonator::Process does.
+template<typename Filter, int batchSize>
+static BenchResult run(int numBlocks) {
+    Filter filters[kNumModes / batchSize];
+    for (int i = 0; i < kNumModes / batchSize; i++) {
+        filters[i].Init();
+    }
+    float f[kNumModes];
+    float q[kNumModes];
+    float gain[kNumModes];
+    for (int i = 0; i < kNumModes; i++) {
+        f[i] = std::min(50.0f / 48000.0f * (float) (i + 1) * (1.0f + 0.01f * i), 0.499f);
+        q[i] = 1.0f + f[i] * 2000.0f;
+        gain[i] = 0.25f * (1.0f - f[i] * 2.0f);
+    }
+
+    BenchResult result;
+    result.output.resize((size_t) numBlocks * kBlockSize);
+    float in[kBlockSize];
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    for (int block = 0; block < numBlocks; block++) {
+        for (int j = 0; j < kBlockSize; j++) {
+            in[j] = ((block * kBlockSize + j) & 4095) == 0 ? 1.0f : 0.0f;
+        }
+        float *out = &result.output[(size_t) block * kBlockSize];
+        for (int j = 0; j < kBlockSize; j++) {
+            out[j] = 0.0f;
+        }
+        for (int i = 0; i < kNumModes / batchSize; i++) {
+            filters[i].template Process<stmlib::FILTER_MODE_BAND_PASS, true>(
+                &f[i * batchSize], &q[i * batchSize], &gain[i * batchSize], in, out, kBlockSize);
+        }
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    result.nanoseconds = seconds * 1e9 / ((double) numBlocks * kBlockSize * kNumModes);
+    return result;
+}
+
+static float maxDifference(const BenchResult& a, const BenchResult& b) {
+    float difference = 0.0f;
+    for (size_t i = 0; i < a.output.size(); i++) {
+        difference = std::max(difference, std::fabs(a.output[i] - b.output[i]));
+    }
+    return difference;
+}
+
+int main(int argc, char **argv) {
+    double duration = argc > 1 ? atof(argv[1]) : 60.0;
+    if (duration <= 0.0) {
+        fprintf(stderr, "usage: resonator-bench [seconds of audio at 48 kHz, default 60]\n");
+        return 2;
+    }
+    int numBlocks = (int) (duration * 48000.0 / kBlockSize);
+
+    printf("%d modes, %.0f s of audio, widest vector of the target: %d lanes\n",
+           kNumModes, duration, (int) stmlib::kSimdWidth);
+    BenchResult single = run<plaits::ResonatorSvf<1>, 1>(numBlocks);
+    BenchResult scalar4 = run<plaits::ScalarResonatorSvf<4>, 4>(numBlocks);
+    BenchResult simd4 = run<plaits::SimdResonatorSvf<stmlib::f32x4>, 4>(numBlocks);
+    BenchResult scalar8 = run<plaits::ScalarResonatorSvf<8>, 8>(numBlocks);
+    BenchResult simd8 = run<plaits::SimdResonatorSvf<stmlib::f32x8>, 8>(numBlocks);
+
+    printf("%-16s %12s %12s\n", "filters", "ns/mode/smp", "max diff");
+    printf("%-16s %12.3f %12s\n", "1 mode", single.nanoseconds, "-");
+    printf("%-16s %12.3f %12s\n", "4 modes, scalar", scalar4.nanoseconds, "-");
+    printf("%-16s %12.3f %12g\n", "4 modes, f32x4", simd4.nanoseconds, maxDifference(simd4, scalar4));
+    printf("%-16s %12.3f %12s\n", "8 modes, scalar", scalar8.nanoseconds, "-");
+    printf("%-16s %12.3f %12g\n", "8 modes, f32x8", simd8.nanoseconds, maxDifference(simd8, scalar8));
+    return 0;
+}
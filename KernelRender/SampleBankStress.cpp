@@ -0,0 +1,139 @@
+//
+//  SampleBankStress.cpp
+//  KernelRender
+//
+//  Stress test of the hand-over of sample banks to the render thread: one thread loads banks two
+//  at a time, the second while the first may still be pending, and waits for the render thread
+//  to acquire the second. The render thread keeps acquiring them and reads every sample of the
+//  active one. Fails when a bank read by the render thread holds the wrong data, or when a bank
+//  loaded is not acquired within a second.
+//
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "stmlib/utils/sample_bank.h"
+
+static const int kNumBanks = 4;
+static const int kBankSize = 4096;
+
+static const uint32_t kTag = stmlib::SampleBankTag('T', 'E', 'S', 'T');
+
+// A bank with one section of kBankSize values, all equal to id.
+static bool writeBank(const std::string& path, uint32_t id) {
+    FILE *file = fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    stmlib::SampleBankHeader header = { stmlib::SampleBankTag('S', 'B', 'N', 'K'), stmlib::kSampleBankVersion, 1, 0 };
+    stmlib::SampleBankSection section = { kTag, 32, kBankSize * sizeof(uint32_t), 1 };
+    std::vector<uint32_t> data(kBankSize, id);
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+        fwrite(&section, sizeof(section), 1, file) == 1 &&
+        fwrite(data.data(), sizeof(uint32_t), kBankSize, file) == kBankSize;
+    return fclose(file) == 0 && ok;
+}
+
+// Id of the bank, 0 when there is none, or -1 when its data is not that of a bank written above.
+static int readBank(const stmlib::SampleBank *bank) {
+    if (!bank || !bank->is_open()) {
+        return 0;
+    }
+    size_t size = 0;
+    size_t stride = 0;
+    const uint32_t *data = bank->section<uint32_t>(kTag, &size, &stride);
+    if (!data || size != kBankSize) {
+        return -1;
+    }
+    for (size_t i = 0; i < size; i++) {
+        if (data[i] != data[0]) {
+            return -1;
+        }
+    }
+    return (int) data[0];
+}
+
+int main(int argc, char **argv) {
+    int numLoads = argc > 1 ? atoi(argv[1]) : 2000;
+    if (numLoads <= 0) {
+        fprintf(stderr, "usage: sample-bank-stress [number of loads, default 2000]\n");
+        return 2;
+    }
+
+    char directory[] = "/tmp/sample-bank-stress.XXXXXX";
+    if (!mkdtemp(directory)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    std::vector<std::string> paths;
+    for (int i = 0; i < kNumBanks; i++) {
+        paths.push_back(std::string(directory) + "/bank" + std::to_string(i + 1) + ".bin");
+        if (!writeBank(paths.back(), i + 1)) {
+            fprintf(stderr, "cannot write %s\n", paths.back().c_str());
+            return 1;
+        }
+    }
+
+    stmlib::SampleBankLoader loader;
+    std::atomic<bool> loading(true);
+    std::atomic<int> activeId(0);
+    std::atomic<bool> corrupted(false);
+    uint64_t acquisitions = 0;
+
+    std::thread render([&] {
+        while (loading) {
+            if (loader.Acquire()) {
+                acquisitions++;
+            }
+            int id = readBank(loader.bank());
+            if (id < 0) {
+                corrupted = true;
+                return;
+            }
+            activeId = id;
+        }
+    });
+
+    // Every few loads switch back to no bank at all. Consecutive pairs never load the same bank
+    // twice, so that the wait below cannot be satisfied by the previous one.
+    bool lost = false;
+    typedef std::chrono::steady_clock Clock;
+    for (int i = 0; i < numLoads && !corrupted && !lost; i += 2) {
+        int first = i % (kNumBanks + 1);
+        int second = (first + 1 + (i / 2) % kNumBanks) % (kNumBanks + 1);
+        loader.Load(first ? paths[first - 1].c_str() : NULL);
+        loader.Load(second ? paths[second - 1].c_str() : NULL);
+        Clock::time_point deadline = Clock::now() + std::chrono::seconds(1);
+        while (activeId != second && !corrupted) {
+            if (Clock::now() > deadline) {
+                lost = true;
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+    loading = false;
+    render.join();
+
+    for (const std::string& path : paths) {
+        remove(path.c_str());
+    }
+    remove(directory);
+
+    printf("%d loads, %llu acquisitions\n", numLoads, (unsigned long long) acquisitions);
+    if (corrupted) {
+        printf("FAIL: the render thread read a bank which was not a whole one\n");
+        return 1;
+    }
+    if (lost) {
+        printf("FAIL: a bank loaded was not acquired\n");
+        return 1;
+    }
+    printf("pass\n");
+    return 0;
+}
@@ -0,0 +1,132 @@
+//
+//  AudioToolbox.h
+//  KernelRender
+//
+//  Stand-in for the AudioToolbox types used by DSPKernel and the instrument kernels, so that
+//  the kernels can be built and driven outside of an AUv3 host on platforms without
+//  AudioToolbox. Layouts follow AUAudioUnitImplementation.h and CoreAudioTypes.h.
+//
+
+#ifndef KernelRender_AudioToolbox_h
+#define KernelRender_AudioToolbox_h
+
+// The real header brings in the C library through CoreFoundation, and the kernels rely on it.
+#include <assert.h>
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t UInt8;
+typedef int16_t SInt16;
+typedef uint16_t UInt16;
+typedef int32_t SInt32;
+typedef uint32_t UInt32;
+typedef int64_t SInt64;
+typedef uint64_t UInt64;
+typedef float Float32;
+typedef double Float64;
+typedef unsigned char Boolean;
+typedef long NSInteger;
+
+typedef SInt32 OSStatus;
+enum { noErr = 0 };
+
+typedef uint64_t AUParameterAddress;
+typedef float AUValue;
+typedef uint32_t AUAudioFrameCount;
+typedef uint32_t AVAudioFrameCount;
+typedef int64_t AUEventSampleTime;
+typedef OSStatus AUAudioUnitStatus;
+typedef UInt32 AudioUnitRenderActionFlags;
+
+typedef struct AudioBuffer {
+    UInt32 mNumberChannels;
+    UInt32 mDataByteSize;
+    void *mData;
+} AudioBuffer;
+
+typedef struct AudioBufferList {
+    UInt32 mNumberBuffers;
+    AudioBuffer mBuffers[1];
+} AudioBufferList;
+
+typedef struct SMPTETime {
+    SInt16 mSubframes;
+    SInt16 mSubframeDivisor;
+    UInt32 mCounter;
+    UInt32 mType;
+    UInt32 mFlags;
+    SInt16 mHours;
+    SInt16 mMinutes;
+    SInt16 mSeconds;
+    SInt16 mFrames;
+} SMPTETime;
+
+enum {
+    kAudioTimeStampSampleTimeValid = (1U << 0),
+    kAudioTimeStampHostTimeValid = (1U << 1),
+};
+
+typedef struct AudioTimeStamp {
+    Float64 mSampleTime;
+    UInt64 mHostTime;
+    Float64 mRateScalar;
+    UInt64 mWordClockTime;
+    SMPTETime mSMPTETime;
+    UInt32 mFlags;
+    UInt32 mReserved;
+} AudioTimeStamp;
+
+typedef uint8_t AURenderEventType;
+enum {
+    AURenderEventParameter = 1,
+    AURenderEventParameterRamp = 2,
+    AURenderEventMIDI = 8,
+    AURenderEventMIDISysEx = 9,
+};
+
+union AURenderEvent;
+
+typedef struct AURenderEventHeader {
+    union AURenderEvent *next;
+    AUEventSampleTime eventSampleTime;
+    AURenderEventType eventType;
+    uint8_t reserved;
+} AURenderEventHeader;
+
+typedef struct AUParameterEvent {
+    union AURenderEvent *next;
+    AUEventSampleTime eventSampleTime;
+    AURenderEventType eventType;
+    uint8_t reserved[3];
+    AUAudioFrameCount rampDurationSampleFrames;
+    AUParameterAddress parameterAddress;
+    AUValue value;
+} AUParameterEvent;
+
+typedef struct AUMIDIEvent {
+    union AURenderEvent *next;
+    AUEventSampleTime eventSampleTime;
+    AURenderEventType eventType;
+    uint8_t reserved;
+    uint16_t length;
+    uint8_t cable;
+    uint8_t data[3];
+} AUMIDIEvent;
+
+typedef union AURenderEvent {
+    AURenderEventHeader head;
+    AUParameterEvent parameter;
+    AUMIDIEvent MIDI;
+} AURenderEvent;
+
+#ifdef __cplusplus
+#ifndef nil
+#define nil nullptr
+#endif
+#endif
+
+#endif /* KernelRender_AudioToolbox_h */
@@ -0,0 +1,6 @@
+//
+//  AudioUnit.h
+//  KernelRender
+//
+
+#include <AudioToolbox/AudioToolbox.h>